@@ -215,7 +215,13 @@ void Application::mainloop()
     
     // 主循环
     while (!glfwWindowShouldClose(myGlfwWindow)) {
-        if (occtView && occtView->toWaitEvents()) {
+        if (myViewModel && (myViewModel->isImporting() || myViewModel->isBuildingPresentations())) {
+            // 后台导入和显示准备期间定时唤醒，以刷新进度条并及时提交结果
+            glfwWaitEventsTimeout(0.05);
+        }
+        else if (occtView && occtView->toWaitEvents()
+                 && !(myViewModel && myViewModel->getViewerUpdates().hasPending())) {
+            // 界面在视图之后绘制，其中产生的显示更新在下一帧刷新，有待刷新的更新时不能等待事件
             glfwWaitEvents();
         }
         else {
@@ -3,6 +3,8 @@
 #include <Precision.hxx>
 #include <Standard_Type.hxx>
 
+#include <cmath>
+
 IMPLEMENT_STANDARD_RTTIEXT(Mesh_DataSource, MeshVS_DataSource)
 
 //================================================================
@@ -10,50 +12,125 @@ IMPLEMENT_STANDARD_RTTIEXT(Mesh_DataSource, MeshVS_DataSource)
 // Purpose  :
 //================================================================
 Mesh_DataSource::Mesh_DataSource(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F)
-    : myV(V), myF(F)
+    : myOwnedV(V), myOwnedF(F)
+{
+    Init(myOwnedV, myOwnedF, myOwnedNormals);
+}
+
+//================================================================
+// Function : Constructor with pre-computed normals
+// Purpose  :
+//================================================================
+Mesh_DataSource::Mesh_DataSource(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const Eigen::MatrixXd& N)
+    : myOwnedV(V), myOwnedF(F), myOwnedNormals(N)
+{
+    Init(myOwnedV, myOwnedF, myOwnedNormals);
+}
+
+//================================================================
+// Function : Constructor taking over the buffers
+// Purpose  :
+//================================================================
+Mesh_DataSource::Mesh_DataSource(Eigen::MatrixXd&& V, Eigen::MatrixXi&& F, Eigen::MatrixXd&& N)
+    : myOwnedV(std::move(V)), myOwnedF(std::move(F)), myOwnedNormals(std::move(N))
+{
+    Init(myOwnedV, myOwnedF, myOwnedNormals);
+}
+
+//================================================================
+// Function : Constructor sharing the buffers
+// Purpose  :
+//================================================================
+Mesh_DataSource::Mesh_DataSource(const std::shared_ptr<const void>& theOwner,
+                                 const Eigen::MatrixXd& V,
+                                 const Eigen::MatrixXi& F,
+                                 const Eigen::MatrixXd& N,
+                                 const Eigen::MatrixXd& NodeNormals)
+    : myOwner(theOwner)
+{
+    Init(V, F, N);
+
+    // 已归一化的节点法向量直接共享，否则复制后归一化
+    if (NodeNormals.rows() == V.rows() && NodeNormals.cols() == 3 && IsNormalized(NodeNormals))
+    {
+        Bind(myNodeNormals, NodeNormals);
+    }
+    else
+    {
+        SetNodeNormals(NodeNormals);
+    }
+}
+
+//================================================================
+// Function : Init
+// Purpose  : Bind the views and initialize maps and normals
+//================================================================
+void Mesh_DataSource::Init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const Eigen::MatrixXd& N)
 {
-    if (V.rows() > 0 && F.rows() > 0)
+    Bind(myV, V);
+    Bind(myF, F);
+    if (V.rows() == 0 || F.rows() == 0)
+    {
+        return;
+    }
+
+    // 初始化节点和元素映射
+    InitMaps();
+
+    // 如果提供的法向量尺寸不匹配，则重新计算
+    if (N.rows() != F.rows() || N.cols() != 3)
     {
-        // 初始化节点和元素映射
-        InitMaps();
-        
-        // 计算法向量
         CalculateNormals();
+        return;
+    }
+
+    // 确保法向量已归一化，已归一化的法向量不再复制
+    if (!IsNormalized(N))
+    {
+        Eigen::MatrixXd aNormals = N;
+        Normalize(aNormals);
+        myOwnedNormals = std::move(aNormals);
+        Bind(myNormals, myOwnedNormals);
+    }
+    else
+    {
+        Bind(myNormals, N);
     }
 }
 
 //================================================================
-// Function : Constructor with pre-computed normals
+// Function : IsNormalized
 // Purpose  :
 //================================================================
-Mesh_DataSource::Mesh_DataSource(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const Eigen::MatrixXd& N)
-    : myV(V), myF(F), myNormals(N)
+bool Mesh_DataSource::IsNormalized(const Eigen::MatrixXd& N)
 {
-    if (V.rows() > 0 && F.rows() > 0)
+    for (Eigen::Index i = 0; i < N.rows(); ++i)
     {
-        // 初始化节点和元素映射
-        InitMaps();
-        
-        // 如果提供的法向量尺寸不匹配，则重新计算
-        if (N.rows() != F.rows() || N.cols() != 3)
+        const double aSquareLength = N.row(i).squaredNorm();
+        if (aSquareLength != 0.0 && std::abs(aSquareLength - 1.0) > Precision::Confusion())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//================================================================
+// Function : Normalize
+// Purpose  :
+//================================================================
+void Mesh_DataSource::Normalize(Eigen::MatrixXd& N)
+{
+    for (Eigen::Index i = 0; i < N.rows(); ++i)
+    {
+        const double aLength = N.row(i).norm();
+        if (aLength > Precision::Confusion())
         {
-            CalculateNormals();
+            N.row(i) /= aLength;
         }
         else
         {
-            // 确保法向量已归一化
-            for (int i = 0; i < N.rows(); ++i)
-            {
-                double length = N.row(i).norm();
-                if (length > Precision::Confusion())
-                {
-                    myNormals.row(i) = N.row(i) / length;
-                }
-                else
-                {
-                    myNormals.row(i) = Eigen::Vector3d::Zero();
-                }
-            }
+            N.row(i) = Eigen::Vector3d::Zero();
         }
     }
 }
@@ -90,7 +167,7 @@ void Mesh_DataSource::CalculateNormals()
     const Standard_Integer aNbTris = myF.rows();
     
     // 初始化法向量矩阵
-    myNormals = Eigen::MatrixXd::Zero(aNbTris, 3);
+    myOwnedNormals = Eigen::MatrixXd::Zero(aNbTris, 3);
     
     // 计算每个面的法向量
     for (Standard_Integer i = 1; i <= aNbTris; i++)
@@ -115,10 +192,11 @@ void Mesh_DataSource::CalculateNormals()
             aN.SetCoord(0.0, 0.0, 0.0);
         
         // 存储法向量到 Eigen 矩阵
-        myNormals(i-1, 0) = aN.X();
-        myNormals(i-1, 1) = aN.Y();
-        myNormals(i-1, 2) = aN.Z();
+        myOwnedNormals(i-1, 0) = aN.X();
+        myOwnedNormals(i-1, 1) = aN.Y();
+        myOwnedNormals(i-1, 2) = aN.Z();
     }
+    Bind(myNormals, myOwnedNormals);
 }
 
 //================================================================
@@ -301,3 +379,58 @@ Standard_Boolean Mesh_DataSource::GetNormal(
     else
         return Standard_False;
 }
+
+//================================================================
+// Function : SetNodeNormals
+// Purpose  :
+//================================================================
+void Mesh_DataSource::SetNodeNormals(const Eigen::MatrixXd& N)
+{
+    SetNodeNormals(Eigen::MatrixXd(N));
+}
+
+//================================================================
+// Function : SetNodeNormals
+// Purpose  :
+//================================================================
+void Mesh_DataSource::SetNodeNormals(Eigen::MatrixXd&& N)
+{
+    if (N.rows() != myV.rows() || N.cols() != 3)
+    {
+        myOwnedNodeNormals.resize(0, 3);
+    }
+    else
+    {
+        // 确保法向量已归一化
+        myOwnedNodeNormals = std::move(N);
+        Normalize(myOwnedNodeNormals);
+    }
+    Bind(myNodeNormals, myOwnedNodeNormals);
+}
+
+//================================================================
+// Function : GetNodeNormal
+// Purpose  :
+//================================================================
+Standard_Boolean Mesh_DataSource::GetNodeNormal(
+    const Standard_Integer RankNode,
+    const Standard_Integer ElementId,
+    Standard_Real& nx,
+    Standard_Real& ny,
+    Standard_Real& nz) const
+{
+    if (myNodeNormals.rows() == 0)
+        return Standard_False;
+
+    if (ElementId >= 1 && ElementId <= myElements.Extent() && RankNode >= 1 && RankNode <= 3)
+    {
+        // RankNode是节点在三角形中的序号（从1开始）
+        const Standard_Integer aNode = myF(ElementId-1, RankNode-1);
+        nx = myNodeNormals(aNode, 0);
+        ny = myNodeNormals(aNode, 1);
+        nz = myNodeNormals(aNode, 2);
+        return Standard_True;
+    }
+    else
+        return Standard_False;
+}
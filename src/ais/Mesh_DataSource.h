@@ -12,6 +12,8 @@
 
 #include <Eigen/Dense>
 
+#include <memory>
+
 class Mesh_DataSource;
 DEFINE_STANDARD_HANDLE(Mesh_DataSource, MeshVS_DataSource)
 
@@ -19,12 +21,25 @@ DEFINE_STANDARD_HANDLE(Mesh_DataSource, MeshVS_DataSource)
 class Mesh_DataSource: public MeshVS_DataSource
 {
 public:
-    //! Constructor.
+    //! Constructor, copying the buffers.
     Mesh_DataSource(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
     
-    //! Constructor with pre-computed normals.
+    //! Constructor with pre-computed normals, copying the buffers.
     Mesh_DataSource(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const Eigen::MatrixXd& N);
 
+    //! Constructor taking over the buffers without copying them.
+    //! Face normals are computed if N is empty or does not match F.
+    Mesh_DataSource(Eigen::MatrixXd&& V, Eigen::MatrixXi&& F, Eigen::MatrixXd&& N = Eigen::MatrixXd());
+
+    //! Constructor sharing buffers that are kept alive by theOwner (e.g. the mesh data of
+    //! the model), without copying them. The buffers must not be modified while shared.
+    //! Normals that are not unit length are copied normalized; NodeNormals may be empty.
+    Mesh_DataSource(const std::shared_ptr<const void>& theOwner,
+                    const Eigen::MatrixXd& V,
+                    const Eigen::MatrixXi& F,
+                    const Eigen::MatrixXd& N,
+                    const Eigen::MatrixXd& NodeNormals = Eigen::MatrixXd());
+
     //! Destructor.
     ~Mesh_DataSource() override;
 
@@ -69,20 +84,62 @@ public:
                                        Standard_Real& ny,
                                        Standard_Real& nz) const Standard_OVERRIDE;
 
+    //! Sets per-node normals (one row per node) used for smooth shading.
+    //! An empty or mismatching matrix disables node normals.
+    void SetNodeNormals(const Eigen::MatrixXd& N);
+
+    //! Sets per-node normals, taking over the buffer.
+    void SetNodeNormals(Eigen::MatrixXd&& N);
+
+    //! Returns true if per-node normals are available.
+    Standard_Boolean HasNodeNormals() const { return myNodeNormals.rows() > 0; }
+
+    //! This method returns the normal of the node with rank RankNode in element ElementId.
+    virtual Standard_Boolean GetNodeNormal(const Standard_Integer RankNode,
+                                           const Standard_Integer ElementId,
+                                           Standard_Real& nx,
+                                           Standard_Real& ny,
+                                           Standard_Real& nz) const Standard_OVERRIDE;
+
 
     DEFINE_STANDARD_RTTIEXT(Mesh_DataSource, MeshVS_DataSource)
 
 private:
+    //! Points the views at the buffers, initializes the maps and the face normals
+    void Init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const Eigen::MatrixXd& N);
+
     //! Initialize nodes and elements maps
     void InitMaps();
     
     //! Calculate face normals if not provided
     void CalculateNormals();
+
+    //! Returns true if every row of N has unit length or is zero
+    static bool IsNormalized(const Eigen::MatrixXd& N);
+
+    //! Normalizes every row of N in place
+    static void Normalize(Eigen::MatrixXd& N);
+
+    //! Points a view at the data of a matrix
+    template <typename Matrix>
+    static void Bind(Eigen::Map<const Matrix>& theView, const Matrix& theMatrix)
+    {
+        new (&theView) Eigen::Map<const Matrix>(theMatrix.data(), theMatrix.rows(), theMatrix.cols());
+    }
     
     TColStd_PackedMapOfInteger myNodes;
     TColStd_PackedMapOfInteger myElements;
-    
-    Eigen::MatrixXd myV;
-    Eigen::MatrixXi myF;
-    Eigen::MatrixXd myNormals; // 存储每个面的法向量
+
+    // 共享缓冲区的所有者（为空时数据由下面的矩阵持有）
+    std::shared_ptr<const void> myOwner;
+    Eigen::MatrixXd myOwnedV;
+    Eigen::MatrixXi myOwnedF;
+    Eigen::MatrixXd myOwnedNormals;
+    Eigen::MatrixXd myOwnedNodeNormals;
+
+    // 访问数据的视图，指向共享的或自身持有的缓冲区
+    Eigen::Map<const Eigen::MatrixXd> myV{nullptr, 0, 3};
+    Eigen::Map<const Eigen::MatrixXi> myF{nullptr, 0, 3};
+    Eigen::Map<const Eigen::MatrixXd> myNormals{nullptr, 0, 3}; // 每个面的法向量
+    Eigen::Map<const Eigen::MatrixXd> myNodeNormals{nullptr, 0, 3}; // 每个节点的法向量（可选）
 };
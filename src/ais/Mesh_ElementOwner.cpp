@@ -0,0 +1,82 @@
+﻿#include "Mesh_ElementOwner.h"
+
+#include <Standard_Type.hxx>
+#include <TColStd_HPackedMapOfInteger.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(Mesh_ElementOwner, SelectMgr_EntityOwner)
+
+//================================================================
+// Function : Constructor
+// Purpose  :
+//================================================================
+Mesh_ElementOwner::Mesh_ElementOwner(const Handle(SelectMgr_SelectableObject)& theObject,
+                                     const Standard_Integer thePatch)
+    : SelectMgr_EntityOwner(theObject, 5),
+      myPatch(thePatch)
+{
+    SetComesFromDecomposition(Standard_True);
+}
+
+//================================================================
+// Function : UpdateSelectedElements
+// Purpose  :
+//================================================================
+Standard_Boolean Mesh_ElementOwner::UpdateSelectedElements(const Handle(Select3D_SensitiveEntity)& theEntity,
+                                                           const AIS_SelectionScheme theScheme)
+{
+    Handle(Select3D_SensitivePrimitiveArray) aSensitive = Handle(Select3D_SensitivePrimitiveArray)::DownCast(theEntity);
+    if (aSensitive.IsNull())
+    {
+        return Standard_False;
+    }
+
+    if (theScheme != AIS_SelectionScheme_Add
+     && theScheme != AIS_SelectionScheme_XOR
+     && theScheme != AIS_SelectionScheme_Remove)
+    {
+        DetectedElements(aSensitive, mySelElements);
+        return Standard_True;
+    }
+
+    TColStd_PackedMapOfInteger aDetected;
+    DetectedElements(aSensitive, aDetected);
+    switch (theScheme)
+    {
+        case AIS_SelectionScheme_Add:
+            mySelElements.Unite(aDetected);
+            break;
+        case AIS_SelectionScheme_XOR:
+            // 对称差：已选中的三角形取消，其余加入
+            mySelElements.Differ(aDetected);
+            break;
+        default:
+            mySelElements.Subtract(aDetected);
+            break;
+    }
+    return Standard_True;
+}
+
+//================================================================
+// Function : DetectedElements
+// Purpose  :
+//================================================================
+void Mesh_ElementOwner::DetectedElements(const Handle(Select3D_SensitivePrimitiveArray)& theSensitive,
+                                         TColStd_PackedMapOfInteger& theElements)
+{
+    theElements.Clear();
+    if (theSensitive.IsNull())
+    {
+        return;
+    }
+
+    // 框选和套索选择得到所有命中的三角形，单击时至少有最近的一个
+    const Handle(TColStd_HPackedMapOfInteger)& aDetected = theSensitive->LastDetectedElementMap();
+    if (!aDetected.IsNull())
+    {
+        theElements.Assign(aDetected->Map());
+    }
+    if (theElements.IsEmpty() && theSensitive->LastDetectedElement() >= 0)
+    {
+        theElements.Add(theSensitive->LastDetectedElement());
+    }
+}
@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include <AIS_SelectionScheme.hxx>
+#include <Select3D_SensitivePrimitiveArray.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <TColStd_PackedMapOfInteger.hxx>
+
+class Mesh_ElementOwner;
+DEFINE_STANDARD_HANDLE(Mesh_ElementOwner, SelectMgr_EntityOwner)
+
+//! Owner of the triangles of one patch of a Mesh_PreparedObject in the triangle selection mode.
+//!
+//! The sensitive entity of the patch detects all triangles touched by a point, rectangle or
+//! polygon pick, but only keeps them until the next pick. Once a pick has selected the owner,
+//! the detected triangles are copied here and drawn by the object (the owner is not
+//! highlighted automatically).
+class Mesh_ElementOwner: public SelectMgr_EntityOwner
+{
+public:
+    //! Constructor.
+    //! @param theObject the presentation
+    //! @param thePatch index of the patch in the prepared data
+    Mesh_ElementOwner(const Handle(SelectMgr_SelectableObject)& theObject, const Standard_Integer thePatch);
+
+    //! Returns the index of the patch.
+    Standard_Integer Patch() const { return myPatch; }
+
+    //! Returns the selected triangles (0-based indices within the patch).
+    const TColStd_PackedMapOfInteger& SelectedElements() const { return mySelElements; }
+
+    //! Combines the triangles detected by the last pick with the selected triangles.
+    //! @param theEntity the sensitive entity of the patch
+    //! @param theScheme AIS_SelectionScheme_Add unites, AIS_SelectionScheme_XOR toggles and
+    //!                  AIS_SelectionScheme_Remove subtracts the detected triangles; other schemes replace them
+    //! @return false if the entity does not detect triangles
+    Standard_Boolean UpdateSelectedElements(const Handle(Select3D_SensitiveEntity)& theEntity,
+                                            const AIS_SelectionScheme theScheme = AIS_SelectionScheme_Replace);
+
+    //! Clears the selected triangles, e.g. once the owner has been deselected.
+    void ClearSelectedElements() { mySelElements.Clear(); }
+
+    //! Collects the triangles detected by the last pick of a sensitive entity.
+    static void DetectedElements(const Handle(Select3D_SensitivePrimitiveArray)& theSensitive,
+                                 TColStd_PackedMapOfInteger& theElements);
+
+    //! The selected triangles are drawn by Mesh_PreparedObject::HilightSelected().
+    Standard_Boolean IsAutoHilight() const Standard_OVERRIDE { return Standard_False; }
+
+private:
+    TColStd_PackedMapOfInteger mySelElements;
+    Standard_Integer           myPatch;
+
+public:
+    DEFINE_STANDARD_RTTIEXT(Mesh_ElementOwner, SelectMgr_EntityOwner)
+};
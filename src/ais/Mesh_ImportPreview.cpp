@@ -0,0 +1,108 @@
+﻿#include "Mesh_ImportPreview.h"
+
+#include <Graphic3d_AspectFillArea3d.hxx>
+#include <Graphic3d_Group.hxx>
+#include <PrsMgr_Presentation.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <Standard_Type.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(Mesh_ImportPreview, AIS_InteractiveObject)
+
+//================================================================
+// Function : Constructor
+// Purpose  :
+//================================================================
+Mesh_ImportPreview::Mesh_ImportPreview()
+    : myNbTriangles(0)
+{
+    // 预览统一使用中性灰色，提交后的网格再使用模型中的颜色
+    myDrawer->SetupOwnShadingAspect();
+    myDrawer->ShadingAspect()->SetColor(Quantity_NOC_GRAY70);
+    SetDisplayMode(0);
+}
+
+//================================================================
+// Function : AddTriangles
+// Purpose  :
+//================================================================
+void Mesh_ImportPreview::AddTriangles(const std::vector<float>& thePositions,
+                                      const std::vector<float>& theNormals)
+{
+    const Standard_Integer aNbTriangles = Standard_Integer(theNormals.size() / 3);
+    if (aNbTriangles == 0 || thePositions.size() < size_t(aNbTriangles) * 9)
+    {
+        return;
+    }
+
+    // 三角形汤：每个角点一个顶点，法向量取所在三角形的面法向量；数组按批次大小一次分配
+    Handle(Graphic3d_ArrayOfTriangles) aTriangles =
+        new Graphic3d_ArrayOfTriangles(aNbTriangles * 3, 0, Graphic3d_ArrayFlags_VertexNormal);
+    for (Standard_Integer aTri = 0; aTri < aNbTriangles; ++aTri)
+    {
+        const float* aNormal = &theNormals[size_t(aTri) * 3];
+        for (Standard_Integer aCorner = 0; aCorner < 3; ++aCorner)
+        {
+            const float* aPoint = &thePositions[(size_t(aTri) * 3 + size_t(aCorner)) * 3];
+            aTriangles->AddVertex(Graphic3d_Vec3(aPoint[0], aPoint[1], aPoint[2]),
+                                  Graphic3d_Vec3(aNormal[0], aNormal[1], aNormal[2]));
+        }
+    }
+    myNbTriangles += aNbTriangles;
+
+    // 已显示时追加到现有显示，否则留到首次计算
+    for (PrsMgr_Presentations::Iterator aPrsIter(Presentations()); aPrsIter.More(); aPrsIter.Next())
+    {
+        const Handle(PrsMgr_Presentation)& aPrs = aPrsIter.Value();
+        if (aPrs->Mode() == 0)
+        {
+            // 包围盒变大后通知所在图层，视锥裁剪使用新的包围盒
+            addGroup(aPrs, aTriangles);
+            aPrs->CalculateBoundBox();
+            aPrs->Update(true);
+            return;
+        }
+    }
+    myPending.push_back(aTriangles);
+}
+
+//================================================================
+// Function : Compute
+// Purpose  :
+//================================================================
+void Mesh_ImportPreview::Compute(const Handle(PrsMgr_PresentationManager)&,
+                                 const Handle(Prs3d_Presentation)& thePrs,
+                                 const Standard_Integer theMode)
+{
+    if (theMode != 0)
+    {
+        return;
+    }
+
+    // 交给显示后不再保留，批次只由图形驱动持有
+    for (const Handle(Graphic3d_ArrayOfTriangles)& aTriangles : myPending)
+    {
+        addGroup(thePrs, aTriangles);
+    }
+    myPending.clear();
+    myPending.shrink_to_fit();
+}
+
+//================================================================
+// Function : ComputeSelection
+// Purpose  :
+//================================================================
+void Mesh_ImportPreview::ComputeSelection(const Handle(SelectMgr_Selection)&, const Standard_Integer)
+{
+}
+
+//================================================================
+// Function : addGroup
+// Purpose  :
+//================================================================
+void Mesh_ImportPreview::addGroup(const Handle(Graphic3d_Structure)& thePrs,
+                                  const Handle(Graphic3d_ArrayOfTriangles)& theTriangles) const
+{
+    Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+    aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+    aGroup->AddPrimitiveArray(theTriangles);
+}
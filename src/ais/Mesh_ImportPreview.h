@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+
+#include <vector>
+
+class Mesh_ImportPreview;
+DEFINE_STANDARD_HANDLE(Mesh_ImportPreview, AIS_InteractiveObject)
+
+//! Shaded, non-selectable preview of the triangles streamed by the mesh readers of a running import.
+//!
+//! Every batch of triangles is added to the displayed presentation as a new group, so the preview
+//! grows without recomputing or redisplaying what is already shown. The object keeps no reference
+//! to the triangle arrays: the graphic driver releases their CPU copies once they are uploaded.
+//! The preview is therefore never recomputed; it is removed once the complete meshes have been
+//! committed to the model.
+class Mesh_ImportPreview: public AIS_InteractiveObject
+{
+public:
+    //! Constructor.
+    Mesh_ImportPreview();
+
+    //! Adds a batch of triangles.
+    //! @param thePositions x, y, z of the three corners of each triangle
+    //! @param theNormals x, y, z of the normal of each triangle
+    void AddTriangles(const std::vector<float>& thePositions, const std::vector<float>& theNormals);
+
+    //! Returns the number of triangles added so far.
+    Standard_Integer NbTriangles() const { return myNbTriangles; }
+
+    //! Only the shaded mode is supported.
+    Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE
+    {
+        return theMode == 0;
+    }
+
+protected:
+    //! Adds the batches added before the object was displayed.
+    void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                 const Handle(Prs3d_Presentation)& thePrs,
+                 const Standard_Integer theMode) Standard_OVERRIDE;
+
+    //! The preview is not selectable.
+    void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                          const Standard_Integer theMode) Standard_OVERRIDE;
+
+private:
+    //! Adds one batch to a presentation as a new group.
+    void addGroup(const Handle(Graphic3d_Structure)& thePrs,
+                  const Handle(Graphic3d_ArrayOfTriangles)& theTriangles) const;
+
+private:
+    std::vector<Handle(Graphic3d_ArrayOfTriangles)> myPending;    //!< batches waiting for the first Compute()
+    Standard_Integer                                myNbTriangles;
+
+public:
+    DEFINE_STANDARD_RTTIEXT(Mesh_ImportPreview, AIS_InteractiveObject)
+};
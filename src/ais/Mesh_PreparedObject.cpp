@@ -0,0 +1,742 @@
+﻿#include "Mesh_PreparedObject.h"
+
+#include "Mesh_ElementOwner.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <BRep_Tool.hxx>
+#include <Graphic3d_AspectFillArea3d.hxx>
+#include <Graphic3d_Group.hxx>
+#include <gp.hxx>
+#include <Poly_Polygon3D.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <PrsMgr_PresentationManager.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <Standard_Type.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+IMPLEMENT_STANDARD_RTTIEXT(Mesh_PreparedObject, AIS_InteractiveObject)
+
+namespace
+{
+//! Triangulated face of a CAD part collected for preparation.
+struct FaceEntry
+{
+    Handle(Poly_Triangulation) Triangulation;
+    gp_Trsf                    Transformation;
+    Standard_Boolean           IsReversed = Standard_False;
+    size_t                     Patch = 0;
+};
+
+//! Resets a bounding box to empty.
+void resetBox(Graphic3d_Vec3& theMin, Graphic3d_Vec3& theMax)
+{
+    theMin = Graphic3d_Vec3(std::numeric_limits<float>::max());
+    theMax = Graphic3d_Vec3(-std::numeric_limits<float>::max());
+}
+
+//! Converts a point to single precision and extends the bounding box by it.
+Graphic3d_Vec3 addToBox(const gp_XYZ& thePoint, Graphic3d_Vec3& theMin, Graphic3d_Vec3& theMax)
+{
+    const Graphic3d_Vec3 aPoint(float(thePoint.X()), float(thePoint.Y()), float(thePoint.Z()));
+    theMin = theMin.cwiseMin(aPoint);
+    theMax = theMax.cwiseMax(aPoint);
+    return aPoint;
+}
+
+//! Converts a direction to single precision.
+Graphic3d_Vec3 toVec3(const gp_XYZ& theDir)
+{
+    return Graphic3d_Vec3(float(theDir.X()), float(theDir.Y()), float(theDir.Z()));
+}
+
+//! Returns the unit normal of a triangle, or +Z for degenerate triangles.
+gp_XYZ triangleNormal(const gp_XYZ& theP1, const gp_XYZ& theP2, const gp_XYZ& theP3)
+{
+    const gp_XYZ aNormal = (theP2 - theP1).Crossed(theP3 - theP1);
+    const Standard_Real aLength = aNormal.Modulus();
+    return aLength > gp::Resolution() ? aNormal / aLength : gp_XYZ(0.0, 0.0, 1.0);
+}
+
+//! Creates the sensitive entity of a patch and builds its BVH on the calling thread.
+void prepareSelection(Mesh_PreparedObject::Patch& thePatch, const Handle(SelectMgr_EntityOwner)& theOwner)
+{
+    thePatch.Sensitive = new Select3D_SensitivePrimitiveArray(theOwner);
+    if (!thePatch.Sensitive->InitTriangulation(thePatch.Triangles->Attributes(),
+                                               thePatch.Triangles->Indices(),
+                                               TopLoc_Location()))
+    {
+        thePatch.Sensitive.Nullify();
+        return;
+    }
+    thePatch.Sensitive->BVH();
+}
+
+//! Appends the triangles of an array listed in a map to a non-indexed array.
+void appendTriangles(const Handle(Graphic3d_ArrayOfTriangles)& theTriangles,
+                     const TColStd_PackedMapOfInteger& theElements,
+                     const Handle(Graphic3d_ArrayOfTriangles)& theResult)
+{
+    const Standard_Boolean isIndexed = theTriangles->EdgeNumber() > 0;
+    const Standard_Integer aNbTriangles = isIndexed ? theTriangles->EdgeNumber() / 3 : theTriangles->VertexNumber() / 3;
+    for (TColStd_PackedMapOfInteger::Iterator anIter(theElements); anIter.More(); anIter.Next())
+    {
+        if (anIter.Key() < 0 || anIter.Key() >= aNbTriangles)
+        {
+            continue;
+        }
+        const Standard_Integer aFirst = anIter.Key() * 3 + 1;
+        for (Standard_Integer aCorner = 0; aCorner < 3; ++aCorner)
+        {
+            const Standard_Integer aVertex = isIndexed ? theTriangles->Edge(aFirst + aCorner) : aFirst + aCorner;
+            theResult->AddVertex(theTriangles->Vertice(aVertex));
+        }
+    }
+}
+
+//! Appends the discretization of the edges of a CAD part as segment end points.
+void collectShapeEdges(const TopoDS_Shape& theShape, std::vector<gp_Pnt>& theSegments)
+{
+    TopTools_IndexedDataMapOfShapeListOfShape anEdgeFaces;
+    TopExp::MapShapesAndAncestors(theShape, TopAbs_EDGE, TopAbs_FACE, anEdgeFaces);
+    std::vector<gp_Pnt> aPoints;
+    for (Standard_Integer anEdgeIter = 1; anEdgeIter <= anEdgeFaces.Extent(); ++anEdgeIter)
+    {
+        const TopoDS_Edge& anEdge = TopoDS::Edge(anEdgeFaces.FindKey(anEdgeIter));
+        if (BRep_Tool::Degenerated(anEdge))
+        {
+            continue;
+        }
+
+        // 优先使用边的三维离散，否则使用其所在面的三角网格上的离散
+        aPoints.clear();
+        TopLoc_Location aLocation;
+        const Handle(Poly_Polygon3D)& aPolygon = BRep_Tool::Polygon3D(anEdge, aLocation);
+        if (!aPolygon.IsNull())
+        {
+            const gp_Trsf& aTrsf = aLocation.Transformation();
+            for (Standard_Integer aNodeIter = 1; aNodeIter <= aPolygon->NbNodes(); ++aNodeIter)
+            {
+                aPoints.push_back(aPolygon->Nodes().Value(aNodeIter).Transformed(aTrsf));
+            }
+        }
+        else
+        {
+            for (TopTools_ListOfShape::Iterator aFaceIter(anEdgeFaces(anEdgeIter)); aFaceIter.More(); aFaceIter.Next())
+            {
+                TopLoc_Location aFaceLocation;
+                const Handle(Poly_Triangulation)& aTriangulation =
+                    BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Value()), aFaceLocation);
+                if (aTriangulation.IsNull())
+                {
+                    continue;
+                }
+                const Handle(Poly_PolygonOnTriangulation)& anOnTriangulation =
+                    BRep_Tool::PolygonOnTriangulation(anEdge, aTriangulation, aFaceLocation);
+                if (anOnTriangulation.IsNull())
+                {
+                    continue;
+                }
+                const gp_Trsf& aTrsf = aFaceLocation.Transformation();
+                for (Standard_Integer aNodeIter = 1; aNodeIter <= anOnTriangulation->NbNodes(); ++aNodeIter)
+                {
+                    aPoints.push_back(aTriangulation->Node(anOnTriangulation->Node(aNodeIter)).Transformed(aTrsf));
+                }
+                break;
+            }
+        }
+
+        for (size_t aPointIter = 1; aPointIter < aPoints.size(); ++aPointIter)
+        {
+            theSegments.push_back(aPoints[aPointIter - 1]);
+            theSegments.push_back(aPoints[aPointIter]);
+        }
+    }
+}
+} // namespace
+
+//================================================================
+// Function : PrepareShape
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::PrepareShape(const TopoDS_Shape& theShape,
+                                       const std::vector<UnifiedModel::SubShapeColor>& theColors,
+                                       const Standard_Boolean theToPrepareEdges,
+                                       Data& theData)
+{
+    theData = Data();
+    theData.Shape = theShape;
+    theData.Owner = new SelectMgr_EntityOwner();
+
+    // 第一遍：收集有三角网格的面，按颜色分组并统计节点和三角形数，以便一次分配数组
+    std::vector<FaceEntry> aFaces;
+    std::vector<Standard_Integer> aNbNodes(1, 0);
+    std::vector<Standard_Integer> aNbTriangles(1, 0);
+    theData.Patches.emplace_back();
+    for (TopExp_Explorer aFaceExp(theShape, TopAbs_FACE); aFaceExp.More(); aFaceExp.Next())
+    {
+        const TopoDS_Face& aFace = TopoDS::Face(aFaceExp.Current());
+        TopLoc_Location aLocation;
+        const Handle(Poly_Triangulation)& aTriangulation = BRep_Tool::Triangulation(aFace, aLocation);
+        if (aTriangulation.IsNull() || aTriangulation->NbTriangles() == 0)
+        {
+            continue;
+        }
+
+        FaceEntry anEntry;
+        anEntry.Triangulation = aTriangulation;
+        anEntry.Transformation = aLocation.Transformation();
+        anEntry.IsReversed = aFace.Orientation() == TopAbs_REVERSED;
+
+        // 面颜色以未定位零件形状的子形状表达，按TShape匹配，后设置的颜色优先
+        const Quantity_Color* aColor = nullptr;
+        for (const UnifiedModel::SubShapeColor& aSubShapeColor : theColors)
+        {
+            if (aFace.IsPartner(aSubShapeColor.subShape))
+            {
+                aColor = &aSubShapeColor.color;
+            }
+        }
+        if (aColor != nullptr)
+        {
+            anEntry.Patch = theData.Patches.size();
+            for (size_t aPatchIter = 1; aPatchIter < theData.Patches.size(); ++aPatchIter)
+            {
+                if (theData.Patches[aPatchIter].Color == *aColor)
+                {
+                    anEntry.Patch = aPatchIter;
+                    break;
+                }
+            }
+            if (anEntry.Patch == theData.Patches.size())
+            {
+                theData.Patches.emplace_back();
+                theData.Patches.back().Color = *aColor;
+                theData.Patches.back().HasCustomColor = Standard_True;
+                aNbNodes.push_back(0);
+                aNbTriangles.push_back(0);
+            }
+        }
+        aNbNodes[anEntry.Patch] += aTriangulation->NbNodes();
+        aNbTriangles[anEntry.Patch] += aTriangulation->NbTriangles();
+        aFaces.push_back(anEntry);
+    }
+
+    for (size_t aPatchIter = 0; aPatchIter < theData.Patches.size(); ++aPatchIter)
+    {
+        Patch& aPatch = theData.Patches[aPatchIter];
+        resetBox(aPatch.Min, aPatch.Max);
+        if (aNbNodes[aPatchIter] > 0)
+        {
+            aPatch.Triangles = new Graphic3d_ArrayOfTriangles(aNbNodes[aPatchIter],
+                                                              aNbTriangles[aPatchIter] * 3,
+                                                              Graphic3d_ArrayFlags_VertexNormal);
+        }
+    }
+
+    // 第二遍：填充节点、法向量和三角形；反向的面翻转三角形绕序和法向量
+    std::vector<gp_XYZ> aNormals;
+    for (const FaceEntry& aFace : aFaces)
+    {
+        const Handle(Poly_Triangulation)& aTriangulation = aFace.Triangulation;
+        Patch& aPatch = theData.Patches[aFace.Patch];
+        const Standard_Integer aNbFaceNodes = aTriangulation->NbNodes();
+
+        aNormals.assign(size_t(aNbFaceNodes), gp_XYZ(0.0, 0.0, 0.0));
+        if (aTriangulation->HasNormals())
+        {
+            for (Standard_Integer aNodeIter = 1; aNodeIter <= aNbFaceNodes; ++aNodeIter)
+            {
+                aNormals[size_t(aNodeIter - 1)] = aTriangulation->Normal(aNodeIter).XYZ();
+            }
+        }
+        else
+        {
+            // 三角网格没有法向量时按相邻三角形的面积加权平均，不修改共享的三角网格
+            for (Standard_Integer aTriIter = 1; aTriIter <= aTriangulation->NbTriangles(); ++aTriIter)
+            {
+                Standard_Integer aNodes[3];
+                aTriangulation->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+                const gp_XYZ aP1 = aTriangulation->Node(aNodes[0]).XYZ();
+                const gp_XYZ aNormal = (aTriangulation->Node(aNodes[1]).XYZ() - aP1)
+                                           .Crossed(aTriangulation->Node(aNodes[2]).XYZ() - aP1);
+                for (Standard_Integer aCorner = 0; aCorner < 3; ++aCorner)
+                {
+                    aNormals[size_t(aNodes[aCorner] - 1)] += aNormal;
+                }
+            }
+        }
+
+        const Standard_Integer aFirstNode = aPatch.Triangles->VertexNumber();
+        for (Standard_Integer aNodeIter = 1; aNodeIter <= aNbFaceNodes; ++aNodeIter)
+        {
+            gp_XYZ aPoint = aTriangulation->Node(aNodeIter).XYZ();
+            aFace.Transformation.Transforms(aPoint);
+            gp_XYZ aNormal = aNormals[size_t(aNodeIter - 1)];
+            const Standard_Real aLength = aNormal.Modulus();
+            aNormal = aLength > gp::Resolution() ? aNormal / aLength : gp_XYZ(0.0, 0.0, 1.0);
+            aNormal = gp_Dir(aNormal).Transformed(aFace.Transformation).XYZ();
+            if (aFace.IsReversed)
+            {
+                aNormal.Reverse();
+            }
+            aPatch.Triangles->AddVertex(addToBox(aPoint, aPatch.Min, aPatch.Max), toVec3(aNormal));
+        }
+        for (Standard_Integer aTriIter = 1; aTriIter <= aTriangulation->NbTriangles(); ++aTriIter)
+        {
+            Standard_Integer aN1 = 0, aN2 = 0, aN3 = 0;
+            aTriangulation->Triangle(aTriIter).Get(aN1, aN2, aN3);
+            if (aFace.IsReversed)
+            {
+                std::swap(aN2, aN3);
+            }
+            aPatch.Triangles->AddEdges(aFirstNode + aN1, aFirstNode + aN2, aFirstNode + aN3);
+        }
+        theData.NbTriangles += aTriangulation->NbTriangles();
+    }
+
+    // 没有使用零件颜色的三角形时去掉空的基本分组
+    theData.Patches.erase(std::remove_if(theData.Patches.begin(),
+                                         theData.Patches.end(),
+                                         [](const Patch& thePatch) { return thePatch.Triangles.IsNull(); }),
+                          theData.Patches.end());
+    for (Patch& aPatch : theData.Patches)
+    {
+        prepareSelection(aPatch, theData.Owner);
+    }
+    if (theToPrepareEdges)
+    {
+        PrepareEdges(theData);
+    }
+}
+
+//================================================================
+// Function : PrepareMesh
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::PrepareMesh(const UnifiedModel::MeshDataPtr& theMesh,
+                                      const Standard_Boolean theToPrepareEdges,
+                                      Data& theData)
+{
+    theData = Data();
+    theData.Mesh = theMesh;
+    theData.Owner = new SelectMgr_EntityOwner();
+    if (!theMesh || theMesh->faces.rows() == 0 || theMesh->vertices.rows() == 0)
+    {
+        return;
+    }
+
+    const UnifiedModel::MeshData& aMesh = *theMesh;
+    const Standard_Integer aNbNodes = Standard_Integer(aMesh.vertices.rows());
+    const Standard_Integer aNbFaces = Standard_Integer(aMesh.faces.rows());
+    const bool hasNodeNormals = aMesh.vertexNormals.rows() == aMesh.vertices.rows() && aMesh.vertexNormals.cols() == 3;
+    const bool hasFaceNormals = aMesh.normals.rows() == aMesh.faces.rows() && aMesh.normals.cols() == 3;
+    const bool hasColors = aMesh.vertexColors.rows() == aMesh.vertices.rows() && aMesh.vertexColors.cols() == 3;
+    Graphic3d_ArrayFlags aFlags = Graphic3d_ArrayFlags_VertexNormal;
+    if (hasColors)
+    {
+        aFlags |= Graphic3d_ArrayFlags_VertexColor;
+    }
+
+    auto aPointOf = [&aMesh](Eigen::Index theNode) {
+        return gp_XYZ(aMesh.vertices(theNode, 0), aMesh.vertices(theNode, 1), aMesh.vertices(theNode, 2));
+    };
+
+    Patch aPatch;
+    resetBox(aPatch.Min, aPatch.Max);
+    if (hasNodeNormals)
+    {
+        // 带顶点法向量的网格共享顶点，平滑着色
+        aPatch.Triangles = new Graphic3d_ArrayOfTriangles(aNbNodes, aNbFaces * 3, aFlags);
+        for (Eigen::Index aNode = 0; aNode < aNbNodes; ++aNode)
+        {
+            const gp_XYZ aNormal(aMesh.vertexNormals(aNode, 0), aMesh.vertexNormals(aNode, 1), aMesh.vertexNormals(aNode, 2));
+            const Standard_Integer anIndex =
+                aPatch.Triangles->AddVertex(addToBox(aPointOf(aNode), aPatch.Min, aPatch.Max), toVec3(aNormal));
+            if (hasColors)
+            {
+                aPatch.Triangles->SetVertexColor(anIndex,
+                                                 aMesh.vertexColors(aNode, 0),
+                                                 aMesh.vertexColors(aNode, 1),
+                                                 aMesh.vertexColors(aNode, 2));
+            }
+        }
+        for (Eigen::Index aFace = 0; aFace < aNbFaces; ++aFace)
+        {
+            aPatch.Triangles->AddEdges(aMesh.faces(aFace, 0) + 1, aMesh.faces(aFace, 1) + 1, aMesh.faces(aFace, 2) + 1);
+        }
+    }
+    else
+    {
+        // 否则每个三角形使用独立的顶点和面法向量，平面着色
+        aPatch.Triangles = new Graphic3d_ArrayOfTriangles(aNbFaces * 3, 0, aFlags);
+        for (Eigen::Index aFace = 0; aFace < aNbFaces; ++aFace)
+        {
+            const gp_XYZ aPoints[3] = {aPointOf(aMesh.faces(aFace, 0)),
+                                       aPointOf(aMesh.faces(aFace, 1)),
+                                       aPointOf(aMesh.faces(aFace, 2))};
+            gp_XYZ aNormal = hasFaceNormals
+                                 ? gp_XYZ(aMesh.normals(aFace, 0), aMesh.normals(aFace, 1), aMesh.normals(aFace, 2))
+                                 : gp_XYZ(0.0, 0.0, 0.0);
+            if (aNormal.SquareModulus() <= gp::Resolution())
+            {
+                aNormal = triangleNormal(aPoints[0], aPoints[1], aPoints[2]);
+            }
+            for (Standard_Integer aCorner = 0; aCorner < 3; ++aCorner)
+            {
+                const Standard_Integer anIndex =
+                    aPatch.Triangles->AddVertex(addToBox(aPoints[aCorner], aPatch.Min, aPatch.Max), toVec3(aNormal));
+                if (hasColors)
+                {
+                    const Eigen::Index aNode = aMesh.faces(aFace, aCorner);
+                    aPatch.Triangles->SetVertexColor(anIndex,
+                                                     aMesh.vertexColors(aNode, 0),
+                                                     aMesh.vertexColors(aNode, 1),
+                                                     aMesh.vertexColors(aNode, 2));
+                }
+            }
+        }
+    }
+
+    theData.NbTriangles = aNbFaces;
+    prepareSelection(aPatch, theData.Owner);
+    theData.Patches.push_back(aPatch);
+    if (theToPrepareEdges)
+    {
+        PrepareEdges(theData);
+    }
+}
+
+//================================================================
+// Function : PrepareEdges
+// Purpose  : The edges stay null if there are none
+//================================================================
+void Mesh_PreparedObject::PrepareEdges(Data& theData)
+{
+    theData.Edges.Nullify();
+    resetBox(theData.EdgesMin, theData.EdgesMax);
+    if (!theData.Shape.IsNull())
+    {
+        std::vector<gp_Pnt> aSegments;
+        collectShapeEdges(theData.Shape, aSegments);
+        if (aSegments.empty())
+        {
+            return;
+        }
+        theData.Edges = new Graphic3d_ArrayOfSegments(Standard_Integer(aSegments.size()));
+        for (const gp_Pnt& aPoint : aSegments)
+        {
+            theData.Edges->AddVertex(addToBox(aPoint.XYZ(), theData.EdgesMin, theData.EdgesMax));
+        }
+        return;
+    }
+
+    if (!theData.Mesh || theData.Mesh->faces.rows() == 0)
+    {
+        return;
+    }
+
+    // 网格的每条边只绘制一次：按端点编码后排序去重
+    const UnifiedModel::MeshData& aMesh = *theData.Mesh;
+    std::vector<std::uint64_t> anEdgeKeys;
+    anEdgeKeys.reserve(size_t(aMesh.faces.rows()) * 3);
+    for (Eigen::Index aFace = 0; aFace < aMesh.faces.rows(); ++aFace)
+    {
+        for (Eigen::Index aCorner = 0; aCorner < 3; ++aCorner)
+        {
+            const std::uint32_t aFrom = std::uint32_t(aMesh.faces(aFace, aCorner));
+            const std::uint32_t aTo = std::uint32_t(aMesh.faces(aFace, (aCorner + 1) % 3));
+            anEdgeKeys.push_back((std::uint64_t(std::min(aFrom, aTo)) << 32) | std::max(aFrom, aTo));
+        }
+    }
+    std::sort(anEdgeKeys.begin(), anEdgeKeys.end());
+    anEdgeKeys.erase(std::unique(anEdgeKeys.begin(), anEdgeKeys.end()), anEdgeKeys.end());
+
+    theData.Edges = new Graphic3d_ArrayOfSegments(Standard_Integer(aMesh.vertices.rows()),
+                                                  Standard_Integer(anEdgeKeys.size() * 2));
+    for (Eigen::Index aNode = 0; aNode < aMesh.vertices.rows(); ++aNode)
+    {
+        const gp_XYZ aPoint(aMesh.vertices(aNode, 0), aMesh.vertices(aNode, 1), aMesh.vertices(aNode, 2));
+        theData.Edges->AddVertex(addToBox(aPoint, theData.EdgesMin, theData.EdgesMax));
+    }
+    for (const std::uint64_t aKey : anEdgeKeys)
+    {
+        theData.Edges->AddEdges(Standard_Integer(aKey >> 32) + 1, Standard_Integer(aKey & 0xFFFFFFFFu) + 1);
+    }
+}
+
+//================================================================
+// Function : Constructor
+// Purpose  :
+//================================================================
+Mesh_PreparedObject::Mesh_PreparedObject(Data&& theData)
+    : myData(std::move(theData))
+{
+    myDrawer->SetupOwnShadingAspect();
+    myDrawer->SetLineAspect(new Prs3d_LineAspect(Quantity_NOC_GRAY70, Aspect_TOL_SOLID, 1.0));
+    SetDisplayMode(AIS_Shaded);
+}
+
+//================================================================
+// Function : HasCustomColors
+// Purpose  :
+//================================================================
+Standard_Boolean Mesh_PreparedObject::HasCustomColors() const
+{
+    return std::any_of(myData.Patches.begin(), myData.Patches.end(), [](const Patch& thePatch) {
+        return thePatch.HasCustomColor;
+    });
+}
+
+//================================================================
+// Function : SetColor
+// Purpose  : Modify the aspects shared with the presentation groups
+//================================================================
+void Mesh_PreparedObject::SetColor(const Quantity_Color& theColor)
+{
+    hasOwnColor = Standard_True;
+    myDrawer->SetColor(theColor);
+    myDrawer->ShadingAspect()->SetColor(theColor);
+    myDrawer->LineAspect()->SetColor(theColor);
+    SynchronizeAspects();
+}
+
+//================================================================
+// Function : Compute
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::Compute(const Handle(PrsMgr_PresentationManager)&,
+                                  const Handle(Prs3d_Presentation)& thePrs,
+                                  const Standard_Integer theMode)
+{
+    // 包围盒已在准备时计算，添加数组时不再遍历顶点
+    if (theMode == AIS_WireFrame)
+    {
+        if (myData.Edges.IsNull())
+        {
+            PrepareEdges(myData);
+        }
+        if (myData.Edges.IsNull())
+        {
+            return;
+        }
+        Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+        aGroup->SetGroupPrimitivesAspect(myDrawer->LineAspect()->Aspect());
+        aGroup->AddPrimitiveArray(myData.Edges, Standard_False);
+        aGroup->SetMinMaxValues(myData.EdgesMin.x(), myData.EdgesMin.y(), myData.EdgesMin.z(),
+                                myData.EdgesMax.x(), myData.EdgesMax.y(), myData.EdgesMax.z());
+        return;
+    }
+    if (theMode != AIS_Shaded)
+    {
+        return;
+    }
+
+    for (const Patch& aPatch : myData.Patches)
+    {
+        Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+        if (aPatch.HasCustomColor)
+        {
+            // 子形状颜色使用单独的属性，改变对象颜色时保持不变
+            Handle(Prs3d_ShadingAspect) aCustomAspect = new Prs3d_ShadingAspect();
+            *aCustomAspect->Aspect() = *myDrawer->ShadingAspect()->Aspect();
+            aCustomAspect->SetColor(aPatch.Color);
+            aGroup->SetGroupPrimitivesAspect(aCustomAspect->Aspect());
+        }
+        else
+        {
+            aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+        }
+        aGroup->AddPrimitiveArray(aPatch.Triangles, Standard_False);
+        aGroup->SetMinMaxValues(aPatch.Min.x(), aPatch.Min.y(), aPatch.Min.z(),
+                                aPatch.Max.x(), aPatch.Max.y(), aPatch.Max.z());
+    }
+}
+
+//================================================================
+// Function : ComputeSelection
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                           const Standard_Integer theMode)
+{
+    if (theMode == SM_Triangles)
+    {
+        // 三角形选择只在切换到该模式时创建，BVH在首次拾取前由选择器构建
+        myElementSensitives.clear();
+        for (size_t aPatchIter = 0; aPatchIter < myData.Patches.size(); ++aPatchIter)
+        {
+            const Patch& aPatch = myData.Patches[aPatchIter];
+            Handle(Mesh_ElementOwner) anOwner = new Mesh_ElementOwner(this, Standard_Integer(aPatchIter));
+            Handle(Select3D_SensitivePrimitiveArray) aSensitive = new Select3D_SensitivePrimitiveArray(anOwner);
+            aSensitive->SetDetectElements(Standard_True);
+            aSensitive->SetDetectElementMap(Standard_True);
+            if (aSensitive->InitTriangulation(aPatch.Triangles->Attributes(),
+                                              aPatch.Triangles->Indices(),
+                                              TopLoc_Location()))
+            {
+                theSel->Add(aSensitive);
+            }
+            else
+            {
+                aSensitive.Nullify();
+            }
+            myElementSensitives.push_back(aSensitive);
+        }
+        return;
+    }
+    if (theMode != SM_Object || myData.Owner.IsNull())
+    {
+        return;
+    }
+
+    // 所有者在准备时还没有对应的对象
+    myData.Owner->SetSelectable(this);
+    for (const Patch& aPatch : myData.Patches)
+    {
+        if (!aPatch.Sensitive.IsNull())
+        {
+            theSel->Add(aPatch.Sensitive);
+        }
+    }
+}
+
+//================================================================
+// Function : HilightSelected
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::HilightSelected(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                          const SelectMgr_SequenceOfOwner& theOwners)
+{
+    std::vector<std::pair<Standard_Integer, const TColStd_PackedMapOfInteger*>> anElements;
+    for (SelectMgr_SequenceOfOwner::Iterator anOwnerIter(theOwners); anOwnerIter.More(); anOwnerIter.Next())
+    {
+        Handle(Mesh_ElementOwner) anOwner = Handle(Mesh_ElementOwner)::DownCast(anOwnerIter.Value());
+        if (!anOwner.IsNull())
+        {
+            anElements.emplace_back(anOwner->Patch(), &anOwner->SelectedElements());
+        }
+    }
+
+    // 子元素使用上下文的局部选择样式
+    Handle(Prs3d_Drawer) aStyle = HilightAttributes();
+    if (aStyle.IsNull() && InteractiveContext() != NULL)
+    {
+        aStyle = InteractiveContext()->HighlightStyle(Prs3d_TypeOfHighlight_LocalSelected);
+    }
+    if (aStyle.IsNull())
+    {
+        return;
+    }
+
+    Handle(Prs3d_Presentation) aPrs = GetSelectPresentation(thePrsMgr);
+    fillElementPresentation(aPrs, aStyle, anElements);
+    aPrs->Display();
+}
+
+//================================================================
+// Function : HilightOwnerWithColor
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::HilightOwnerWithColor(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                                const Handle(Prs3d_Drawer)& theStyle,
+                                                const Handle(SelectMgr_EntityOwner)& theOwner)
+{
+    Handle(Mesh_ElementOwner) anOwner = Handle(Mesh_ElementOwner)::DownCast(theOwner);
+    if (anOwner.IsNull() || anOwner->Patch() >= Standard_Integer(myElementSensitives.size()))
+    {
+        return;
+    }
+
+    // 悬停高亮紧跟在拾取之后，敏感实体中仍是光标下的三角形
+    TColStd_PackedMapOfInteger aDetected;
+    Mesh_ElementOwner::DetectedElements(myElementSensitives[anOwner->Patch()], aDetected);
+    Handle(Prs3d_Presentation) aPrs = GetHilightPresentation(thePrsMgr);
+    fillElementPresentation(aPrs, theStyle, {std::make_pair(anOwner->Patch(), &aDetected)});
+    if (thePrsMgr->IsImmediateModeOn())
+    {
+        thePrsMgr->AddToImmediateList(aPrs);
+    }
+    else
+    {
+        aPrs->Display();
+    }
+}
+
+//================================================================
+// Function : RedrawSelectedElements
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::RedrawSelectedElements(const Handle(PrsMgr_PresentationManager)& thePrsMgr)
+{
+    SelectMgr_SequenceOfOwner aSelected;
+    for (const Handle(Select3D_SensitivePrimitiveArray)& aSensitive : myElementSensitives)
+    {
+        if (!aSensitive.IsNull() && aSensitive->OwnerId()->IsSelected())
+        {
+            aSelected.Append(aSensitive->OwnerId());
+        }
+    }
+    if (aSelected.IsEmpty())
+    {
+        ClearSelected();
+        return;
+    }
+    HilightSelected(thePrsMgr, aSelected);
+}
+
+//================================================================
+// Function : fillElementPresentation
+// Purpose  :
+//================================================================
+void Mesh_PreparedObject::fillElementPresentation(
+    const Handle(Prs3d_Presentation)& thePrs,
+    const Handle(Prs3d_Drawer)& theStyle,
+    const std::vector<std::pair<Standard_Integer, const TColStd_PackedMapOfInteger*>>& theElements) const
+{
+    thePrs->Clear();
+    Standard_Integer aNbTriangles = 0;
+    for (const auto& anEntry : theElements)
+    {
+        if (anEntry.first >= 0 && anEntry.first < Standard_Integer(myData.Patches.size()))
+        {
+            aNbTriangles += anEntry.second->Extent();
+        }
+    }
+    if (aNbTriangles == 0)
+    {
+        return;
+    }
+
+    Handle(Graphic3d_ArrayOfTriangles) aTriangles = new Graphic3d_ArrayOfTriangles(aNbTriangles * 3);
+    for (const auto& anEntry : theElements)
+    {
+        if (anEntry.first >= 0 && anEntry.first < Standard_Integer(myData.Patches.size()))
+        {
+            appendTriangles(myData.Patches[anEntry.first].Triangles, *anEntry.second, aTriangles);
+        }
+    }
+
+    // 着色三角形默认向后偏移深度，高亮不偏移即可绘制在其前面
+    Handle(Graphic3d_AspectFillArea3d) anAspect = new Graphic3d_AspectFillArea3d();
+    anAspect->SetInteriorStyle(Aspect_IS_SOLID);
+    anAspect->SetInteriorColor(theStyle->Color());
+    anAspect->SetShadingModel(Graphic3d_TOSM_UNLIT);
+    anAspect->SetPolygonOffsets(Aspect_POM_Off, 0.0f, 0.0f);
+
+    Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+    aGroup->SetGroupPrimitivesAspect(anAspect);
+    aGroup->AddPrimitiveArray(aTriangles);
+    thePrs->SetTransformation(TransformationGeom());
+    thePrs->SetZLayer(theStyle->ZLayer() != Graphic3d_ZLayerId_UNKNOWN ? theStyle->ZLayer() : ZLayer());
+}
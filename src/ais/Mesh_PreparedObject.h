@@ -0,0 +1,148 @@
+﻿#pragma once
+
+#include "model/UnifiedModel.h"
+
+#include <AIS_DisplayMode.hxx>
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfSegments.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_Vec3.hxx>
+#include <Select3D_SensitivePrimitiveArray.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <TColStd_PackedMapOfInteger.hxx>
+
+#include <utility>
+#include <vector>
+
+class Mesh_PreparedObject;
+DEFINE_STANDARD_HANDLE(Mesh_PreparedObject, AIS_InteractiveObject)
+
+//! Presentation of a triangulated CAD part or of a mesh whose primitive arrays and
+//! selection entities are prepared in advance, typically on a worker thread.
+//!
+//! The Prepare functions only read an immutable snapshot of the geometry (a shape whose
+//! faces already carry a triangulation, or shared mesh buffers) and may run on any thread.
+//! Compute() and ComputeSelection() then only hand the prepared arrays and the sensitive
+//! entities, whose BVH is already built, over to the presentation and the selector, so
+//! displaying the object on the UI thread is cheap. The location of a CAD part is not
+//! part of the prepared data; it is applied as local transformation.
+//!
+//! Supported display modes are AIS_WireFrame (edges) and AIS_Shaded (triangles).
+//! Selection mode SM_Object selects the object as a whole; SM_Triangles selects triangles,
+//! one Mesh_ElementOwner per patch, and draws the selected ones on top of the object.
+class Mesh_PreparedObject: public AIS_InteractiveObject
+{
+public:
+    //! Selection modes.
+    enum SelectionMode
+    {
+        SM_Object    = 0, //!< The whole object, using the prepared sensitive entities
+        SM_Triangles = 1  //!< Individual triangles, detected by rectangle and polygon picks as well
+    };
+
+    //! Triangles drawn with the same color.
+    struct Patch
+    {
+        Handle(Graphic3d_ArrayOfTriangles)       Triangles;
+        Handle(Select3D_SensitivePrimitiveArray) Sensitive;
+        Quantity_Color                           Color;
+        Standard_Boolean                         HasCustomColor = Standard_False; //!< Sub-shape color instead of the object color
+        Graphic3d_Vec3                           Min;
+        Graphic3d_Vec3                           Max;
+    };
+
+    //! Geometry snapshot and the primitive arrays prepared from it.
+    struct Data
+    {
+        TopoDS_Shape                      Shape; //!< Unlocated CAD part (null for meshes)
+        UnifiedModel::MeshDataPtr         Mesh;  //!< Mesh buffers (null for CAD parts)
+        std::vector<Patch>                Patches;
+        Handle(Graphic3d_ArrayOfSegments) Edges; //!< Edges for the wireframe mode (null until prepared, or if none)
+        Graphic3d_Vec3                    EdgesMin;
+        Graphic3d_Vec3                    EdgesMax;
+        Handle(SelectMgr_EntityOwner)     Owner; //!< Owner of the sensitive entities
+        Standard_Integer                  NbTriangles = 0;
+    };
+
+    //! Prepares the shaded triangles and the selection of a triangulated CAD part.
+    //! Faces without triangulation are skipped. Thread-safe as long as no other thread
+    //! modifies the shape or its triangulations.
+    //! @param theShape the part, without location
+    //! @param theColors colors of sub-shapes (faces are matched by their TShape)
+    //! @param theToPrepareEdges whether the edges of the wireframe mode are prepared as well
+    //! @param theData receives the snapshot and the arrays
+    static void PrepareShape(const TopoDS_Shape& theShape,
+                             const std::vector<UnifiedModel::SubShapeColor>& theColors,
+                             const Standard_Boolean theToPrepareEdges,
+                             Data& theData);
+
+    //! Prepares the shaded triangles and the selection of a mesh. Vertex normals and
+    //! vertex colors are used when present; otherwise triangles are flat shaded.
+    //! @param theMesh the shared mesh buffers
+    //! @param theToPrepareEdges whether the edges of the wireframe mode are prepared as well
+    //! @param theData receives the snapshot and the arrays
+    static void PrepareMesh(const UnifiedModel::MeshDataPtr& theMesh,
+                            const Standard_Boolean theToPrepareEdges,
+                            Data& theData);
+
+    //! Prepares the edges of the wireframe mode from the snapshot.
+    static void PrepareEdges(Data& theData);
+
+    //! Constructor taking over prepared data.
+    explicit Mesh_PreparedObject(Data&& theData);
+
+    //! Returns the prepared data.
+    const Data& PreparedData() const { return myData; }
+
+    //! Returns true if some triangles use a sub-shape color.
+    Standard_Boolean HasCustomColors() const;
+
+    //! Sets the color of the triangles without sub-shape color and of the edges,
+    //! updating the existing presentations without recomputing them.
+    void SetColor(const Quantity_Color& theColor) Standard_OVERRIDE;
+
+    //! Accepts AIS_WireFrame and AIS_Shaded.
+    Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE
+    {
+        return theMode == AIS_WireFrame || theMode == AIS_Shaded;
+    }
+
+    //! Draws the selected triangles of the given owners; other owners are ignored.
+    void HilightSelected(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                         const SelectMgr_SequenceOfOwner& theOwners) Standard_OVERRIDE;
+
+    //! Draws the triangles detected under the cursor for a Mesh_ElementOwner.
+    void HilightOwnerWithColor(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                               const Handle(Prs3d_Drawer)& theStyle,
+                               const Handle(SelectMgr_EntityOwner)& theOwner) Standard_OVERRIDE;
+
+    //! Redraws the selected triangles of all selected element owners, e.g. after their
+    //! triangles were updated from a pick.
+    void RedrawSelectedElements(const Handle(PrsMgr_PresentationManager)& thePrsMgr);
+
+protected:
+    //! Adds the prepared arrays to the presentation. The edges are prepared here
+    //! if they were not prepared in advance.
+    void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                 const Handle(Prs3d_Presentation)& thePrs,
+                 const Standard_Integer theMode) Standard_OVERRIDE;
+
+    //! Adds the prepared sensitive entities in mode SM_Object, or one triangle detecting
+    //! entity per patch in mode SM_Triangles.
+    void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                          const Standard_Integer theMode) Standard_OVERRIDE;
+
+private:
+    //! Fills a presentation with triangles of the patches, drawn unlit in the style color.
+    //! @param theElements patch index and triangle indices within the patch
+    void fillElementPresentation(const Handle(Prs3d_Presentation)& thePrs,
+                                 const Handle(Prs3d_Drawer)& theStyle,
+                                 const std::vector<std::pair<Standard_Integer, const TColStd_PackedMapOfInteger*>>& theElements) const;
+
+private:
+    Data myData;
+    std::vector<Handle(Select3D_SensitivePrimitiveArray)> myElementSensitives; //!< Entities of mode SM_Triangles, per patch
+
+public:
+    DEFINE_STANDARD_RTTIEXT(Mesh_PreparedObject, AIS_InteractiveObject)
+};
@@ -0,0 +1,251 @@
+// MIT License
+//
+// Copyright(c) 2023 Shing Liu
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// 无界面的批量转换与基准测试工具：导入文件，执行处理阶段，导出或缓存结果，并输出各阶段耗时
+
+#include "model/ConversionPipeline.h"
+#include "utils/Logger.h"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <locale>
+#include <sstream>
+
+namespace
+{
+// 输出命令行帮助
+void printUsage(const char* program)
+{
+    std::cerr
+        << "Usage: " << program << " [options] <file|directory>...\n"
+        << "\n"
+        << "Imports model files, runs processing stages and exports the results without a display.\n"
+        << "\n"
+        << "Options:\n"
+        << "  -o, --output-dir DIR     Directory of the converted files (default: .)\n"
+        << "  -f, --format FORMAT      Output format: none, stl, glb, archive (default: none)\n"
+        << "  -s, --stages LIST        Comma-separated stages: tessellate, repair, weld,\n"
+        << "                           decimate, normals\n"
+        << "      --weld-tolerance D   Grid size of the weld stage (default: 0, identical positions)\n"
+        << "      --decimate-ratio R   Fraction of faces kept by the decimate stage (default: 0.5)\n"
+        << "      --deviation D        Relative linear deflection of the tessellation (default: 0.001)\n"
+        << "      --angle DEG          Angular deflection of the tessellation (default: 20)\n"
+        << "      --step-reader MODE   STEP reader: xde (names, colors, instancing) or basic (default: xde)\n"
+        << "      --step-transfer MODE Root transfer of the basic reader: serial or parallel (default: serial)\n"
+        << "      --cache-dir DIR      Cache processed models in DIR\n"
+        << "      --cache-size-mb N    Size limit of the cache (default: 2048)\n"
+        << "      --json FILE          Write the timing report as JSON to FILE ('-' for stdout)\n"
+        << "  -r, --recursive          Scan directories recursively\n"
+        << "  -v, --verbose            Log debug messages\n"
+        << "  -h, --help               Show this help\n";
+}
+
+// 按C区域设置解析浮点数选项值，整个字符串都必须是数字
+bool parseNumber(const std::string& text, double& value)
+{
+    std::istringstream stream(text);
+    stream.imbue(std::locale::classic());
+    stream >> value;
+    return !stream.fail() && stream.eof();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // 日志写入标准错误，标准输出只用于JSON报告
+    auto console_sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+    console_sink->set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+    auto main_logger = std::make_shared<spdlog::logger>("main", console_sink);
+    main_logger->set_level(spdlog::level::info);
+    spdlog::set_default_logger(main_logger);
+
+    ConversionPipeline::Options options;
+    std::vector<std::string> inputs;
+    std::string jsonPath;
+    std::string cacheDir;
+    double cacheSizeMb = 2048.0;
+    bool isRecursive = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto nextValue = [&](std::string& target) {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            target = argv[++i];
+            return true;
+        };
+
+        std::string value;
+        double number = 0.0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else if (arg == "-r" || arg == "--recursive") {
+            isRecursive = true;
+        }
+        else if (arg == "-v" || arg == "--verbose") {
+            main_logger->set_level(spdlog::level::debug);
+        }
+        else if (arg == "-o" || arg == "--output-dir") {
+            if (!nextValue(options.outputDirectory)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "-f" || arg == "--format") {
+            if (!nextValue(value) || !ConversionPipeline::parseFormat(value, options.format)) {
+                std::cerr << "Unknown output format '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "-s" || arg == "--stages") {
+            if (!nextValue(value)) {
+                return EXIT_FAILURE;
+            }
+            std::istringstream list(value);
+            std::string name;
+            while (std::getline(list, name, ',')) {
+                ConversionPipeline::Stage stage;
+                if (!ConversionPipeline::parseStage(name, stage)) {
+                    std::cerr << "Unknown stage '" << name << "'\n";
+                    return EXIT_FAILURE;
+                }
+                options.stages.push_back(stage);
+            }
+        }
+        else if (arg == "--weld-tolerance" || arg == "--decimate-ratio" || arg == "--deviation"
+              || arg == "--angle" || arg == "--cache-size-mb") {
+            if (!nextValue(value) || !parseNumber(value, number)) {
+                std::cerr << "Invalid number '" << value << "' for " << arg << "\n";
+                return EXIT_FAILURE;
+            }
+            if (arg == "--weld-tolerance") {
+                options.weldTolerance = number;
+            }
+            else if (arg == "--decimate-ratio") {
+                options.decimateRatio = number;
+            }
+            else if (arg == "--deviation") {
+                options.tessellation.deviationCoefficient = number;
+            }
+            else if (arg == "--angle") {
+                options.tessellation.deviationAngleDeg = number;
+            }
+            else {
+                cacheSizeMb = number;
+            }
+        }
+        else if (arg == "--step-reader") {
+            if (!nextValue(value) || (value != "xde" && value != "basic")) {
+                std::cerr << "Unknown STEP reader '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+            options.stepReader = value == "xde" ? ModelImporter::StepReaderMode::XDE
+                                                : ModelImporter::StepReaderMode::BASIC;
+        }
+        else if (arg == "--step-transfer") {
+            if (!nextValue(value) || (value != "parallel" && value != "serial")) {
+                std::cerr << "Unknown STEP transfer mode '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+            options.stepTransfer = value == "parallel" ? ModelImporter::StepTransferMode::PARALLEL
+                                                       : ModelImporter::StepTransferMode::SERIAL;
+        }
+        else if (arg == "--cache-dir") {
+            if (!nextValue(cacheDir)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "--json") {
+            if (!nextValue(jsonPath)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (!arg.empty() && arg[0] == '-' && arg != "-") {
+            std::cerr << "Unknown option '" << arg << "'\n";
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (!cacheDir.empty()) {
+            options.cache = std::make_shared<ImportCache>(cacheDir, std::uint64_t(cacheSizeMb * 1024.0 * 1024.0));
+        }
+
+        // 目录展开为其中所有受支持的文件
+        ModelImporter importer;
+        std::vector<std::string> filePaths;
+        for (const std::string& input : inputs) {
+            if (std::filesystem::is_directory(input)) {
+                const std::vector<std::string> files = importer.collectSupportedFiles(input, isRecursive);
+                filePaths.insert(filePaths.end(), files.begin(), files.end());
+            }
+            else {
+                filePaths.push_back(input);
+            }
+        }
+
+        ConversionPipeline pipeline(options);
+        const std::vector<ConversionPipeline::FileReport> reports = pipeline.convertFiles(filePaths);
+
+        if (jsonPath == "-") {
+            pipeline.writeJson(std::cout, reports);
+        }
+        else if (!jsonPath.empty()) {
+            std::ofstream jsonFile(jsonPath);
+            if (!jsonFile) {
+                spdlog::error("Cannot write the report to '{}'", jsonPath);
+                return EXIT_FAILURE;
+            }
+            pipeline.writeJson(jsonFile, reports);
+        }
+
+        // 简要汇总写入日志
+        size_t nbFailed = 0;
+        for (const auto& report : reports) {
+            if (!report.succeeded) {
+                ++nbFailed;
+                spdlog::error("Failed to convert '{}': {}", report.inputPath, report.error);
+            }
+        }
+        spdlog::info("Converted {} of {} files", reports.size() - nbFailed, reports.size());
+        return nbFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Unhandled exception: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,433 @@
+#include "ConversionPipeline.h"
+#include "ImportProgress.h"
+#include "MeshProcessing.h"
+#include "ModelArchive.h"
+#include "ModelExporter.h"
+#include "utils/JsonWriter.h"
+#include "utils/Logger.h"
+#include "utils/Parallel.h"
+
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+// 创建转换流水线日志记录器
+static std::shared_ptr<Utils::Logger>& getPipelineLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.pipeline");
+    return logger;
+}
+
+namespace
+{
+// 计量一个阶段的耗时并追加到报告
+class StageTimer
+{
+public:
+    StageTimer(ConversionPipeline::FileReport& report, const char* name, std::uint64_t facesBefore)
+    : myReport(report),
+      myStartTime(std::chrono::steady_clock::now())
+    {
+        myTiming.name = name;
+        myTiming.facesBefore = facesBefore;
+    }
+
+    // 记录阶段及其生成的三角形数
+    void stop(std::uint64_t facesAfter)
+    {
+        myTiming.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - myStartTime).count();
+        myTiming.facesAfter = facesAfter;
+        myReport.stages.push_back(myTiming);
+    }
+
+private:
+    ConversionPipeline::FileReport& myReport;
+    ConversionPipeline::StageTiming myTiming;
+    std::chrono::steady_clock::time_point myStartTime;
+};
+
+// 统计所有网格以及所有形状三角化面的三角形数
+std::uint64_t countTriangles(const UnifiedModel& model)
+{
+    std::uint64_t count = 0;
+    for (const auto& entity : model.getEntities()) {
+        const UnifiedModel::GeometryData& data = entity.second;
+        if (data.type == UnifiedModel::GeometryType::MESH) {
+            count += std::uint64_t(std::get<UnifiedModel::MeshDataPtr>(data.geometry)->faces.rows());
+        }
+        else if (data.type == UnifiedModel::GeometryType::SHAPE) {
+            const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data.geometry);
+            for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next()) {
+                TopLoc_Location location;
+                const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(TopoDS::Face(exp.Current()), location);
+                if (!triangulation.IsNull()) {
+                    count += std::uint64_t(triangulation->NbTriangles());
+                }
+            }
+        }
+    }
+    return count;
+}
+} // namespace
+
+ConversionPipeline::ConversionPipeline(const Options& options)
+    : myOptions(options)
+{
+    // 导入时不剖分，剖分作为单独的阶段计时
+    ModelImporter::TessellationOptions tessellation = myOptions.tessellation;
+    tessellation.enabled = false;
+    myImporter.setTessellationOptions(tessellation);
+    myImporter.setStepReaderMode(myOptions.stepReader);
+    myImporter.setStepTransferMode(myOptions.stepTransfer);
+}
+
+ConversionPipeline::FileReport ConversionPipeline::convertFile(const std::string& filePath)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    FileReport report;
+    report.inputPath = filePath;
+    std::error_code errorCode;
+    report.inputBytes = std::filesystem::file_size(filePath, errorCode);
+    if (errorCode) {
+        report.inputBytes = 0;
+        report.error = "Cannot read file";
+        getPipelineLogger()->error("Cannot read '{}': {}", filePath, errorCode.message());
+        return report;
+    }
+
+    const std::string modelId = std::filesystem::path(filePath).stem().string();
+    UnifiedModel model;
+
+    // 缓存命中时加载处理后的模型，跳过导入与所有处理阶段
+    std::string cacheKey;
+    bool isProcessed = false;
+    if (myOptions.cache) {
+        StageTimer timer(report, "cache-load", 0);
+        cacheKey = myOptions.cache->makeKey(filePath, getCacheSettings());
+        isProcessed = !cacheKey.empty() && myOptions.cache->load(cacheKey, model, modelId);
+        timer.stop(isProcessed ? countTriangles(model) : 0);
+        report.cacheHit = isProcessed;
+    }
+
+    if (!isProcessed) {
+        if (!process(filePath, model, report)) {
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            return report;
+        }
+        if (!cacheKey.empty()) {
+            const std::uint64_t triangles = countTriangles(model);
+            StageTimer timer(report, "cache-store", triangles);
+            if (!myOptions.cache->store(cacheKey, model)) {
+                getPipelineLogger()->warn("Could not store '{}' in the cache", filePath);
+            }
+            timer.stop(triangles);
+        }
+    }
+
+    report.entities = model.getEntityCount();
+    report.triangles = countTriangles(model);
+    report.succeeded = write(filePath, model, report);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (report.succeeded) {
+        getPipelineLogger()->info("Converted '{}' in {:.3f} s ({} triangles{})",
+                                  filePath,
+                                  report.seconds,
+                                  report.triangles,
+                                  report.cacheHit ? ", from cache" : "");
+    }
+    return report;
+}
+
+std::vector<ConversionPipeline::FileReport> ConversionPipeline::convertFiles(const std::vector<std::string>& filePaths)
+{
+    std::vector<FileReport> reports;
+    reports.reserve(filePaths.size());
+    for (const std::string& filePath : filePaths) {
+        reports.push_back(convertFile(filePath));
+    }
+    return reports;
+}
+
+bool ConversionPipeline::process(const std::string& filePath, UnifiedModel& model, FileReport& report)
+{
+    const std::string modelId = std::filesystem::path(filePath).stem().string();
+
+    {
+        StageTimer timer(report, "import", 0);
+        if (!myImporter.importModel(filePath, model, modelId)) {
+            timer.stop(0);
+            report.error = "Import failed";
+            return false;
+        }
+        timer.stop(countTriangles(model));
+    }
+
+    const std::vector<std::string> meshIds = model.getGeometryIdsByType(UnifiedModel::GeometryType::MESH);
+    for (const Stage stage : myOptions.stages) {
+        StageTimer timer(report, getStageName(stage), countTriangles(model));
+        switch (stage) {
+            case Stage::TESSELLATE: {
+                ModelImporter tessellator;
+                ModelImporter::TessellationOptions tessellation = myOptions.tessellation;
+                tessellation.enabled = true;
+                tessellator.setTessellationOptions(tessellation);
+                ImportProgress progress;
+                for (const std::string& rootId : model.getRootIds()) {
+                    tessellator.tessellateShapes(model, rootId, progress);
+                }
+                break;
+            }
+            case Stage::REPAIR:
+                for (const std::string& id : meshIds) {
+                    model.modifyMesh(id, [](UnifiedModel::MeshData& mesh) {
+                        MeshProcessing::repair(mesh);
+                    });
+                }
+                break;
+            case Stage::WELD:
+                for (const std::string& id : meshIds) {
+                    model.modifyMesh(id, [this](UnifiedModel::MeshData& mesh) {
+                        MeshProcessing::weldVertices(mesh, myOptions.weldTolerance);
+                    });
+                }
+                break;
+            case Stage::DECIMATE:
+                for (const std::string& id : meshIds) {
+                    model.modifyMesh(id, [this](UnifiedModel::MeshData& mesh) {
+                        MeshProcessing::decimate(mesh, myOptions.decimateRatio);
+                    });
+                }
+                break;
+            case Stage::NORMALS:
+                for (const std::string& id : meshIds) {
+                    model.modifyMesh(id, [](UnifiedModel::MeshData& mesh) {
+                        MeshProcessing::computeNormals(mesh, true);
+                    });
+                }
+                break;
+        }
+        timer.stop(countTriangles(model));
+    }
+    return true;
+}
+
+bool ConversionPipeline::write(const std::string& filePath, UnifiedModel& model, FileReport& report)
+{
+    if (myOptions.format == OutputFormat::NONE) {
+        return true;
+    }
+
+    const char* extension = myOptions.format == OutputFormat::STL   ? ".stl"
+                          : myOptions.format == OutputFormat::GLB   ? ".glb"
+                                                                    : ModelArchive::FILE_EXTENSION;
+    std::error_code errorCode;
+    std::filesystem::create_directories(myOptions.outputDirectory, errorCode);
+    const std::filesystem::path outputPath = std::filesystem::path(myOptions.outputDirectory)
+                                           / (std::filesystem::path(filePath).stem().string() + extension);
+    report.outputPath = outputPath.string();
+
+    StageTimer timer(report, "export", report.triangles);
+    bool isWritten = false;
+    if (myOptions.format == OutputFormat::ARCHIVE) {
+        isWritten = ModelArchive().save(model, report.outputPath);
+    }
+    else {
+        ModelExporter exporter;
+        ModelExporter::Options exportOptions;
+        exportOptions.tessellation = myOptions.tessellation;
+        exportOptions.tessellation.enabled = true;
+        exporter.setOptions(exportOptions);
+        isWritten = exporter.exportModel(model, report.outputPath);
+    }
+    timer.stop(report.triangles);
+
+    if (!isWritten) {
+        report.error = "Export failed";
+        return false;
+    }
+    report.outputBytes = std::filesystem::file_size(outputPath, errorCode);
+    if (errorCode) {
+        report.outputBytes = 0;
+    }
+    return true;
+}
+
+std::string ConversionPipeline::getCacheSettings() const
+{
+    // 缓存的是处理后的模型，键中包含所有影响结果的选项
+    std::string settings = "pipeline;stages=";
+    for (const Stage stage : myOptions.stages) {
+        settings += getStageName(stage);
+        settings += ',';
+        switch (stage) {
+            case Stage::TESSELLATE:
+                settings += "deviation=" + std::to_string(myOptions.tessellation.deviationCoefficient)
+                          + ",angle=" + std::to_string(myOptions.tessellation.deviationAngleDeg) + ',';
+                break;
+            case Stage::WELD:
+                settings += "tolerance=" + std::to_string(myOptions.weldTolerance) + ',';
+                break;
+            case Stage::DECIMATE:
+                settings += "ratio=" + std::to_string(myOptions.decimateRatio) + ',';
+                break;
+            case Stage::REPAIR:
+            case Stage::NORMALS:
+                break;
+        }
+    }
+    settings += myImporter.getStepReaderMode() == ModelImporter::StepReaderMode::XDE ? ";reader=xde" : ";reader=basic";
+    return settings;
+}
+
+bool ConversionPipeline::parseStage(const std::string& name, Stage& stage)
+{
+    for (const Stage candidate : {Stage::TESSELLATE, Stage::REPAIR, Stage::WELD, Stage::DECIMATE, Stage::NORMALS}) {
+        if (name == getStageName(candidate)) {
+            stage = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* ConversionPipeline::getStageName(Stage stage)
+{
+    switch (stage) {
+        case Stage::TESSELLATE: return "tessellate";
+        case Stage::REPAIR:     return "repair";
+        case Stage::WELD:       return "weld";
+        case Stage::DECIMATE:   return "decimate";
+        case Stage::NORMALS:    return "normals";
+    }
+    return "";
+}
+
+bool ConversionPipeline::parseFormat(const std::string& name, OutputFormat& format)
+{
+    if (name == "none") {
+        format = OutputFormat::NONE;
+    }
+    else if (name == "stl") {
+        format = OutputFormat::STL;
+    }
+    else if (name == "glb") {
+        format = OutputFormat::GLB;
+    }
+    else if (name == "archive") {
+        format = OutputFormat::ARCHIVE;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void ConversionPipeline::writeJson(std::ostream& stream, const std::vector<FileReport>& reports) const
+{
+    static const char* const FORMAT_NAMES[] = {"none", "stl", "glb", "archive"};
+
+    Utils::JsonWriter json(stream);
+    json.beginObject();
+
+    json.key("options").beginObject();
+    json.key("stages").beginArray();
+    for (const Stage stage : myOptions.stages) {
+        json.value(getStageName(stage));
+    }
+    json.endArray();
+    json.key("format").value(FORMAT_NAMES[int(myOptions.format)]);
+    json.key("stepReader").value(myOptions.stepReader == ModelImporter::StepReaderMode::XDE ? "xde" : "basic");
+    json.key("stepTransfer").value(myOptions.stepTransfer == ModelImporter::StepTransferMode::PARALLEL ? "parallel" : "serial");
+    json.key("deviationCoefficient").value(myOptions.tessellation.deviationCoefficient);
+    json.key("deviationAngleDeg").value(myOptions.tessellation.deviationAngleDeg);
+    json.key("weldTolerance").value(myOptions.weldTolerance);
+    json.key("decimateRatio").value(myOptions.decimateRatio);
+    json.key("cache").value(myOptions.cache != nullptr);
+    json.key("threads").value(std::uint64_t(Utils::getParallelThreadCount()));
+    json.endObject();
+
+    // 汇总各文件，并按阶段名累计耗时
+    size_t nbSucceeded = 0;
+    size_t nbCacheHits = 0;
+    std::uint64_t inputBytes = 0;
+    std::uint64_t outputBytes = 0;
+    std::uint64_t triangles = 0;
+    double seconds = 0.0;
+    std::vector<std::pair<std::string, double>> stageSeconds;
+
+    json.key("files").beginArray();
+    for (const FileReport& report : reports) {
+        json.beginObject();
+        json.key("input").value(report.inputPath);
+        json.key("output").value(report.outputPath);
+        json.key("succeeded").value(report.succeeded);
+        if (!report.error.empty()) {
+            json.key("error").value(report.error);
+        }
+        json.key("cacheHit").value(report.cacheHit);
+        json.key("inputBytes").value(report.inputBytes);
+        json.key("outputBytes").value(report.outputBytes);
+        json.key("entities").value(std::uint64_t(report.entities));
+        json.key("triangles").value(report.triangles);
+        json.key("seconds").value(report.seconds);
+        json.key("megabytesPerSecond").value(report.megabytesPerSecond());
+        json.key("stages").beginArray();
+        for (const StageTiming& stage : report.stages) {
+            json.beginObject();
+            json.key("name").value(stage.name);
+            json.key("seconds").value(stage.seconds);
+            json.key("facesBefore").value(stage.facesBefore);
+            json.key("facesAfter").value(stage.facesAfter);
+            json.endObject();
+
+            auto it = std::find_if(stageSeconds.begin(), stageSeconds.end(),
+                                   [&stage](const auto& entry) { return entry.first == stage.name; });
+            if (it == stageSeconds.end()) {
+                stageSeconds.emplace_back(stage.name, stage.seconds);
+            }
+            else {
+                it->second += stage.seconds;
+            }
+        }
+        json.endArray();
+        json.endObject();
+
+        nbSucceeded += report.succeeded ? 1 : 0;
+        nbCacheHits += report.cacheHit ? 1 : 0;
+        inputBytes += report.inputBytes;
+        outputBytes += report.outputBytes;
+        triangles += report.triangles;
+        seconds += report.seconds;
+    }
+    json.endArray();
+
+    json.key("totals").beginObject();
+    json.key("files").value(std::uint64_t(reports.size()));
+    json.key("succeeded").value(std::uint64_t(nbSucceeded));
+    json.key("cacheHits").value(std::uint64_t(nbCacheHits));
+    json.key("inputBytes").value(inputBytes);
+    json.key("outputBytes").value(outputBytes);
+    json.key("triangles").value(triangles);
+    json.key("seconds").value(seconds);
+    json.key("megabytesPerSecond").value(seconds > 0.0 ? double(inputBytes) / (1024.0 * 1024.0) / seconds : 0.0);
+    json.key("trianglesPerSecond").value(seconds > 0.0 ? double(triangles) / seconds : 0.0);
+    json.key("stageSeconds").beginObject();
+    for (const auto& entry : stageSeconds) {
+        json.key(entry.first).value(entry.second);
+    }
+    json.endObject();
+    json.endObject();
+
+    json.endObject();
+    stream << '\n';
+}
@@ -0,0 +1,205 @@
+/**
+ * @file ConversionPipeline.h
+ * @brief Defines the ConversionPipeline class which converts model files without a display.
+ *
+ * The pipeline imports a file into its own UnifiedModel, runs the selected processing
+ * stages, optionally caches the processed model and writes it in one of the export
+ * formats. Every stage is timed, so the reports can be used to track the throughput
+ * of conversion jobs on servers over time.
+ */
+#pragma once
+
+#include "ImportCache.h"
+#include "ModelImporter.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConversionPipeline
+ * @brief Imports, processes and exports model files, timing each stage.
+ *
+ * Only the model layer is used, so the pipeline runs on machines without a GPU or a
+ * windowing system. Tessellation applies to CAD shapes; repair, welding, decimation and
+ * normal computation apply to mesh entities.
+ */
+class ConversionPipeline {
+public:
+    /**
+     * @brief Processing stages run after the import, in the order given in the options
+     */
+    enum class Stage {
+        TESSELLATE,  ///< Triangulate CAD shapes (ModelImporter::tessellateShapes)
+        REPAIR,      ///< Remove NaN, degenerate, duplicated and non-manifold faces (MeshProcessing::repair)
+        WELD,        ///< Merge coincident mesh vertices (MeshProcessing::weldVertices)
+        DECIMATE,    ///< Reduce the number of mesh faces (MeshProcessing::decimate)
+        NORMALS      ///< Recompute face and vertex normals (MeshProcessing::computeNormals)
+    };
+
+    /**
+     * @brief Format of the converted files
+     */
+    enum class OutputFormat {
+        NONE,     ///< Do not write the result (benchmark or cache warm-up)
+        STL,      ///< Binary STL
+        GLB,      ///< Binary glTF
+        ARCHIVE   ///< Native model archive (.oimodel)
+    };
+
+    /**
+     * @brief Options of a conversion
+     */
+    struct Options {
+        /** Stages to run, in order */
+        std::vector<Stage> stages;
+
+        /** Reader used for STEP files */
+        ModelImporter::StepReaderMode stepReader = ModelImporter::StepReaderMode::XDE;
+
+        /** Root transfer mode of the BASIC STEP reader */
+        ModelImporter::StepTransferMode stepTransfer = ModelImporter::StepTransferMode::SERIAL;
+
+        /** Deflections of the tessellation stage (and of exports of untessellated shapes) */
+        ModelImporter::TessellationOptions tessellation;
+
+        /** Grid size of the weld stage (0: merge identical positions only) */
+        double weldTolerance = 0.0;
+
+        /** Fraction of the faces kept by the decimate stage */
+        double decimateRatio = 0.5;
+
+        /** Output format */
+        OutputFormat format = OutputFormat::NONE;
+
+        /** Directory receiving the converted files (created if needed) */
+        std::string outputDirectory = ".";
+
+        /**
+         * Cache of processed models (optional). The key covers the file content and the
+         * stage settings, so a hit skips the import and all stages.
+         */
+        std::shared_ptr<ImportCache> cache;
+    };
+
+    /**
+     * @brief Timing of one stage of a file
+     */
+    struct StageTiming {
+        std::string name;           ///< Stage name ("import", "weld", "export", ...)
+        double seconds = 0.0;       ///< Wall-clock time of the stage
+        std::uint64_t facesBefore = 0;  ///< Number of triangles entering the stage
+        std::uint64_t facesAfter = 0;   ///< Number of triangles leaving the stage
+    };
+
+    /**
+     * @brief Result of the conversion of one file
+     */
+    struct FileReport {
+        std::string inputPath;          ///< The converted file
+        std::string outputPath;         ///< The written file (empty if none)
+        bool succeeded = false;         ///< Whether all stages succeeded
+        bool cacheHit = false;          ///< Whether the processed model came from the cache
+        std::string error;              ///< Description of the failure
+        std::uint64_t inputBytes = 0;   ///< Size of the input file
+        std::uint64_t outputBytes = 0;  ///< Size of the output file
+        size_t entities = 0;            ///< Number of entities of the processed model
+        std::uint64_t triangles = 0;    ///< Number of triangles of the processed model
+        double seconds = 0.0;           ///< Wall-clock time of all stages
+        std::vector<StageTiming> stages;  ///< Per-stage timings, in execution order
+
+        /** @brief Gets the input throughput in MB/s */
+        double megabytesPerSecond() const {
+            return seconds > 0.0 ? double(inputBytes) / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Constructor
+     * @param options The conversion options
+     */
+    explicit ConversionPipeline(const Options& options);
+
+    /**
+     * @brief Converts one file
+     * @param filePath The file to convert
+     * @return FileReport The timings and result of the conversion
+     */
+    FileReport convertFile(const std::string& filePath);
+
+    /**
+     * @brief Converts several files one after the other
+     *
+     * Files are processed sequentially; the stages themselves use all hardware threads.
+     *
+     * @param filePaths The files to convert
+     * @return std::vector<FileReport> One report per file, in input order
+     */
+    std::vector<FileReport> convertFiles(const std::vector<std::string>& filePaths);
+
+    /**
+     * @brief Gets the conversion options
+     * @return The options
+     */
+    const Options& getOptions() const { return myOptions; }
+
+    /**
+     * @brief Parses a stage name ("tessellate", "repair", "weld", "decimate" or "normals")
+     * @param name The stage name
+     * @param stage Receives the stage
+     * @return bool False if the name is unknown
+     */
+    static bool parseStage(const std::string& name, Stage& stage);
+
+    /**
+     * @brief Gets the name of a stage
+     * @param stage The stage
+     * @return const char* The stage name, as accepted by parseStage()
+     */
+    static const char* getStageName(Stage stage);
+
+    /**
+     * @brief Parses an output format name ("none", "stl", "glb" or "archive")
+     * @param name The format name
+     * @param format Receives the format
+     * @return bool False if the name is unknown
+     */
+    static bool parseFormat(const std::string& name, OutputFormat& format);
+
+    /**
+     * @brief Writes reports as a JSON document
+     *
+     * The document holds the options, one object per file with its stage timings and
+     * totals over all files.
+     *
+     * @param stream The output stream
+     * @param reports The reports to write
+     */
+    void writeJson(std::ostream& stream, const std::vector<FileReport>& reports) const;
+
+private:
+    /**
+     * @brief Runs the import and the processing stages of a file
+     * @return bool False if a stage failed (report.error is set)
+     */
+    bool process(const std::string& filePath, UnifiedModel& model, FileReport& report);
+
+    /**
+     * @brief Writes the processed model in the output format
+     * @return bool False if the file could not be written (report.error is set)
+     */
+    bool write(const std::string& filePath, UnifiedModel& model, FileReport& report);
+
+    /**
+     * @brief Describes the options that influence the processed model (part of the cache key)
+     */
+    std::string getCacheSettings() const;
+
+    /** The conversion options */
+    Options myOptions;
+
+    /** The importer used for all files, with tessellation at import disabled */
+    ModelImporter myImporter;
+};
@@ -4,8 +4,14 @@ void IModel::addChangeListener(ChangeListener listener) {
     myChangeListeners.push_back(listener);
 }
 
-void IModel::notifyChange(const std::string& entityId) {
-    for (auto& listener : myChangeListeners) {
+void IModel::addChangeListener(std::function<void(const std::string&)> listener) {
+    myChangeListeners.push_back([listener](const std::string& entityId, ChangeKind) {
         listener(entityId);
+    });
+}
+
+void IModel::notifyChange(const std::string& entityId, ChangeKind kind) {
+    for (auto& listener : myChangeListeners) {
+        listener(entityId, kind);
     }
 } 
\ No newline at end of file
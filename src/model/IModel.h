@@ -12,12 +12,24 @@ public:
     virtual std::vector<std::string> getAllEntityIds() const = 0;
     virtual void removeEntity(const std::string& id) = 0;
     
+    // 变更类型，监听者据此只更新受影响的部分
+    enum class ChangeKind {
+        GEOMETRY,    // 实体新增或几何改变，需要完全重建
+        COLOR,       // 颜色改变
+        TRANSFORM,   // 位置改变，几何本身不变
+        VISIBILITY,  // 显示或隐藏
+        REMOVAL,     // 实体被移除
+        ATTRIBUTES   // 名称、图层等不影响显示的属性
+    };
+    
     // 事件通知系统
-    using ChangeListener = std::function<void(const std::string&)>;
+    using ChangeListener = std::function<void(const std::string&, ChangeKind)>;
     void addChangeListener(ChangeListener listener);
+    // 不关心变更类型的监听者
+    void addChangeListener(std::function<void(const std::string&)> listener);
     
 protected:
-    void notifyChange(const std::string& entityId);
+    void notifyChange(const std::string& entityId, ChangeKind kind);
     
     std::vector<ChangeListener> myChangeListeners;
 }; 
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "ImportCache.h"
+#include "ModelArchive.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// 创建导入缓存日志记录器
+static std::shared_ptr<Utils::Logger>& getCacheLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.cache");
+    return logger;
+}
+
+namespace
+{
+// 并行计算哈希的分块大小；键与线程数无关
+constexpr size_t HASH_CHUNK_SIZE = size_t(4) << 20;
+
+constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// 64位哈希的最终混合（splitmix64的末尾步骤）
+inline std::uint64_t finalizeHash(std::uint64_t hash)
+{
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+// 每次8字节对字节范围计算哈希（xxHash64式的轮次）
+std::uint64_t hashBytes(const char* data, size_t size, std::uint64_t seed)
+{
+    std::uint64_t hash = seed ^ (std::uint64_t(size) * PRIME_1);
+    size_t offset = 0;
+    for (; offset + 8 <= size; offset += 8) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + offset, 8);
+        hash ^= rotateLeft(word * PRIME_2, 31) * PRIME_1;
+        hash = rotateLeft(hash, 27) * PRIME_1 + PRIME_3;
+    }
+    for (; offset < size; ++offset) {
+        hash ^= std::uint64_t(static_cast<unsigned char>(data[offset])) * PRIME_3;
+        hash = rotateLeft(hash, 11) * PRIME_1;
+    }
+    return finalizeHash(hash);
+}
+
+std::string toHex(std::uint64_t value)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i, value >>= 4) {
+        text[size_t(i)] = DIGITS[value & 0xF];
+    }
+    return text;
+}
+}  // namespace
+
+ImportCache::ImportCache(const std::string& directory, std::uint64_t maxBytes)
+    : myDirectory(directory),
+      myMaxBytes(maxBytes)
+{
+    std::error_code error;
+    std::filesystem::create_directories(myDirectory, error);
+    if (error) {
+        getCacheLogger()->error("Failed to create import cache directory '{}': {}", myDirectory, error.message());
+    }
+
+    std::lock_guard<std::mutex> lock(myMutex);
+    evict();
+}
+
+std::string ImportCache::makeKey(const std::string& filePath, const std::string& settings) const
+{
+    Utils::MappedFile file;
+    if (!file.open(filePath)) {
+        return std::string();
+    }
+
+    // 按固定大小分块并行计算哈希，再按顺序合并，结果与线程数无关
+    const char* data = file.data();
+    const size_t size = file.size();
+    const size_t nbChunks = (size + HASH_CHUNK_SIZE - 1) / HASH_CHUNK_SIZE;
+    std::vector<std::uint64_t> chunkHashes(nbChunks * 2);
+    Utils::parallelFor(0, nbChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            const size_t offset = chunk * HASH_CHUNK_SIZE;
+            const size_t length = std::min(HASH_CHUNK_SIZE, size - offset);
+            chunkHashes[chunk * 2] = hashBytes(data + offset, length, PRIME_1);
+            chunkHashes[chunk * 2 + 1] = hashBytes(data + offset, length, PRIME_2);
+        }
+    });
+
+    std::uint64_t keyHigh = hashBytes(settings.data(), settings.size(), std::uint64_t(size));
+    std::uint64_t keyLow = hashBytes(settings.data(), settings.size(), ~std::uint64_t(size));
+    keyHigh = hashBytes(reinterpret_cast<const char*>(chunkHashes.data()),
+                        chunkHashes.size() * sizeof(std::uint64_t),
+                        keyHigh);
+    keyLow = hashBytes(reinterpret_cast<const char*>(chunkHashes.data()),
+                       chunkHashes.size() * sizeof(std::uint64_t),
+                       keyLow ^ PRIME_3);
+    return toHex(keyHigh) + toHex(keyLow);
+}
+
+bool ImportCache::load(const std::string& key, UnifiedModel& model, const std::string& modelId)
+{
+    const std::string entryPath = getEntryPath(key);
+    std::error_code error;
+    if (key.empty() || !std::filesystem::exists(entryPath, error)) {
+        std::lock_guard<std::mutex> lock(myMutex);
+        ++myStats.misses;
+        return false;
+    }
+
+    ModelArchive archive;
+    if (!archive.load(entryPath, model, modelId)) {
+        // 损坏的条目直接删除
+        std::filesystem::remove(entryPath, error);
+        std::lock_guard<std::mutex> lock(myMutex);
+        ++myStats.misses;
+        return false;
+    }
+
+    // 命中时刷新修改时间，作为LRU的访问时间
+    std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+    std::lock_guard<std::mutex> lock(myMutex);
+    ++myStats.hits;
+    getCacheLogger()->debug("Import cache hit {} for '{}'", key, modelId);
+    return true;
+}
+
+bool ImportCache::store(const std::string& key, const UnifiedModel& model)
+{
+    if (key.empty()) {
+        return false;
+    }
+
+    // 先写入临时文件再重命名，并发读取不会看到写了一半的条目
+    std::ostringstream tempName;
+    tempName << key << ".tmp" << std::this_thread::get_id();
+    const std::string tempPath = (std::filesystem::path(myDirectory) / tempName.str()).string();
+    const std::string entryPath = getEntryPath(key);
+
+    ModelArchive archive;
+    std::error_code error;
+    if (!archive.save(model, tempPath)) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    std::filesystem::rename(tempPath, entryPath, error);
+    if (error) {
+        getCacheLogger()->warn("Failed to store import cache entry '{}': {}", entryPath, error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(myMutex);
+    ++myStats.stores;
+    evict();
+    return true;
+}
+
+void ImportCache::clear()
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(myDirectory, error)) {
+        if (entry.path().extension() == ModelArchive::FILE_EXTENSION) {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+    myStats.sizeBytes = 0;
+}
+
+void ImportCache::setMaxBytes(std::uint64_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    if (myMaxBytes == maxBytes) {
+        return;
+    }
+    myMaxBytes = maxBytes;
+    evict();
+}
+
+std::uint64_t ImportCache::getMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myMaxBytes;
+}
+
+ImportCache::Stats ImportCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myStats;
+}
+
+std::string ImportCache::getEntryPath(const std::string& key) const
+{
+    return (std::filesystem::path(myDirectory) / (key + ModelArchive::FILE_EXTENSION)).string();
+}
+
+void ImportCache::evict()
+{
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUse;
+        std::uint64_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::uint64_t totalBytes = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(myDirectory, error)) {
+        if (entry.path().extension() != ModelArchive::FILE_EXTENSION) {
+            continue;
+        }
+        std::error_code entryError;
+        const std::uint64_t size = entry.file_size(entryError);
+        const auto lastUse = entry.last_write_time(entryError);
+        if (!entryError) {
+            entries.push_back({entry.path(), lastUse, size});
+            totalBytes += size;
+        }
+    }
+
+    // 最久未使用的条目先删除
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUse < b.lastUse;
+    });
+    for (const Entry& entry : entries) {
+        if (totalBytes <= myMaxBytes) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error)) {
+            totalBytes -= entry.size;
+            ++myStats.evictions;
+            getCacheLogger()->debug("Evicted import cache entry '{}'", entry.path.string());
+        }
+    }
+    myStats.sizeBytes = totalBytes;
+}
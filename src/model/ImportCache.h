@@ -0,0 +1,123 @@
+/**
+ * @file ImportCache.h
+ * @brief Defines the ImportCache class, an on-disk cache of imported models.
+ *
+ * Entries are model archives (see ModelArchive) named after a key derived from the file
+ * content and the importer settings, so a file that was imported before is re-opened
+ * with its tessellation, normals and welded meshes instead of being parsed again.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/**
+ * @class ImportCache
+ * @brief Content-addressed cache directory with a size limit and LRU eviction.
+ *
+ * The last access time of an entry is its file modification time, which is refreshed
+ * on every hit; when the total size exceeds the limit, the least recently used entries
+ * are removed. All methods are thread-safe.
+ */
+class ImportCache {
+public:
+    /**
+     * @brief Hit/miss statistics of the cache since it was created
+     */
+    struct Stats {
+        std::uint64_t hits = 0;        ///< Imports served from the cache
+        std::uint64_t misses = 0;      ///< Imports that had to parse the file
+        std::uint64_t stores = 0;      ///< Entries written
+        std::uint64_t evictions = 0;   ///< Entries removed to respect the size limit
+        std::uint64_t sizeBytes = 0;   ///< Total size of the entries after the last store
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param directory The cache directory (created if needed)
+     * @param maxBytes The size limit of all entries together
+     */
+    ImportCache(const std::string& directory, std::uint64_t maxBytes);
+
+    /**
+     * @brief Computes the cache key of a file
+     *
+     * The key hashes the file content (in parallel chunks of the mapped file), its size
+     * and the importer settings that influence the result.
+     *
+     * @param filePath The file to import
+     * @param settings Text describing the importer settings
+     * @return std::string The key (32 hexadecimal digits), empty if the file cannot be read
+     */
+    std::string makeKey(const std::string& filePath, const std::string& settings) const;
+
+    /**
+     * @brief Loads a cached import into a model
+     *
+     * @param key The cache key
+     * @param model The model that receives the entities
+     * @param modelId The root ID the entities are renamed to
+     * @return bool True on a hit
+     */
+    bool load(const std::string& key, UnifiedModel& model, const std::string& modelId);
+
+    /**
+     * @brief Stores an imported model and evicts old entries if the cache is too large
+     *
+     * @param key The cache key
+     * @param model The model holding exactly the imported entities
+     * @return bool True if the entry was written
+     */
+    bool store(const std::string& key, const UnifiedModel& model);
+
+    /**
+     * @brief Removes all entries
+     */
+    void clear();
+
+    /**
+     * @brief Sets the size limit, evicting entries if needed
+     * @param maxBytes The size limit of all entries together
+     */
+    void setMaxBytes(std::uint64_t maxBytes);
+
+    /**
+     * @brief Gets the size limit
+     * @return std::uint64_t The size limit in bytes
+     */
+    std::uint64_t getMaxBytes() const;
+
+    /**
+     * @brief Gets the cache directory
+     * @return const std::string& The directory
+     */
+    const std::string& getDirectory() const { return myDirectory; }
+
+    /**
+     * @brief Gets the statistics
+     * @return Stats A snapshot of the statistics
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Returns the path of the entry of a key
+     */
+    std::string getEntryPath(const std::string& key) const;
+
+    /**
+     * @brief Removes least recently used entries until the size limit is respected
+     *
+     * Must be called with myMutex locked.
+     */
+    void evict();
+
+    std::string myDirectory;
+    std::uint64_t myMaxBytes;
+    mutable std::mutex myMutex;
+    Stats myStats;
+};
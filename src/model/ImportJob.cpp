@@ -0,0 +1,139 @@
+#include "ImportJob.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+
+// 创建导入任务日志记录器
+static std::shared_ptr<Utils::Logger>& getImportJobLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.import_job");
+    return logger;
+}
+
+ImportJob::ImportJob(std::shared_ptr<ModelImporter> importer,
+                     std::vector<std::string> filePaths,
+                     const ModelImporter::BatchOptions& options)
+    : myImporter(std::move(importer))
+    , myFilePaths(std::move(filePaths))
+    , myOptions(options)
+{
+    // 预览三角形的上限由各文件平分，预览占用的内存与文件数量无关
+    const size_t previewTriangleLimit = myOptions.previewTriangleLimit / std::max<size_t>(myFilePaths.size(), 1);
+    myProgresses.reserve(myFilePaths.size());
+    for (size_t i = 0; i < myFilePaths.size(); ++i) {
+        myProgresses.push_back(std::make_unique<ImportProgress>());
+        myProgresses.back()->setPreviewEnabled(myOptions.streamPreview);
+        myProgresses.back()->setPreviewTriangleLimit(previewTriangleLimit);
+    }
+}
+
+ImportJob::~ImportJob()
+{
+    cancel();
+    if (myWorker.joinable()) {
+        myWorker.join();
+    }
+}
+
+void ImportJob::start()
+{
+    getImportJobLogger()->info("Starting background import of {} file(s)", myFilePaths.size());
+    myWorker = std::thread(&ImportJob::run, this);
+}
+
+void ImportJob::cancel()
+{
+    myIsCancelled.store(true);
+    for (auto& progress : myProgresses) {
+        progress->cancel();
+    }
+}
+
+double ImportJob::getFraction() const
+{
+    if (myProgresses.empty()) {
+        return 1.0;
+    }
+
+    double sum = 0.0;
+    for (const auto& progress : myProgresses) {
+        sum += progress->getFraction();
+    }
+    return sum / double(myProgresses.size());
+}
+
+std::vector<MeshPreviewChunk> ImportJob::takePreviews()
+{
+    std::vector<MeshPreviewChunk> previews;
+    previews.reserve(myProgresses.size());
+    for (auto& progress : myProgresses) {
+        previews.push_back(progress->takePreview());
+    }
+    return previews;
+}
+
+std::string ImportJob::getStatusText() const
+{
+    if (isFinished()) {
+        return isCancelled() ? "Cancelling" : "Finishing";
+    }
+
+    // 统计已完成的文件，并显示第一个正在读取的文件的阶段
+    size_t nbDone = 0;
+    size_t running = myFilePaths.size();
+    for (size_t i = 0; i < myProgresses.size(); ++i) {
+        const double fraction = myProgresses[i]->getFraction();
+        if (fraction >= 1.0) {
+            ++nbDone;
+        }
+        else if (running == myFilePaths.size() && fraction > 0.0) {
+            running = i;
+        }
+    }
+
+    std::string text;
+    if (myFilePaths.size() > 1) {
+        text = "[" + std::to_string(nbDone) + "/" + std::to_string(myFilePaths.size()) + "] ";
+    }
+    if (running == myFilePaths.size()) {
+        return text + (isCancelled() ? "Cancelling" : "Reading");
+    }
+    return text + std::filesystem::path(myFilePaths[running]).filename().string() + ": "
+         + myProgresses[running]->getStage();
+}
+
+void ImportJob::run()
+{
+    std::vector<ImportProgress*> progresses;
+    progresses.reserve(myProgresses.size());
+    for (auto& progress : myProgresses) {
+        progresses.push_back(progress.get());
+    }
+
+    try {
+        myResult = myImporter->readBatch(myFilePaths, myOptions, progresses);
+    }
+    catch (const std::exception& e) {
+        getImportJobLogger()->error("Exception while importing batch: {}", e.what());
+    }
+    catch (...) {
+        getImportJobLogger()->error("Unknown exception while importing batch");
+    }
+    myIsFinished.store(true);
+}
+
+size_t ImportJob::commit(UnifiedModel& model)
+{
+    if (myWorker.joinable()) {
+        myWorker.join();
+    }
+
+    size_t nbImported = 0;
+    if (!myIsCancelled.load()) {
+        nbImported = myImporter->commitBatch(myResult, model);
+    }
+
+    getImportJobLogger()->info("Committed {} of {} imported file(s)", nbImported, myFilePaths.size());
+    return nbImported;
+}
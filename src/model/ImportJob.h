@@ -0,0 +1,135 @@
+/**
+ * @file ImportJob.h
+ * @brief Defines the ImportJob class which imports model files on a background thread.
+ * 
+ * The job reads files into private staging models on a worker thread, so the UI thread
+ * keeps rendering. Several files are read in parallel through ModelImporter::readBatch().
+ * Once the worker has finished, the UI thread commits all staging models into the
+ * application model in one merge, which fires the usual change notifications there.
+ */
+#pragma once
+
+#include "ModelImporter.h"
+#include "UnifiedModel.h"
+#include "ImportProgress.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ImportJob
+ * @brief Asynchronous, cancellable import of one or more model files.
+ */
+class ImportJob {
+public:
+    /**
+     * @brief Constructor
+     * @param importer The importer used to read the files
+     * @param filePaths The files to import, in order
+     * @param options Worker count and memory budget of the batch
+     */
+    ImportJob(std::shared_ptr<ModelImporter> importer,
+              std::vector<std::string> filePaths,
+              const ModelImporter::BatchOptions& options = ModelImporter::BatchOptions());
+    
+    /**
+     * @brief Destructor; cancels a running import and waits for the worker to stop
+     */
+    ~ImportJob();
+    
+    ImportJob(const ImportJob&) = delete;
+    ImportJob& operator=(const ImportJob&) = delete;
+    
+    /**
+     * @brief Starts the worker thread
+     */
+    void start();
+    
+    /**
+     * @brief Requests cancellation of all files that have not finished yet
+     */
+    void cancel();
+    
+    /**
+     * @brief Checks whether the worker has finished (successfully or not)
+     * @return True if commit() can be called without blocking
+     */
+    bool isFinished() const { return myIsFinished.load(); }
+    
+    /**
+     * @brief Checks whether cancellation was requested
+     * @return True if the job was cancelled
+     */
+    bool isCancelled() const { return myIsCancelled.load(); }
+    
+    /**
+     * @brief Gets the overall completed fraction of all files
+     * @return Value in [0, 1]
+     */
+    double getFraction() const;
+    
+    /**
+     * @brief Gets a short description of what the worker is doing
+     * @return Status text, e.g. "[2/5] part.step: Transferring STEP roots"
+     */
+    std::string getStatusText() const;
+    
+    /**
+     * @brief Takes the preview triangles streamed by the mesh readers since the last call
+     * 
+     * Only filled when the job was created with BatchOptions::streamPreview.
+     * 
+     * @return One chunk per file, in input order (empty for files without new triangles)
+     */
+    std::vector<MeshPreviewChunk> takePreviews();
+    
+    /**
+     * @brief Gets the throughput statistics of the batch
+     * @return Statistics; complete only after commit()
+     */
+    const ModelImporter::BatchStats& getStats() const { return myResult.stats; }
+    
+    /**
+     * @brief Hands the imported geometry over to the target model
+     * 
+     * Must be called on the thread that owns the target model, after isFinished()
+     * returned true. Waits for the worker if it is still running.
+     * 
+     * @param model The model to merge the imported entities into
+     * @return size_t The number of files that were imported successfully
+     */
+    size_t commit(UnifiedModel& model);
+    
+private:
+    /**
+     * @brief Worker thread entry point
+     */
+    void run();
+    
+    /** The importer used to read the files */
+    std::shared_ptr<ModelImporter> myImporter;
+    
+    /** The files to import */
+    std::vector<std::string> myFilePaths;
+    
+    /** Worker count and memory budget of the batch */
+    ModelImporter::BatchOptions myOptions;
+    
+    /** Per-file progress state */
+    std::vector<std::unique_ptr<ImportProgress>> myProgresses;
+    
+    /** Staging models and statistics filled by the worker */
+    ModelImporter::BatchResult myResult;
+    
+    /** Set once the worker is done */
+    std::atomic<bool> myIsFinished{false};
+    
+    /** Set when cancellation was requested */
+    std::atomic<bool> myIsCancelled{false};
+    
+    /** The worker thread */
+    std::thread myWorker;
+};
@@ -0,0 +1,120 @@
+#include "ImportProgress.h"
+
+#include <algorithm>
+
+void ImportProgress::publishPreview(const UnifiedModel::MeshData& mesh, size_t faceBegin, size_t faceEnd)
+{
+    if (!isPreviewEnabled() || faceBegin >= faceEnd) {
+        return;
+    }
+
+    // 锁外转换为三角形汤，锁内只做追加；超出上限的三角形不转换
+    const size_t nbTriangles = claimPreviewTriangles(faceEnd - faceBegin);
+    if (nbTriangles == 0) {
+        return;
+    }
+    const bool hasNormals = size_t(mesh.normals.rows()) >= faceEnd;
+    MeshPreviewChunk chunk;
+    chunk.positions.resize(nbTriangles * 9);
+    chunk.normals.resize(nbTriangles * 3);
+    for (size_t t = 0; t < nbTriangles; ++t) {
+        const Eigen::Index face = Eigen::Index(faceBegin + t);
+        Eigen::RowVector3d corners[3];
+        for (int c = 0; c < 3; ++c) {
+            corners[c] = mesh.vertices.row(mesh.faces(face, c));
+            for (int k = 0; k < 3; ++k) {
+                chunk.positions[t * 9 + size_t(c) * 3 + size_t(k)] = float(corners[c](k));
+            }
+        }
+        Eigen::RowVector3d normal;
+        if (hasNormals) {
+            normal = mesh.normals.row(face);
+        }
+        else {
+            const Eigen::RowVector3d e1 = corners[1] - corners[0];
+            const Eigen::RowVector3d e2 = corners[2] - corners[0];
+            normal = e1.cross(e2);
+            const double length = normal.norm();
+            normal = length > 0.0 ? Eigen::RowVector3d(normal / length) : Eigen::RowVector3d::Zero();
+        }
+        for (int k = 0; k < 3; ++k) {
+            chunk.normals[t * 3 + size_t(k)] = float(normal(k));
+        }
+    }
+
+    appendPreview(std::move(chunk));
+}
+
+void ImportProgress::publishPreview(MeshPreviewChunk&& chunk)
+{
+    if (!isPreviewEnabled() || chunk.normals.empty()) {
+        return;
+    }
+
+    const size_t nbTriangles = claimPreviewTriangles(chunk.getTriangleCount());
+    if (nbTriangles == 0) {
+        return;
+    }
+    chunk.positions.resize(nbTriangles * 9);
+    chunk.normals.resize(nbTriangles * 3);
+    appendPreview(std::move(chunk));
+}
+
+size_t ImportProgress::claimPreviewTriangles(size_t count)
+{
+    const size_t limit = myPreviewTriangleLimit.load();
+    size_t published = myPreviewTriangles.load();
+    size_t granted = 0;
+    do {
+        if (published >= limit) {
+            return 0;
+        }
+        granted = std::min(count, limit - published);
+    } while (!myPreviewTriangles.compare_exchange_weak(published, published + granted));
+    return granted;
+}
+
+void ImportProgress::appendPreview(MeshPreviewChunk&& chunk)
+{
+    std::lock_guard<std::mutex> lock(myPreviewMutex);
+    if (myPendingPreview.normals.empty()) {
+        myPendingPreview = std::move(chunk);
+        return;
+    }
+    myPendingPreview.positions.insert(myPendingPreview.positions.end(),
+                                      chunk.positions.begin(),
+                                      chunk.positions.end());
+    myPendingPreview.normals.insert(myPendingPreview.normals.end(), chunk.normals.begin(), chunk.normals.end());
+}
+
+MeshPreviewChunk ImportProgress::takePreview()
+{
+    std::lock_guard<std::mutex> lock(myPreviewMutex);
+    MeshPreviewChunk chunk = std::move(myPendingPreview);
+    myPendingPreview = MeshPreviewChunk();
+    return chunk;
+}
+
+void ImportProgress::addStageTiming(const ImportStageTiming& timing)
+{
+    std::lock_guard<std::mutex> lock(myTimingMutex);
+    myStageTimings.push_back(timing);
+}
+
+std::vector<ImportStageTiming> ImportProgress::takeStageTimings()
+{
+    std::lock_guard<std::mutex> lock(myTimingMutex);
+    std::vector<ImportStageTiming> timings = std::move(myStageTimings);
+    myStageTimings.clear();
+    return timings;
+}
+
+void ImportStageTimer::stop()
+{
+    if (myIsStopped) {
+        return;
+    }
+    myIsStopped = true;
+    myTiming.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - myStartTime).count();
+    myProgress.addStageTiming(myTiming);
+}
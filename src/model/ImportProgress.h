@@ -0,0 +1,249 @@
+/**
+ * @file ImportProgress.h
+ * @brief Defines the ImportProgress class shared between an import worker and the UI.
+ * 
+ * The importer updates the stage and fraction from its worker thread, while the UI
+ * thread reads them every frame and may request cancellation at any time. Mesh readers
+ * can also stream the triangles they have decoded so far, so the UI can display a
+ * preview of a large mesh while it is still being read. Scoped ImportStageTimer objects
+ * record how long each stage of the import took.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Triangles of a mesh that is still being imported, in display-ready form
+ *
+ * Chunks are unindexed triangle soups in single precision; they are only used for the
+ * preview and are discarded once the complete mesh is committed to the model.
+ */
+struct MeshPreviewChunk {
+    std::vector<float> positions;  ///< x, y, z of the three corners of each triangle
+    std::vector<float> normals;    ///< x, y, z of the normal of each triangle
+    
+    /** @brief Gets the number of triangles of the chunk */
+    size_t getTriangleCount() const { return normals.size() / 3; }
+};
+
+/**
+ * @brief Measured duration of one stage of an import
+ */
+struct ImportStageTiming {
+    std::string name;            ///< Stage name ("map", "parse", "transfer", "add mesh", ...)
+    double seconds = 0.0;        ///< Wall-clock time of the stage
+    std::uint64_t bytes = 0;     ///< Bytes consumed by the stage (0 if it reads no input)
+    std::uint64_t elements = 0;  ///< Triangles, roots or parts produced by the stage (0 if not counted)
+};
+
+/**
+ * @class ImportProgress
+ * @brief Thread-safe progress and cancellation state of a single file import.
+ */
+class ImportProgress {
+public:
+    /**
+     * @brief Default constructor
+     */
+    ImportProgress() = default;
+    
+    ImportProgress(const ImportProgress&) = delete;
+    ImportProgress& operator=(const ImportProgress&) = delete;
+    
+    /**
+     * @brief Sets the human readable name of the current stage
+     * @param stage The stage name (e.g. "Reading", "Transferring")
+     */
+    void setStage(const std::string& stage) {
+        std::lock_guard<std::mutex> lock(myStageMutex);
+        myStage = stage;
+    }
+    
+    /**
+     * @brief Gets the name of the current stage
+     * @return The stage name
+     */
+    std::string getStage() const {
+        std::lock_guard<std::mutex> lock(myStageMutex);
+        return myStage;
+    }
+    
+    /**
+     * @brief Sets the completed fraction of the import
+     * @param fraction Value in [0, 1]; values outside the range are clamped
+     */
+    void setFraction(double fraction) {
+        myFraction.store(fraction < 0.0 ? 0.0 : (fraction > 1.0 ? 1.0 : fraction));
+    }
+    
+    /**
+     * @brief Gets the completed fraction of the import
+     * @return Value in [0, 1]
+     */
+    double getFraction() const { return myFraction.load(); }
+    
+    /**
+     * @brief Requests cancellation; the importer stops at its next check point
+     */
+    void cancel() { myIsCancelled.store(true); }
+    
+    /**
+     * @brief Checks whether cancellation was requested
+     * @return True if the import should stop
+     */
+    bool isCancelled() const { return myIsCancelled.load(); }
+    
+    /**
+     * @brief Enables or disables streaming of preview triangles
+     * @param enabled True if the UI consumes the chunks published by the reader
+     */
+    void setPreviewEnabled(bool enabled) { myIsPreviewEnabled.store(enabled); }
+    
+    /**
+     * @brief Limits the number of triangles published for the preview
+     * 
+     * Each preview triangle takes 48 bytes, in the pending chunk and again in the displayed
+     * preview. Triangles beyond the limit are not published.
+     * 
+     * @param limit The maximum number of triangles (unlimited by default)
+     */
+    void setPreviewTriangleLimit(size_t limit) { myPreviewTriangleLimit.store(limit); }
+    
+    /**
+     * @brief Checks whether preview triangles should be published
+     * @return True if streaming is enabled and the triangle limit is not reached
+     */
+    bool isPreviewEnabled() const
+    {
+        return myIsPreviewEnabled.load() && myPreviewTriangles.load() < myPreviewTriangleLimit.load();
+    }
+    
+    /**
+     * @brief Publishes a range of decoded triangles of a mesh being read
+     * 
+     * Does nothing unless the preview is enabled; the range is cut at the triangle limit.
+     * May be called concurrently from the
+     * threads of a parallel reader, each with a range it has finished; the vertices
+     * referenced by the range must already be final. The face normals are taken from
+     * mesh.normals if it covers the range, and computed from the positions otherwise.
+     * 
+     * @param mesh The mesh being read
+     * @param faceBegin The first triangle of the range
+     * @param faceEnd One past the last triangle of the range
+     */
+    void publishPreview(const UnifiedModel::MeshData& mesh, size_t faceBegin, size_t faceEnd);
+    
+    /**
+     * @brief Publishes triangles a reader has already converted to a preview chunk
+     * @param chunk The triangles to append to the pending preview (cut at the triangle limit)
+     */
+    void publishPreview(MeshPreviewChunk&& chunk);
+    
+    /**
+     * @brief Takes all triangles published since the last call
+     * @return One chunk holding the pending triangles (empty if nothing was published)
+     */
+    MeshPreviewChunk takePreview();
+    
+    /**
+     * @brief Appends the timing of a finished stage
+     * 
+     * Thread-safe; usually called by an ImportStageTimer going out of scope.
+     * 
+     * @param timing The stage timing
+     */
+    void addStageTiming(const ImportStageTiming& timing);
+    
+    /**
+     * @brief Takes the stage timings recorded since the last call
+     * @return The timings in the order the stages finished
+     */
+    std::vector<ImportStageTiming> takeStageTimings();
+    
+private:
+    /**
+     * @brief Reserves preview triangles within the limit
+     * @param count The number of triangles to publish
+     * @return The number of triangles that may be published
+     */
+    size_t claimPreviewTriangles(size_t count);
+    
+    /**
+     * @brief Appends a chunk to the pending preview
+     * @param chunk The triangles, already within the limit
+     */
+    void appendPreview(MeshPreviewChunk&& chunk);
+    
+    mutable std::mutex myStageMutex;
+    std::string myStage;
+    std::atomic<double> myFraction{0.0};
+    std::atomic<bool> myIsCancelled{false};
+    std::atomic<bool> myIsPreviewEnabled{false};
+    std::atomic<size_t> myPreviewTriangleLimit{std::numeric_limits<size_t>::max()};
+    std::atomic<size_t> myPreviewTriangles{0};
+    std::mutex myPreviewMutex;
+    MeshPreviewChunk myPendingPreview;
+    std::mutex myTimingMutex;
+    std::vector<ImportStageTiming> myStageTimings;
+};
+
+/**
+ * @class ImportStageTimer
+ * @brief Measures a stage of an import and records it in an ImportProgress when it ends.
+ * 
+ * The stage ends when stop() is called or the timer goes out of scope, whichever comes
+ * first, so early returns of the measured code are recorded as well.
+ */
+class ImportStageTimer {
+public:
+    /**
+     * @brief Starts measuring a stage
+     * @param progress Receives the timing of the stage
+     * @param name The stage name
+     */
+    ImportStageTimer(ImportProgress& progress, const char* name)
+        : myProgress(progress)
+        , myStartTime(std::chrono::steady_clock::now())
+    {
+        myTiming.name = name;
+    }
+    
+    /**
+     * @brief Destructor; records the stage unless stop() was called
+     */
+    ~ImportStageTimer() { stop(); }
+    
+    ImportStageTimer(const ImportStageTimer&) = delete;
+    ImportStageTimer& operator=(const ImportStageTimer&) = delete;
+    
+    /**
+     * @brief Sets the number of bytes consumed by the stage
+     * @param bytes The byte count
+     */
+    void setBytes(std::uint64_t bytes) { myTiming.bytes = bytes; }
+    
+    /**
+     * @brief Sets the number of elements produced by the stage
+     * @param elements The element count
+     */
+    void setElements(std::uint64_t elements) { myTiming.elements = elements; }
+    
+    /**
+     * @brief Ends the stage and records it; later calls do nothing
+     */
+    void stop();
+    
+private:
+    ImportProgress& myProgress;
+    ImportStageTiming myTiming;
+    std::chrono::steady_clock::time_point myStartTime;
+    bool myIsStopped = false;
+};
@@ -0,0 +1,87 @@
+#include "ImportRecord.h"
+#include "utils/JsonWriter.h"
+#include "utils/Logger.h"
+
+#include <fstream>
+#include <mutex>
+
+// 创建导入记录日志记录器
+static std::shared_ptr<Utils::Logger>& getImportRecordLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.import_record");
+    return logger;
+}
+
+namespace
+{
+// 串行追加日志文件，并发导入的行不会交错
+std::mutex LOG_MUTEX;
+} // namespace
+
+double ImportRecord::getStageSeconds(const std::string& name) const
+{
+    double total = 0.0;
+    for (const ImportStageTiming& stage : stages) {
+        if (stage.name == name) {
+            total += stage.seconds;
+        }
+    }
+    return total;
+}
+
+void ImportRecord::writeJson(Utils::JsonWriter& json) const
+{
+    json.beginObject();
+    json.key("file").value(filePath);
+    json.key("id").value(modelId);
+    json.key("format").value(format);
+    json.key("succeeded").value(succeeded);
+    json.key("cancelled").value(cancelled);
+    json.key("cacheHit").value(cacheHit);
+    json.key("timestamp").value(timestamp);
+    json.key("fileBytes").value(fileBytes);
+    json.key("triangles").value(triangles);
+    json.key("vertices").value(vertices);
+    json.key("parts").value(std::uint64_t(parts));
+    json.key("seconds").value(seconds);
+    json.key("megabytesPerSecond").value(megabytesPerSecond());
+    json.key("trianglesPerSecond").value(trianglesPerSecond());
+    json.key("residentBytesBefore").value(residentBytesBefore);
+    json.key("peakResidentBytes").value(peakResidentBytes);
+    json.key("stages").beginArray();
+    for (const ImportStageTiming& stage : stages) {
+        json.beginObject();
+        json.key("name").value(stage.name);
+        json.key("seconds").value(stage.seconds);
+        json.key("bytes").value(stage.bytes);
+        json.key("elements").value(stage.elements);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+void ImportRecord::writeJsonLine(std::ostream& stream) const
+{
+    // 紧凑输出不含换行，每条记录恰好占一行
+    Utils::JsonWriter json(stream, 0);
+    writeJson(json);
+    stream << '\n';
+}
+
+bool ImportRecord::appendToLog(const std::string& filePath) const
+{
+    std::lock_guard<std::mutex> lock(LOG_MUTEX);
+    std::ofstream stream(filePath, std::ios::app | std::ios::binary);
+    if (!stream) {
+        getImportRecordLogger()->error("Cannot open import log '{}'", filePath);
+        return false;
+    }
+    writeJsonLine(stream);
+    stream.flush();
+    if (!stream) {
+        getImportRecordLogger()->error("Failed to write import log '{}'", filePath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ImportRecord.h
+ * @brief Defines the ImportRecord structure describing where the time of one import went.
+ *
+ * ModelImporter fills a record per imported file from the ImportStageTimer measurements
+ * of its readers (file mapping, parsing, transfer, normals, addMesh, ...); the view model
+ * appends the time spent building the presentation. Records can be written as one JSON
+ * object per line, so a log of many imports stays machine-readable.
+ */
+#pragma once
+
+#include "ImportProgress.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Utils {
+class JsonWriter;
+}
+
+/**
+ * @brief Stage durations, counters and memory use of one file import
+ */
+struct ImportRecord {
+    std::string filePath;         ///< The imported file
+    std::string modelId;          ///< ID of the root entity of the import
+    std::string format;           ///< File extension (lowercase, including the dot)
+    bool succeeded = false;       ///< Whether the import succeeded
+    bool cancelled = false;       ///< Whether the import was cancelled
+    bool cacheHit = false;        ///< Whether the entities came from the import cache
+    double timestamp = 0.0;       ///< Start of the import, in seconds since the Unix epoch
+    std::uint64_t fileBytes = 0;  ///< Size of the file
+    std::uint64_t triangles = 0;  ///< Triangles of the imported meshes and triangulated shapes
+    std::uint64_t vertices = 0;   ///< Vertices (triangulation nodes) of the same
+    size_t parts = 0;             ///< Number of part entities (shapes and meshes)
+    double seconds = 0.0;         ///< Wall-clock time of the import, without the presentation
+    std::uint64_t residentBytesBefore = 0;  ///< Resident memory of the process when the import started
+    std::uint64_t peakResidentBytes = 0;    ///< Peak resident memory during the import (0 if unknown)
+    std::vector<ImportStageTiming> stages;  ///< Stage timings, in the order the stages finished
+
+    /** @brief Gets the read throughput in MB/s */
+    double megabytesPerSecond() const {
+        return seconds > 0.0 ? double(fileBytes) / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+
+    /** @brief Gets the number of triangles imported per second */
+    double trianglesPerSecond() const {
+        return seconds > 0.0 ? double(triangles) / seconds : 0.0;
+    }
+
+    /**
+     * @brief Gets the growth of the resident memory during the import
+     * @return Peak minus starting resident bytes (0 if unknown)
+     */
+    std::uint64_t peakGrowthBytes() const {
+        return peakResidentBytes > residentBytesBefore ? peakResidentBytes - residentBytesBefore : 0;
+    }
+
+    /**
+     * @brief Gets the total time of the stages with a given name
+     * @param name The stage name
+     * @return The summed seconds (0 if the stage did not run)
+     */
+    double getStageSeconds(const std::string& name) const;
+
+    /**
+     * @brief Writes the record as a JSON object
+     * @param json The writer, positioned where a value is expected
+     */
+    void writeJson(Utils::JsonWriter& json) const;
+
+    /**
+     * @brief Writes the record as one line of compact JSON
+     * @param stream The output stream
+     */
+    void writeJsonLine(std::ostream& stream) const;
+
+    /**
+     * @brief Appends the record to a JSON Lines log file
+     * @param filePath The log file (created if missing)
+     * @return bool False if the file could not be written
+     */
+    bool appendToLog(const std::string& filePath) const;
+};
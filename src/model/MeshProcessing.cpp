@@ -0,0 +1,722 @@
+#include "MeshProcessing.h"
+#include "utils/Logger.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// 创建网格处理日志记录器
+static std::shared_ptr<Utils::Logger>& getMeshProcessingLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.processing");
+    return logger;
+}
+
+namespace
+{
+// 每个线程至少处理的元素数
+constexpr size_t MIN_CHUNK = 16384;
+
+// 搜索简化网格时修正单元尺寸的最大次数
+constexpr int MAX_GRID_ITERATIONS = 4;
+
+// 与目标簇数的相对偏差小于该值时结束网格搜索
+constexpr double GRID_TOLERANCE = 0.1;
+
+// 顶点的排序项：所在网格单元及其序号
+struct VertexEntry
+{
+    std::array<std::int64_t, 3> key;
+    int index;
+
+    bool operator<(const VertexEntry& other) const
+    {
+        return key != other.key ? key < other.key : index < other.index;
+    }
+};
+
+// 面的排序项：排序后的顶点索引及其序号
+struct FaceEntry
+{
+    std::array<int, 3> key;
+    int index;
+
+    bool operator<(const FaceEntry& other) const
+    {
+        return key != other.key ? key < other.key : index < other.index;
+    }
+};
+
+// 顶点位置的排序项：坐标的哈希及其序号
+struct PositionEntry
+{
+    std::uint64_t key;
+    int index;
+
+    bool operator<(const PositionEntry& other) const
+    {
+        return key != other.key ? key < other.key : index < other.index;
+    }
+};
+
+// 边的排序项：两个顶点索引打包为64位（较小的索引在高半部分）及所属的面
+struct EdgeEntry
+{
+    std::uint64_t key;
+    int face;
+
+    bool operator<(const EdgeEntry& other) const
+    {
+        return key != other.key ? key < other.key : face < other.face;
+    }
+};
+
+// 已删除面的边键的高半部分，顶点索引不会达到该值
+constexpr std::uint64_t REMOVED_EDGE = std::uint64_t(0xFFFFFFFFu) << 32;
+
+// repair()删除面的原因
+enum FaceStatus : std::uint8_t
+{
+    FACE_KEPT,
+    FACE_INVALID,
+    FACE_DEGENERATE,
+    FACE_DUPLICATE,
+    FACE_NON_MANIFOLD
+};
+
+// 对每段键相等的排序项并行调用func(begin, end)
+// 每个线程从其分块内开始的第一段做起，并处理完最后一段，因此一段不会被拆到两个线程
+template <typename Entry, typename Func>
+void forEachRun(const std::vector<Entry>& entries, Func&& func)
+{
+    Utils::parallelFor(0, entries.size(), MIN_CHUNK, [&](size_t begin, size_t end) {
+        size_t i = begin;
+        while (i > 0 && i < end && entries[i].key == entries[i - 1].key) {
+            ++i;
+        }
+        while (i < end) {
+            size_t runEnd = i + 1;
+            while (runEnd < entries.size() && entries[runEnd].key == entries[i].key) {
+                ++runEnd;
+            }
+            func(i, runEnd);
+            i = runEnd;
+        }
+    });
+}
+
+// 返回面面积的两倍
+double doubleArea(const UnifiedModel::MeshData& mesh, Eigen::Index face)
+{
+    const Eigen::Vector3d a = mesh.vertices.row(mesh.faces(face, 0)).transpose();
+    const Eigen::Vector3d b = mesh.vertices.row(mesh.faces(face, 1)).transpose();
+    const Eigen::Vector3d c = mesh.vertices.row(mesh.faces(face, 2)).transpose();
+    return (b - a).cross(c - a).norm();
+}
+
+// 返回坐标的位模式，-0和+0映射为同一个键
+std::int64_t coordinateBits(double value)
+{
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    std::int64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// 混合64位值的各位（splitmix64的末尾步骤）
+std::uint64_t mixBits(std::uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+// 返回顶点精确位置的哈希（-0和+0的哈希相同）
+std::uint64_t positionHash(const Eigen::MatrixXd& vertices, Eigen::Index row)
+{
+    std::uint64_t hash = 0;
+    for (int c = 0; c < 3; ++c) {
+        hash = mixBits(hash ^ std::uint64_t(coordinateBits(vertices(row, c))));
+    }
+    return hash;
+}
+
+// 按给定的单元尺寸计算所有顶点的排序项
+// 单元尺寸为0时按精确位置作为键；坐标不是有限值的顶点各自使用单独的键
+std::vector<VertexEntry> makeVertexEntries(const Eigen::MatrixXd& vertices, double cellSize)
+{
+    const Eigen::Index nbVertices = vertices.rows();
+    std::vector<VertexEntry> entries(static_cast<size_t>(nbVertices));
+    if (nbVertices == 0) {
+        return entries;
+    }
+
+    // 网格原点取有限坐标的最小值，使格子索引非负；范围过大导致溢出时退回精确匹配
+    std::array<double, 3> origin = {0.0, 0.0, 0.0};
+    if (cellSize > 0.0) {
+        std::array<double, 3> min, max;
+        min.fill(std::numeric_limits<double>::max());
+        max.fill(std::numeric_limits<double>::lowest());
+        for (Eigen::Index i = 0; i < nbVertices; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                const double value = vertices(i, c);
+                if (std::isfinite(value)) {
+                    min[c] = std::min(min[c], value);
+                    max[c] = std::max(max[c], value);
+                }
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            origin[c] = min[c] <= max[c] ? min[c] : 0.0;
+            if (min[c] <= max[c] && (max[c] - min[c]) / cellSize > 1.0e15) {
+                cellSize = 0.0;
+            }
+        }
+    }
+
+    Utils::parallelFor(0, entries.size(), MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = static_cast<Eigen::Index>(i);
+            VertexEntry& entry = entries[i];
+            entry.index = static_cast<int>(i);
+            const bool isFinite = std::isfinite(vertices(row, 0)) && std::isfinite(vertices(row, 1))
+                               && std::isfinite(vertices(row, 2));
+            if (!isFinite) {
+                // 格子索引与坐标位模式都不会取到最小值（-0已归一为+0）
+                entry.key = {std::numeric_limits<std::int64_t>::min(), std::int64_t(i), 0};
+            } else if (cellSize > 0.0) {
+                for (int c = 0; c < 3; ++c) {
+                    entry.key[c] = static_cast<std::int64_t>(std::floor((vertices(row, c) - origin[c]) / cellSize));
+                }
+            } else {
+                for (int c = 0; c < 3; ++c) {
+                    entry.key[c] = coordinateBits(vertices(row, c));
+                }
+            }
+        }
+    });
+    Utils::parallelSort(entries.begin(), entries.end(), std::less<VertexEntry>());
+    return entries;
+}
+
+// 统计已排序顶点项中相等键的分组数
+size_t countClusters(const std::vector<VertexEntry>& entries)
+{
+    size_t count = entries.empty() ? 0 : 1;
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].key != entries[i - 1].key) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// 并行归一化矩阵的每一行，零行保持为零
+void normalizeRows(Eigen::MatrixXd& rows)
+{
+    Utils::parallelFor(0, static_cast<size_t>(rows.rows()), MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = static_cast<Eigen::Index>(i);
+            const double norm = rows.row(row).norm();
+            if (norm > 0.0) {
+                rows.row(row) /= norm;
+            }
+        }
+    });
+}
+
+// 按簇平均属性的各行，可选重新归一化
+Eigen::MatrixXd averageRows(const Eigen::MatrixXd& values,
+                            const std::vector<int>& remap,
+                            const std::vector<int>& clusterSizes,
+                            bool toNormalize)
+{
+    Eigen::MatrixXd result = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(clusterSizes.size()), 3);
+    for (size_t i = 0; i < remap.size(); ++i) {
+        result.row(remap[i]) += values.row(static_cast<Eigen::Index>(i));
+    }
+    if (toNormalize) {
+        normalizeRows(result);
+        return result;
+    }
+    Utils::parallelFor(0, clusterSizes.size(), MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result.row(static_cast<Eigen::Index>(i)) /= double(clusterSizes[i]);
+        }
+    });
+    return result;
+}
+
+// 把每组已排序项的顶点合并为一个并重写面
+// 退化面总是删除，重复面只在要求时删除
+void collapseClusters(UnifiedModel::MeshData& mesh,
+                      const std::vector<VertexEntry>& entries,
+                      bool toRemoveDuplicates)
+{
+    const size_t nbVertices = entries.size();
+
+    // 每组的代表是索引最小的顶点（排序的次要键），新顶点按代表的原始顺序编号
+    std::vector<int> representative(nbVertices);
+    for (size_t i = 0, groupBegin = 0; i < nbVertices; ++i) {
+        if (i > 0 && entries[i].key != entries[i - 1].key) {
+            groupBegin = i;
+        }
+        representative[entries[i].index] = entries[groupBegin].index;
+    }
+    std::vector<int> remap(nbVertices);
+    std::vector<int> clusterSizes;
+    for (size_t i = 0; i < nbVertices; ++i) {
+        if (representative[i] == int(i)) {
+            remap[i] = int(clusterSizes.size());
+            clusterSizes.push_back(0);
+        } else {
+            remap[i] = remap[representative[i]];
+        }
+        ++clusterSizes[remap[i]];
+    }
+
+    // 顶点属性按组求平均
+    const Eigen::Index nbRows = static_cast<Eigen::Index>(nbVertices);
+    mesh.vertices = averageRows(mesh.vertices, remap, clusterSizes, false);
+    if (mesh.vertexColors.rows() == nbRows) {
+        mesh.vertexColors = averageRows(mesh.vertexColors, remap, clusterSizes, false);
+    } else {
+        mesh.vertexColors.resize(0, 3);
+    }
+    if (mesh.vertexNormals.rows() == nbRows) {
+        mesh.vertexNormals = averageRows(mesh.vertexNormals, remap, clusterSizes, true);
+    } else {
+        mesh.vertexNormals.resize(0, 3);
+    }
+
+    // 并行重写面索引并标记退化面
+    const size_t nbFaces = static_cast<size_t>(mesh.faces.rows());
+    std::vector<char> toKeep(nbFaces, 1);
+    Utils::parallelFor(0, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = static_cast<Eigen::Index>(i);
+            for (int c = 0; c < 3; ++c) {
+                const int vertex = mesh.faces(row, c);
+                if (vertex < 0 || size_t(vertex) >= nbVertices) {
+                    toKeep[i] = 0;
+                    break;
+                }
+                mesh.faces(row, c) = remap[vertex];
+            }
+            if (toKeep[i]
+             && (mesh.faces(row, 0) == mesh.faces(row, 1) || mesh.faces(row, 1) == mesh.faces(row, 2)
+              || mesh.faces(row, 0) == mesh.faces(row, 2)))
+            {
+                toKeep[i] = 0;
+            }
+        }
+    });
+
+    // 重复面（不论方向）通过排序后的索引三元组检测，保留第一个
+    if (toRemoveDuplicates) {
+        std::vector<FaceEntry> faceEntries(nbFaces);
+        Utils::parallelFor(0, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const Eigen::Index row = static_cast<Eigen::Index>(i);
+                faceEntries[i].key = {mesh.faces(row, 0), mesh.faces(row, 1), mesh.faces(row, 2)};
+                std::sort(faceEntries[i].key.begin(), faceEntries[i].key.end());
+                faceEntries[i].index = static_cast<int>(i);
+            }
+        });
+        Utils::parallelSort(faceEntries.begin(), faceEntries.end(), std::less<FaceEntry>());
+        for (size_t i = 1; i < nbFaces; ++i) {
+            if (faceEntries[i].key == faceEntries[i - 1].key) {
+                toKeep[faceEntries[i].index] = 0;
+            }
+        }
+    }
+
+    // 压缩保留的面及其法向量，保持原有顺序
+    const bool hasFaceNormals = static_cast<size_t>(mesh.normals.rows()) == nbFaces;
+    Eigen::Index nbKept = 0;
+    for (size_t i = 0; i < nbFaces; ++i) {
+        if (!toKeep[i]) {
+            continue;
+        }
+        const Eigen::Index row = static_cast<Eigen::Index>(i);
+        if (nbKept != row) {
+            mesh.faces.row(nbKept) = mesh.faces.row(row);
+            if (hasFaceNormals) {
+                mesh.normals.row(nbKept) = mesh.normals.row(row);
+            }
+        }
+        ++nbKept;
+    }
+    mesh.faces.conservativeResize(nbKept, 3);
+    if (hasFaceNormals) {
+        mesh.normals.conservativeResize(nbKept, 3);
+    } else {
+        mesh.normals = Eigen::MatrixXd::Zero(nbKept, 3);
+    }
+}
+
+// 返回有限面的平均边长
+double meanEdgeLength(const UnifiedModel::MeshData& mesh)
+{
+    double sum = 0.0;
+    size_t count = 0;
+    for (Eigen::Index i = 0; i < mesh.faces.rows(); ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const int from = mesh.faces(i, c);
+            const int to = mesh.faces(i, (c + 1) % 3);
+            if (from < 0 || to < 0 || from >= mesh.vertices.rows() || to >= mesh.vertices.rows()) {
+                continue;
+            }
+            const double length = (mesh.vertices.row(from) - mesh.vertices.row(to)).norm();
+            if (std::isfinite(length)) {
+                sum += length;
+                ++count;
+            }
+        }
+    }
+    return count > 0 ? sum / double(count) : 0.0;
+}
+} // namespace
+
+namespace MeshProcessing {
+
+Result weldVertices(UnifiedModel::MeshData& mesh, double tolerance)
+{
+    Result result;
+    result.verticesBefore = static_cast<size_t>(mesh.vertices.rows());
+    result.facesBefore = static_cast<size_t>(mesh.faces.rows());
+
+    const std::vector<VertexEntry> entries = makeVertexEntries(mesh.vertices, std::max(0.0, tolerance));
+    collapseClusters(mesh, entries, false);
+
+    result.verticesAfter = static_cast<size_t>(mesh.vertices.rows());
+    result.facesAfter = static_cast<size_t>(mesh.faces.rows());
+    getMeshProcessingLogger()->debug("Welded {} vertices into {} ({} degenerate faces removed)",
+                                     result.verticesBefore,
+                                     result.verticesAfter,
+                                     result.facesBefore - result.facesAfter);
+    return result;
+}
+
+RepairReport repair(UnifiedModel::MeshData& mesh)
+{
+    RepairReport report;
+    const size_t nbVertices = static_cast<size_t>(mesh.vertices.rows());
+    const size_t nbFaces = static_cast<size_t>(mesh.faces.rows());
+    report.counts.verticesBefore = nbVertices;
+    report.counts.facesBefore = nbFaces;
+
+    std::vector<char> isFinite(nbVertices);
+    Utils::parallelFor(0, nbVertices, MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            isFinite[i] = mesh.vertices.row(static_cast<Eigen::Index>(i)).allFinite();
+        }
+    });
+    report.nonFiniteVertices = static_cast<size_t>(std::count(isFinite.begin(), isFinite.end(), 0));
+
+    // 位置相同的顶点共用规范索引（其中最小的索引）：按坐标哈希排序，
+    // 哈希相同的游程内再逐一比较坐标，排除哈希冲突；非有限坐标的顶点各自独立
+    std::vector<int> canonical(nbVertices);
+    {
+        std::vector<PositionEntry> entries(nbVertices);
+        Utils::parallelFor(0, nbVertices, MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                entries[i] = {positionHash(mesh.vertices, static_cast<Eigen::Index>(i)), static_cast<int>(i)};
+            }
+        });
+        Utils::parallelSort(entries.begin(), entries.end(), std::less<PositionEntry>());
+        forEachRun(entries, [&](size_t begin, size_t end) {
+            std::vector<int> leaders;
+            for (size_t i = begin; i < end; ++i) {
+                const int vertex = entries[i].index;
+                canonical[vertex] = vertex;
+                if (!isFinite[vertex]) {
+                    continue;
+                }
+                const auto leader = std::find_if(leaders.begin(), leaders.end(), [&](int candidate) {
+                    return (mesh.vertices.row(candidate).array() == mesh.vertices.row(vertex).array()).all();
+                });
+                if (leader != leaders.end()) {
+                    canonical[vertex] = *leader;
+                } else {
+                    leaders.push_back(vertex);
+                }
+            }
+        });
+    }
+
+    // 无效面与零面积面
+    std::vector<std::uint8_t> status(nbFaces, FACE_KEPT);
+    Utils::parallelFor(0, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = static_cast<Eigen::Index>(i);
+            std::array<int, 3> corners;
+            for (int c = 0; c < 3; ++c) {
+                const int vertex = mesh.faces(row, c);
+                if (vertex < 0 || size_t(vertex) >= nbVertices || !isFinite[vertex]) {
+                    status[i] = FACE_INVALID;
+                    break;
+                }
+                corners[c] = canonical[vertex];
+            }
+            if (status[i] != FACE_KEPT) {
+                continue;
+            }
+            if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2]
+             || doubleArea(mesh, row) == 0.0)
+            {
+                status[i] = FACE_DEGENERATE;
+            }
+        }
+    });
+
+    // 重复面：按排序后的规范索引三元组排序，相邻相等者只保留索引最小的一个
+    {
+        std::vector<FaceEntry> entries(nbFaces);
+        Utils::parallelFor(0, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const Eigen::Index row = static_cast<Eigen::Index>(i);
+                FaceEntry& entry = entries[i];
+                entry.index = static_cast<int>(i);
+                if (status[i] != FACE_KEPT) {
+                    entry.key = {-1, -1, static_cast<int>(i)};
+                    continue;
+                }
+                entry.key = {canonical[mesh.faces(row, 0)], canonical[mesh.faces(row, 1)], canonical[mesh.faces(row, 2)]};
+                std::sort(entry.key.begin(), entry.key.end());
+            }
+        });
+        Utils::parallelSort(entries.begin(), entries.end(), std::less<FaceEntry>());
+        Utils::parallelFor(1, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (entries[i].key[0] >= 0 && entries[i].key == entries[i - 1].key) {
+                    status[entries[i].index] = FACE_DUPLICATE;
+                }
+            }
+        });
+    }
+
+    // 非流形边：排序后长度大于2的游程；只保留面积最大的两个面
+    {
+        std::vector<EdgeEntry> entries(3 * nbFaces);
+        Utils::parallelFor(0, nbFaces, MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const Eigen::Index row = static_cast<Eigen::Index>(i);
+                for (int c = 0; c < 3; ++c) {
+                    EdgeEntry& entry = entries[3 * i + c];
+                    entry.face = static_cast<int>(i);
+                    if (status[i] != FACE_KEPT) {
+                        entry.key = REMOVED_EDGE | std::uint64_t(3 * i + c);
+                        continue;
+                    }
+                    const int from = canonical[mesh.faces(row, c)];
+                    const int to = canonical[mesh.faces(row, (c + 1) % 3)];
+                    entry.key = (std::uint64_t(std::min(from, to)) << 32) | std::uint64_t(std::max(from, to));
+                }
+            }
+        });
+        Utils::parallelSort(entries.begin(), entries.end(), std::less<EdgeEntry>());
+
+        // 非流形边很少见，标记时加锁即可
+        std::mutex mutex;
+        forEachRun(entries, [&](size_t begin, size_t end) {
+            if (end - begin <= 2 || entries[begin].key >= REMOVED_EDGE) {
+                return;
+            }
+            std::vector<std::pair<double, int>> faces;
+            for (size_t i = begin; i < end; ++i) {
+                faces.emplace_back(doubleArea(mesh, entries[i].face), entries[i].face);
+            }
+            std::sort(faces.begin(), faces.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            ++report.nonManifoldEdges;
+            for (size_t i = 2; i < faces.size(); ++i) {
+                status[faces[i].second] = FACE_NON_MANIFOLD;
+            }
+        });
+    }
+
+    for (const std::uint8_t faceStatus : status) {
+        switch (faceStatus) {
+            case FACE_INVALID: ++report.invalidFaces; break;
+            case FACE_DEGENERATE: ++report.degenerateFaces; break;
+            case FACE_DUPLICATE: ++report.duplicateFaces; break;
+            case FACE_NON_MANIFOLD: ++report.nonManifoldFaces; break;
+            default: break;
+        }
+    }
+
+    // 保留的面用到的顶点按原顺序重新编号
+    std::vector<int> keptFaces;
+    keptFaces.reserve(nbFaces - report.removedFaces());
+    std::vector<int> remap(nbVertices, -1);
+    for (size_t i = 0; i < nbFaces; ++i) {
+        if (status[i] != FACE_KEPT) {
+            continue;
+        }
+        keptFaces.push_back(static_cast<int>(i));
+        for (int c = 0; c < 3; ++c) {
+            remap[mesh.faces(static_cast<Eigen::Index>(i), c)] = 0;
+        }
+    }
+    std::vector<int> keptVertices;
+    keptVertices.reserve(nbVertices);
+    for (size_t i = 0; i < nbVertices; ++i) {
+        if (remap[i] == 0) {
+            remap[i] = static_cast<int>(keptVertices.size());
+            keptVertices.push_back(static_cast<int>(i));
+        } else if (isFinite[i]) {
+            ++report.unusedVertices;
+        }
+    }
+
+    report.counts.verticesAfter = keptVertices.size();
+    report.counts.facesAfter = keptFaces.size();
+    if (!report.hasChanges()) {
+        return report;
+    }
+
+    // 并行收集保留的顶点、面及其属性
+    auto gatherRows = [](const Eigen::MatrixXd& values, const std::vector<int>& rows) {
+        Eigen::MatrixXd result(static_cast<Eigen::Index>(rows.size()), values.cols());
+        Utils::parallelFor(0, rows.size(), MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                result.row(static_cast<Eigen::Index>(i)) = values.row(rows[i]);
+            }
+        });
+        return result;
+    };
+    const Eigen::Index nbRows = static_cast<Eigen::Index>(nbVertices);
+    mesh.vertices = gatherRows(mesh.vertices, keptVertices);
+    if (mesh.vertexNormals.rows() == nbRows) {
+        mesh.vertexNormals = gatherRows(mesh.vertexNormals, keptVertices);
+    } else {
+        mesh.vertexNormals.resize(0, 3);
+    }
+    if (mesh.vertexColors.rows() == nbRows) {
+        mesh.vertexColors = gatherRows(mesh.vertexColors, keptVertices);
+    } else {
+        mesh.vertexColors.resize(0, 3);
+    }
+    if (static_cast<size_t>(mesh.normals.rows()) == nbFaces) {
+        mesh.normals = gatherRows(mesh.normals, keptFaces);
+    } else {
+        mesh.normals = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(keptFaces.size()), 3);
+    }
+    Eigen::MatrixXi faces(static_cast<Eigen::Index>(keptFaces.size()), 3);
+    Utils::parallelFor(0, keptFaces.size(), MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                faces(static_cast<Eigen::Index>(i), c) = remap[mesh.faces(keptFaces[i], c)];
+            }
+        }
+    });
+    mesh.faces = std::move(faces);
+
+    getMeshProcessingLogger()->debug(
+        "Repaired mesh: {} invalid, {} degenerate, {} duplicate and {} non-manifold faces removed, "
+        "{} non-manifold edges, {} vertices removed",
+        report.invalidFaces,
+        report.degenerateFaces,
+        report.duplicateFaces,
+        report.nonManifoldFaces,
+        report.nonManifoldEdges,
+        report.counts.verticesBefore - report.counts.verticesAfter);
+    return report;
+}
+
+Result decimate(UnifiedModel::MeshData& mesh, double ratio)
+{
+    Result result;
+    result.verticesBefore = static_cast<size_t>(mesh.vertices.rows());
+    result.facesBefore = static_cast<size_t>(mesh.faces.rows());
+    result.verticesAfter = result.verticesBefore;
+    result.facesAfter = result.facesBefore;
+
+    const double edgeLength = meanEdgeLength(mesh);
+    if (ratio <= 0.0 || ratio >= 1.0 || result.facesBefore == 0 || edgeLength <= 0.0) {
+        return result;
+    }
+
+    // 闭合流形网格的面数约为顶点数的两倍，据此由目标面数估计目标顶点数（同样适用于三角形汤）
+    const double targetClusters = std::max(4.0, ratio * double(result.facesBefore) / 2.0);
+
+    // 格子数与格子尺寸的平方成反比：从平均边长出发，按实际格子数修正几次
+    double cellSize = edgeLength / std::sqrt(ratio);
+    std::vector<VertexEntry> entries = makeVertexEntries(mesh.vertices, cellSize);
+    for (int iteration = 0; iteration < MAX_GRID_ITERATIONS; ++iteration) {
+        const double nbClusters = double(countClusters(entries));
+        if (std::abs(nbClusters - targetClusters) <= GRID_TOLERANCE * targetClusters) {
+            break;
+        }
+        cellSize *= std::sqrt(nbClusters / targetClusters);
+        entries = makeVertexEntries(mesh.vertices, cellSize);
+    }
+    collapseClusters(mesh, entries, true);
+
+    result.verticesAfter = static_cast<size_t>(mesh.vertices.rows());
+    result.facesAfter = static_cast<size_t>(mesh.faces.rows());
+    getMeshProcessingLogger()->debug("Decimated {} faces to {} (cell size {})",
+                                     result.facesBefore,
+                                     result.facesAfter,
+                                     cellSize);
+    return result;
+}
+
+void computeNormals(UnifiedModel::MeshData& mesh, bool withVertexNormals)
+{
+    const Eigen::Index nbFaces = mesh.faces.rows();
+    const Eigen::Index nbVertices = mesh.vertices.rows();
+
+    // 面法向量：叉积的长度为面积的两倍，先保留以便加权顶点法向量
+    Eigen::MatrixXd areaNormals = Eigen::MatrixXd::Zero(nbFaces, 3);
+    Utils::parallelFor(0, static_cast<size_t>(nbFaces), MIN_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = static_cast<Eigen::Index>(i);
+            const int a = mesh.faces(row, 0);
+            const int b = mesh.faces(row, 1);
+            const int c = mesh.faces(row, 2);
+            if (a < 0 || b < 0 || c < 0 || a >= nbVertices || b >= nbVertices || c >= nbVertices) {
+                continue;
+            }
+            const Eigen::Vector3d u = (mesh.vertices.row(b) - mesh.vertices.row(a)).transpose();
+            const Eigen::Vector3d v = (mesh.vertices.row(c) - mesh.vertices.row(a)).transpose();
+            const Eigen::Vector3d n = u.cross(v);
+            if (n.allFinite()) {
+                areaNormals.row(row) = n.transpose();
+            }
+        }
+    });
+
+    mesh.normals = areaNormals;
+    normalizeRows(mesh.normals);
+    if (!withVertexNormals) {
+        return;
+    }
+
+    // 顶点法向量：累加相邻面的面积加权法向量后归一化
+    Eigen::MatrixXd vertexNormals = Eigen::MatrixXd::Zero(nbVertices, 3);
+    for (Eigen::Index i = 0; i < nbFaces; ++i) {
+        if (areaNormals.row(i).isZero(0.0)) {
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            vertexNormals.row(mesh.faces(i, c)) += areaNormals.row(i);
+        }
+    }
+    normalizeRows(vertexNormals);
+    mesh.vertexNormals = std::move(vertexNormals);
+}
+
+} // namespace MeshProcessing
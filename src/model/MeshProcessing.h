@@ -0,0 +1,105 @@
+/**
+ * @file MeshProcessing.h
+ * @brief Declares the processing stages applied to polygon meshes after import.
+ *
+ * The stages work in place on UnifiedModel::MeshData and keep the optional per-vertex
+ * attributes (normals, colors) and the per-face normals consistent with the new
+ * vertices and faces. They are parallelized with Utils::parallelFor and
+ * Utils::parallelSort, so they scale to meshes with tens of millions of triangles.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+
+#include <cstddef>
+
+namespace MeshProcessing {
+
+/**
+ * @brief Element counts before and after a stage
+ */
+struct Result {
+    size_t verticesBefore = 0;  ///< Number of vertices of the input
+    size_t verticesAfter = 0;   ///< Number of vertices of the output
+    size_t facesBefore = 0;     ///< Number of faces of the input
+    size_t facesAfter = 0;      ///< Number of faces of the output
+};
+
+/**
+ * @brief Defects found and removed by repair()
+ */
+struct RepairReport {
+    size_t nonFiniteVertices = 0;  ///< Vertices with NaN or infinite coordinates
+    size_t invalidFaces = 0;       ///< Faces with an out-of-range index or a non-finite vertex
+    size_t degenerateFaces = 0;    ///< Faces of zero area (coincident or collinear corners)
+    size_t duplicateFaces = 0;     ///< Faces with the same corner positions as an earlier face
+    size_t nonManifoldEdges = 0;   ///< Edges shared by more than two faces
+    size_t nonManifoldFaces = 0;   ///< Faces removed so that every edge has at most two faces
+    size_t unusedVertices = 0;     ///< Finite vertices removed because no face uses them
+    Result counts;                 ///< Element counts before and after the repair
+
+    /** @brief Gets the number of removed faces */
+    size_t removedFaces() const {
+        return invalidFaces + degenerateFaces + duplicateFaces + nonManifoldFaces;
+    }
+
+    /** @brief Checks whether the mesh was changed */
+    bool hasChanges() const {
+        return counts.facesAfter != counts.facesBefore || counts.verticesAfter != counts.verticesBefore;
+    }
+};
+
+/**
+ * @brief Merges vertices that lie in the same cell of a grid of the given size
+ *
+ * Typically used on STL triangle soups, where every triangle has its own three
+ * vertices. Merged vertices are placed at the mean of their positions; faces that
+ * become degenerate are removed. Vertices closer than the tolerance but on both sides
+ * of a cell boundary are not merged. Vertices with non-finite coordinates are kept.
+ *
+ * @param mesh The mesh to weld
+ * @param tolerance The grid cell size (0: merge only identical positions)
+ * @return Result The element counts
+ */
+Result weldVertices(UnifiedModel::MeshData& mesh, double tolerance = 0.0);
+
+/**
+ * @brief Removes the defects that break or slow down rendering, picking and processing
+ *
+ * In this order: faces using non-finite vertices or invalid indices, zero-area faces,
+ * duplicated faces (same corner positions, in any order or orientation; the first one
+ * is kept) and, on edges shared by more than two faces, all but the two largest faces.
+ * Vertices are compared by position, so triangle soups are repaired like indexed
+ * meshes; the vertices are not merged. Vertices no longer used by any face are removed.
+ * Detection sorts vertex, face and edge keys with Utils::parallelSort.
+ *
+ * @param mesh The mesh to repair
+ * @return RepairReport The defects found
+ */
+RepairReport repair(UnifiedModel::MeshData& mesh);
+
+/**
+ * @brief Reduces the number of faces by vertex clustering
+ *
+ * The vertices are clustered on a uniform grid whose cell size is adjusted so that
+ * about `ratio` of the faces remain. Unlike edge-collapse decimation, clustering
+ * accepts non-manifold input and triangle soups; it does not preserve sharp features
+ * smaller than a cell. Degenerate and duplicated faces are removed.
+ *
+ * @param mesh The mesh to decimate
+ * @param ratio The fraction of faces to keep, in (0, 1)
+ * @return Result The element counts
+ */
+Result decimate(UnifiedModel::MeshData& mesh, double ratio);
+
+/**
+ * @brief Recomputes the face normals and, optionally, area-weighted vertex normals
+ *
+ * Degenerate faces get a zero normal.
+ *
+ * @param mesh The mesh to update
+ * @param withVertexNormals Whether to compute vertex normals as well
+ */
+void computeNormals(UnifiedModel::MeshData& mesh, bool withVertexNormals = true);
+
+} // namespace MeshProcessing
@@ -0,0 +1,166 @@
+#include "MeshingJob.h"
+#include "utils/Logger.h"
+
+#include <BRepBuilderAPI_Copy.hxx>
+
+// 创建剖分任务日志记录器
+static std::shared_ptr<Utils::Logger>& getMeshingJobLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.meshing_job");
+    return logger;
+}
+
+MeshingJob::MeshingJob(const UnifiedModel& model,
+                       const std::vector<std::string>& shapeIds,
+                       const ShapeMesher::Options& options)
+    : myMesher(options)
+{
+    myTasks.reserve(shapeIds.size());
+    for (const std::string& id : shapeIds) {
+        const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+        if (!data || data->type != UnifiedModel::GeometryType::SHAPE) {
+            getMeshingJobLogger()->warn("Entity '{}' is not a shape, skipping", id);
+            continue;
+        }
+        const TopoDS_Shape shape = model.getShape(id);
+        if (shape.IsNull()) {
+            continue;
+        }
+
+        // Netgen会修改其处理的形状（如附加三角剖分），因此在调用线程上复制一份
+        Task task;
+        task.shapeId = id;
+        task.name = model.getName(id);
+        task.parentId = model.getParentId(id);
+        task.color = model.getColor(id);
+        task.shape = BRepBuilderAPI_Copy(shape, Standard_True, Standard_False).Shape();
+        myTasks.push_back(std::move(task));
+    }
+}
+
+MeshingJob::~MeshingJob()
+{
+    cancel();
+    if (myWorker.joinable()) {
+        myWorker.join();
+    }
+}
+
+void MeshingJob::start()
+{
+    getMeshingJobLogger()->info("Starting background meshing of {} shape(s)", myTasks.size());
+    myWorker = std::thread(&MeshingJob::run, this);
+}
+
+void MeshingJob::cancel()
+{
+    myIsCancelled.store(true);
+    myProgress.cancel();
+}
+
+double MeshingJob::getFraction() const
+{
+    if (myTasks.empty()) {
+        return 1.0;
+    }
+
+    const size_t current = myCurrentTask.load();
+    if (current >= myTasks.size()) {
+        return 1.0;
+    }
+    return (double(current) + myProgress.getFraction()) / double(myTasks.size());
+}
+
+std::string MeshingJob::getStatusText() const
+{
+    if (isFinished()) {
+        return isCancelled() ? "Cancelling" : "Finishing";
+    }
+
+    const size_t current = myCurrentTask.load();
+    if (current >= myTasks.size()) {
+        return "Finishing";
+    }
+
+    std::string text;
+    if (myTasks.size() > 1) {
+        text = "[" + std::to_string(current + 1) + "/" + std::to_string(myTasks.size()) + "] ";
+    }
+    const Task& task = myTasks[current];
+    text += task.name.empty() ? task.shapeId : task.name;
+    const std::string stage = myProgress.getStage();
+    return stage.empty() ? text : text + ": " + stage;
+}
+
+void MeshingJob::run()
+{
+    for (size_t i = 0; i < myTasks.size() && !myIsCancelled.load(); ++i) {
+        myProgress.setStage("");
+        myProgress.setFraction(0.0);
+        myCurrentTask.store(i);
+
+        Task& task = myTasks[i];
+        try {
+            task.isMeshed = myMesher.mesh(task.shape, task.result, &myProgress);
+        }
+        catch (const std::exception& e) {
+            getMeshingJobLogger()->error("Exception while meshing '{}': {}", task.shapeId, e.what());
+        }
+        catch (...) {
+            getMeshingJobLogger()->error("Unknown exception while meshing '{}'", task.shapeId);
+        }
+        if (!task.isMeshed && !myIsCancelled.load()) {
+            getMeshingJobLogger()->error("Failed to mesh '{}'", task.shapeId);
+        }
+    }
+    myCurrentTask.store(myTasks.size());
+    myIsFinished.store(true);
+}
+
+std::vector<std::string> MeshingJob::commit(UnifiedModel& model)
+{
+    if (myWorker.joinable()) {
+        myWorker.join();
+    }
+
+    std::vector<std::string> meshIds;
+    if (myIsCancelled.load()) {
+        getMeshingJobLogger()->info("Meshing cancelled, no mesh committed");
+        return meshIds;
+    }
+
+    // 网格实体放在形状旁边：相同的父节点和颜色，ID不与已有实体冲突
+    auto addNextToShape = [&model, &meshIds](const Task& task,
+                                             const std::string& suffix,
+                                             const std::string& label,
+                                             UnifiedModel::MeshData&& mesh) {
+        std::string meshId = task.shapeId + suffix;
+        for (int index = 2; model.getGeometryData(meshId) != nullptr; ++index) {
+            meshId = task.shapeId + suffix + std::to_string(index);
+        }
+        model.addMesh(meshId, std::move(mesh));
+        model.setColor(meshId, task.color);
+        model.setName(meshId, (task.name.empty() ? task.shapeId : task.name) + label);
+        if (!task.parentId.empty() && model.getGeometryData(task.parentId) != nullptr) {
+            model.setParent(meshId, task.parentId);
+        }
+        meshIds.push_back(meshId);
+    };
+
+    for (Task& task : myTasks) {
+        if (!task.isMeshed || task.result.surface.faces.rows() == 0) {
+            continue;
+        }
+        addNextToShape(task, "_mesh", " (mesh)", std::move(task.result.surface));
+
+        // 体网格作为单独的实体，每个四面体对应四个三角形
+        if (task.result.tetrahedra.rows() > 0) {
+            addNextToShape(task, "_volume", " (volume mesh)", ShapeMesher::makeVolumeMesh(task.result));
+            task.result.volumeNodes.resize(0, 3);
+            task.result.tetrahedra.resize(0, 4);
+        }
+    }
+
+    getMeshingJobLogger()->info("Committed {} of {} mesh(es)", meshIds.size(), myTasks.size());
+    return meshIds;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file MeshingJob.h
+ * @brief Defines the MeshingJob class which meshes shapes with Netgen on a background thread.
+ *
+ * The job copies the shapes of the requested SHAPE entities on the calling thread and
+ * meshes the copies on a worker thread, so the UI thread keeps rendering and the
+ * displayed shapes are never touched by Netgen. Once the worker has finished, the UI
+ * thread commits the generated meshes into the model as new MESH entities.
+ */
+#pragma once
+
+#include "ImportProgress.h"
+#include "ShapeMesher.h"
+#include "UnifiedModel.h"
+
+#include <Quantity_Color.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class MeshingJob
+ * @brief Asynchronous, cancellable Netgen meshing of one or more shapes.
+ */
+class MeshingJob {
+public:
+    /**
+     * @brief Constructor
+     *
+     * Entities that are not shapes are ignored.
+     *
+     * @param model The model holding the shapes (read on the calling thread only)
+     * @param shapeIds The SHAPE entities to mesh, in order
+     * @param options The size parameters of the meshes
+     */
+    MeshingJob(const UnifiedModel& model,
+               const std::vector<std::string>& shapeIds,
+               const ShapeMesher::Options& options = ShapeMesher::Options());
+
+    /**
+     * @brief Destructor; cancels a running meshing and waits for the worker to stop
+     */
+    ~MeshingJob();
+
+    MeshingJob(const MeshingJob&) = delete;
+    MeshingJob& operator=(const MeshingJob&) = delete;
+
+    /**
+     * @brief Starts the worker thread
+     */
+    void start();
+
+    /**
+     * @brief Requests cancellation; Netgen stops at its next check
+     */
+    void cancel();
+
+    /**
+     * @brief Checks whether the worker has finished (successfully or not)
+     * @return True if commit() can be called without blocking
+     */
+    bool isFinished() const { return myIsFinished.load(); }
+
+    /**
+     * @brief Checks whether cancellation was requested
+     * @return True if the job was cancelled
+     */
+    bool isCancelled() const { return myIsCancelled.load(); }
+
+    /**
+     * @brief Gets the number of shapes to mesh
+     * @return The number of SHAPE entities found in the constructor
+     */
+    size_t getShapeCount() const { return myTasks.size(); }
+
+    /**
+     * @brief Gets the overall completed fraction of all shapes
+     * @return Value in [0, 1]
+     */
+    double getFraction() const;
+
+    /**
+     * @brief Gets a short description of what the worker is doing
+     * @return Status text, e.g. "[1/2] Bracket: Surface meshing"
+     */
+    std::string getStatusText() const;
+
+    /**
+     * @brief Adds the generated meshes to the target model
+     *
+     * Each mesh becomes a MESH entity next to its shape (same parent and color), named
+     * after the shape. A volume mesh becomes a second MESH entity, "<shape>_volume", built
+     * by ShapeMesher::makeVolumeMesh(). Must be called on the thread that owns the target model, after
+     * isFinished() returned true. Waits for the worker if it is still running.
+     *
+     * @param model The model to add the meshes to
+     * @return std::vector<std::string> The IDs of the added MESH entities
+     */
+    std::vector<std::string> commit(UnifiedModel& model);
+
+private:
+    /**
+     * @brief A shape to mesh and its result
+     */
+    struct Task {
+        std::string shapeId;          ///< The meshed SHAPE entity
+        std::string name;             ///< Display name of the shape
+        std::string parentId;         ///< Parent of the shape
+        Quantity_Color color;         ///< Color of the shape
+        TopoDS_Shape shape;           ///< Private copy of the shape, read by the worker
+        ShapeMesher::Result result;   ///< Mesh filled by the worker
+        bool isMeshed = false;        ///< Whether the meshing succeeded
+    };
+
+    /**
+     * @brief Worker thread entry point
+     */
+    void run();
+
+    /** The mesher used for all shapes */
+    ShapeMesher myMesher;
+
+    /** The shapes to mesh */
+    std::vector<Task> myTasks;
+
+    /** Progress state of the shape being meshed */
+    ImportProgress myProgress;
+
+    /** Index of the shape being meshed */
+    std::atomic<size_t> myCurrentTask{0};
+
+    /** Set once the worker is done */
+    std::atomic<bool> myIsFinished{false};
+
+    /** Set when cancellation was requested */
+    std::atomic<bool> myIsCancelled{false};
+
+    /** The worker thread */
+    std::thread myWorker;
+};
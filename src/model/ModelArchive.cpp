@@ -0,0 +1,520 @@
+#include "ModelArchive.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Parallel.h"
+
+#include <BinTools_ShapeSet.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <map>
+#include <streambuf>
+#include <vector>
+
+// 创建模型存档日志记录器
+static std::shared_ptr<Utils::Logger>& getArchiveLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.archive");
+    return logger;
+}
+
+namespace
+{
+// 每个存档开头的魔数
+constexpr char MAGIC[8] = {'O', 'I', 'M', 'O', 'D', 'E', 'L', '\0'};
+
+// 当前版本写出的格式版本，更旧或更新的版本被拒绝
+constexpr std::uint32_t VERSION = 1;
+
+// 网格原始缓冲区的对齐，使其可以在映射中直接使用
+constexpr std::uint64_t ALIGNMENT = 64;
+
+// 文件开头的定长文件头（小端序，与所有支持的平台相同）
+struct ArchiveHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t entityCount;
+    std::uint64_t shapeSetOffset;
+    std::uint64_t shapeSetSize;
+    std::uint64_t tocOffset;
+    std::uint64_t tocSize;
+    char padding[8];
+};
+static_assert(sizeof(ArchiveHeader) == ALIGNMENT, "archive header must fill one alignment block");
+
+// 存档中一个网格原始缓冲区的位置
+struct BufferRecord
+{
+    std::uint64_t rows = 0;
+    std::uint64_t offset = 0;
+};
+
+// 映射文件上的只读流，位置为文件偏移
+class MappedStreamBuffer : public std::streambuf
+{
+public:
+    MappedStreamBuffer(const char* data, size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode) override
+    {
+        char* target = dir == std::ios_base::beg ? eback() + offset
+                      : dir == std::ios_base::cur ? gptr() + offset
+                                                     : egptr() + offset;
+        if (target < eback() || target > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), target, egptr());
+        return pos_type(off_type(target - eback()));
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode mode) override
+    {
+        return seekoff(off_type(position), std::ios_base::beg, mode);
+    }
+};
+
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& stream, T& value)
+{
+    return bool(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writeString(std::ostream& stream, const std::string& string)
+{
+    writeValue(stream, std::uint32_t(string.size()));
+    stream.write(string.data(), std::streamsize(string.size()));
+}
+
+bool readString(std::istream& stream, std::string& string)
+{
+    std::uint32_t length = 0;
+    if (!readValue(stream, length)) {
+        return false;
+    }
+    string.resize(length);
+    return length == 0 || bool(stream.read(&string[0], length));
+}
+
+void writeColor(std::ostream& stream, const Quantity_Color& color)
+{
+    writeValue(stream, color.Red());
+    writeValue(stream, color.Green());
+    writeValue(stream, color.Blue());
+}
+
+bool readColor(std::istream& stream, Quantity_Color& color)
+{
+    double rgb[3];
+    if (!readValue(stream, rgb)) {
+        return false;
+    }
+    color.SetValues(rgb[0], rgb[1], rgb[2], Quantity_TOC_RGB);
+    return true;
+}
+
+// 用零把流填充到ALIGNMENT的下一个整数倍
+std::uint64_t alignStream(std::ostream& stream)
+{
+    std::uint64_t position = std::uint64_t(stream.tellp());
+    static const char ZEROS[ALIGNMENT] = {};
+    const std::uint64_t padding = (ALIGNMENT - position % ALIGNMENT) % ALIGNMENT;
+    stream.write(ZEROS, std::streamsize(padding));
+    return position + padding;
+}
+
+// 在对齐的偏移处写出矩阵按列存储的原始数据
+template <typename Matrix>
+BufferRecord writeBuffer(std::ostream& stream, const Matrix& matrix)
+{
+    BufferRecord record;
+    record.rows = std::uint64_t(matrix.rows());
+    if (matrix.size() > 0 && matrix.cols() == 3) {
+        record.offset = alignStream(stream);
+        stream.write(reinterpret_cast<const char*>(matrix.data()),
+                        std::streamsize(matrix.size() * sizeof(typename Matrix::Scalar)));
+    }
+    else {
+        record.rows = 0;
+    }
+    return record;
+}
+
+// 从映射文件到网格缓冲区的一次待执行拷贝
+struct BufferCopy
+{
+    void* target;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+// 按缓冲区记录设置矩阵尺寸，并排队拷贝其内容
+template <typename Matrix>
+bool prepareBuffer(const BufferRecord& record,
+                   std::uint64_t fileSize,
+                   Matrix& matrix,
+                   std::vector<BufferCopy>& copies)
+{
+    if (record.rows > fileSize / (3 * sizeof(typename Matrix::Scalar))) {
+        return false;
+    }
+    const std::uint64_t size = record.rows * 3 * sizeof(typename Matrix::Scalar);
+    if (record.offset % ALIGNMENT != 0 || record.offset > fileSize
+        || size > fileSize - record.offset) {
+        return false;
+    }
+    matrix.resize(Eigen::Index(record.rows), 3);
+    if (size > 0) {
+        copies.push_back({matrix.data(), record.offset, size});
+    }
+    return true;
+}
+
+// 从目录读出、尚未加入模型的实体
+struct EntityRecord
+{
+    std::string id;
+    UnifiedModel::GeometryType type = UnifiedModel::GeometryType::SHAPE;
+    std::string parentId;
+    std::string name;
+    Quantity_Color color;
+    std::vector<std::string> layers;
+    std::string instanceKey;
+    TopoDS_Shape shape;
+    std::vector<std::pair<std::uint32_t, Quantity_Color>> subShapeColors;
+    UnifiedModel::MeshData mesh;
+};
+}  // namespace
+
+bool ModelArchive::save(const UnifiedModel& model, const std::string& filePath) const
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        getArchiveLogger()->error("Failed to create model archive: {}", filePath);
+        return false;
+    }
+
+    // 父节点在前、子节点按原顺序排列，读取时按此顺序重建层次结构
+    using Entity = std::pair<const std::string, UnifiedModel::GeometryData>;
+    std::vector<const Entity*> entities;
+    std::map<std::string, const Entity*> byId;
+    for (const auto& entity : model.getEntities()) {
+        byId.emplace(entity.first, &entity);
+    }
+    std::function<void(const std::string&)> appendEntity = [&](const std::string& id) {
+        auto it = byId.find(id);
+        if (it == byId.end()) {
+            return;
+        }
+        entities.push_back(it->second);
+        for (const std::string& childId : it->second->second.childIds) {
+            appendEntity(childId);
+        }
+    };
+    for (const std::string& rootId : model.getRootIds()) {
+        appendEntity(rootId);
+    }
+
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entityCount = entities.size();
+    writeValue(stream, header);
+
+    // 所有形体写入同一个形体集合，共享的TShape（装配实例）只存储一次，三角剖分一并保存
+    BinTools_ShapeSet shapeSet;
+    shapeSet.SetWithTriangles(Standard_True);
+    for (const auto* entity : entities) {
+        if (entity->second.type == UnifiedModel::GeometryType::SHAPE) {
+            shapeSet.Add(std::get<TopoDS_Shape>(entity->second.geometry));
+        }
+    }
+    header.shapeSetOffset = alignStream(stream);
+    shapeSet.Write(stream);
+    header.shapeSetSize = std::uint64_t(stream.tellp()) - header.shapeSetOffset;
+
+    // 网格缓冲区按MeshData的内存布局原样写入，并对齐到64字节
+    std::vector<std::array<BufferRecord, 5>> meshBuffers;
+    for (const auto* entity : entities) {
+        if (entity->second.type != UnifiedModel::GeometryType::MESH) {
+            continue;
+        }
+        const UnifiedModel::MeshData& mesh = *std::get<UnifiedModel::MeshDataPtr>(entity->second.geometry);
+        meshBuffers.push_back({writeBuffer(stream, mesh.vertices),
+                               writeBuffer(stream, mesh.faces),
+                               writeBuffer(stream, mesh.normals),
+                               writeBuffer(stream, mesh.vertexNormals),
+                               writeBuffer(stream, mesh.vertexColors)});
+    }
+
+    // 目录：层次结构、名称、颜色等属性，以及形体在形体集合中的引用
+    header.tocOffset = alignStream(stream);
+    size_t meshIndex = 0;
+    for (const auto* entity : entities) {
+        const UnifiedModel::GeometryData& data = entity->second;
+        writeString(stream, entity->first);
+        writeValue(stream, std::uint8_t(data.type));
+        writeString(stream, data.parentId);
+        writeString(stream, data.name);
+        writeColor(stream, data.color);
+        writeValue(stream, std::uint32_t(data.layers.size()));
+        for (const std::string& layer : data.layers) {
+            writeString(stream, layer);
+        }
+        writeString(stream, data.instanceKey);
+
+        if (data.type == UnifiedModel::GeometryType::SHAPE) {
+            const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data.geometry);
+            shapeSet.Write(shape, stream);
+
+            // 子形状颜色按其在未定位零件形状中的子形状序号保存
+            TopTools_IndexedMapOfShape subShapes;
+            if (!data.subShapeColors.empty()) {
+                TopExp::MapShapes(shape.Located(TopLoc_Location()), subShapes);
+            }
+            std::vector<std::pair<std::uint32_t, Quantity_Color>> subShapeColors;
+            for (const UnifiedModel::SubShapeColor& subShapeColor : data.subShapeColors) {
+                const int index = subShapes.FindIndex(subShapeColor.subShape);
+                if (index > 0) {
+                    subShapeColors.emplace_back(std::uint32_t(index), subShapeColor.color);
+                }
+            }
+            writeValue(stream, std::uint32_t(subShapeColors.size()));
+            for (const auto& subShapeColor : subShapeColors) {
+                writeValue(stream, subShapeColor.first);
+                writeColor(stream, subShapeColor.second);
+            }
+        }
+        else if (data.type == UnifiedModel::GeometryType::MESH) {
+            for (const BufferRecord& buffer : meshBuffers[meshIndex]) {
+                writeValue(stream, buffer);
+            }
+            ++meshIndex;
+        }
+    }
+    header.tocSize = std::uint64_t(stream.tellp()) - header.tocOffset;
+
+    stream.seekp(0);
+    writeValue(stream, header);
+    stream.close();
+    if (!stream) {
+        getArchiveLogger()->error("Failed to write model archive: {}", filePath);
+        return false;
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    getArchiveLogger()->info("Saved {} entities to '{}' ({:.1f} MB in {:.3f} s)",
+                             entities.size(),
+                             filePath,
+                             double(header.tocOffset + header.tocSize) / (1024.0 * 1024.0),
+                             seconds);
+    return true;
+}
+
+bool ModelArchive::load(const std::string& filePath, UnifiedModel& model) const
+{
+    return load(filePath, model, std::string());
+}
+
+bool ModelArchive::load(const std::string& filePath, UnifiedModel& model, const std::string& rootId) const
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    Utils::MappedFile file;
+    if (!file.open(filePath)) {
+        getArchiveLogger()->error("Failed to open model archive: {}", filePath);
+        return false;
+    }
+
+    ArchiveHeader header;
+    const std::uint64_t fileSize = file.size();
+    if (fileSize < sizeof(header)) {
+        getArchiveLogger()->error("Not a model archive: {}", filePath);
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        getArchiveLogger()->error("Not a model archive: {}", filePath);
+        return false;
+    }
+    if (header.version != VERSION) {
+        getArchiveLogger()->error("Unsupported model archive version {}: {}", header.version, filePath);
+        return false;
+    }
+    if (header.shapeSetOffset > fileSize || header.shapeSetSize > fileSize - header.shapeSetOffset
+        || header.tocOffset > fileSize || header.tocSize > fileSize - header.tocOffset) {
+        getArchiveLogger()->error("Truncated model archive: {}", filePath);
+        return false;
+    }
+
+    MappedStreamBuffer buffer(file.data(), file.size());
+    std::istream stream(&buffer);
+
+    BinTools_ShapeSet shapeSet;
+    try {
+        stream.seekg(std::streamoff(header.shapeSetOffset));
+        shapeSet.Read(stream);
+    }
+    catch (const Standard_Failure& error) {
+        getArchiveLogger()->error("Invalid shape data in '{}': {}", filePath, error.GetMessageString());
+        return false;
+    }
+
+    // 读取目录；网格只分配内存并记录待拷贝的缓冲区
+    std::vector<EntityRecord> records(header.entityCount <= fileSize ? size_t(header.entityCount) : 0);
+    std::vector<BufferCopy> copies;
+    bool isValid = records.size() == header.entityCount;
+    stream.seekg(std::streamoff(header.tocOffset));
+    for (EntityRecord& record : records) {
+        std::uint8_t type = 0;
+        std::uint32_t nbLayers = 0;
+        isValid = isValid && readString(stream, record.id) && readValue(stream, type)
+                  && type <= std::uint8_t(UnifiedModel::GeometryType::ASSEMBLY)
+                  && readString(stream, record.parentId) && readString(stream, record.name)
+                  && readColor(stream, record.color) && readValue(stream, nbLayers);
+        for (std::uint32_t i = 0; isValid && i < nbLayers; ++i) {
+            record.layers.emplace_back();
+            isValid = readString(stream, record.layers.back());
+        }
+        isValid = isValid && readString(stream, record.instanceKey);
+        if (!isValid) {
+            break;
+        }
+
+        record.type = UnifiedModel::GeometryType(type);
+        if (record.type == UnifiedModel::GeometryType::SHAPE) {
+            std::uint32_t nbColors = 0;
+            try {
+                shapeSet.Read(stream, record.shape);
+            }
+            catch (const Standard_Failure&) {
+                isValid = false;
+                break;
+            }
+            isValid = readValue(stream, nbColors);
+            for (std::uint32_t i = 0; isValid && i < nbColors; ++i) {
+                std::pair<std::uint32_t, Quantity_Color> subShapeColor;
+                isValid = readValue(stream, subShapeColor.first) && readColor(stream, subShapeColor.second);
+                record.subShapeColors.push_back(subShapeColor);
+            }
+        }
+        else if (record.type == UnifiedModel::GeometryType::MESH) {
+            BufferRecord buffers[5];
+            isValid = readValue(stream, buffers)
+                      && prepareBuffer(buffers[0], fileSize, record.mesh.vertices, copies)
+                      && prepareBuffer(buffers[1], fileSize, record.mesh.faces, copies)
+                      && prepareBuffer(buffers[2], fileSize, record.mesh.normals, copies)
+                      && prepareBuffer(buffers[3], fileSize, record.mesh.vertexNormals, copies)
+                      && prepareBuffer(buffers[4], fileSize, record.mesh.vertexColors, copies);
+        }
+        if (!isValid) {
+            break;
+        }
+    }
+    if (!isValid) {
+        getArchiveLogger()->error("Invalid table of contents in model archive: {}", filePath);
+        return false;
+    }
+
+    // 按需把根节点ID替换为新的ID（ID、父ID和实例键均以根节点ID为前缀）
+    if (!rootId.empty()) {
+        const size_t nbRoots = size_t(std::count_if(records.begin(), records.end(), [](const EntityRecord& record) {
+            return record.parentId.empty();
+        }));
+        if (nbRoots != 1 || !records.front().parentId.empty()) {
+            getArchiveLogger()->error("Model archive does not hold a single root: {}", filePath);
+            return false;
+        }
+        const std::string oldRootId = records.front().id;
+        auto rename = [&](std::string& id) {
+            if (id.compare(0, oldRootId.size(), oldRootId) == 0
+                && (id.size() == oldRootId.size() || id[oldRootId.size()] == '/' || id[oldRootId.size()] == ':')) {
+                id = rootId + id.substr(oldRootId.size());
+            }
+        };
+        for (EntityRecord& record : records) {
+            rename(record.id);
+            rename(record.parentId);
+            rename(record.instanceKey);
+        }
+    }
+
+    // 网格缓冲区与内存布局一致，直接从映射内存并行拷贝
+    const char* data = file.data();
+    Utils::parallelFor(0, copies.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::memcpy(copies[i].target, data + copies[i].offset, size_t(copies[i].size));
+        }
+    });
+
+    // 先在暂存模型中重建，成功后一次性合并
+    UnifiedModel staging;
+    for (EntityRecord& record : records) {
+        if (record.type == UnifiedModel::GeometryType::ASSEMBLY) {
+            staging.addAssembly(record.id, record.parentId);
+        }
+        else {
+            if (record.type == UnifiedModel::GeometryType::SHAPE) {
+                staging.addShape(record.id, record.shape);
+            }
+            else {
+                staging.addMesh(record.id, std::move(record.mesh));
+            }
+            if (!record.parentId.empty()) {
+                staging.setParent(record.id, record.parentId);
+            }
+        }
+        staging.setName(record.id, record.name);
+        staging.setColor(record.id, record.color);
+        if (!record.layers.empty()) {
+            staging.setLayers(record.id, record.layers);
+        }
+        if (!record.instanceKey.empty()) {
+            staging.setInstanceKey(record.id, record.instanceKey);
+        }
+        if (!record.subShapeColors.empty()) {
+            TopTools_IndexedMapOfShape subShapes;
+            TopExp::MapShapes(record.shape.Located(TopLoc_Location()), subShapes);
+            std::vector<UnifiedModel::SubShapeColor> subShapeColors;
+            for (const auto& subShapeColor : record.subShapeColors) {
+                if (subShapeColor.first >= 1 && int(subShapeColor.first) <= subShapes.Extent()) {
+                    subShapeColors.push_back({subShapes.FindKey(int(subShapeColor.first)), subShapeColor.second});
+                }
+            }
+            staging.setSubShapeColors(record.id, std::move(subShapeColors));
+        }
+    }
+    model.merge(std::move(staging));
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    getArchiveLogger()->info("Loaded {} entities from '{}' ({:.1f} MB in {:.3f} s)",
+                             records.size(),
+                             filePath,
+                             double(fileSize) / (1024.0 * 1024.0),
+                             seconds);
+    return true;
+}
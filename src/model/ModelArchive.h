@@ -0,0 +1,64 @@
+/**
+ * @file ModelArchive.h
+ * @brief Defines the ModelArchive class, the native binary file format of UnifiedModel.
+ *
+ * An archive stores everything needed to re-open a model without re-importing it:
+ * CAD shapes as one BinTools shape set (with triangulations, so nothing is re-meshed),
+ * mesh buffers as raw 64-byte aligned arrays in the in-memory layout of MeshData, and
+ * the hierarchy, names, colors, layers and instance keys in a table of contents.
+ *
+ * Layout: fixed header | shape set | mesh buffers | table of contents.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+
+#include <string>
+
+/**
+ * @class ModelArchive
+ * @brief Saves a UnifiedModel to, and loads it from, a memory-mapped archive file.
+ *
+ * Loading maps the file and copies the mesh buffers in parallel with plain memory copies;
+ * no text is parsed and no normals or triangulations are recomputed.
+ */
+class ModelArchive {
+public:
+    /** File extension of model archives (including the dot) */
+    static constexpr const char* FILE_EXTENSION = ".oimodel";
+
+    /**
+     * @brief Writes all entities of a model to an archive file
+     *
+     * @param model The model to save
+     * @param filePath The path of the archive file (overwritten if it exists)
+     * @return bool True if the archive was written
+     */
+    bool save(const UnifiedModel& model, const std::string& filePath) const;
+
+    /**
+     * @brief Reads an archive file into a model
+     *
+     * The entities are added to `model`; use UnifiedModel::clear() first to replace
+     * its content. Nothing is added if the archive is invalid.
+     *
+     * @param filePath The path of the archive file
+     * @param model The model that receives the entities
+     * @return bool True if the archive was read
+     */
+    bool load(const std::string& filePath, UnifiedModel& model) const;
+
+    /**
+     * @brief Reads an archive holding a single root entity under a new root ID
+     *
+     * The root ID is replaced in the IDs, parent IDs and instance keys of all entities,
+     * e.g. "part/2" becomes "<rootId>/2". Used to re-open cached imports under the ID
+     * of the current import.
+     *
+     * @param filePath The path of the archive file
+     * @param model The model that receives the entities
+     * @param rootId The new ID of the root entity
+     * @return bool True if the archive was read, false if it is invalid or has several roots
+     */
+    bool load(const std::string& filePath, UnifiedModel& model, const std::string& rootId) const;
+};
@@ -0,0 +1,845 @@
+#include "ModelExporter.h"
+#include "ImportProgress.h"
+#include "utils/JsonWriter.h"
+#include "utils/Logger.h"
+#include "utils/Parallel.h"
+
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <map>
+#include <set>
+#include <sstream>
+
+// 创建导出器日志记录器
+static std::shared_ptr<Utils::Logger>& getExporterLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.exporter");
+    return logger;
+}
+
+namespace
+{
+// 每个线程至少处理的元素数，较小的数组直接在当前线程转换
+constexpr size_t MIN_PARALLEL_ITEMS = size_t(1) << 14;
+
+// 二进制STL三角形记录的长度
+constexpr size_t STL_RECORD_SIZE = 50;
+
+// glTF的长度单位为米，模型为毫米
+constexpr double GLTF_LENGTH_SCALE = 0.001;
+
+// 按大块写出文件，后台线程写出上一块时填充下一块
+class BlockWriter
+{
+public:
+    explicit BlockWriter(size_t blockBytes)
+        : myBlockBytes(std::max<size_t>(blockBytes, size_t(1) << 16))
+    {
+        // 不做零初始化，块内容总是先填充后写出
+        myBuffers[0].reset(new char[myBlockBytes]);
+        myBuffers[1].reset(new char[myBlockBytes]);
+    }
+
+    ~BlockWriter() { waitPending(); }
+
+    bool open(const std::string& path)
+    {
+        myStream.open(path, std::ios::binary | std::ios::trunc);
+        return static_cast<bool>(myStream);
+    }
+
+    size_t getBlockBytes() const { return myBlockBytes; }
+
+    std::uint64_t getBytesWritten() const { return myBytesWritten; }
+
+    // 在当前块中预留size字节（不超过一块）
+    char* reserve(size_t size)
+    {
+        if (myFill + size > myBlockBytes) {
+            flush();
+        }
+        char* data = myBuffers[myCurrent].get() + myFill;
+        myFill += size;
+        return data;
+    }
+
+    // 当前块的剩余字节数
+    size_t getAvailable() const { return myBlockBytes - myFill; }
+
+    // 拷贝任意数据，必要时跨越多个块
+    void append(const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            if (getAvailable() == 0) {
+                flush();
+            }
+            const size_t count = std::min(size, getAvailable());
+            std::memcpy(reserve(count), bytes, count);
+            bytes += count;
+            size -= count;
+        }
+    }
+
+    // 把当前块交给后台线程写出并切换缓冲区
+    void flush()
+    {
+        waitPending();
+        if (myFill == 0) {
+            return;
+        }
+        const char* data = myBuffers[myCurrent].get();
+        const size_t size = myFill;
+        myPending = std::async(std::launch::async, [this, data, size]() {
+            myStream.write(data, static_cast<std::streamsize>(size));
+            return static_cast<bool>(myStream);
+        });
+        myBytesWritten += size;
+        myCurrent ^= 1;
+        myFill = 0;
+    }
+
+    bool finish()
+    {
+        flush();
+        waitPending();
+        myStream.close();
+        return !myHasFailed && !myStream.fail();
+    }
+
+private:
+    void waitPending()
+    {
+        if (myPending.valid() && !myPending.get()) {
+            myHasFailed = true;
+        }
+    }
+
+private:
+    std::ofstream myStream;
+    std::unique_ptr<char[]> myBuffers[2];
+    std::future<bool> myPending;
+    size_t myBlockBytes;
+    size_t myCurrent = 0;
+    size_t myFill = 0;
+    std::uint64_t myBytesWritten = 0;
+    bool myHasFailed = false;
+};
+
+// 向输出填充count个各占itemBytes字节的元素，每个块内并行填充
+// fill(first, last, out)把元素[first, last)转换到out
+template <typename Fill>
+void writeItems(BlockWriter& writer, size_t count, size_t itemBytes, Fill&& fill)
+{
+    size_t first = 0;
+    while (first < count) {
+        size_t nbItems = std::min(count - first, writer.getAvailable() / itemBytes);
+        if (nbItems == 0) {
+            writer.flush();
+            continue;
+        }
+        char* out = writer.reserve(nbItems * itemBytes);
+        Utils::parallelFor(0, nbItems, MIN_PARALLEL_ITEMS, [&](size_t begin, size_t end) {
+            fill(first + begin, first + end, out + begin * itemBytes);
+        });
+        first += nbItems;
+    }
+}
+
+inline void putFloats(char*& out, float x, float y, float z)
+{
+    const float values[3] = {x, y, z};
+    std::memcpy(out, values, sizeof(values));
+    out += sizeof(values);
+}
+
+// CAD零件的一个三角化面，使用零件自身的坐标
+struct FacePatch
+{
+    Handle(Poly_Triangulation) triangulation;
+    gp_Trsf transformation;
+    bool isReversed = false;
+    Quantity_Color color;
+    size_t firstNode = 0;
+    size_t firstTriangle = 0;
+};
+
+// 一个导出零件的几何：模型坐标下的网格，或零件自身坐标下的CAD面
+struct PartGeometry
+{
+    const UnifiedModel::MeshData* mesh = nullptr;
+    std::vector<FacePatch> patches;
+    std::string name;
+    Quantity_Color color;
+    size_t nbNodes = 0;
+    size_t nbTriangles = 0;
+    bool hasNormals = false;
+    bool hasColors = false;
+    float min[3] = {0.0f, 0.0f, 0.0f};
+    float max[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// 零件几何在模型中的放置
+struct PartInstance
+{
+    size_t geometry = 0;
+    gp_Trsf placement;
+};
+
+// 导出层次结构中的节点
+struct SceneNode
+{
+    std::string name;
+    std::vector<size_t> children;
+    int geometry = -1;
+    gp_Trsf placement;
+};
+
+// 导出的零件及其层次结构
+struct ExportScene
+{
+    std::vector<PartGeometry> geometries;
+    std::vector<PartInstance> instances;
+    std::vector<SceneNode> nodes;
+    std::vector<size_t> roots;
+    std::map<std::string, size_t> geometryByKey;
+    size_t nbMissingFaces = 0;
+};
+
+// 返回包含第index个元素（节点或三角形）的分片
+size_t findPatch(const std::vector<FacePatch>& patches, size_t index, bool byTriangle)
+{
+    auto iter = std::upper_bound(patches.begin(), patches.end(), index,
+                                   [byTriangle](size_t value, const FacePatch& patch) {
+                                       return value < (byTriangle ? patch.firstTriangle : patch.firstNode);
+                                   });
+    return size_t(iter - patches.begin()) - 1;
+}
+
+// 收集位于原点的CAD零件的三角化面
+void buildShapeGeometry(const TopoDS_Shape& part,
+                        const UnifiedModel::GeometryData& data,
+                        PartGeometry& geometry,
+                        size_t& nbMissingFaces)
+{
+    bool hasNormals = true;
+    for (TopExp_Explorer faceExp(part, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(faceExp.Current());
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull() || triangulation->NbTriangles() == 0) {
+            ++nbMissingFaces;
+            continue;
+        }
+
+        FacePatch patch;
+        patch.triangulation = triangulation;
+        patch.transformation = location.Transformation();
+        patch.isReversed = face.Orientation() == TopAbs_REVERSED;
+        patch.color = data.color;
+        patch.firstNode = geometry.nbNodes;
+        patch.firstTriangle = geometry.nbTriangles;
+        // 面颜色以未定位零件形状的子形状表达，按TShape匹配
+        for (const UnifiedModel::SubShapeColor& subShapeColor : data.subShapeColors) {
+            if (face.IsPartner(subShapeColor.subShape)) {
+                patch.color = subShapeColor.color;
+                geometry.hasColors = true;
+            }
+        }
+        geometry.nbNodes += size_t(triangulation->NbNodes());
+        geometry.nbTriangles += size_t(triangulation->NbTriangles());
+        hasNormals = hasNormals && triangulation->HasNormals();
+        geometry.patches.push_back(patch);
+    }
+    geometry.hasNormals = hasNormals && !geometry.patches.empty();
+}
+
+// 把实体及其子树加入场景
+void appendEntity(const UnifiedModel& model, const std::string& id, ExportScene& scene, int parent)
+{
+    const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+    if (data == nullptr) {
+        return;
+    }
+
+    const size_t nodeIndex = scene.nodes.size();
+    scene.nodes.emplace_back();
+    scene.nodes[nodeIndex].name = data->name.empty() ? id : data->name;
+    if (parent < 0) {
+        scene.roots.push_back(nodeIndex);
+    }
+    else {
+        scene.nodes[size_t(parent)].children.push_back(nodeIndex);
+    }
+
+    if (data->type == UnifiedModel::GeometryType::ASSEMBLY) {
+        for (const std::string& childId : data->childIds) {
+            appendEntity(model, childId, scene, int(nodeIndex));
+        }
+        return;
+    }
+
+    // 多次放置的零件共用一份几何，实例只记录位置
+    std::string key = "entity:" + id;
+    gp_Trsf placement;
+    TopoDS_Shape part;
+    if (data->type == UnifiedModel::GeometryType::SHAPE) {
+        const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data->geometry);
+        if (shape.IsNull()) {
+            return;
+        }
+        part = shape.Located(TopLoc_Location());
+        placement = shape.Location().Transformation();
+        if (!data->instanceKey.empty()) {
+            std::ostringstream stream;
+            stream << "shape:" << static_cast<const void*>(shape.TShape().get()) << ':'
+                    << int(shape.Orientation()) << ':' << data->color.Red() << ','
+                    << data->color.Green() << ',' << data->color.Blue() << ':'
+                    << data->subShapeColors.size();
+            key = stream.str();
+        }
+    }
+
+    auto inserted = scene.geometryByKey.emplace(key, scene.geometries.size());
+    if (inserted.second) {
+        PartGeometry geometry;
+        geometry.name = scene.nodes[nodeIndex].name;
+        geometry.color = data->color;
+        if (data->type == UnifiedModel::GeometryType::MESH) {
+            const UnifiedModel::MeshData& mesh = *std::get<UnifiedModel::MeshDataPtr>(data->geometry);
+            geometry.mesh = &mesh;
+            geometry.nbNodes = size_t(mesh.vertices.rows());
+            geometry.nbTriangles = size_t(mesh.faces.rows());
+            geometry.hasNormals = mesh.vertexNormals.rows() == mesh.vertices.rows();
+            geometry.hasColors = mesh.vertexColors.rows() == mesh.vertices.rows();
+        }
+        else {
+            buildShapeGeometry(part, *data, geometry, scene.nbMissingFaces);
+        }
+        if (geometry.nbTriangles == 0) {
+            scene.geometryByKey.erase(inserted.first);
+            return;
+        }
+        scene.geometries.push_back(std::move(geometry));
+    }
+
+    const size_t geometryIndex = inserted.first->second;
+    scene.nodes[nodeIndex].geometry = int(geometryIndex);
+    scene.nodes[nodeIndex].placement = placement;
+    scene.instances.push_back({geometryIndex, placement});
+}
+
+// 把几何的节点[begin, end)转换为浮点位置(x, y, z)
+void fillPositions(const PartGeometry& geometry, size_t begin, size_t end, char* out, double scale)
+{
+    if (geometry.mesh != nullptr) {
+        const Eigen::MatrixXd& vertices = geometry.mesh->vertices;
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = Eigen::Index(i);
+            putFloats(out,
+                      float(vertices(row, 0) * scale),
+                      float(vertices(row, 1) * scale),
+                      float(vertices(row, 2) * scale));
+        }
+        return;
+    }
+
+    size_t patchIndex = findPatch(geometry.patches, begin, false);
+    for (size_t i = begin; i < end; ++i) {
+        while (patchIndex + 1 < geometry.patches.size() && i >= geometry.patches[patchIndex + 1].firstNode) {
+            ++patchIndex;
+        }
+        const FacePatch& patch = geometry.patches[patchIndex];
+        const gp_Pnt point = patch.triangulation->Node(Standard_Integer(i - patch.firstNode) + 1)
+                                  .Transformed(patch.transformation);
+        putFloats(out, float(point.X() * scale), float(point.Y() * scale), float(point.Z() * scale));
+    }
+}
+
+// 把几何的节点法向[begin, end)转换为浮点数
+void fillNormals(const PartGeometry& geometry, size_t begin, size_t end, char* out)
+{
+    if (geometry.mesh != nullptr) {
+        const Eigen::MatrixXd& normals = geometry.mesh->vertexNormals;
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = Eigen::Index(i);
+            putFloats(out, float(normals(row, 0)), float(normals(row, 1)), float(normals(row, 2)));
+        }
+        return;
+    }
+
+    size_t patchIndex = findPatch(geometry.patches, begin, false);
+    for (size_t i = begin; i < end; ++i) {
+        while (patchIndex + 1 < geometry.patches.size() && i >= geometry.patches[patchIndex + 1].firstNode) {
+            ++patchIndex;
+        }
+        const FacePatch& patch = geometry.patches[patchIndex];
+        gp_Dir normal = patch.triangulation->Normal(Standard_Integer(i - patch.firstNode) + 1)
+                             .Transformed(patch.transformation);
+        if (patch.isReversed) {
+            normal.Reverse();
+        }
+        putFloats(out, float(normal.X()), float(normal.Y()), float(normal.Z()));
+    }
+}
+
+// 把几何的节点颜色[begin, end)转换为浮点数
+void fillColors(const PartGeometry& geometry, size_t begin, size_t end, char* out)
+{
+    if (geometry.mesh != nullptr) {
+        const Eigen::MatrixXd& colors = geometry.mesh->vertexColors;
+        for (size_t i = begin; i < end; ++i) {
+            const Eigen::Index row = Eigen::Index(i);
+            putFloats(out, float(colors(row, 0)), float(colors(row, 1)), float(colors(row, 2)));
+        }
+        return;
+    }
+
+    size_t patchIndex = findPatch(geometry.patches, begin, false);
+    for (size_t i = begin; i < end; ++i) {
+        while (patchIndex + 1 < geometry.patches.size() && i >= geometry.patches[patchIndex + 1].firstNode) {
+            ++patchIndex;
+        }
+        const Quantity_Color& color = geometry.patches[patchIndex].color;
+        putFloats(out, float(color.Red()), float(color.Green()), float(color.Blue()));
+    }
+}
+
+// 返回三角形朝外的节点索引
+inline void getTriangle(const PartGeometry& geometry, size_t& patchIndex, size_t triangle, size_t nodes[3])
+{
+    if (geometry.mesh != nullptr) {
+        const Eigen::MatrixXi& faces = geometry.mesh->faces;
+        const Eigen::Index row = Eigen::Index(triangle);
+        nodes[0] = size_t(faces(row, 0));
+        nodes[1] = size_t(faces(row, 1));
+        nodes[2] = size_t(faces(row, 2));
+        return;
+    }
+
+    while (patchIndex + 1 < geometry.patches.size()
+           && triangle >= geometry.patches[patchIndex + 1].firstTriangle) {
+        ++patchIndex;
+    }
+    const FacePatch& patch = geometry.patches[patchIndex];
+    Standard_Integer node1 = 0, node2 = 0, node3 = 0;
+    patch.triangulation->Triangle(Standard_Integer(triangle - patch.firstTriangle) + 1).Get(node1, node2, node3);
+    if (patch.isReversed) {
+        std::swap(node2, node3);
+    }
+    nodes[0] = patch.firstNode + size_t(node1) - 1;
+    nodes[1] = patch.firstNode + size_t(node2) - 1;
+    nodes[2] = patch.firstNode + size_t(node3) - 1;
+}
+
+// 返回几何在自身坐标下的一个节点
+inline gp_Pnt getNode(const PartGeometry& geometry, size_t patchIndex, size_t node)
+{
+    if (geometry.mesh != nullptr) {
+        const Eigen::Index row = Eigen::Index(node);
+        return gp_Pnt(geometry.mesh->vertices(row, 0),
+                      geometry.mesh->vertices(row, 1),
+                      geometry.mesh->vertices(row, 2));
+    }
+    const FacePatch& patch = geometry.patches[patchIndex];
+    return patch.triangulation->Node(Standard_Integer(node - patch.firstNode) + 1).Transformed(patch.transformation);
+}
+
+// 按写入glTF的位置计算每个几何的包围盒
+void computeBounds(ExportScene& scene)
+{
+    Utils::parallelFor(0, scene.geometries.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<char> buffer;
+        for (size_t g = begin; g < end; ++g) {
+            PartGeometry& geometry = scene.geometries[g];
+            std::fill(geometry.min, geometry.min + 3, std::numeric_limits<float>::max());
+            std::fill(geometry.max, geometry.max + 3, std::numeric_limits<float>::lowest());
+            // 按写出的浮点数计算，保证min/max与缓冲区内容一致
+            constexpr size_t BATCH = 4096;
+            buffer.resize(BATCH * 12);
+            for (size_t first = 0; first < geometry.nbNodes; first += BATCH) {
+                const size_t last = std::min(geometry.nbNodes, first + BATCH);
+                fillPositions(geometry, first, last, buffer.data(), GLTF_LENGTH_SCALE);
+                for (size_t i = 0; i < last - first; ++i) {
+                    float point[3];
+                    std::memcpy(point, buffer.data() + i * 12, sizeof(point));
+                    for (int c = 0; c < 3; ++c) {
+                        geometry.min[c] = std::min(geometry.min[c], point[c]);
+                        geometry.max[c] = std::max(geometry.max[c], point[c]);
+                    }
+                }
+            }
+        }
+    });
+}
+
+void appendJsonString(std::ostringstream& json, const std::string& text)
+{
+    Utils::JsonWriter::writeString(json, text);
+}
+
+// 追加列主序的glTF矩阵，平移换算为米
+void appendJsonMatrix(std::ostringstream& json, const gp_Trsf& trsf)
+{
+    json << "\"matrix\":[";
+    for (int column = 1; column <= 4; ++column) {
+        for (int row = 1; row <= 3; ++row) {
+            const double scale = column == 4 ? GLTF_LENGTH_SCALE : 1.0;
+            json << trsf.Value(row, column) * scale << ',';
+        }
+        json << (column == 4 ? "1" : "0") << (column == 4 ? "]" : ",");
+    }
+}
+
+std::string getLowerExtension(const std::string& filePath)
+{
+    std::string extension = std::filesystem::path(filePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension;
+}
+
+// 以模型坐标写出每个放置的三角形
+bool writeStl(const ExportScene& scene, const std::string& filePath, size_t blockBytes, ModelExporter::Stats& stats)
+{
+    std::uint64_t nbTriangles = 0;
+    for (const PartInstance& instance : scene.instances) {
+        nbTriangles += scene.geometries[instance.geometry].nbTriangles;
+    }
+    if (nbTriangles > std::numeric_limits<std::uint32_t>::max()) {
+        getExporterLogger()->error("Cannot export {} triangles to binary STL (limit is 2^32 - 1)", nbTriangles);
+        return false;
+    }
+
+    BlockWriter writer(blockBytes);
+    if (!writer.open(filePath)) {
+        getExporterLogger()->error("Failed to open file for writing: {}", filePath);
+        return false;
+    }
+
+    char header[80] = {};
+    std::strncpy(header, "Binary STL exported by OcctImgui", sizeof(header) - 1);
+    writer.append(header, sizeof(header));
+    const std::uint32_t count = static_cast<std::uint32_t>(nbTriangles);
+    writer.append(&count, sizeof(count));
+
+    for (const PartInstance& instance : scene.instances) {
+        const PartGeometry& geometry = scene.geometries[instance.geometry];
+        writeItems(writer, geometry.nbTriangles, STL_RECORD_SIZE, [&](size_t begin, size_t end, char* out) {
+            size_t patchIndex = geometry.mesh != nullptr ? 0 : findPatch(geometry.patches, begin, true);
+            for (size_t t = begin; t < end; ++t) {
+                size_t nodes[3];
+                getTriangle(geometry, patchIndex, t, nodes);
+                gp_Pnt points[3];
+                for (int c = 0; c < 3; ++c) {
+                    points[c] = getNode(geometry, patchIndex, nodes[c]).Transformed(instance.placement);
+                }
+
+                // 法向由放置后的三个角点计算，与读取器的约定一致
+                const gp_Vec cross = gp_Vec(points[0], points[1]).Crossed(gp_Vec(points[0], points[2]));
+                const double length = cross.Magnitude();
+                const gp_Vec normal = length > 0.0 ? cross / length : gp_Vec(0.0, 0.0, 0.0);
+                putFloats(out, float(normal.X()), float(normal.Y()), float(normal.Z()));
+                for (const gp_Pnt& point : points) {
+                    putFloats(out, float(point.X()), float(point.Y()), float(point.Z()));
+                }
+                out[0] = 0;
+                out[1] = 0;
+                out += 2;
+            }
+        });
+    }
+
+    if (!writer.finish()) {
+        getExporterLogger()->error("Failed to write file: {}", filePath);
+        return false;
+    }
+    stats.triangles = nbTriangles;
+    stats.bytesWritten = writer.getBytesWritten();
+    return true;
+}
+
+// 层次结构写为glTF节点，每个不同的几何只写入二进制块一次
+bool writeGlb(ExportScene& scene, const std::string& filePath, size_t blockBytes, ModelExporter::Stats& stats)
+{
+    computeBounds(scene);
+
+    // 二进制块布局：每个几何依次为位置、法向、颜色和索引，均按4字节对齐
+    struct GeometryLayout
+    {
+        std::uint64_t positions = 0;
+        std::uint64_t normals = 0;
+        std::uint64_t colors = 0;
+        std::uint64_t indices = 0;
+    };
+    std::vector<GeometryLayout> layouts(scene.geometries.size());
+    std::uint64_t binLength = 0;
+    std::uint64_t nbTriangles = 0;
+    for (size_t g = 0; g < scene.geometries.size(); ++g) {
+        const PartGeometry& geometry = scene.geometries[g];
+        if (geometry.nbNodes > std::numeric_limits<std::uint32_t>::max()) {
+            getExporterLogger()->error("Cannot export a part with {} nodes to glTF", geometry.nbNodes);
+            return false;
+        }
+        const std::uint64_t arrayBytes = std::uint64_t(geometry.nbNodes) * 12;
+        layouts[g].positions = binLength;
+        binLength += arrayBytes;
+        if (geometry.hasNormals) {
+            layouts[g].normals = binLength;
+            binLength += arrayBytes;
+        }
+        if (geometry.hasColors) {
+            layouts[g].colors = binLength;
+            binLength += arrayBytes;
+        }
+        layouts[g].indices = binLength;
+        binLength += std::uint64_t(geometry.nbTriangles) * 12;
+        nbTriangles += geometry.nbTriangles;
+    }
+
+    std::ostringstream json;
+    json.imbue(std::locale::classic());
+    json << std::setprecision(9);
+    json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"OcctImgui\"},\"scene\":0,";
+
+    // 根节点把模型坐标（Z轴向上）旋转为glTF约定（Y轴向上），长度单位在写出时换算为米
+    const size_t rootNode = scene.nodes.size();
+    json << "\"scenes\":[{\"nodes\":[" << rootNode << "]}],\"nodes\":[";
+    for (size_t n = 0; n < scene.nodes.size(); ++n) {
+        const SceneNode& node = scene.nodes[n];
+        json << "{\"name\":";
+        appendJsonString(json, node.name);
+        if (!node.children.empty()) {
+            json << ",\"children\":[";
+            for (size_t c = 0; c < node.children.size(); ++c) {
+                json << (c > 0 ? "," : "") << node.children[c];
+            }
+            json << ']';
+        }
+        if (node.geometry >= 0) {
+            json << ",\"mesh\":" << node.geometry;
+            if (node.placement.Form() != gp_Identity) {
+                json << ',';
+                appendJsonMatrix(json, node.placement);
+            }
+        }
+        json << "},";
+    }
+    json << "{\"name\":\"Root\",\"matrix\":[1,0,0,0,0,0,-1,0,0,1,0,0,0,0,0,1],\"children\":[";
+    for (size_t r = 0; r < scene.roots.size(); ++r) {
+        json << (r > 0 ? "," : "") << scene.roots[r];
+    }
+    json << "]}],";
+
+    // 每个几何一个网格、一个材质；访问器与缓冲视图一一对应
+    std::ostringstream accessors;
+    std::ostringstream views;
+    accessors.imbue(std::locale::classic());
+    accessors << std::setprecision(9);
+    size_t nbAccessors = 0;
+    auto addAccessor = [&](std::uint64_t offset, std::uint64_t length, size_t count, bool isIndex) {
+        if (nbAccessors > 0) {
+            accessors << ',';
+            views << ',';
+        }
+        views << "{\"buffer\":0,\"byteOffset\":" << offset << ",\"byteLength\":" << length
+               << ",\"target\":" << (isIndex ? 34963 : 34962) << '}';
+        accessors << "{\"bufferView\":" << nbAccessors << ",\"componentType\":" << (isIndex ? 5125 : 5126)
+                    << ",\"count\":" << count << ",\"type\":\"" << (isIndex ? "SCALAR" : "VEC3") << '"';
+        return nbAccessors++;
+    };
+
+    json << "\"meshes\":[";
+    std::ostringstream materials;
+    materials.imbue(std::locale::classic());
+    materials << std::setprecision(6);
+    for (size_t g = 0; g < scene.geometries.size(); ++g) {
+        const PartGeometry& geometry = scene.geometries[g];
+        const GeometryLayout& layout = layouts[g];
+        const std::uint64_t arrayBytes = std::uint64_t(geometry.nbNodes) * 12;
+
+        const size_t positions = addAccessor(layout.positions, arrayBytes, geometry.nbNodes, false);
+        accessors << ",\"min\":[" << geometry.min[0] << ',' << geometry.min[1] << ',' << geometry.min[2]
+                    << "],\"max\":[" << geometry.max[0] << ',' << geometry.max[1] << ',' << geometry.max[2] << "]}";
+        json << (g > 0 ? "," : "") << "{\"name\":";
+        appendJsonString(json, geometry.name);
+        json << ",\"primitives\":[{\"attributes\":{\"POSITION\":" << positions;
+        if (geometry.hasNormals) {
+            json << ",\"NORMAL\":" << addAccessor(layout.normals, arrayBytes, geometry.nbNodes, false);
+            accessors << '}';
+        }
+        if (geometry.hasColors) {
+            json << ",\"COLOR_0\":" << addAccessor(layout.colors, arrayBytes, geometry.nbNodes, false);
+            accessors << '}';
+        }
+        json << "},\"indices\":"
+              << addAccessor(layout.indices, std::uint64_t(geometry.nbTriangles) * 12, geometry.nbTriangles * 3, true);
+        accessors << '}';
+        json << ",\"material\":" << g << ",\"mode\":4}]}";
+
+        // Quantity_Color以线性RGB存储，与glTF的baseColorFactor一致
+        materials << (g > 0 ? "," : "") << "{\"pbrMetallicRoughness\":{\"baseColorFactor\":["
+                   << geometry.color.Red() << ',' << geometry.color.Green() << ',' << geometry.color.Blue()
+                   << ",1],\"metallicFactor\":0,\"roughnessFactor\":0.5}}";
+    }
+    json << "],\"materials\":[" << materials.str() << "],\"accessors\":[" << accessors.str()
+          << "],\"bufferViews\":[" << views.str() << "],\"buffers\":[{\"byteLength\":" << binLength << "}]}";
+
+    std::string jsonText = json.str();
+    jsonText.resize((jsonText.size() + 3) & ~size_t(3), ' ');
+    const std::uint64_t totalLength = 12 + 8 + jsonText.size() + 8 + binLength;
+    if (totalLength > std::numeric_limits<std::uint32_t>::max()) {
+        getExporterLogger()->error("Cannot export {} bytes to GLB (limit is 4 GB)", totalLength);
+        return false;
+    }
+
+    BlockWriter writer(blockBytes);
+    if (!writer.open(filePath)) {
+        getExporterLogger()->error("Failed to open file for writing: {}", filePath);
+        return false;
+    }
+
+    const std::uint32_t header[5] = {0x46546C67u,  // "glTF"
+                                      2u,
+                                      std::uint32_t(totalLength),
+                                      std::uint32_t(jsonText.size()),
+                                      0x4E4F534Au};  // "JSON"
+    writer.append(header, sizeof(header));
+    writer.append(jsonText.data(), jsonText.size());
+    const std::uint32_t binHeader[2] = {std::uint32_t(binLength), 0x004E4942u};  // "BIN"
+    writer.append(binHeader, sizeof(binHeader));
+
+    for (const PartGeometry& geometry : scene.geometries) {
+        writeItems(writer, geometry.nbNodes, 12, [&](size_t begin, size_t end, char* out) {
+            fillPositions(geometry, begin, end, out, GLTF_LENGTH_SCALE);
+        });
+        if (geometry.hasNormals) {
+            writeItems(writer, geometry.nbNodes, 12, [&](size_t begin, size_t end, char* out) {
+                fillNormals(geometry, begin, end, out);
+            });
+        }
+        if (geometry.hasColors) {
+            writeItems(writer, geometry.nbNodes, 12, [&](size_t begin, size_t end, char* out) {
+                fillColors(geometry, begin, end, out);
+            });
+        }
+        writeItems(writer, geometry.nbTriangles, 12, [&](size_t begin, size_t end, char* out) {
+            size_t patchIndex = geometry.mesh != nullptr ? 0 : findPatch(geometry.patches, begin, true);
+            for (size_t t = begin; t < end; ++t) {
+                size_t nodes[3];
+                getTriangle(geometry, patchIndex, t, nodes);
+                const std::uint32_t indices[3] = {std::uint32_t(nodes[0]),
+                                                    std::uint32_t(nodes[1]),
+                                                    std::uint32_t(nodes[2])};
+                std::memcpy(out, indices, sizeof(indices));
+                out += sizeof(indices);
+            }
+        });
+    }
+
+    if (!writer.finish()) {
+        getExporterLogger()->error("Failed to write file: {}", filePath);
+        return false;
+    }
+    stats.triangles = nbTriangles;
+    stats.bytesWritten = writer.getBytesWritten();
+    return true;
+}
+}  // namespace
+
+bool ModelExporter::exportModel(UnifiedModel& model, const std::string& filePath)
+{
+    return exportEntities(model, model.getRootIds(), filePath);
+}
+
+bool ModelExporter::exportEntities(UnifiedModel& model,
+                                   const std::vector<std::string>& ids,
+                                   const std::string& filePath)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const std::string extension = getLowerExtension(filePath);
+    if (extension != ".stl" && extension != ".glb") {
+        getExporterLogger()->error("Unsupported export format: {}", extension);
+        return false;
+    }
+
+    // 祖先也在导出列表中的实体随祖先一起导出，避免重复
+    const std::set<std::string> idSet(ids.begin(), ids.end());
+    std::vector<std::string> exportIds;
+    for (const std::string& id : ids) {
+        bool isCovered = false;
+        for (std::string parentId = model.getParentId(id); !parentId.empty(); parentId = model.getParentId(parentId)) {
+            if (idSet.count(parentId) > 0) {
+                isCovered = true;
+                break;
+            }
+        }
+        if (!isCovered && model.getGeometryData(id) != nullptr
+            && std::find(exportIds.begin(), exportIds.end(), id) == exportIds.end()) {
+            exportIds.push_back(id);
+        }
+    }
+    if (exportIds.empty()) {
+        getExporterLogger()->error("Nothing to export to {}", filePath);
+        return false;
+    }
+
+    // 尚未剖分的CAD形状先在模型中并行剖分，写出阶段只读取已有的三角剖分
+    ModelImporter importer;
+    ModelImporter::TessellationOptions tessellation = myOptions.tessellation;
+    tessellation.enabled = true;
+    importer.setTessellationOptions(tessellation);
+    ImportProgress progress;
+    for (const std::string& id : exportIds) {
+        importer.tessellateShapes(model, id, progress);
+    }
+
+    ExportScene scene;
+    for (const std::string& id : exportIds) {
+        appendEntity(model, id, scene, -1);
+    }
+    if (scene.nbMissingFaces > 0) {
+        getExporterLogger()->warn("Skipped {} faces without triangulation", scene.nbMissingFaces);
+    }
+    // 没有三角形的场景不写出：glTF不允许空的网格和缓冲区
+    if (scene.instances.empty()) {
+        getExporterLogger()->error("No triangles to export to {}", filePath);
+        return false;
+    }
+
+    Stats stats;
+    stats.parts = scene.instances.size();
+    const bool isWritten = extension == ".stl" ? writeStl(scene, filePath, myOptions.blockBytes, stats)
+                                               : writeGlb(scene, filePath, myOptions.blockBytes, stats);
+    if (!isWritten) {
+        std::error_code error;
+        std::filesystem::remove(filePath, error);
+        return false;
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    myLastStats = stats;
+    getExporterLogger()->info("Exported {} parts ({} triangles, {} bytes) to {} in {:.3f} s ({:.1f} MB/s)",
+                              stats.parts,
+                              stats.triangles,
+                              stats.bytesWritten,
+                              filePath,
+                              stats.seconds,
+                              stats.megabytesPerSecond());
+    return true;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ModelExporter.h
+ * @brief Defines the ModelExporter class which writes UnifiedModel geometry to mesh formats.
+ *
+ * Supported formats are binary STL and binary glTF (GLB). Mesh entities are written
+ * straight from their MeshData buffers; CAD shapes without a triangulation are
+ * tessellated in parallel first, then their face triangulations are written.
+ */
+#pragma once
+
+#include "ModelImporter.h"
+#include "UnifiedModel.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ModelExporter
+ * @brief Exports a whole model or a set of entities to binary STL or GLB.
+ *
+ * Output is produced in large blocks that are filled in parallel and written by a
+ * background thread while the next block is being filled, so exporting is bound by
+ * the disk rather than by the conversion.
+ *
+ * STL receives every placed triangle in model coordinates. GLB keeps the entity
+ * hierarchy as nodes, writes each part placed several times only once (instances
+ * become nodes with a transformation) and converts the model units (millimetres,
+ * Z up) to the glTF convention (metres, Y up).
+ */
+class ModelExporter {
+public:
+    /**
+     * @brief Options of an export
+     */
+    struct Options {
+        /** Tessellation applied to CAD shapes that have no triangulation yet */
+        ModelImporter::TessellationOptions tessellation;
+
+        /** Size of each output block in bytes (two blocks are in memory) */
+        size_t blockBytes = size_t(64) << 20;
+    };
+
+    /**
+     * @brief Statistics of the last export
+     */
+    struct Stats {
+        size_t parts = 0;                ///< Number of part entities written
+        std::uint64_t triangles = 0;     ///< Number of triangles written (instances counted once for GLB)
+        std::uint64_t bytesWritten = 0;  ///< Size of the output file
+        double seconds = 0.0;            ///< Wall-clock time including tessellation
+
+        /** @brief Gets the write throughput in MB/s */
+        double megabytesPerSecond() const {
+            return seconds > 0.0 ? double(bytesWritten) / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Exports all entities of a model
+     *
+     * CAD shapes without a triangulation are tessellated first. The triangulation is stored in the
+     * shapes of the model, so no other thread may read them during the export.
+     *
+     * @param model The model to export
+     * @param filePath The output file; its extension (.stl or .glb) selects the format
+     * @return bool True if the file was written, false on errors or if there are no triangles
+     */
+    bool exportModel(UnifiedModel& model, const std::string& filePath);
+
+    /**
+     * @brief Exports some entities of a model together with their sub-trees
+     *
+     * Entities that are descendants of other exported entities are written once. CAD shapes are
+     * tessellated in the model as in exportModel().
+     *
+     * @param model The model to export
+     * @param ids The IDs of the entities to export (e.g. the selection)
+     * @param filePath The output file; its extension (.stl or .glb) selects the format
+     * @return bool True if the file was written
+     */
+    bool exportEntities(UnifiedModel& model,
+                        const std::vector<std::string>& ids,
+                        const std::string& filePath);
+
+    /**
+     * @brief Sets the export options
+     * @param options The options
+     */
+    void setOptions(const Options& options) { myOptions = options; }
+
+    /**
+     * @brief Gets the export options
+     * @return The options
+     */
+    const Options& getOptions() const { return myOptions; }
+
+    /**
+     * @brief Gets the statistics of the last successful export
+     * @return The statistics
+     */
+    const Stats& getLastStats() const { return myLastStats; }
+
+    /**
+     * @brief Gets the supported file extensions
+     * @return std::vector<std::string> The extensions (lowercase, including the dot)
+     */
+    std::vector<std::string> getSupportedExtensions() const { return {".stl", ".glb"}; }
+
+private:
+    /** The export options */
+    Options myOptions;
+
+    /** Statistics of the last successful export */
+    Stats myLastStats;
+};
@@ -1,27 +1,63 @@
 #include "ModelImporter.h"
+#include "ObjReader.h"
+#include "PlyReader.h"
+#include "StlReader.h"
+#include "XdeModelBuilder.h"
 #include "utils/Logger.h"
+#include "utils/Parallel.h"
+#include "utils/ProcessMemory.h"
 
 // OpenCASCADE includes for STEP import
+#include <BRepBndLib.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
 #include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Interface_EntityIterator.hxx>
+#include <Interface_Graph.hxx>
+#include <Interface_InterfaceModel.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressRange.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
 #include <Poly_Triangulation.hxx>
+#include <RWGltf_CafReader.hxx>
+#include <STEPCAFControl_Reader.hxx>
 #include <STEPControl_Reader.hxx>
+#include <Standard_Version.hxx>
+#include <StepBasic_ProductDefinition.hxx>
+#include <StepRepr_NextAssemblyUsageOccurrence.hxx>
+#include <StepRepr_PropertyDefinition.hxx>
+#include <StepShape_ShapeDefinitionRepresentation.hxx>
+#include <TDocStd_Document.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopLoc_Location.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Face.hxx>
-
-
-// libigl includes for mesh import
-#include <igl/per_face_normals.h>
-#include <igl/readOBJ.h>
-#include <igl/read_triangle_mesh.h>
-
+#include <TopoDS_Iterator.hxx>
+#include <TransferBRep.hxx>
+#include <Transfer_TransientProcess.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XSControl_TransferReader.hxx>
+#include <XSControl_WorkSession.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
 
 
 // 创建导入器日志记录器
@@ -31,25 +67,227 @@ static std::shared_ptr<Utils::Logger>& getImporterLogger()
     return logger;
 }
 
+namespace
+{
+// 把OCCT的进度更新映射到ImportProgress的一个子区间
+class ImportProgressIndicator: public Message_ProgressIndicator
+{
+public:
+    ImportProgressIndicator(ImportProgress& progress, double from, double to)
+        : myProgress(progress)
+        , myFrom(from)
+        , myTo(to)
+    {}
+
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean) override
+    {
+        if (scope.Name() != nullptr) {
+            myProgress.setStage(scope.Name());
+        }
+        myProgress.setFraction(myFrom + (myTo - myFrom) * GetPosition());
+    }
+
+    Standard_Boolean UserBreak() override { return myProgress.isCancelled(); }
+
+private:
+    ImportProgress& myProgress;
+    double myFrom;
+    double myTo;
+};
+
+#if OCC_VERSION_HEX < 0x070600
+// OCCT 7.6之前的STEP解析器使用全局状态，所有STEP文件只能逐个解析
+std::mutex& getStepParserMutex()
+{
+    static std::mutex parserMutex;
+    return parserMutex;
+}
+#endif
+
+// 解析STEP文件；批量导入和并行转换会在多个线程上同时解析
+template <typename Reader>
+IFSelect_ReturnStatus readStepFile(Reader& reader, const std::string& filePath)
+{
+#if OCC_VERSION_HEX < 0x070600
+    std::lock_guard<std::mutex> lock(getStepParserMutex());
+#endif
+    return reader.ReadFile(filePath.c_str());
+}
+
+// 检查不同的根实体是否沿装配结构（NAUO）使用同一个产品定义，例如被多个顶层装配体使用的零件。
+// 只遍历已解析模型的实体图，不转换任何实体；不是形状定义的根实体不参与检查
+bool rootsShareProducts(STEPControl_Reader& reader)
+{
+    const Handle(Interface_InterfaceModel) stepModel = reader.Model();
+    const Interface_Graph& graph = reader.WS()->Graph();
+    std::vector<int> owners(size_t(stepModel->NbEntities()) + 1, 0);
+    for (int root = 1; root <= reader.NbRootsForTransfer(); ++root) {
+        const Handle(StepShape_ShapeDefinitionRepresentation) definition =
+            Handle(StepShape_ShapeDefinitionRepresentation)::DownCast(reader.RootForTransfer(root));
+        if (definition.IsNull() || definition->Definition().PropertyDefinition().IsNull()) {
+            continue;
+        }
+        std::vector<Handle(StepBasic_ProductDefinition)> stack{
+            definition->Definition().PropertyDefinition()->Definition().ProductDefinition()};
+        while (!stack.empty()) {
+            const Handle(StepBasic_ProductDefinition) product = stack.back();
+            stack.pop_back();
+            if (product.IsNull()) {
+                continue;
+            }
+            int& owner = owners[size_t(stepModel->Number(product))];
+            if (owner == root) {
+                continue;
+            }
+            if (owner != 0) {
+                return true;
+            }
+            owner = root;
+            for (Interface_EntityIterator it = graph.Sharings(product); it.More(); it.Next()) {
+                const Handle(StepRepr_NextAssemblyUsageOccurrence) usage =
+                    Handle(StepRepr_NextAssemblyUsageOccurrence)::DownCast(it.Value());
+                if (!usage.IsNull() && usage->RelatingProductDefinition() == product) {
+                    stack.push_back(usage->RelatedProductDefinition());
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// 在多个线程上转换STEP文件的根实体
+// 第一个工作线程使用调用方已解析的读取器，其余工作线程解析自己的文件副本，拥有独立的StepData模型、
+// 工作会话和转换过程，线程之间不共享可变数据。根实体逐个分发，少数大的根实体不会拖住其他线程。
+// 按根实体顺序填充形状（无法转换的为空）。不同线程转换的根实体引用同一个产生形状的实体时，该实体会被
+// 转换多次，形状不再共享，此时返回false，由调用方改为串行转换。共享的产品定义在启动工作线程之前检查，
+// 转换结果的检查只用于装配结构之外的共享
+bool transferRootsInParallel(STEPControl_Reader& reader,
+                             const std::string& filePath,
+                             ImportProgress& progress,
+                             double from,
+                             double to,
+                             std::vector<TopoDS_Shape>& shapes)
+{
+    if (rootsShareProducts(reader)) {
+        return false;
+    }
+
+    const int nbRoots = reader.NbRootsForTransfer();
+    shapes.assign(nbRoots, TopoDS_Shape());
+    std::atomic<int> nextRoot(0);
+    std::atomic<int> nbDone(0);
+    std::atomic<bool> isFailed(false);
+    const size_t nbWorkers = std::min<size_t>(size_t(nbRoots), Utils::getParallelThreadCount());
+    std::vector<std::unique_ptr<STEPControl_Reader>> ownReaders(nbWorkers);
+    std::vector<STEPControl_Reader*> workerReaders(nbWorkers, &reader);
+    Utils::parallelFor(0, nbWorkers, 1, [&](size_t begin, size_t end) {
+        for (size_t worker = begin; worker < end; ++worker) {
+            if (worker > 0) {
+                ownReaders[worker] = std::make_unique<STEPControl_Reader>();
+                workerReaders[worker] = ownReaders[worker].get();
+                if (readStepFile(*workerReaders[worker], filePath) != IFSelect_RetDone
+                    || workerReaders[worker]->NbRootsForTransfer() != nbRoots) {
+                    isFailed = true;
+                    continue;
+                }
+            }
+            STEPControl_Reader& workerReader = *workerReaders[worker];
+            for (int root = nextRoot++; root < nbRoots && !progress.isCancelled(); root = nextRoot++) {
+                const int nbShapesBefore = workerReader.NbShapes();
+                if (workerReader.TransferEntity(workerReader.RootForTransfer(root + 1))
+                    && workerReader.NbShapes() > nbShapesBefore) {
+                    shapes[root] = workerReader.Shape(workerReader.NbShapes());
+                }
+                progress.setFraction(from + (to - from) * double(++nbDone) / double(nbRoots));
+            }
+        }
+    });
+    if (isFailed) {
+        return false;
+    }
+
+    // 各副本中实体的编号相同，按编号检查产生形状的实体是否被多个线程转换
+    std::map<Standard_Integer, size_t> shapeOwners;
+    for (size_t worker = 0; worker < nbWorkers; ++worker) {
+        const Handle(Interface_InterfaceModel) workerModel = workerReaders[worker]->Model();
+        const Handle(Transfer_TransientProcess) process =
+            workerReaders[worker]->WS()->TransferReader()->TransientProcess();
+        if (process.IsNull()) {
+            continue;
+        }
+        for (Standard_Integer i = 1; i <= process->NbMapped(); ++i) {
+            if (TransferBRep::ShapeResult(process->MapItem(i)).IsNull()) {
+                continue;
+            }
+            auto inserted = shapeOwners.emplace(workerModel->Number(process->Mapped(i)), worker);
+            if (!inserted.second && inserted.first->second != worker) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 返回文件的字节数（无法读取时为0）
+std::uint64_t fileSize(const std::string& filePath)
+{
+    std::error_code error;
+    const auto size = std::filesystem::file_size(filePath, error);
+    return error ? 0 : std::uint64_t(size);
+}
+
+// 取走之前最多保留的导入记录数
+constexpr size_t MAX_IMPORT_RECORDS = 256;
+
+// 角度转换为弧度（M_PI不是标准C++）
+constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+
+// 把模型中一个子树的零件、三角形和顶点数累加到record
+void countImportedGeometry(const UnifiedModel& model, const std::string& rootId, ImportRecord& record)
+{
+    std::vector<std::string> stack{rootId};
+    while (!stack.empty()) {
+        const std::string id = std::move(stack.back());
+        stack.pop_back();
+        const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+        if (data == nullptr) {
+            continue;
+        }
+        if (data->type == UnifiedModel::GeometryType::MESH) {
+            const UnifiedModel::MeshData& mesh = *std::get<UnifiedModel::MeshDataPtr>(data->geometry);
+            record.triangles += std::uint64_t(mesh.faces.rows());
+            record.vertices += std::uint64_t(mesh.vertices.rows());
+            ++record.parts;
+        }
+        else if (data->type == UnifiedModel::GeometryType::SHAPE) {
+            const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data->geometry);
+            for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next()) {
+                TopLoc_Location location;
+                const Handle(Poly_Triangulation)& triangulation =
+                    BRep_Tool::Triangulation(TopoDS::Face(exp.Current()), location);
+                if (!triangulation.IsNull()) {
+                    record.triangles += std::uint64_t(triangulation->NbTriangles());
+                    record.vertices += std::uint64_t(triangulation->NbNodes());
+                }
+            }
+            ++record.parts;
+        }
+        const std::vector<std::string>& children = model.getChildIds(id);
+        stack.insert(stack.end(), children.begin(), children.end());
+    }
+}
+}  // namespace
+
 ModelImporter::ModelImporter()
 {
     // 注册导入函数
-    myImportFunctions[".step"] = std::bind(&ModelImporter::importStepFile,
-                                           this,
-                                           std::placeholders::_1,
-                                           std::placeholders::_2,
-                                           std::placeholders::_3);
-    myImportFunctions[".stp"] = myImportFunctions[".step"];
-    myImportFunctions[".stl"] = std::bind(&ModelImporter::importStlFile,
-                                          this,
-                                          std::placeholders::_1,
-                                          std::placeholders::_2,
-                                          std::placeholders::_3);
-    myImportFunctions[".obj"] = std::bind(&ModelImporter::importObjFile,
-                                          this,
-                                          std::placeholders::_1,
-                                          std::placeholders::_2,
-                                          std::placeholders::_3);
+    myImportFunctions[".step"] = &ModelImporter::importStepFile;
+    myImportFunctions[".stp"] = &ModelImporter::importStepFile;
+    myImportFunctions[".stl"] = &ModelImporter::importStlFile;
+    myImportFunctions[".obj"] = &ModelImporter::importObjFile;
+    myImportFunctions[".ply"] = &ModelImporter::importPlyFile;
+    myImportFunctions[".gltf"] = &ModelImporter::importGltfFile;
+    myImportFunctions[".glb"] = &ModelImporter::importGltfFile;
 
     getImporterLogger()->info("ModelImporter initialized with {} supported formats",
                               myImportFunctions.size());
@@ -58,6 +296,15 @@ ModelImporter::ModelImporter()
 bool ModelImporter::importModel(const std::string& filePath,
                                 UnifiedModel& model,
                                 const std::string& modelId)
+{
+    ImportProgress progress;
+    return importModel(filePath, model, modelId, progress);
+}
+
+bool ModelImporter::importModel(const std::string& filePath,
+                                UnifiedModel& model,
+                                const std::string& modelId,
+                                ImportProgress& progress)
 {
     // 获取文件扩展名（转为小写）
     std::string extension = getFileExtension(filePath);
@@ -74,8 +321,318 @@ bool ModelImporter::importModel(const std::string& filePath,
         return false;
     }
 
-    // 调用导入函数
-    return (this->*it->second)(filePath, model, effectiveModelId);
+    progress.setFraction(0.0);
+    progress.takeStageTimings();
+
+    // 没有其他导入同时运行时重置内存峰值，峰值即为本次导入的峰值
+    ImportRecord record;
+    record.filePath = filePath;
+    record.modelId = effectiveModelId;
+    record.format = extension;
+    record.timestamp =
+        std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    record.fileBytes = fileSize(filePath);
+    if (myActiveImports.fetch_add(1) == 0) {
+        Utils::resetPeakResidentBytes();
+    }
+    record.residentBytesBefore = Utils::getResidentBytes();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    bool result = false;
+    try {
+        result = importFile(filePath, model, effectiveModelId, it->second, progress, record);
+    }
+    catch (...) {
+        myActiveImports.fetch_sub(1);
+        throw;
+    }
+
+    record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    record.peakResidentBytes = Utils::getPeakResidentBytes();
+    myActiveImports.fetch_sub(1);
+    record.cancelled = progress.isCancelled();
+    record.succeeded = result && !record.cancelled;
+    record.stages = progress.takeStageTimings();
+    if (record.succeeded) {
+        countImportedGeometry(model, effectiveModelId, record);
+    }
+    getImporterLogger()->debug("Import record of '{}': {:.3f} s, {} stages, {} triangles ({:.1f} MB/s)",
+                               filePath,
+                               record.seconds,
+                               record.stages.size(),
+                               record.triangles,
+                               record.megabytesPerSecond());
+    {
+        std::lock_guard<std::mutex> lock(myImportRecordsMutex);
+        myImportRecords.push_back(std::move(record));
+        if (myImportRecords.size() > MAX_IMPORT_RECORDS) {
+            myImportRecords.pop_front();
+        }
+    }
+
+    if (progress.isCancelled()) {
+        getImporterLogger()->warn("Import of '{}' was cancelled", filePath);
+        return false;
+    }
+    if (result) {
+        progress.setStage("Done");
+        progress.setFraction(1.0);
+    }
+    return result;
+}
+
+bool ModelImporter::importFile(const std::string& filePath,
+                               UnifiedModel& model,
+                               const std::string& modelId,
+                               ImportFunction function,
+                               ImportProgress& progress,
+                               ImportRecord& record)
+{
+    // 先查询导入缓存，命中时直接加载预处理过的几何
+    std::string cacheKey;
+    if (myImportCache) {
+        progress.setStage("Checking import cache");
+        ImportStageTimer timer(progress, "cache lookup");
+        cacheKey = myImportCache->makeKey(filePath, getCacheSettings(getFileExtension(filePath)));
+        if (!cacheKey.empty() && myImportCache->load(cacheKey, model, modelId)) {
+            getImporterLogger()->info("Loaded '{}' from the import cache", filePath);
+            record.cacheHit = true;
+            return true;
+        }
+    }
+
+    // 调用导入函数；启用缓存时先导入到暂存模型，以便只把本次导入的实体写入缓存
+    if (cacheKey.empty()) {
+        return (this->*function)(filePath, model, modelId, progress);
+    }
+    UnifiedModel staging;
+    const bool result = (this->*function)(filePath, staging, modelId, progress);
+    if (result && !progress.isCancelled()) {
+        {
+            ImportStageTimer timer(progress, "cache store");
+            myImportCache->store(cacheKey, staging);
+        }
+        ImportStageTimer timer(progress, "merge");
+        timer.setElements(staging.getEntityCount());
+        model.merge(std::move(staging));
+    }
+    return result;
+}
+
+std::vector<ImportRecord> ModelImporter::takeImportRecords()
+{
+    std::lock_guard<std::mutex> lock(myImportRecordsMutex);
+    std::vector<ImportRecord> records(std::make_move_iterator(myImportRecords.begin()),
+                                      std::make_move_iterator(myImportRecords.end()));
+    myImportRecords.clear();
+    return records;
+}
+
+ModelImporter::BatchResult ModelImporter::readBatch(const std::vector<std::string>& filePaths,
+                                                    const BatchOptions& options,
+                                                    const std::vector<ImportProgress*>& progresses)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const size_t nbFiles = filePaths.size();
+
+    BatchResult result;
+    result.filePaths = filePaths;
+    result.stagingModels = std::vector<UnifiedModel>(nbFiles);
+    result.succeeded.assign(nbFiles, 0);
+    result.stats.filesRequested = nbFiles;
+
+    // 批次内同名文件追加序号，保证模型ID唯一
+    std::vector<std::string> modelIds(nbFiles);
+    std::map<std::string, int> usedIds;
+    for (size_t i = 0; i < nbFiles; ++i) {
+        const std::string baseId = getFileName(filePaths[i]);
+        const int count = ++usedIds[baseId];
+        modelIds[i] = count == 1 ? baseId : baseId + "_" + std::to_string(count);
+    }
+
+    // 按文件大小从大到小调度，减少并行尾部的等待
+    std::vector<std::uint64_t> fileSizes(nbFiles, 0);
+    for (size_t i = 0; i < nbFiles; ++i) {
+        fileSizes[i] = fileSize(filePaths[i]);
+    }
+    std::vector<size_t> order(nbFiles);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&fileSizes](size_t a, size_t b) {
+        return fileSizes[a] > fileSizes[b];
+    });
+
+    unsigned int nbWorkers = options.workerCount;
+    if (nbWorkers == 0) {
+        nbWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    nbWorkers = static_cast<unsigned int>(std::min<size_t>(nbWorkers, std::max<size_t>(nbFiles, 1)));
+
+    std::mutex mutex;
+    std::condition_variable budgetReleased;
+    size_t nextFile = 0;
+    std::uint64_t bytesInFlight = 0;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t index = 0;
+            {
+                // 等待内存预算：正在读取的文件总大小不超过预算（单个超大文件单独读取）
+                std::unique_lock<std::mutex> lock(mutex);
+                budgetReleased.wait(lock, [&]() {
+                    return nextFile >= nbFiles || bytesInFlight == 0
+                        || bytesInFlight + fileSizes[order[nextFile]] <= options.memoryBudgetBytes;
+                });
+                if (nextFile >= nbFiles) {
+                    return;
+                }
+                index = order[nextFile++];
+                bytesInFlight += fileSizes[index];
+            }
+
+            ImportProgress localProgress;
+            ImportProgress& progress =
+                index < progresses.size() && progresses[index] != nullptr ? *progresses[index]
+                                                                          : localProgress;
+            try {
+                result.succeeded[index] =
+                    importModel(filePaths[index], result.stagingModels[index], modelIds[index], progress);
+            }
+            catch (const std::exception& e) {
+                getImporterLogger()->error("Exception while importing '{}': {}", filePaths[index], e.what());
+            }
+            catch (...) {
+                getImporterLogger()->error("Unknown exception while importing '{}'", filePaths[index]);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                bytesInFlight -= fileSizes[index];
+            }
+            budgetReleased.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < nbWorkers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < nbFiles; ++i) {
+        if (!result.succeeded[i]) {
+            continue;
+        }
+        ++result.stats.filesImported;
+        result.stats.bytesRead += fileSizes[i];
+        if (myIsMeshRepairEnabled) {
+            std::lock_guard<std::mutex> lock(myRepairReportsMutex);
+            const auto report = myRepairReports.find(modelIds[i]);
+            if (report != myRepairReports.end() && report->second.hasChanges()) {
+                ++result.stats.meshesRepaired;
+            }
+        }
+        for (const auto& entity : result.stagingModels[i].getEntities()) {
+            if (entity.second.type != UnifiedModel::GeometryType::ASSEMBLY) {
+                ++result.stats.partsImported;
+            }
+        }
+    }
+    result.stats.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    getImporterLogger()->info("Read {} of {} files with {} workers in {:.3f} s",
+                              result.stats.filesImported,
+                              nbFiles,
+                              nbWorkers,
+                              result.stats.seconds);
+    return result;
+}
+
+size_t ModelImporter::commitBatch(BatchResult& result, UnifiedModel& model) const
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // 先在暂存模型中汇总，再一次性合并到目标模型
+    UnifiedModel combined;
+    size_t nbCommitted = 0;
+    for (size_t i = 0; i < result.stagingModels.size(); ++i) {
+        if (!result.succeeded[i]) {
+            continue;
+        }
+        combined.merge(std::move(result.stagingModels[i]));
+        ++nbCommitted;
+    }
+
+    const size_t nbEntities = combined.getEntityCount();
+    const size_t nbMerged = model.merge(std::move(combined)).size();
+    if (nbMerged < nbEntities) {
+        getImporterLogger()->warn("Skipped {} entities whose IDs already exist in the model",
+                                  nbEntities - nbMerged);
+    }
+
+    result.stats.seconds +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    getImporterLogger()->info(
+        "Batch import: {} files, {} parts, {:.1f} MB in {:.3f} s ({:.1f} MB/s, {:.1f} parts/s)",
+        result.stats.filesImported,
+        result.stats.partsImported,
+        double(result.stats.bytesRead) / (1024.0 * 1024.0),
+        result.stats.seconds,
+        result.stats.megabytesPerSecond(),
+        result.stats.partsPerSecond());
+    return nbCommitted;
+}
+
+ModelImporter::BatchStats ModelImporter::importBatch(const std::vector<std::string>& filePaths,
+                                                     UnifiedModel& model,
+                                                     const BatchOptions& options)
+{
+    BatchResult result = readBatch(filePaths, options);
+    commitBatch(result, model);
+    return result.stats;
+}
+
+ModelImporter::BatchStats ModelImporter::importDirectory(const std::string& directory,
+                                                         UnifiedModel& model,
+                                                         const BatchOptions& options,
+                                                         bool recursive)
+{
+    return importBatch(collectSupportedFiles(directory, recursive), model, options);
+}
+
+std::vector<std::string> ModelImporter::collectSupportedFiles(const std::string& directory,
+                                                              bool recursive) const
+{
+    std::vector<std::string> files;
+    std::error_code error;
+
+    auto addIfSupported = [&](const std::filesystem::directory_entry& entry) {
+        if (entry.is_regular_file()
+            && myImportFunctions.count(getFileExtension(entry.path().string())) > 0) {
+            files.push_back(entry.path().string());
+        }
+    };
+
+    if (recursive) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            addIfSupported(entry);
+        }
+    }
+    else {
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            addIfSupported(entry);
+        }
+    }
+
+    if (error) {
+        getImporterLogger()->error("Failed to scan directory '{}': {}", directory, error.message());
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
 }
 
 std::vector<std::string> ModelImporter::getSupportedExtensions() const
@@ -92,93 +649,562 @@ std::vector<std::string> ModelImporter::getSupportedExtensions() const
 
 bool ModelImporter::importStepFile(const std::string& filePath,
                                    UnifiedModel& model,
-                                   const std::string& modelId)
+                                   const std::string& modelId,
+                                   ImportProgress& progress)
+{
+    if (myStepReaderMode == StepReaderMode::XDE) {
+        return importStepFileXde(filePath, model, modelId, progress);
+    }
+    return importStepFileBasic(filePath, model, modelId, progress);
+}
+
+bool ModelImporter::importStepFileXde(const std::string& filePath,
+                                      UnifiedModel& model,
+                                      const std::string& modelId,
+                                      ImportProgress& progress)
+{
+    getImporterLogger()->info("Importing STEP file with XDE: {}", filePath);
+
+    progress.setStage("Reading STEP file");
+    ImportStageTimer readTimer(progress, "read");
+    STEPCAFControl_Reader reader;
+    reader.SetColorMode(true);
+    reader.SetNameMode(true);
+    reader.SetLayerMode(true);
+    if (readStepFile(reader, filePath) != IFSelect_RetDone) {
+        getImporterLogger()->error("Failed to read STEP file: {}", filePath);
+        return false;
+    }
+    readTimer.setBytes(fileSize(filePath));
+    readTimer.stop();
+
+    if (progress.isCancelled()) {
+        return false;
+    }
+
+    // 文档不注册到XCAFApp_Application，避免多个工作线程共享应用对象
+    Handle(TDocStd_Document) document = new TDocStd_Document("MDTV-XCAF");
+    XCAFDoc_DocumentTool::Set(document->Main(), Standard_False);
+
+    progress.setStage("Transferring STEP roots");
+    progress.setFraction(0.3);
+    ImportStageTimer transferTimer(progress, "transfer");
+    Handle(ImportProgressIndicator) indicator = new ImportProgressIndicator(progress, 0.3, 0.8);
+    if (!reader.Transfer(document, indicator->Start())) {
+        if (!progress.isCancelled()) {
+            getImporterLogger()->error("Failed to transfer STEP file: {}", filePath);
+        }
+        return false;
+    }
+    transferTimer.stop();
+    if (progress.isCancelled()) {
+        return false;
+    }
+
+    progress.setStage("Building assembly tree");
+    ImportStageTimer buildTimer(progress, "build tree");
+    XdeModelBuilder builder(model);
+    const int nbParts = builder.build(document, modelId);
+    buildTimer.setElements(std::uint64_t(std::max(0, nbParts)));
+    buildTimer.stop();
+    if (nbParts == 0) {
+        getImporterLogger()->error("No valid shape in STEP file: {}", filePath);
+        model.removeGeometry(modelId);
+        return false;
+    }
+
+    if (!tessellateShapes(model, modelId, progress, 0.8, 1.0)) {
+        model.removeGeometry(modelId);
+        return false;
+    }
+
+    getImporterLogger()->info("Successfully imported STEP model with ID: {} ({} parts, {} unique)",
+                              modelId,
+                              nbParts,
+                              builder.getUniquePartCount());
+    return true;
+}
+
+bool ModelImporter::importStepFileBasic(const std::string& filePath,
+                                        UnifiedModel& model,
+                                        const std::string& modelId,
+                                        ImportProgress& progress)
 {
     getImporterLogger()->info("Importing STEP file: {}", filePath);
 
-    // 使用OpenCASCADE的STEP读取器
+    // 使用OpenCASCADE的STEP读取器（解析阶段不提供进度，只标记阶段）
+    progress.setStage("Reading STEP file");
+    ImportStageTimer readTimer(progress, "read");
     STEPControl_Reader reader;
-    IFSelect_ReturnStatus status = reader.ReadFile(filePath.c_str());
+    IFSelect_ReturnStatus status = readStepFile(reader, filePath);
 
     if (status != IFSelect_RetDone) {
         getImporterLogger()->error("Failed to read STEP file: {}", filePath);
         return false;
     }
+    readTimer.setBytes(fileSize(filePath));
+    readTimer.stop();
 
-    // 转换所有根实体
-    reader.TransferRoots();
-    TopoDS_Shape shape = reader.OneShape();
+    if (progress.isCancelled()) {
+        return false;
+    }
 
-    if (shape.IsNull()) {
+    // 转换所有根实体，保留每个根实体的装配结构
+    // 多个相互独立的根实体可在多个线程上并行转换，否则通过OCCT进度指示器上报串行转换的进度
+    progress.setStage("Transferring STEP roots");
+    progress.setFraction(0.3);
+    ImportStageTimer transferTimer(progress, "transfer");
+    const auto transferStart = std::chrono::steady_clock::now();
+    bool isParallel = myStepTransferMode == StepTransferMode::PARALLEL
+                   && reader.NbRootsForTransfer() > 1
+                   && Utils::getParallelThreadCount() > 1;
+    std::vector<TopoDS_Shape> rootShapes;
+    if (isParallel && !transferRootsInParallel(reader, filePath, progress, 0.3, 0.8, rootShapes)) {
+        if (progress.isCancelled()) {
+            return false;
+        }
+        // 根实体共享子实体，串行转换才能让它们共享同一个形状；读取器中已转换的实体被重用
+        getImporterLogger()->info("STEP roots share entities, transferring serially: {}", filePath);
+        isParallel = false;
+        rootShapes.clear();
+        progress.setFraction(0.3);
+    }
+    if (isParallel) {
+        ++myParallelStepTransfers;
+    }
+    else {
+        Handle(ImportProgressIndicator) indicator = new ImportProgressIndicator(progress, 0.3, 0.8);
+        reader.ClearShapes();
+        reader.TransferRoots(indicator->Start());
+        for (int i = 1; i <= reader.NbShapes(); ++i) {
+            rootShapes.push_back(reader.Shape(i));
+        }
+    }
+    if (progress.isCancelled()) {
+        return false;
+    }
+    rootShapes.erase(std::remove_if(rootShapes.begin(), rootShapes.end(),
+                                    [](const TopoDS_Shape& shape) { return shape.IsNull(); }),
+                     rootShapes.end());
+    transferTimer.setElements(rootShapes.size());
+    transferTimer.stop();
+    getImporterLogger()->info("Transferred {} STEP roots in {:.3f} s ({})",
+                              rootShapes.size(),
+                              std::chrono::duration<double>(std::chrono::steady_clock::now() - transferStart).count(),
+                              isParallel ? "parallel" : "serial");
+
+    const int nbRoots = static_cast<int>(rootShapes.size());
+    if (nbRoots == 0) {
+        getImporterLogger()->error("No valid shape in STEP file: {}", filePath);
+        return false;
+    }
+
+    ImportStageTimer buildTimer(progress, "build tree");
+    int nbParts = 0;
+    if (nbRoots == 1) {
+        nbParts = addShapeHierarchy(rootShapes[0], model, modelId, "");
+    }
+    else {
+        // 多个根实体时，用一个顶层装配节点把它们组织起来
+        model.addAssembly(modelId);
+        for (int i = 1; i <= nbRoots; ++i) {
+            nbParts += addShapeHierarchy(rootShapes[i - 1], model, modelId + "/" + std::to_string(i), modelId);
+        }
+    }
+    buildTimer.setElements(std::uint64_t(nbParts));
+    buildTimer.stop();
+
+    if (nbParts == 0) {
         getImporterLogger()->error("No valid shape in STEP file: {}", filePath);
+        model.removeGeometry(modelId);
+        return false;
+    }
+
+    if (!tessellateShapes(model, modelId, progress, 0.8, 1.0)) {
+        model.removeGeometry(modelId);
         return false;
     }
 
-    // 添加形体到模型
-    model.addShape(modelId, shape);
-    getImporterLogger()->info("Successfully imported STEP model with ID: {}", modelId);
+    getImporterLogger()->info("Successfully imported STEP model with ID: {} ({} roots, {} parts)",
+                              modelId,
+                              nbRoots,
+                              nbParts);
 
     return true;
 }
 
+bool ModelImporter::tessellateShapes(UnifiedModel& model,
+                                     const std::string& rootId,
+                                     ImportProgress& progress,
+                                     double fromFraction,
+                                     double toFraction) const
+{
+    if (!myTessellationOptions.enabled) {
+        return true;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    progress.setStage("Tessellating shapes");
+    progress.setFraction(fromFraction);
+    ImportStageTimer timer(progress, "tessellate");
+
+    // 收集子树中的所有零件形状，同一个TShape（多次放置的零件）只剖分一次
+    std::vector<TopoDS_Shape> shapes;
+    std::set<const TopoDS_TShape*> visited;
+    std::vector<std::string> pending{rootId};
+    while (!pending.empty()) {
+        const std::string id = pending.back();
+        pending.pop_back();
+        const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+        if (data == nullptr) {
+            continue;
+        }
+        if (data->type == UnifiedModel::GeometryType::ASSEMBLY) {
+            pending.insert(pending.end(), data->childIds.begin(), data->childIds.end());
+        }
+        else if (data->type == UnifiedModel::GeometryType::SHAPE) {
+            const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data->geometry);
+            // 已有完整三角剖分的形状（例如再次导出时）不再剖分
+            if (!shape.IsNull() && visited.insert(shape.TShape().get()).second
+                && !BRepTools::Triangulation(shape, Precision::Infinite())) {
+                shapes.push_back(shape.Located(TopLoc_Location()));
+            }
+        }
+    }
+    if (shapes.empty()) {
+        return true;
+    }
+
+    // 零件较多时按零件并行，零件较少时在每个零件内部按面并行
+    const int nbShapes = static_cast<int>(shapes.size());
+    timer.setElements(std::uint64_t(nbShapes));
+    const bool isFaceParallel = nbShapes < OSD_Parallel::NbLogicalProcessors();
+    std::atomic<int> nbDone{0};
+
+    auto tessellate = [&](int index) {
+        if (progress.isCancelled()) {
+            return;
+        }
+
+        // 与Prs3d::GetDeflection相同的相对挠度定义：零件最大尺寸 * 系数 * 4
+        const TopoDS_Shape& shape = shapes[index];
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box, false);
+        if (box.IsVoid()) {
+            return;
+        }
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        const double size = std::max({xMax - xMin, yMax - yMin, zMax - zMin});
+
+        IMeshTools_Parameters parameters;
+        parameters.Deflection = std::max(size * myTessellationOptions.deviationCoefficient * 4.0,
+                                         Precision::Confusion());
+        parameters.Angle = myTessellationOptions.deviationAngleDeg * DEGREES_TO_RADIANS;
+        parameters.InParallel = isFaceParallel;
+        BRepMesh_IncrementalMesh mesher(shape, parameters);
+
+        const int done = ++nbDone;
+        progress.setFraction(fromFraction + (toFraction - fromFraction) * done / nbShapes);
+    };
+
+    if (isFaceParallel) {
+        for (int i = 0; i < nbShapes; ++i) {
+            tessellate(i);
+        }
+    }
+    else {
+        OSD_Parallel::For(0, nbShapes, tessellate);
+    }
+
+    if (progress.isCancelled()) {
+        return false;
+    }
+
+    getImporterLogger()->info(
+        "Tessellated {} unique shapes in {:.3f} s",
+        nbShapes,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    return true;
+}
+
+int ModelImporter::addShapeHierarchy(const TopoDS_Shape& shape,
+                                     UnifiedModel& model,
+                                     const std::string& id,
+                                     const std::string& parentId)
+{
+    if (shape.IsNull()) {
+        return 0;
+    }
+
+    if (shape.ShapeType() == TopAbs_COMPOUND) {
+        // TopoDS_Iterator默认累积位置和方向，子形体已处于装配中的最终位置
+        std::vector<TopoDS_Shape> children;
+        bool isAssembly = true;
+        for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+            const TopAbs_ShapeEnum childType = it.Value().ShapeType();
+            if (childType != TopAbs_COMPOUND && childType != TopAbs_COMPSOLID
+                && childType != TopAbs_SOLID && childType != TopAbs_SHELL) {
+                isAssembly = false;
+            }
+            children.push_back(it.Value());
+        }
+
+        if (children.empty()) {
+            return 0;
+        }
+
+        // 只有一个子节点的复合体直接折叠为该子节点
+        if (children.size() == 1 && isAssembly) {
+            return addShapeHierarchy(children.front(), model, id, parentId);
+        }
+
+        if (isAssembly) {
+            model.addAssembly(id, parentId);
+            int nbParts = 0;
+            for (size_t i = 0; i < children.size(); ++i) {
+                nbParts += addShapeHierarchy(children[i], model, id + "/" + std::to_string(i + 1), id);
+            }
+            return nbParts;
+        }
+    }
+
+    // 叶子节点：作为独立零件添加，拥有自己的显示和选择
+    model.addShape(id, shape);
+    if (!parentId.empty()) {
+        model.setParent(id, parentId);
+    }
+    return 1;
+}
+
 bool ModelImporter::importStlFile(const std::string& filePath,
                                   UnifiedModel& model,
-                                  const std::string& modelId)
+                                  const std::string& modelId,
+                                  ImportProgress& progress)
 {
     getImporterLogger()->info("Importing STL file: {}", filePath);
 
-    // 使用libigl读取STL文件
-    Eigen::MatrixXd vertices;
-    Eigen::MatrixXi faces;
-
-    if (!igl::read_triangle_mesh(filePath, vertices, faces)) {
-        getImporterLogger()->error("Failed to read STL file: {}", filePath);
+    // 内存映射读取，二进制STL按块并行解码到最终的网格缓冲区
+    UnifiedModel::MeshData mesh;
+    StlReader reader;
+    if (!reader.read(filePath, mesh, progress)) {
+        if (!progress.isCancelled()) {
+            getImporterLogger()->error("Failed to read STL file: {}", filePath);
+        }
         return false;
     }
 
-    // 计算法向量
-    Eigen::MatrixXd normals;
-    igl::per_face_normals(vertices, faces, Eigen::Vector3d(0, 0, 0), normals);
+    repairMesh(modelId, mesh, progress);
 
-    // 添加网格到模型
-    model.addMesh(modelId, vertices, faces, normals);
+    // 网格缓冲区直接移入模型，不再复制
+    const Eigen::Index nbVertices = mesh.vertices.rows();
+    const Eigen::Index nbFaces = mesh.faces.rows();
+    {
+        ImportStageTimer timer(progress, "add mesh");
+        timer.setElements(std::uint64_t(nbFaces));
+        model.addMesh(modelId, std::move(mesh));
+    }
     getImporterLogger()->info("Successfully imported STL model with ID: {} ({} vertices, {} faces)",
                               modelId,
-                              vertices.rows(),
-                              faces.rows());
+                              nbVertices,
+                              nbFaces);
 
     return true;
 }
 
 bool ModelImporter::importObjFile(const std::string& filePath,
                                   UnifiedModel& model,
-                                  const std::string& modelId)
+                                  const std::string& modelId,
+                                  ImportProgress& progress)
 {
     getImporterLogger()->info("Importing OBJ file: {}", filePath);
 
-    // 使用libigl读取OBJ文件
-    Eigen::MatrixXd vertices;
-    Eigen::MatrixXi faces;
-
-    if (!igl::readOBJ(filePath, vertices, faces)) {
-        getImporterLogger()->error("Failed to read OBJ file: {}", filePath);
+    // 内存映射后按行分块并行解析，记录直接写入最终的网格缓冲区
+    UnifiedModel::MeshData mesh;
+    ObjReader reader;
+    if (!reader.read(filePath, mesh, progress)) {
+        if (!progress.isCancelled()) {
+            getImporterLogger()->error("Failed to read OBJ file: {}", filePath);
+        }
         return false;
     }
 
-    // 计算法向量
-    Eigen::MatrixXd normals;
-    igl::per_face_normals(vertices, faces, Eigen::Vector3d(0, 0, 0), normals);
-
-    // 添加网格到模型
-    model.addMesh(modelId, vertices, faces, normals);
+    repairMesh(modelId, mesh, progress);
+    const Eigen::Index nbVertices = mesh.vertices.rows();
+    const Eigen::Index nbFaces = mesh.faces.rows();
+    {
+        ImportStageTimer timer(progress, "add mesh");
+        timer.setElements(std::uint64_t(nbFaces));
+        model.addMesh(modelId, std::move(mesh));
+    }
     getImporterLogger()->info("Successfully imported OBJ model with ID: {} ({} vertices, {} faces)",
                               modelId,
-                              vertices.rows(),
-                              faces.rows());
+                              nbVertices,
+                              nbFaces);
+
+    return true;
+}
+
+bool ModelImporter::importPlyFile(const std::string& filePath,
+                                  UnifiedModel& model,
+                                  const std::string& modelId,
+                                  ImportProgress& progress)
+{
+    getImporterLogger()->info("Importing PLY file: {}", filePath);
+
+    // 二进制PLY的定长记录直接从映射内存批量拷贝，保留顶点法向量和颜色
+    UnifiedModel::MeshData mesh;
+    PlyReader reader;
+    if (!reader.read(filePath, mesh, progress)) {
+        if (!progress.isCancelled()) {
+            getImporterLogger()->error("Failed to read PLY file: {}", filePath);
+        }
+        return false;
+    }
+
+    repairMesh(modelId, mesh, progress);
+    const Eigen::Index nbVertices = mesh.vertices.rows();
+    const Eigen::Index nbFaces = mesh.faces.rows();
+    {
+        ImportStageTimer timer(progress, "add mesh");
+        timer.setElements(std::uint64_t(nbFaces));
+        model.addMesh(modelId, std::move(mesh));
+    }
+    getImporterLogger()->info("Successfully imported PLY model with ID: {} ({} vertices, {} faces)",
+                              modelId,
+                              nbVertices,
+                              nbFaces);
+
+    return true;
+}
+
+bool ModelImporter::importGltfFile(const std::string& filePath,
+                                   UnifiedModel& model,
+                                   const std::string& modelId,
+                                   ImportProgress& progress)
+{
+    getImporterLogger()->info("Importing glTF file: {}", filePath);
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // 文档不注册到XCAFApp_Application，避免多个工作线程共享应用对象
+    Handle(TDocStd_Document) document = new TDocStd_Document("MDTV-XCAF");
+    XCAFDoc_DocumentTool::Set(document->Main(), Standard_False);
+
+    // 并行解码缓冲区；glTF为Y轴向上、单位为米，转换为与STEP一致的Z轴向上、毫米
+    progress.setStage("Reading glTF file");
+    ImportStageTimer readTimer(progress, "read");
+    readTimer.setBytes(fileSize(filePath));
+    RWGltf_CafReader reader;
+    reader.SetDocument(document);
+    reader.SetParallel(true);
+    reader.SetMeshNameAsFallback(true);
+    reader.SetSystemLengthUnit(0.001);
+    reader.SetSystemCoordinateSystem(RWMesh_CoordinateSystem_Zup);
+    Handle(ImportProgressIndicator) indicator = new ImportProgressIndicator(progress, 0.0, 0.8);
+    if (!reader.Perform(TCollection_AsciiString(filePath.c_str()), indicator->Start())) {
+        if (!progress.isCancelled()) {
+            getImporterLogger()->error("Failed to read glTF file: {}", filePath);
+        }
+        return false;
+    }
+    if (progress.isCancelled()) {
+        return false;
+    }
+
+    readTimer.stop();
 
+    progress.setStage("Building node tree");
+    progress.setFraction(0.8);
+    ImportStageTimer buildTimer(progress, "build tree");
+    XdeModelBuilder builder(model);
+    builder.setMeshConversion(true);
+    const int nbParts = builder.build(document, modelId);
+    buildTimer.setElements(std::uint64_t(std::max(0, nbParts)));
+    buildTimer.stop();
+    if (nbParts == 0) {
+        getImporterLogger()->error("No mesh in glTF file: {}", filePath);
+        model.removeGeometry(modelId);
+        return false;
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    getImporterLogger()->info("Imported glTF model with ID: {} ({} parts, {} unique, {} as meshes) in {:.3f} s",
+                              modelId,
+                              nbParts,
+                              builder.getUniquePartCount(),
+                              builder.getConvertedMeshCount(),
+                              seconds);
     return true;
 }
 
+void ModelImporter::repairMesh(const std::string& modelId, UnifiedModel::MeshData& mesh, ImportProgress& progress)
+{
+    if (!myIsMeshRepairEnabled) {
+        return;
+    }
+
+    progress.setStage("Repairing mesh");
+    ImportStageTimer timer(progress, "repair");
+    timer.setElements(std::uint64_t(mesh.faces.rows()));
+    const auto startTime = std::chrono::steady_clock::now();
+    const MeshProcessing::RepairReport report = MeshProcessing::repair(mesh);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (report.hasChanges()) {
+        getImporterLogger()->info(
+            "Repaired mesh '{}' in {:.3f} s: removed {} of {} faces ({} invalid, {} degenerate, "
+            "{} duplicate, {} on {} non-manifold edges), {} NaN vertices",
+            modelId,
+            seconds,
+            report.removedFaces(),
+            report.counts.facesBefore,
+            report.invalidFaces,
+            report.degenerateFaces,
+            report.duplicateFaces,
+            report.nonManifoldFaces,
+            report.nonManifoldEdges,
+            report.nonFiniteVertices);
+    }
+    else {
+        getImporterLogger()->debug("Mesh '{}' has no defects ({:.3f} s)", modelId, seconds);
+    }
+
+    std::lock_guard<std::mutex> lock(myRepairReportsMutex);
+    myRepairReports[modelId] = report;
+}
+
+std::map<std::string, MeshProcessing::RepairReport> ModelImporter::getRepairReports() const
+{
+    std::lock_guard<std::mutex> lock(myRepairReportsMutex);
+    return myRepairReports;
+}
+
+void ModelImporter::clearRepairReports()
+{
+    std::lock_guard<std::mutex> lock(myRepairReportsMutex);
+    myRepairReports.clear();
+}
+
+std::string ModelImporter::getCacheSettings(const std::string& extension) const
+{
+    // STEP导入受读取模式和三角剖分选项影响，网格文件受修复开关影响
+    std::string settings = "format=" + extension;
+    if (myIsMeshRepairEnabled && (extension == ".stl" || extension == ".obj" || extension == ".ply")) {
+        settings += ";repair=on";
+    }
+    if (extension == ".step" || extension == ".stp") {
+        settings += myStepReaderMode == StepReaderMode::XDE ? ";reader=xde" : ";reader=basic";
+        if (myTessellationOptions.enabled) {
+            settings += ";deviation=" + std::to_string(myTessellationOptions.deviationCoefficient)
+                      + ";angle=" + std::to_string(myTessellationOptions.deviationAngleDeg);
+        } else {
+            settings += ";tessellation=off";
+        }
+    }
+    return settings;
+}
+
 std::string ModelImporter::getFileExtension(const std::string& filePath) const
 {
     std::filesystem::path path(filePath);
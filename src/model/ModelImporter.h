@@ -3,25 +3,125 @@
  * @brief Defines the ModelImporter class for importing various 3D model formats.
  * 
  * The ModelImporter provides a unified interface for importing different 3D model formats
- * including STEP (CAD) files using OpenCASCADE and mesh files (STL, OBJ) using libigl.
+ * including STEP (CAD) and glTF files using OpenCASCADE and mesh files (STL, OBJ, PLY)
+ * using the memory-mapped StlReader, ObjReader and PlyReader.
  */
 #pragma once
 
 #include "UnifiedModel.h"
+#include "ImportCache.h"
+#include "ImportProgress.h"
+#include "ImportRecord.h"
+#include "MeshProcessing.h"
+#include <atomic>
+#include <deque>
 #include <string>
 #include <memory>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <vector>
+#include <cstdint>
 
 /**
  * @class ModelImporter
  * @brief A class that provides a unified interface for importing various 3D model formats.
  * 
  * This class handles the import of different 3D model formats based on file extensions.
- * It uses OpenCASCADE for STEP files and libigl for mesh files (STL, OBJ).
+ * It uses OpenCASCADE for STEP files and memory-mapped parallel readers for mesh files
+ * (STL, OBJ, PLY).
  */
 class ModelImporter {
 public:
+    /**
+     * @brief Reader used for STEP files
+     */
+    enum class StepReaderMode {
+        BASIC,  ///< STEPControl_Reader: geometry only
+        XDE     ///< STEPCAFControl_Reader: geometry with names, colors, layers and instancing
+    };
+    
+    /**
+     * @brief How the roots of a STEP file are transferred by the BASIC reader
+     */
+    enum class StepTransferMode {
+        SERIAL,   ///< One TransferRoots() call on the reading thread
+        PARALLEL  ///< Independent roots are transferred concurrently, one parsed copy of the file per thread
+    };
+    
+    /**
+     * @brief Options of the tessellation stage run after a CAD import
+     * 
+     * The deflections follow the conventions of Prs3d_Drawer, so the triangulation
+     * computed at import is the one AIS would otherwise compute when first displaying
+     * the shape.
+     */
+    struct TessellationOptions {
+        /** Whether CAD shapes are tessellated during import */
+        bool enabled = true;
+        
+        /** Linear deflection relative to the size of each part (Prs3d deviation coefficient) */
+        double deviationCoefficient = 0.001;
+        
+        /** Angular deflection in degrees */
+        double deviationAngleDeg = 20.0;
+    };
+    
+    /**
+     * @brief Options controlling a batch import
+     */
+    struct BatchOptions {
+        /** Maximum number of files read concurrently (0: one per hardware thread) */
+        unsigned int workerCount = 0;
+        
+        /**
+         * Upper bound for the total size of the files being read at the same time, in bytes.
+         * A single file larger than the budget is read on its own.
+         */
+        std::uint64_t memoryBudgetBytes = std::uint64_t(2) << 30;
+        
+        /** Whether mesh readers stream decoded triangles through ImportProgress for a preview */
+        bool streamPreview = false;
+        
+        /**
+         * Upper bound for the preview triangles of the whole batch, shared evenly by its files.
+         * Each preview triangle takes 48 bytes on top of the imported mesh.
+         */
+        size_t previewTriangleLimit = size_t(1) << 20;
+    };
+    
+    /**
+     * @brief Throughput statistics of a batch import
+     */
+    struct BatchStats {
+        size_t filesRequested = 0;  ///< Number of files passed to the batch
+        size_t filesImported = 0;   ///< Number of files read successfully
+        size_t partsImported = 0;   ///< Number of part entities (shapes and meshes) imported
+        size_t meshesRepaired = 0;  ///< Number of meshes changed by the repair stage
+        std::uint64_t bytesRead = 0;  ///< Total size of the files read successfully
+        double seconds = 0.0;       ///< Wall-clock time of reading and committing
+        
+        /** @brief Gets the read throughput in MB/s */
+        double megabytesPerSecond() const {
+            return seconds > 0.0 ? double(bytesRead) / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+        
+        /** @brief Gets the number of parts imported per second */
+        double partsPerSecond() const {
+            return seconds > 0.0 ? double(partsImported) / seconds : 0.0;
+        }
+    };
+    
+    /**
+     * @brief Files read by readBatch(), waiting to be committed into a model
+     */
+    struct BatchResult {
+        std::vector<std::string> filePaths;       ///< The files of the batch, in input order
+        std::vector<UnifiedModel> stagingModels;  ///< One staging model per file
+        std::vector<char> succeeded;              ///< Per-file success flag
+        BatchStats stats;                         ///< Statistics of the read phase
+    };
+    
     /**
      * @brief Default constructor
      */
@@ -42,43 +142,408 @@ public:
      */
     bool importModel(const std::string& filePath, UnifiedModel& model, const std::string& modelId = "");
     
+    /**
+     * @brief Imports a model from a file, reporting progress and honoring cancellation
+     * 
+     * This overload may run on a worker thread as long as the given model is not shared
+     * with other threads (e.g. a staging model that is merged on the UI thread later).
+     * 
+     * @param filePath The path to the model file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model (if empty, the filename will be used)
+     * @param progress Receives stage and fraction updates; cancelling it aborts the import
+     * @return bool True if import was successful, false on failure or cancellation
+     */
+    bool importModel(const std::string& filePath,
+                     UnifiedModel& model,
+                     const std::string& modelId,
+                     ImportProgress& progress);
+    
+    /**
+     * @brief Reads several files in parallel into staging models
+     * 
+     * Files are scheduled largest first on up to options.workerCount threads, while the
+     * total size of the files in flight is kept below options.memoryBudgetBytes. Each file
+     * is read into its own staging model, so this method never touches an application
+     * model and may itself run on a background thread. STEP files are parsed in parallel
+     * with OCCT 7.6 or later; older versions parse them one at a time, since their STEP
+     * parser is not re-entrant.
+     * 
+     * @param filePaths The files to read
+     * @param options Worker count and memory budget
+     * @param progresses Optional per-file progress objects (same order as filePaths)
+     * @return BatchResult The staging models and statistics, to be passed to commitBatch()
+     */
+    BatchResult readBatch(const std::vector<std::string>& filePaths,
+                          const BatchOptions& options,
+                          const std::vector<ImportProgress*>& progresses = {});
+    
+    /**
+     * @brief Merges the files of a batch into a model in a single commit
+     * 
+     * File IDs are made unique within the batch by readBatch(); entities whose ID already
+     * exists in the target model are skipped.
+     * 
+     * @param result The result of readBatch(); its staging models are consumed
+     * @param model The model to merge into
+     * @return size_t The number of files committed
+     */
+    size_t commitBatch(BatchResult& result, UnifiedModel& model) const;
+    
+    /**
+     * @brief Imports several files in parallel and merges them into a model
+     * 
+     * @param filePaths The files to import
+     * @param model The model to merge into
+     * @param options Worker count and memory budget
+     * @return BatchStats Throughput statistics of the whole batch
+     */
+    BatchStats importBatch(const std::vector<std::string>& filePaths,
+                           UnifiedModel& model,
+                           const BatchOptions& options);
+    
+    /**
+     * @brief Imports all supported files of a directory in parallel
+     * 
+     * @param directory The directory to scan
+     * @param model The model to merge into
+     * @param options Worker count and memory budget
+     * @param recursive Whether to scan sub-directories as well
+     * @return BatchStats Throughput statistics of the whole batch
+     */
+    BatchStats importDirectory(const std::string& directory,
+                               UnifiedModel& model,
+                               const BatchOptions& options,
+                               bool recursive = true);
+    
+    /**
+     * @brief Lists the files of a directory that have a supported extension
+     * 
+     * @param directory The directory to scan
+     * @param recursive Whether to scan sub-directories as well
+     * @return std::vector<std::string> The matching file paths, sorted
+     */
+    std::vector<std::string> collectSupportedFiles(const std::string& directory,
+                                                   bool recursive = true) const;
+    
+    /**
+     * @brief Sets the options of the tessellation stage
+     * @param options The tessellation options
+     */
+    void setTessellationOptions(const TessellationOptions& options) { myTessellationOptions = options; }
+    
+    /**
+     * @brief Gets the options of the tessellation stage
+     * @return The tessellation options
+     */
+    const TessellationOptions& getTessellationOptions() const { return myTessellationOptions; }
+    
+    /**
+     * @brief Tessellates all CAD shapes of a sub-tree in parallel
+     * 
+     * Each distinct TopoDS_TShape is meshed once with BRepMesh_IncrementalMesh, so
+     * instances of a part share one triangulation. Parts are meshed concurrently; a
+     * model with only a few parts is meshed face-parallel instead. Shapes whose faces
+     * are all triangulated already are left as they are.
+     * 
+     * @param model The model holding the shapes; the triangulations are stored in its shapes
+     * @param rootId The ID of the sub-tree root
+     * @param progress Progress and cancellation state
+     * @param fromFraction Progress fraction at the start of the stage
+     * @param toFraction Progress fraction at the end of the stage
+     * @return bool False if the stage was cancelled
+     */
+    bool tessellateShapes(UnifiedModel& model,
+                          const std::string& rootId,
+                          ImportProgress& progress,
+                          double fromFraction = 0.0,
+                          double toFraction = 1.0) const;
+    
+    /**
+     * @brief Selects the reader used for STEP files
+     * @param mode The reader mode (XDE by default)
+     */
+    void setStepReaderMode(StepReaderMode mode) { myStepReaderMode = mode; }
+    
+    /**
+     * @brief Gets the reader used for STEP files
+     * @return The reader mode
+     */
+    StepReaderMode getStepReaderMode() const { return myStepReaderMode; }
+    
+    /**
+     * @brief Selects how the BASIC reader transfers the roots of a STEP file
+     * 
+     * In PARALLEL mode the first worker thread transfers roots with the reader that parsed the
+     * file, and every other worker parses its own copy and transfers a share of the roots in its
+     * own work session; the shapes are assembled in root order. This costs one more parse and one
+     * more StepData model in memory per additional worker. If roots share entities (e.g. a part
+     * used by several top-level assemblies), their shapes would no longer be shared, so the file
+     * is transferred serially instead; the result is always the same as in SERIAL mode. Parts
+     * shared through the assembly structure are found on the parsed file before any worker starts. Files with a single root
+     * (e.g. one top-level assembly) are transferred serially. The XDE reader always transfers
+     * serially, as names, colors and layers are resolved from a single transfer process.
+     * 
+     * @param mode The transfer mode (SERIAL by default)
+     */
+    void setStepTransferMode(StepTransferMode mode) { myStepTransferMode = mode; }
+    
+    /**
+     * @brief Gets how the BASIC reader transfers the roots of a STEP file
+     * @return The transfer mode
+     */
+    StepTransferMode getStepTransferMode() const { return myStepTransferMode; }
+    
+    /**
+     * @brief Gets the number of STEP files whose roots were transferred in parallel
+     * 
+     * Files that fell back to the serial transfer are not counted. Thread-safe.
+     * 
+     * @return The count since the importer was created
+     */
+    size_t getParallelStepTransferCount() const { return myParallelStepTransfers; }
+    
+    /**
+     * @brief Enables the repair stage for imported STL, OBJ and PLY meshes
+     * 
+     * The stage runs MeshProcessing::repair() on each mesh before it is added to the
+     * model: faces with NaN coordinates, degenerate, duplicated and non-manifold faces
+     * are removed. Meshes loaded from the import cache are already repaired and get
+     * no new report.
+     * 
+     * @param enabled Whether meshes are repaired (disabled by default)
+     */
+    void setMeshRepairEnabled(bool enabled) { myIsMeshRepairEnabled = enabled; }
+    
+    /**
+     * @brief Checks whether imported meshes are repaired
+     * @return True if the repair stage is enabled
+     */
+    bool isMeshRepairEnabled() const { return myIsMeshRepairEnabled; }
+    
+    /**
+     * @brief Gets the repair reports of the meshes imported so far
+     * 
+     * Thread-safe; the reports of files read in parallel are collected here as well.
+     * 
+     * @return Reports by entity ID (the IDs of the staging models, which are the model IDs
+     *         unless an entity was skipped on commit because its ID already existed)
+     */
+    std::map<std::string, MeshProcessing::RepairReport> getRepairReports() const;
+    
+    /**
+     * @brief Removes all collected repair reports
+     */
+    void clearRepairReports();
+    
+    /**
+     * @brief Takes the records of the imports finished since the last call
+     * 
+     * Every import of a supported file produces a record with its stage timings, counters
+     * and memory use, including the files of readBatch() read on worker threads. Thread-safe;
+     * only the most recent records are kept until they are taken.
+     * 
+     * @return The records in the order the imports finished
+     */
+    std::vector<ImportRecord> takeImportRecords();
+    
+    /**
+     * @brief Sets the on-disk cache consulted before parsing a file
+     * 
+     * On a hit the cached entities are loaded instead of parsing the file; on a miss the
+     * file is imported into a staging model that is stored in the cache and then merged.
+     * 
+     * @param cache The cache (nullptr disables caching)
+     */
+    void setImportCache(std::shared_ptr<ImportCache> cache) { myImportCache = std::move(cache); }
+    
+    /**
+     * @brief Gets the on-disk import cache
+     * @return The cache, or nullptr if caching is disabled
+     */
+    const std::shared_ptr<ImportCache>& getImportCache() const { return myImportCache; }
+    
     /**
      * @brief Gets the supported file extensions
      * 
-     * @return std::vector<std::string> List of supported file extensions (e.g., ".step", ".stl", ".obj")
+     * @return std::vector<std::string> List of supported file extensions (e.g., ".step", ".stl", ".glb")
      */
     std::vector<std::string> getSupportedExtensions() const;
     
 private:
+    // 定义成员函数指针类型
+    using ImportFunction = bool (ModelImporter::*)(const std::string&,
+                                                   UnifiedModel&,
+                                                   const std::string&,
+                                                   ImportProgress&);
+    
+    /**
+     * @brief Imports a file through the cache or the import function of its format
+     * 
+     * @param filePath The path to the model file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model
+     * @param function The import function of the file format
+     * @param progress Progress and cancellation state; receives the stage timings
+     * @param record Receives whether the entities came from the cache
+     * @return bool True if import was successful, false otherwise
+     */
+    bool importFile(const std::string& filePath,
+                    UnifiedModel& model,
+                    const std::string& modelId,
+                    ImportFunction function,
+                    ImportProgress& progress,
+                    ImportRecord& record);
+    
     /**
      * @brief Imports a STEP file using OpenCASCADE
      * 
+     * Dispatches to importStepFileXde() or importStepFileBasic() depending on the
+     * selected StepReaderMode.
+     * 
+     * @param filePath The path to the STEP file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
+     * @return bool True if import was successful, false otherwise
+     */
+    bool importStepFile(const std::string& filePath,
+                        UnifiedModel& model,
+                        const std::string& modelId,
+                        ImportProgress& progress);
+    
+    /**
+     * @brief Imports a STEP file with STEPControl_Reader (geometry only)
+     * 
      * @param filePath The path to the STEP file
      * @param model The UnifiedModel to add the imported model to
      * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
      * @return bool True if import was successful, false otherwise
      */
-    bool importStepFile(const std::string& filePath, UnifiedModel& model, const std::string& modelId);
+    bool importStepFileBasic(const std::string& filePath,
+                             UnifiedModel& model,
+                             const std::string& modelId,
+                             ImportProgress& progress);
     
     /**
-     * @brief Imports an STL file using libigl
+     * @brief Imports a STEP file into an XDE document and converts it with XdeModelBuilder
+     * 
+     * Keeps product names, colors (including face colors), layers and the sharing of
+     * parts placed several times.
+     * 
+     * @param filePath The path to the STEP file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
+     * @return bool True if import was successful, false otherwise
+     */
+    bool importStepFileXde(const std::string& filePath,
+                           UnifiedModel& model,
+                           const std::string& modelId,
+                           ImportProgress& progress);
+    
+    /**
+     * @brief Adds a transferred STEP shape to the model, preserving its assembly structure
+     * 
+     * Compounds made of solids, shells or nested compounds become assembly nodes whose
+     * children are added recursively with IDs of the form "<parent>/<index>". Compounds
+     * with a single child are collapsed into that child, and compounds of loose faces,
+     * wires or edges are kept as one part.
+     * 
+     * @param shape The shape to add
+     * @param model The UnifiedModel to add the shape to
+     * @param id The ID to assign to the node
+     * @param parentId The ID of the parent assembly node (empty for a root node)
+     * @return int The number of part entities added
+     */
+    int addShapeHierarchy(const TopoDS_Shape& shape,
+                          UnifiedModel& model,
+                          const std::string& id,
+                          const std::string& parentId);
+    
+    /**
+     * @brief Imports a binary or ASCII STL file using StlReader
      * 
      * @param filePath The path to the STL file
      * @param model The UnifiedModel to add the imported model to
      * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
      * @return bool True if import was successful, false otherwise
      */
-    bool importStlFile(const std::string& filePath, UnifiedModel& model, const std::string& modelId);
+    bool importStlFile(const std::string& filePath,
+                       UnifiedModel& model,
+                       const std::string& modelId,
+                       ImportProgress& progress);
     
     /**
-     * @brief Imports an OBJ file using libigl
+     * @brief Imports an OBJ file using ObjReader
      * 
      * @param filePath The path to the OBJ file
      * @param model The UnifiedModel to add the imported model to
      * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
+     * @return bool True if import was successful, false otherwise
+     */
+    bool importObjFile(const std::string& filePath,
+                       UnifiedModel& model,
+                       const std::string& modelId,
+                       ImportProgress& progress);
+    
+    /**
+     * @brief Imports an ASCII or binary PLY file using PlyReader
+     * 
+     * Vertex normals and colors stored in the file are kept in the MeshData.
+     * 
+     * @param filePath The path to the PLY file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
+     * @return bool True if import was successful, false otherwise
+     */
+    bool importPlyFile(const std::string& filePath,
+                       UnifiedModel& model,
+                       const std::string& modelId,
+                       ImportProgress& progress);
+    
+    /**
+     * @brief Runs the repair stage on a mesh read from a file, if enabled
+     * 
+     * @param modelId The ID of the mesh entity (key of the report)
+     * @param mesh The mesh to repair
+     * @param progress Progress state (the stage name is updated)
+     */
+    void repairMesh(const std::string& modelId, UnifiedModel::MeshData& mesh, ImportProgress& progress);
+    
+    /**
+     * @brief Describes the importer settings that influence the result for a file type
+     * 
+     * Part of the import cache key, so changing e.g. the tessellation options does not
+     * re-open entries imported with other settings.
+     * 
+     * @param extension The file extension (lowercase, including the dot)
+     * @return std::string The settings text
+     */
+    std::string getCacheSettings(const std::string& extension) const;
+    
+    /**
+     * @brief Imports a glTF or GLB file with RWGltf_CafReader
+     * 
+     * Buffers are decoded in parallel into an XDE document, which is converted with
+     * XdeModelBuilder: the node hierarchy is kept, meshes placed once become MESH
+     * entities and meshes placed several times stay triangulated shapes that share
+     * one triangulation.
+     * 
+     * @param filePath The path to the glTF file
+     * @param model The UnifiedModel to add the imported model to
+     * @param modelId The ID to assign to the imported model
+     * @param progress Progress and cancellation state
      * @return bool True if import was successful, false otherwise
      */
-    bool importObjFile(const std::string& filePath, UnifiedModel& model, const std::string& modelId);
+    bool importGltfFile(const std::string& filePath,
+                        UnifiedModel& model,
+                        const std::string& modelId,
+                        ImportProgress& progress);
     
     /**
      * @brief Gets the file extension from a file path
@@ -96,9 +561,39 @@ private:
      */
     std::string getFileName(const std::string& filePath) const;
     
-    // 定义成员函数指针类型
-    using ImportFunction = std::function<bool(const std::string&, UnifiedModel&, const std::string&)>;
-    
     // Map of file extensions to import functions
     std::map<std::string, ImportFunction> myImportFunctions;
+    
+    /** Reader used for STEP files */
+    StepReaderMode myStepReaderMode = StepReaderMode::XDE;
+    
+    /** Transfer mode of the BASIC STEP reader */
+    StepTransferMode myStepTransferMode = StepTransferMode::SERIAL;
+    
+    /** Number of STEP files transferred in parallel (imports may run on several threads) */
+    std::atomic<size_t> myParallelStepTransfers{0};
+    
+    /** Options of the tessellation stage */
+    TessellationOptions myTessellationOptions;
+    
+    /** On-disk import cache (nullptr: disabled) */
+    std::shared_ptr<ImportCache> myImportCache;
+    
+    /** Whether imported meshes are repaired */
+    bool myIsMeshRepairEnabled = false;
+    
+    /** Repair reports by entity ID, written by the import threads */
+    std::map<std::string, MeshProcessing::RepairReport> myRepairReports;
+    
+    /** Protects myRepairReports */
+    mutable std::mutex myRepairReportsMutex;
+    
+    /** Records of the finished imports not taken yet */
+    std::deque<ImportRecord> myImportRecords;
+    
+    /** Protects myImportRecords */
+    std::mutex myImportRecordsMutex;
+    
+    /** Number of imports running, to measure the peak memory of imports that do not overlap */
+    std::atomic<int> myActiveImports{0};
 }; 
\ No newline at end of file
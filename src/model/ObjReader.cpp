@@ -0,0 +1,422 @@
+#include "ObjReader.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// 创建OBJ读取器日志记录器
+static std::shared_ptr<Utils::Logger>& getObjLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.obj");
+    return logger;
+}
+
+namespace
+{
+// 最小分块大小，更小的文件由单个线程解析
+constexpr size_t MIN_CHUNK_BYTES = size_t(1) << 20;
+
+// 两次取消检查之间解析的行数
+constexpr size_t LINES_PER_CHECK = 65536;
+
+// 就几何而言OBJ行的类型
+enum class RecordType
+{
+    Other,
+    Position,
+    Normal,
+    Face
+};
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// 返回从cursor开始的行的末尾（'\n'或end）
+inline const char* findLineEnd(const char* cursor, const char* end)
+{
+    const void* newLine = std::memchr(cursor, '\n', size_t(end - cursor));
+    return newLine != nullptr ? static_cast<const char*>(newLine) : end;
+}
+
+inline const char* skipBlanks(const char* cursor, const char* lineEnd)
+{
+    while (cursor < lineEnd && isBlank(*cursor)) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+// 识别行的记录类型，并把cursor移到关键字之后
+inline RecordType readRecordType(const char*& cursor, const char* lineEnd)
+{
+    cursor = skipBlanks(cursor, lineEnd);
+    const size_t length = size_t(lineEnd - cursor);
+    if (length >= 2 && cursor[0] == 'v' && isBlank(cursor[1])) {
+        cursor += 2;
+        return RecordType::Position;
+    }
+    if (length >= 3 && cursor[0] == 'v' && cursor[1] == 'n' && isBlank(cursor[2])) {
+        cursor += 3;
+        return RecordType::Normal;
+    }
+    if (length >= 2 && cursor[0] == 'f' && isBlank(cursor[1])) {
+        cursor += 2;
+        return RecordType::Face;
+    }
+    return RecordType::Other;
+}
+
+// 解析浮点数；std::from_chars不接受开头的'+'
+inline bool parseReal(const char*& cursor, const char* lineEnd, double& value)
+{
+    cursor = skipBlanks(cursor, lineEnd);
+    if (cursor < lineEnd && *cursor == '+') {
+        ++cursor;
+    }
+    const std::from_chars_result result = std::from_chars(cursor, lineEnd, value);
+    cursor = result.ptr;
+    return result.ec == std::errc();
+}
+
+// 面记录的一个角点：文件中写出的位置和（可选的）法向索引
+struct FaceCorner
+{
+    long long position = 0;
+    long long normal = 0;  // 角点没有法向时为0
+};
+
+// 解析面角点"v"、"v/vt"、"v//vn"或"v/vt/vn"
+inline bool parseCorner(const char*& cursor, const char* lineEnd, FaceCorner& corner)
+{
+    std::from_chars_result result = std::from_chars(cursor, lineEnd, corner.position);
+    if (result.ec != std::errc() || corner.position == 0) {
+        return false;
+    }
+    cursor = result.ptr;
+    corner.normal = 0;
+    if (cursor < lineEnd && *cursor == '/') {
+        ++cursor;
+        // 纹理坐标索引忽略
+        long long texCoord = 0;
+        result = std::from_chars(cursor, lineEnd, texCoord);
+        if (result.ec == std::errc()) {
+            cursor = result.ptr;
+        }
+        if (cursor < lineEnd && *cursor == '/') {
+            ++cursor;
+            result = std::from_chars(cursor, lineEnd, corner.normal);
+            if (result.ec != std::errc()) {
+                return false;
+            }
+            cursor = result.ptr;
+        }
+    }
+    return true;
+}
+
+// 统计面记录的角点数（注释之前以空白分隔的记号）
+inline size_t countCorners(const char* cursor, const char* lineEnd)
+{
+    size_t nbCorners = 0;
+    while (true) {
+        cursor = skipBlanks(cursor, lineEnd);
+        if (cursor >= lineEnd || *cursor == '#') {
+            return nbCorners;
+        }
+        ++nbCorners;
+        while (cursor < lineEnd && !isBlank(*cursor)) {
+            ++cursor;
+        }
+    }
+}
+
+// 把从1开始或为负（相对）的OBJ索引转换为从0开始的索引
+inline long long resolveIndex(long long index, size_t countBefore)
+{
+    return index > 0 ? index - 1 : (long long)countBefore + index;
+}
+}  // namespace
+
+bool ObjReader::read(const std::string& filePath,
+                     UnifiedModel::MeshData& mesh,
+                     ImportProgress& progress,
+                     double fromFraction,
+                     double toFraction)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    progress.setStage("Reading OBJ file");
+    progress.setFraction(fromFraction);
+
+    ImportStageTimer mapTimer(progress, "map");
+    Utils::MappedFile file;
+    if (!file.open(filePath)) {
+        getObjLogger()->error("Failed to open OBJ file: {}", filePath);
+        return false;
+    }
+    const char* data = file.data();
+    const size_t size = file.size();
+    mapTimer.setBytes(size);
+    mapTimer.stop();
+
+    const size_t nbChunksWanted = std::min<size_t>(Utils::getParallelThreadCount() * 4,
+                                                   std::max<size_t>(1, size / MIN_CHUNK_BYTES));
+    const std::vector<size_t> bounds = splitLines(data, size, nbChunksWanted);
+    const size_t nbChunks = bounds.size() - 1;
+
+    // 进度按三个扫描阶段处理的字节数计算：计数 20%，顶点 40%，面 40%
+    std::atomic<size_t> bytesDone{0};
+    auto reportChunk = [&](size_t chunk, double passFrom, double passTo) {
+        const size_t done = bytesDone += bounds[chunk + 1] - bounds[chunk];
+        const double passFraction = size > 0 ? double(done) / double(size) : 1.0;
+        const double fraction = passFrom + (passTo - passFrom) * passFraction;
+        progress.setFraction(fromFraction + (toFraction - fromFraction) * fraction);
+    };
+
+    // 第一遍：统计每块的记录数，前缀和得到每块在最终缓冲区中的写入位置
+    // （首次读取映射内存，文件I/O主要计入此阶段）
+    ImportStageTimer countTimer(progress, "count");
+    countTimer.setBytes(size);
+    std::vector<ChunkCounts> offsets(nbChunks + 1);
+    Utils::parallelFor(0, nbChunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+            offsets[chunk + 1] = countRecords(data + bounds[chunk], data + bounds[chunk + 1]);
+            reportChunk(chunk, 0.0, 0.2);
+        }
+    });
+    for (size_t chunk = 0; chunk < nbChunks; ++chunk) {
+        offsets[chunk + 1].positions += offsets[chunk].positions;
+        offsets[chunk + 1].normals += offsets[chunk].normals;
+        offsets[chunk + 1].triangles += offsets[chunk].triangles;
+    }
+    const ChunkCounts totals = offsets[nbChunks];
+    countTimer.stop();
+    if (progress.isCancelled()) {
+        return false;
+    }
+    if (totals.positions == 0 || totals.triangles == 0) {
+        getObjLogger()->error("OBJ file contains no faces: {}", filePath);
+        return false;
+    }
+    if (totals.triangles > size_t(std::numeric_limits<int>::max())
+        || totals.positions > size_t(std::numeric_limits<int>::max())) {
+        getObjLogger()->error("OBJ file is too large for 32-bit indices: {}", filePath);
+        return false;
+    }
+
+    std::atomic<bool> hasError{false};
+    auto fail = [&](const char* cursor, const char* message) {
+        if (!hasError.exchange(true)) {
+            getObjLogger()->error("{} at byte {} of {}", message, size_t(cursor - data), filePath);
+        }
+    };
+
+    // 第二遍：解析v和vn记录，直接写入最终位置
+    progress.setStage("Parsing OBJ vertices");
+    ImportStageTimer vertexTimer(progress, "parse vertices");
+    vertexTimer.setBytes(size);
+    vertexTimer.setElements(totals.positions);
+    mesh.vertices.resize(Eigen::Index(totals.positions), 3);
+    std::vector<double> vertexNormals(totals.normals * 3);
+    bytesDone = 0;
+    Utils::parallelFor(0, nbChunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        for (size_t chunk = chunkBegin; chunk < chunkEnd && !hasError; ++chunk) {
+            Eigen::Index position = Eigen::Index(offsets[chunk].positions);
+            size_t normal = offsets[chunk].normals;
+            const char* end = data + bounds[chunk + 1];
+            size_t nbLines = 0;
+            for (const char* line = data + bounds[chunk]; line < end;) {
+                const char* lineEnd = findLineEnd(line, end);
+                const char* cursor = line;
+                const RecordType type = readRecordType(cursor, lineEnd);
+                if (type == RecordType::Position) {
+                    double x, y, z;
+                    if (!parseReal(cursor, lineEnd, x) || !parseReal(cursor, lineEnd, y)
+                        || !parseReal(cursor, lineEnd, z)) {
+                        fail(line, "Invalid vertex record");
+                        return;
+                    }
+                    mesh.vertices(position, 0) = x;
+                    mesh.vertices(position, 1) = y;
+                    mesh.vertices(position, 2) = z;
+                    ++position;
+                }
+                else if (type == RecordType::Normal) {
+                    if (!parseReal(cursor, lineEnd, vertexNormals[normal * 3])
+                        || !parseReal(cursor, lineEnd, vertexNormals[normal * 3 + 1])
+                        || !parseReal(cursor, lineEnd, vertexNormals[normal * 3 + 2])) {
+                        fail(line, "Invalid normal record");
+                        return;
+                    }
+                    ++normal;
+                }
+                line = lineEnd + 1;
+                if (++nbLines % LINES_PER_CHECK == 0 && progress.isCancelled()) {
+                    return;
+                }
+            }
+            reportChunk(chunk, 0.2, 0.6);
+        }
+    });
+    if (hasError || progress.isCancelled()) {
+        return false;
+    }
+    vertexTimer.stop();
+
+    // 第三遍：解析f记录，解析相对索引，按扇形三角化并计算面法向量
+    progress.setStage("Parsing OBJ faces");
+    ImportStageTimer faceTimer(progress, "parse faces");
+    faceTimer.setBytes(size);
+    faceTimer.setElements(totals.triangles);
+    mesh.faces.resize(Eigen::Index(totals.triangles), 3);
+    mesh.normals.resize(Eigen::Index(totals.triangles), 3);
+    bytesDone = 0;
+    Utils::parallelFor(0, nbChunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        std::vector<FaceCorner> corners;
+        for (size_t chunk = chunkBegin; chunk < chunkEnd && !hasError; ++chunk) {
+            size_t positionsBefore = offsets[chunk].positions;
+            size_t normalsBefore = offsets[chunk].normals;
+            Eigen::Index triangle = Eigen::Index(offsets[chunk].triangles);
+            const char* end = data + bounds[chunk + 1];
+            size_t nbLines = 0;
+            for (const char* line = data + bounds[chunk]; line < end;) {
+                const char* lineEnd = findLineEnd(line, end);
+                const char* cursor = line;
+                const RecordType type = readRecordType(cursor, lineEnd);
+                if (type == RecordType::Position) {
+                    ++positionsBefore;
+                }
+                else if (type == RecordType::Normal) {
+                    ++normalsBefore;
+                }
+                else if (type == RecordType::Face) {
+                    // 读取所有角点，并转换为从0开始的绝对索引
+                    corners.clear();
+                    bool hasNormals = true;
+                    for (cursor = skipBlanks(cursor, lineEnd); cursor < lineEnd && *cursor != '#';
+                         cursor = skipBlanks(cursor, lineEnd)) {
+                        FaceCorner corner;
+                        if (!parseCorner(cursor, lineEnd, corner)) {
+                            fail(line, "Invalid face record");
+                            return;
+                        }
+                        corner.position = resolveIndex(corner.position, positionsBefore);
+                        if (corner.position < 0 || corner.position >= (long long)totals.positions) {
+                            fail(line, "Face references a missing vertex");
+                            return;
+                        }
+                        if (corner.normal != 0) {
+                            corner.normal = resolveIndex(corner.normal, normalsBefore);
+                            if (corner.normal < 0 || corner.normal >= (long long)totals.normals) {
+                                fail(line, "Face references a missing normal");
+                                return;
+                            }
+                        }
+                        else {
+                            hasNormals = false;
+                        }
+                        corners.push_back(corner);
+                    }
+
+                    // 多边形按扇形三角化：(0, k, k + 1)
+                    for (size_t k = 1; k + 1 < corners.size(); ++k) {
+                        const FaceCorner* fan[3] = {&corners[0], &corners[k], &corners[k + 1]};
+                        Eigen::RowVector3d normal = Eigen::RowVector3d::Zero();
+                        for (int c = 0; c < 3; ++c) {
+                            mesh.faces(triangle, c) = int(fan[c]->position);
+                            if (hasNormals) {
+                                const double* vn = &vertexNormals[size_t(fan[c]->normal) * 3];
+                                normal += Eigen::RowVector3d(vn[0], vn[1], vn[2]);
+                            }
+                        }
+                        if (!hasNormals) {
+                            const Eigen::RowVector3d p0 = mesh.vertices.row(mesh.faces(triangle, 0));
+                            const Eigen::RowVector3d e1 = mesh.vertices.row(mesh.faces(triangle, 1)) - p0;
+                            const Eigen::RowVector3d e2 = mesh.vertices.row(mesh.faces(triangle, 2)) - p0;
+                            normal = e1.cross(e2);
+                        }
+                        // 与igl::per_face_normals一致：退化时法向量为零向量
+                        const double length = normal.norm();
+                        mesh.normals.row(triangle) =
+                            length > 0.0 ? Eigen::RowVector3d(normal / length) : Eigen::RowVector3d::Zero();
+                        ++triangle;
+                    }
+                }
+                line = lineEnd + 1;
+                if (++nbLines % LINES_PER_CHECK == 0 && progress.isCancelled()) {
+                    return;
+                }
+            }
+            // 顶点已全部解析，本块的三角形即为最终结果，可供预览
+            progress.publishPreview(mesh, offsets[chunk].triangles, size_t(triangle));
+            reportChunk(chunk, 0.6, 1.0);
+        }
+    });
+    if (hasError || progress.isCancelled()) {
+        return false;
+    }
+    faceTimer.stop();
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const double megabytes = double(size) / (1024.0 * 1024.0);
+    getObjLogger()->info("Parsed OBJ with {} chunks: {} vertices, {} triangles, {:.1f} MB in {:.3f} s ({:.1f} MB/s)",
+                         nbChunks,
+                         totals.positions,
+                         totals.triangles,
+                         megabytes,
+                         seconds,
+                         seconds > 0.0 ? megabytes / seconds : 0.0);
+    return true;
+}
+
+std::vector<size_t> ObjReader::splitLines(const char* data, size_t size, size_t count) const
+{
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < count; ++i) {
+        // 从等分点向后找到下一行的开头
+        size_t bound = std::max(size * i / count, bounds.back());
+        const char* lineEnd = findLineEnd(data + bound, data + size);
+        bound = lineEnd < data + size ? size_t(lineEnd - data) + 1 : size;
+        if (bound > bounds.back() && bound < size) {
+            bounds.push_back(bound);
+        }
+    }
+    bounds.push_back(size);
+    return bounds;
+}
+
+ObjReader::ChunkCounts ObjReader::countRecords(const char* begin, const char* end) const
+{
+    ChunkCounts counts;
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = findLineEnd(line, end);
+        const char* cursor = line;
+        switch (readRecordType(cursor, lineEnd)) {
+            case RecordType::Position:
+                ++counts.positions;
+                break;
+            case RecordType::Normal:
+                ++counts.normals;
+                break;
+            case RecordType::Face: {
+                const size_t nbCorners = countCorners(cursor, lineEnd);
+                counts.triangles += nbCorners >= 3 ? nbCorners - 2 : 0;
+                break;
+            }
+            default:
+                break;
+        }
+        line = lineEnd + 1;
+    }
+    return counts;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file ObjReader.h
+ * @brief Defines the ObjReader class, a memory-mapped multithreaded Wavefront OBJ reader.
+ *
+ * The mapped file is split into chunks at line boundaries. A counting pass gives the
+ * number of records of each chunk; prefix sums of these counts tell every chunk where
+ * its records go, so the parsing passes write straight into the final MeshData buffers.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+#include "ImportProgress.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @class ObjReader
+ * @brief Reads the geometry of OBJ files (`v`, `vn` and `f` records) into MeshData.
+ *
+ * Negative (relative) indices are supported, polygons are triangulated as fans, and
+ * other records (`vt`, `o`, `g`, `usemtl`, ...) are ignored. Faces referencing `vn`
+ * records get the normalized average of their corner normals as face normal; other
+ * faces get their geometric normal.
+ */
+class ObjReader {
+public:
+    /**
+     * @brief Reads an OBJ file
+     *
+     * @param filePath The path to the OBJ file
+     * @param mesh Receives the mesh
+     * @param progress Progress and cancellation state
+     * @param fromFraction Progress fraction at the start of the read
+     * @param toFraction Progress fraction at the end of the read
+     * @return bool True if the file was read, false on error or cancellation
+     */
+    bool read(const std::string& filePath,
+              UnifiedModel::MeshData& mesh,
+              ImportProgress& progress,
+              double fromFraction = 0.0,
+              double toFraction = 1.0);
+
+private:
+    /**
+     * @brief Record counts of one chunk, turned into offsets by a prefix sum
+     */
+    struct ChunkCounts {
+        size_t positions = 0;  ///< Number of `v` records
+        size_t normals = 0;    ///< Number of `vn` records
+        size_t triangles = 0;  ///< Number of triangles after fan triangulation
+    };
+
+    /**
+     * @brief Splits a buffer into about `count` chunks that start at line beginnings
+     *
+     * @param data The file content
+     * @param size The file size in bytes
+     * @param count The requested number of chunks
+     * @return std::vector<size_t> The chunk boundaries (count + 1 offsets)
+     */
+    std::vector<size_t> splitLines(const char* data, size_t size, size_t count) const;
+
+    /**
+     * @brief Counts the records of a chunk
+     *
+     * @param begin The first character of the chunk
+     * @param end One past the last character of the chunk
+     * @return ChunkCounts The record counts
+     */
+    ChunkCounts countRecords(const char* begin, const char* end) const;
+};
@@ -0,0 +1,849 @@
+#include "PlyReader.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+// 创建PLY读取器日志记录器
+static std::shared_ptr<Utils::Logger>& getPlyLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.ply");
+    return logger;
+}
+
+namespace
+{
+// 两次进度更新和取消检查之间处理的记录数
+constexpr size_t RECORD_CHUNK_SIZE = 65536;
+
+// PLY属性的标量类型
+enum class ScalarType
+{
+    Invalid,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+// PLY数据体的编码
+enum class PlyFormat
+{
+    Ascii,
+    BinaryLittleEndian,
+    BinaryBigEndian
+};
+
+// 元素的一个属性；列表属性带有计数类型
+struct PlyProperty
+{
+    std::string name;
+    ScalarType type = ScalarType::Invalid;
+    ScalarType countType = ScalarType::Invalid;  // 标量属性为Invalid
+
+    bool isList() const { return countType != ScalarType::Invalid; }
+};
+
+// 文件头中声明的元素
+struct PlyElement
+{
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+};
+
+// 解析后的PLY文件头
+struct PlyHeader
+{
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+    size_t bodyOffset = 0;
+};
+
+// 读取器使用的顶点属性的序号，缺少时为-1
+struct VertexLayout
+{
+    int position[3] = {-1, -1, -1};
+    int normal[3] = {-1, -1, -1};
+    int color[3] = {-1, -1, -1};
+
+    bool hasNormals() const { return normal[0] >= 0 && normal[1] >= 0 && normal[2] >= 0; }
+    bool hasColors() const { return color[0] >= 0 && color[1] >= 0 && color[2] >= 0; }
+};
+
+ScalarType parseScalarType(const std::string& name)
+{
+    if (name == "char" || name == "int8") return ScalarType::Int8;
+    if (name == "uchar" || name == "uint8") return ScalarType::UInt8;
+    if (name == "short" || name == "int16") return ScalarType::Int16;
+    if (name == "ushort" || name == "uint16") return ScalarType::UInt16;
+    if (name == "int" || name == "int32") return ScalarType::Int32;
+    if (name == "uint" || name == "uint32") return ScalarType::UInt32;
+    if (name == "float" || name == "float32") return ScalarType::Float32;
+    if (name == "double" || name == "float64") return ScalarType::Float64;
+    return ScalarType::Invalid;
+}
+
+size_t scalarSize(ScalarType type)
+{
+    switch (type) {
+        case ScalarType::Int8:
+        case ScalarType::UInt8:
+            return 1;
+        case ScalarType::Int16:
+        case ScalarType::UInt16:
+            return 2;
+        case ScalarType::Int32:
+        case ScalarType::UInt32:
+        case ScalarType::Float32:
+            return 4;
+        case ScalarType::Float64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// 把存储的颜色分量映射到[0, 1]的比例
+double colorScale(ScalarType type)
+{
+    switch (type) {
+        case ScalarType::UInt8:
+            return 1.0 / 255.0;
+        case ScalarType::UInt16:
+            return 1.0 / 65535.0;
+        default:
+            return 1.0;
+    }
+}
+
+// 从未对齐的地址读取T类型的值，必要时交换字节序
+template <typename T>
+inline T loadValue(const char* address, bool toSwap)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, address, sizeof(T));
+    if (toSwap) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+inline double loadScalar(const char* address, ScalarType type, bool toSwap)
+{
+    switch (type) {
+        case ScalarType::Int8: return loadValue<std::int8_t>(address, false);
+        case ScalarType::UInt8: return loadValue<std::uint8_t>(address, false);
+        case ScalarType::Int16: return loadValue<std::int16_t>(address, toSwap);
+        case ScalarType::UInt16: return loadValue<std::uint16_t>(address, toSwap);
+        case ScalarType::Int32: return loadValue<std::int32_t>(address, toSwap);
+        case ScalarType::UInt32: return loadValue<std::uint32_t>(address, toSwap);
+        case ScalarType::Float32: return loadValue<float>(address, toSwap);
+        case ScalarType::Float64: return loadValue<double>(address, toSwap);
+        default: return 0.0;
+    }
+}
+
+inline long long loadInteger(const char* address, ScalarType type, bool toSwap)
+{
+    switch (type) {
+        case ScalarType::Int8: return loadValue<std::int8_t>(address, false);
+        case ScalarType::UInt8: return loadValue<std::uint8_t>(address, false);
+        case ScalarType::Int16: return loadValue<std::int16_t>(address, toSwap);
+        case ScalarType::UInt16: return loadValue<std::uint16_t>(address, toSwap);
+        case ScalarType::Int32: return loadValue<std::int32_t>(address, toSwap);
+        case ScalarType::UInt32: return loadValue<std::uint32_t>(address, toSwap);
+        default: return (long long)loadScalar(address, type, toSwap);
+    }
+}
+
+// 主机是否以小端序存储整数
+inline bool isLittleEndianHost()
+{
+    const std::uint16_t probe = 1;
+    std::uint8_t firstByte = 0;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+// 返回面元素的顶点索引列表属性的序号，没有时为-1
+int findIndexList(const PlyElement& element)
+{
+    for (size_t i = 0; i < element.properties.size(); ++i) {
+        const PlyProperty& property = element.properties[i];
+        if (property.isList() && (property.name == "vertex_indices" || property.name == "vertex_index")) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+VertexLayout findVertexLayout(const PlyElement& element)
+{
+    static const char* const POSITION_NAMES[3] = {"x", "y", "z"};
+    static const char* const NORMAL_NAMES[3] = {"nx", "ny", "nz"};
+    static const char* const COLOR_NAMES[3] = {"red", "green", "blue"};
+    static const char* const DIFFUSE_NAMES[3] = {"diffuse_red", "diffuse_green", "diffuse_blue"};
+
+    VertexLayout layout;
+    for (size_t i = 0; i < element.properties.size(); ++i) {
+        const std::string& name = element.properties[i].name;
+        for (int c = 0; c < 3; ++c) {
+            if (name == POSITION_NAMES[c]) layout.position[c] = int(i);
+            if (name == NORMAL_NAMES[c]) layout.normal[c] = int(i);
+            if (name == COLOR_NAMES[c] || name == DIFFUSE_NAMES[c]) layout.color[c] = int(i);
+        }
+    }
+    return layout;
+}
+
+// 返回元素的固定记录长度，含列表属性时为0
+size_t recordStride(const PlyElement& element)
+{
+    size_t stride = 0;
+    for (const PlyProperty& property : element.properties) {
+        if (property.isList()) {
+            return 0;
+        }
+        stride += scalarSize(property.type);
+    }
+    return stride;
+}
+
+// 元素一条记录至少占用的字节数：二进制为标量和列表计数的长度，ASCII每个值至少一个字符和一个分隔符
+size_t minimumRecordSize(const PlyElement& element, PlyFormat format)
+{
+    if (format == PlyFormat::Ascii) {
+        return 2 * element.properties.size();
+    }
+    size_t size = 0;
+    for (const PlyProperty& property : element.properties) {
+        size += scalarSize(property.isList() ? property.countType : property.type);
+    }
+    return size;
+}
+
+bool parseHeader(const char* data, size_t size, PlyHeader& header)
+{
+    const char* cursor = data;
+    const char* end = data + size;
+    bool isFirstLine = true;
+    bool hasFormat = false;
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', size_t(end - cursor)));
+        if (lineEnd == nullptr) {
+            return false;
+        }
+        std::istringstream line(std::string(cursor, lineEnd));
+        cursor = lineEnd + 1;
+
+        std::string keyword;
+        line >> keyword;
+        if (isFirstLine) {
+            if (keyword != "ply") {
+                return false;
+            }
+            isFirstLine = false;
+        }
+        else if (keyword == "format") {
+            std::string format;
+            line >> format;
+            if (format == "ascii") {
+                header.format = PlyFormat::Ascii;
+            }
+            else if (format == "binary_little_endian") {
+                header.format = PlyFormat::BinaryLittleEndian;
+            }
+            else if (format == "binary_big_endian") {
+                header.format = PlyFormat::BinaryBigEndian;
+            }
+            else {
+                return false;
+            }
+            hasFormat = true;
+        }
+        else if (keyword == "element") {
+            PlyElement element;
+            if (!(line >> element.name >> element.count)) {
+                return false;
+            }
+            header.elements.push_back(std::move(element));
+        }
+        else if (keyword == "property") {
+            if (header.elements.empty()) {
+                return false;
+            }
+            PlyProperty property;
+            std::string type;
+            line >> type;
+            if (type == "list") {
+                std::string countType, itemType;
+                line >> countType >> itemType;
+                property.countType = parseScalarType(countType);
+                property.type = parseScalarType(itemType);
+                if (property.countType == ScalarType::Invalid) {
+                    return false;
+                }
+            }
+            else {
+                property.type = parseScalarType(type);
+            }
+            if (property.type == ScalarType::Invalid || !(line >> property.name)) {
+                return false;
+            }
+            header.elements.back().properties.push_back(std::move(property));
+        }
+        else if (keyword == "end_header") {
+            header.bodyOffset = size_t(cursor - data);
+            return hasFormat;
+        }
+        // comment、obj_info等行忽略
+    }
+    return false;
+}
+
+// 追加多边形的扇形三角化，拒绝越界的索引
+inline bool appendFan(const std::vector<long long>& polygon, long long nbVertices, std::vector<int>& triangles)
+{
+    for (long long index : polygon) {
+        if (index < 0 || index >= nbVertices) {
+            return false;
+        }
+    }
+    for (size_t k = 1; k + 1 < polygon.size(); ++k) {
+        triangles.push_back(int(polygon[0]));
+        triangles.push_back(int(polygon[k]));
+        triangles.push_back(int(polygon[k + 1]));
+    }
+    return true;
+}
+
+// 把平铺的三角形索引缓冲区移入面矩阵
+void assignFaces(const std::vector<int>& triangles, UnifiedModel::MeshData& mesh)
+{
+    const Eigen::Index nbTriangles = Eigen::Index(triangles.size() / 3);
+    mesh.faces = Eigen::Map<const Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor>>(
+        triangles.data(), nbTriangles, 3);
+}
+
+// 读取二进制PLY文件的数据体
+class BinaryBodyReader
+{
+public:
+    BinaryBodyReader(const PlyHeader& header,
+                     const char* data,
+                     size_t size,
+                     UnifiedModel::MeshData& mesh,
+                     ImportProgress& progress)
+        : myHeader(header),
+          myCursor(data + header.bodyOffset),
+          myEnd(data + size),
+          myMesh(mesh),
+          myProgress(progress),
+          myToSwap(isLittleEndianHost() != (header.format == PlyFormat::BinaryLittleEndian))
+    {}
+
+    bool read(const std::string& filePath)
+    {
+        for (size_t elementIndex = 0; elementIndex < myHeader.elements.size(); ++elementIndex) {
+            const PlyElement& element = myHeader.elements[elementIndex];
+            bool isRead = false;
+            if (element.name == "vertex") {
+                isRead = readVertices(element);
+            }
+            else if (element.name == "face") {
+                isRead = readFaces(element, elementIndex);
+            }
+            else {
+                isRead = skipElement(element);
+            }
+            if (!isRead) {
+                if (!myProgress.isCancelled()) {
+                    getPlyLogger()->error("Invalid or truncated PLY element '{}' in {}", element.name, filePath);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // 顶点记录长度固定，按属性偏移直接从映射内存中并行批量读取
+    bool readVertices(const PlyElement& element)
+    {
+        const size_t stride = recordStride(element);
+        const VertexLayout layout = findVertexLayout(element);
+        if (stride == 0 || layout.position[0] < 0 || layout.position[1] < 0 || layout.position[2] < 0
+            || size_t(myEnd - myCursor) / stride < element.count) {
+            return false;
+        }
+
+        std::vector<size_t> offsets;
+        size_t offset = 0;
+        for (const PlyProperty& property : element.properties) {
+            offsets.push_back(offset);
+            offset += scalarSize(property.type);
+        }
+
+        const Eigen::Index nbVertices = Eigen::Index(element.count);
+        myMesh.vertices.resize(nbVertices, 3);
+        if (layout.hasNormals()) {
+            myMesh.vertexNormals.resize(nbVertices, 3);
+        }
+        if (layout.hasColors()) {
+            myMesh.vertexColors.resize(nbVertices, 3);
+        }
+
+        const char* records = myCursor;
+        const bool toSwap = myToSwap;
+        auto copyColumns = [&](const int (&properties)[3], Eigen::MatrixXd& target, double scale,
+                               size_t begin, size_t end) {
+            for (int c = 0; c < 3; ++c) {
+                const size_t propertyOffset = offsets[size_t(properties[c])];
+                const ScalarType type = element.properties[size_t(properties[c])].type;
+                double* column = target.col(c).data();
+                for (size_t i = begin; i < end; ++i) {
+                    column[i] = loadScalar(records + i * stride + propertyOffset, type, toSwap) * scale;
+                }
+            }
+        };
+        std::atomic<bool> isCancelled{false};
+        Utils::parallelFor(0, element.count, RECORD_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            if (myProgress.isCancelled()) {
+                isCancelled = true;
+                return;
+            }
+            copyColumns(layout.position, myMesh.vertices, 1.0, begin, end);
+            if (layout.hasNormals()) {
+                copyColumns(layout.normal, myMesh.vertexNormals, 1.0, begin, end);
+            }
+            if (layout.hasColors()) {
+                const double colorFactor = colorScale(element.properties[size_t(layout.color[0])].type);
+                copyColumns(layout.color, myMesh.vertexColors, colorFactor, begin, end);
+            }
+        });
+        myCursor += element.count * stride;
+        return !isCancelled;
+    }
+
+    bool readFaces(const PlyElement& element, size_t elementIndex)
+    {
+        const int indexList = findIndexList(element);
+        if (indexList < 0) {
+            return false;
+        }
+        return readTriangleFaces(element, elementIndex, indexList)
+            || (!myProgress.isCancelled() && readPolygonFaces(element, indexList));
+    }
+
+    // 全部为三角形时面记录长度固定，直接批量拷贝索引
+    bool readTriangleFaces(const PlyElement& element, size_t elementIndex, int indexList)
+    {
+        size_t stride = 0;
+        size_t countOffset = 0;
+        for (size_t i = 0; i < element.properties.size(); ++i) {
+            const PlyProperty& property = element.properties[i];
+            if (int(i) == indexList) {
+                countOffset = stride;
+                stride += scalarSize(property.countType) + 3 * scalarSize(property.type);
+            }
+            else if (property.isList()) {
+                return false;
+            }
+            else {
+                stride += scalarSize(property.type);
+            }
+        }
+
+        // 假设的记录长度必须与文件剩余长度完全吻合，否则按多边形逐条读取
+        size_t trailingSize = 0;
+        for (size_t i = elementIndex + 1; i < myHeader.elements.size(); ++i) {
+            const size_t trailingStride = recordStride(myHeader.elements[i]);
+            if (trailingStride == 0 && myHeader.elements[i].count > 0) {
+                return false;
+            }
+            trailingSize += trailingStride * myHeader.elements[i].count;
+        }
+        const size_t remaining = size_t(myEnd - myCursor);
+        if (remaining / stride < element.count || remaining - element.count * stride != trailingSize) {
+            return false;
+        }
+
+        const PlyProperty& list = element.properties[size_t(indexList)];
+        const size_t countSize = scalarSize(list.countType);
+        const size_t indexSize = scalarSize(list.type);
+        const long long nbVertices = (long long)myMesh.vertices.rows();
+        const char* records = myCursor;
+        const bool toSwap = myToSwap;
+
+        myMesh.faces.resize(Eigen::Index(element.count), 3);
+        std::atomic<bool> isValid{true};
+        Utils::parallelFor(0, element.count, RECORD_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            if (myProgress.isCancelled()) {
+                isValid = false;
+                return;
+            }
+            for (size_t f = begin; f < end && isValid; ++f) {
+                const char* record = records + f * stride + countOffset;
+                if (loadInteger(record, list.countType, toSwap) != 3) {
+                    isValid = false;
+                    return;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    const long long index =
+                        loadInteger(record + countSize + size_t(c) * indexSize, list.type, toSwap);
+                    if (index < 0 || index >= nbVertices) {
+                        isValid = false;
+                        return;
+                    }
+                    myMesh.faces(Eigen::Index(f), c) = int(index);
+                }
+            }
+            if (isValid) {
+                myProgress.publishPreview(myMesh, begin, end);
+            }
+        });
+        if (!isValid) {
+            return false;
+        }
+        myCursor += element.count * stride;
+        return true;
+    }
+
+    bool readPolygonFaces(const PlyElement& element, int indexList)
+    {
+        const long long nbVertices = (long long)myMesh.vertices.rows();
+        std::vector<int> triangles;
+        triangles.reserve(element.count * 3);
+        std::vector<long long> polygon;
+        for (size_t f = 0; f < element.count; ++f) {
+            if (f % RECORD_CHUNK_SIZE == 0 && myProgress.isCancelled()) {
+                return false;
+            }
+            for (size_t i = 0; i < element.properties.size(); ++i) {
+                const PlyProperty& property = element.properties[i];
+                if (!property.isList()) {
+                    if (!skip(scalarSize(property.type))) {
+                        return false;
+                    }
+                    continue;
+                }
+                const size_t countSize = scalarSize(property.countType);
+                if (size_t(myEnd - myCursor) < countSize) {
+                    return false;
+                }
+                const long long count = loadInteger(myCursor, property.countType, myToSwap);
+                myCursor += countSize;
+                const size_t itemSize = scalarSize(property.type);
+                if (count < 0 || size_t(myEnd - myCursor) / itemSize < size_t(count)) {
+                    return false;
+                }
+                if (int(i) == indexList) {
+                    polygon.resize(size_t(count));
+                    for (long long k = 0; k < count; ++k) {
+                        polygon[size_t(k)] = loadInteger(myCursor + size_t(k) * itemSize, property.type, myToSwap);
+                    }
+                    if (!appendFan(polygon, nbVertices, triangles)) {
+                        return false;
+                    }
+                }
+                myCursor += size_t(count) * itemSize;
+            }
+        }
+        assignFaces(triangles, myMesh);
+        return true;
+    }
+
+    bool skipElement(const PlyElement& element)
+    {
+        const size_t stride = recordStride(element);
+        if (stride > 0) {
+            return size_t(myEnd - myCursor) / stride >= element.count && skip(stride * element.count);
+        }
+        // 含列表属性的元素记录长度不定，只能逐条跳过
+        for (size_t r = 0; r < element.count; ++r) {
+            for (const PlyProperty& property : element.properties) {
+                if (!property.isList()) {
+                    if (!skip(scalarSize(property.type))) {
+                        return false;
+                    }
+                    continue;
+                }
+                const size_t countSize = scalarSize(property.countType);
+                if (size_t(myEnd - myCursor) < countSize) {
+                    return false;
+                }
+                const long long count = loadInteger(myCursor, property.countType, myToSwap);
+                if (count < 0 || !skip(countSize + size_t(count) * scalarSize(property.type))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool skip(size_t bytes)
+    {
+        if (size_t(myEnd - myCursor) < bytes) {
+            return false;
+        }
+        myCursor += bytes;
+        return true;
+    }
+
+private:
+    const PlyHeader& myHeader;
+    const char* myCursor;
+    const char* myEnd;
+    UnifiedModel::MeshData& myMesh;
+    ImportProgress& myProgress;
+    bool myToSwap;
+};
+
+// 读取ASCII PLY数据体中以空白分隔的数字
+class AsciiTokenizer
+{
+public:
+    AsciiTokenizer(const char* begin, const char* end)
+        : myCursor(begin),
+          myEnd(end)
+    {}
+
+    bool next(double& value)
+    {
+        while (myCursor < myEnd && (*myCursor == ' ' || *myCursor == '\t' || *myCursor == '\r' || *myCursor == '\n')) {
+            ++myCursor;
+        }
+        if (myCursor < myEnd && *myCursor == '+') {
+            ++myCursor;
+        }
+        const std::from_chars_result result = std::from_chars(myCursor, myEnd, value);
+        myCursor = result.ptr;
+        return result.ec == std::errc();
+    }
+
+    const char* cursor() const { return myCursor; }
+
+private:
+    const char* myCursor;
+    const char* myEnd;
+};
+
+// 逐条记录读取ASCII PLY文件的数据体
+bool readAsciiBody(const PlyHeader& header,
+                   const char* data,
+                   size_t size,
+                   UnifiedModel::MeshData& mesh,
+                   ImportProgress& progress,
+                   const std::string& filePath)
+{
+    AsciiTokenizer tokens(data + header.bodyOffset, data + size);
+    std::vector<double> values;
+    std::vector<long long> polygon;
+    std::vector<int> triangles;
+    for (const PlyElement& element : header.elements) {
+        const bool isVertex = element.name == "vertex";
+        const bool isFace = element.name == "face";
+        const VertexLayout layout = findVertexLayout(element);
+        const int indexList = isFace ? findIndexList(element) : -1;
+        bool isValid = true;
+        if (isVertex) {
+            isValid = layout.position[0] >= 0 && layout.position[1] >= 0 && layout.position[2] >= 0;
+            const Eigen::Index nbVertices = Eigen::Index(element.count);
+            mesh.vertices.resize(nbVertices, 3);
+            if (layout.hasNormals()) {
+                mesh.vertexNormals.resize(nbVertices, 3);
+            }
+            if (layout.hasColors()) {
+                mesh.vertexColors.resize(nbVertices, 3);
+            }
+        }
+        if (isFace) {
+            isValid = indexList >= 0;
+            triangles.reserve(element.count * 3);
+        }
+        const double colorFactor =
+            isVertex && layout.hasColors() ? colorScale(element.properties[size_t(layout.color[0])].type) : 1.0;
+
+        values.resize(element.properties.size());
+        for (size_t r = 0; r < element.count && isValid; ++r) {
+            if (r % RECORD_CHUNK_SIZE == 0 && progress.isCancelled()) {
+                return false;
+            }
+            for (size_t i = 0; i < element.properties.size() && isValid; ++i) {
+                if (!element.properties[i].isList()) {
+                    isValid = tokens.next(values[i]);
+                    continue;
+                }
+                double count = 0.0;
+                isValid = tokens.next(count) && count >= 0.0;
+                polygon.clear();
+                for (long long k = 0; k < (long long)count && isValid; ++k) {
+                    double item = 0.0;
+                    isValid = tokens.next(item);
+                    polygon.push_back((long long)item);
+                }
+                if (isValid && int(i) == indexList) {
+                    isValid = appendFan(polygon, (long long)mesh.vertices.rows(), triangles);
+                }
+            }
+            if (isValid && isVertex) {
+                const Eigen::Index row = Eigen::Index(r);
+                for (int c = 0; c < 3; ++c) {
+                    mesh.vertices(row, c) = values[size_t(layout.position[c])];
+                    if (layout.hasNormals()) {
+                        mesh.vertexNormals(row, c) = values[size_t(layout.normal[c])];
+                    }
+                    if (layout.hasColors()) {
+                        mesh.vertexColors(row, c) = values[size_t(layout.color[c])] * colorFactor;
+                    }
+                }
+            }
+        }
+        if (!isValid) {
+            getPlyLogger()->error("Invalid or truncated PLY element '{}' at byte {} of {}",
+                                  element.name,
+                                  size_t(tokens.cursor() - data),
+                                  filePath);
+            return false;
+        }
+        if (isFace) {
+            assignFaces(triangles, mesh);
+        }
+    }
+    return true;
+}
+
+// 并行计算面法向；与igl::per_face_normals一样，退化面的法向为零
+bool computeFaceNormals(UnifiedModel::MeshData& mesh, ImportProgress& progress)
+{
+    const size_t nbTriangles = size_t(mesh.faces.rows());
+    mesh.normals.resize(Eigen::Index(nbTriangles), 3);
+    std::atomic<bool> isCancelled{false};
+    Utils::parallelFor(0, nbTriangles, RECORD_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        if (progress.isCancelled()) {
+            isCancelled = true;
+            return;
+        }
+        for (size_t t = begin; t < end; ++t) {
+            const Eigen::RowVector3d p0 = mesh.vertices.row(mesh.faces(Eigen::Index(t), 0));
+            const Eigen::RowVector3d v1 = mesh.vertices.row(mesh.faces(Eigen::Index(t), 1)) - p0;
+            const Eigen::RowVector3d v2 = mesh.vertices.row(mesh.faces(Eigen::Index(t), 2)) - p0;
+            const Eigen::RowVector3d n = v1.cross(v2);
+            const double length = n.norm();
+            mesh.normals.row(Eigen::Index(t)) =
+                length > 0.0 ? Eigen::RowVector3d(n / length) : Eigen::RowVector3d::Zero();
+        }
+    });
+    return !isCancelled;
+}
+}  // namespace
+
+bool PlyReader::read(const std::string& filePath,
+                     UnifiedModel::MeshData& mesh,
+                     ImportProgress& progress,
+                     double fromFraction,
+                     double toFraction)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    progress.setStage("Reading PLY file");
+    progress.setFraction(fromFraction);
+
+    ImportStageTimer mapTimer(progress, "map");
+    Utils::MappedFile file;
+    if (!file.open(filePath)) {
+        getPlyLogger()->error("Failed to open PLY file: {}", filePath);
+        return false;
+    }
+    mapTimer.setBytes(file.size());
+    mapTimer.stop();
+
+    ImportStageTimer parseTimer(progress, "parse");
+    parseTimer.setBytes(file.size());
+    PlyHeader header;
+    if (!parseHeader(file.data(), file.size(), header)) {
+        getPlyLogger()->error("Invalid PLY header: {}", filePath);
+        return false;
+    }
+    auto vertexIt = std::find_if(header.elements.begin(), header.elements.end(), [](const PlyElement& element) {
+        return element.name == "vertex";
+    });
+    auto faceIt = std::find_if(header.elements.begin(), header.elements.end(), [](const PlyElement& element) {
+        return element.name == "face";
+    });
+    if (vertexIt == header.elements.end() || faceIt == header.elements.end() || faceIt < vertexIt) {
+        // 点云或面在顶点之前的文件不支持
+        getPlyLogger()->error("PLY file must declare vertices before faces: {}", filePath);
+        return false;
+    }
+    if (vertexIt->count > size_t(std::numeric_limits<int>::max())
+        || faceIt->count > size_t(std::numeric_limits<int>::max())) {
+        getPlyLogger()->error("PLY file is too large for 32-bit indices: {}", filePath);
+        return false;
+    }
+    // 声明的记录数不能超过文件剩余字节所能容纳的数量，否则按数量预留内存会失败
+    // （ASCII文件最后一个值后面可以没有分隔符）
+    const size_t bodySize = file.size() - header.bodyOffset + (header.format == PlyFormat::Ascii ? 1 : 0);
+    for (const PlyElement& element : header.elements) {
+        const size_t recordSize = minimumRecordSize(element, header.format);
+        if (recordSize > 0 && bodySize / recordSize < element.count) {
+            getPlyLogger()->error("PLY element '{}' declares {} records, more than the file holds: {}",
+                                  element.name,
+                                  element.count,
+                                  filePath);
+            return false;
+        }
+    }
+
+    const bool isRead = header.format == PlyFormat::Ascii
+        ? readAsciiBody(header, file.data(), file.size(), mesh, progress, filePath)
+        : BinaryBodyReader(header, file.data(), file.size(), mesh, progress).read(filePath);
+    if (!isRead) {
+        return false;
+    }
+    if (mesh.faces.rows() == 0) {
+        getPlyLogger()->error("PLY file contains no faces: {}", filePath);
+        return false;
+    }
+    parseTimer.setElements(std::uint64_t(mesh.faces.rows()));
+    parseTimer.stop();
+    progress.setFraction(fromFraction + (toFraction - fromFraction) * 0.8);
+
+    progress.setStage("Computing normals");
+    ImportStageTimer normalTimer(progress, "normals");
+    normalTimer.setElements(std::uint64_t(mesh.faces.rows()));
+    if (!computeFaceNormals(mesh, progress)) {
+        return false;
+    }
+    normalTimer.stop();
+    progress.setFraction(toFraction);
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const double megabytes = double(file.size()) / (1024.0 * 1024.0);
+    getPlyLogger()->info("Read {} PLY: {} vertices, {} triangles{}{}, {:.1f} MB in {:.3f} s ({:.1f} MB/s)",
+                         header.format == PlyFormat::Ascii ? "ASCII" : "binary",
+                         mesh.vertices.rows(),
+                         mesh.faces.rows(),
+                         mesh.vertexNormals.rows() > 0 ? ", normals" : "",
+                         mesh.vertexColors.rows() > 0 ? ", colors" : "",
+                         megabytes,
+                         seconds,
+                         seconds > 0.0 ? megabytes / seconds : 0.0);
+    return true;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file PlyReader.h
+ * @brief Defines the PlyReader class, a memory-mapped reader for binary and ASCII PLY files.
+ *
+ * Binary vertex records have a fixed stride, so their properties are gathered in parallel
+ * straight from the mapped file. Faces are copied the same way when every face is a
+ * triangle, which is what scanners export; other face lists are walked sequentially.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+#include "ImportProgress.h"
+
+#include <string>
+
+/**
+ * @class PlyReader
+ * @brief Reads PLY files (ASCII, binary little- and big-endian) into MeshData.
+ *
+ * Vertex positions (`x`, `y`, `z`) and faces (`vertex_indices` or `vertex_index`) are
+ * required. Vertex normals (`nx`, `ny`, `nz`) and colors (`red`, `green`, `blue`) are kept
+ * when present; other elements and properties are skipped. Polygons are triangulated as
+ * fans and face normals are computed from the vertex positions.
+ */
+class PlyReader {
+public:
+    /**
+     * @brief Reads a PLY file
+     *
+     * @param filePath The path to the PLY file
+     * @param mesh Receives the mesh
+     * @param progress Progress and cancellation state
+     * @param fromFraction Progress fraction at the start of the read
+     * @param toFraction Progress fraction at the end of the read
+     * @return bool True if the file was read, false on error or cancellation
+     */
+    bool read(const std::string& filePath,
+              UnifiedModel::MeshData& mesh,
+              ImportProgress& progress,
+              double fromFraction = 0.0,
+              double toFraction = 1.0);
+};
@@ -0,0 +1,304 @@
+#include "ShapeMesher.h"
+#include "MeshProcessing.h"
+#include "utils/Logger.h"
+#include "utils/Parallel.h"
+
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopExp_Explorer.hxx>
+
+// Netgen头文件依赖上面的OCCT头文件
+#include <meshing.hpp>
+#include <occgeom.hpp>
+#if __has_include(<netgen_version.hpp>)
+#include <netgen_version.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 创建网格剖分日志记录器
+static std::shared_ptr<Utils::Logger>& getMesherLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.mesher");
+    return logger;
+}
+
+namespace
+{
+// 串行执行网格划分：Netgen把进度和取消状态保存在全局变量中
+std::mutex NETGEN_MUTEX;
+
+// 转发Netgen进度的间隔
+constexpr std::chrono::milliseconds POLL_INTERVAL(50);
+
+// Netgen各阶段所占的进度比例，其余用于转换
+constexpr double MESHING_FRACTION = 0.95;
+
+// 在对象的生存期内进入Netgen任务管理器
+class TaskManagerScope
+{
+public:
+    explicit TaskManagerScope(unsigned int threadCount)
+    {
+        if (threadCount > 1) {
+            ngcore::TaskManager::SetNumThreads(int(threadCount));
+            myThreadCount = ngcore::EnterTaskManager();
+            myIsEntered = true;
+        }
+    }
+
+    ~TaskManagerScope()
+    {
+        if (myIsEntered) {
+            ngcore::ExitTaskManager(myThreadCount);
+        }
+    }
+
+    TaskManagerScope(const TaskManagerScope&) = delete;
+    TaskManagerScope& operator=(const TaskManagerScope&) = delete;
+
+private:
+    int myThreadCount = 0;
+    bool myIsEntered = false;
+};
+
+// 把Netgen的阶段和百分比转发到progress，把取消转发给Netgen，直到isDone被置位
+// Netgen任务每次变化开始新的阶段
+void monitorProgress(ImportProgress& progress, int nbPhases, const std::atomic<bool>& isDone)
+{
+    std::string task;
+    int phase = -1;
+    while (!isDone.load()) {
+        if (progress.isCancelled()) {
+            netgen::multithread.terminate = 1;
+        }
+
+        // 与Netgen图形界面相同，直接轮询其全局进度状态
+        const char* currentTask = netgen::multithread.task;
+        if (currentTask != nullptr && task != currentTask) {
+            task = currentTask;
+            ++phase;
+            progress.setStage(task);
+        }
+        const double percent = std::clamp(double(netgen::multithread.percent), 0.0, 100.0);
+        const int donePhases = std::clamp(phase, 0, nbPhases - 1);
+        progress.setFraction((donePhases + percent / 100.0) / nbPhases * MESHING_FRACTION);
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+}
+
+// 返回Netgen点序号对应的从0开始的序号
+int toIndex(netgen::PointIndex point)
+{
+    return int(point) - netgen::PointIndex::BASE;
+}
+
+// 返回三角形围成的有向体积（法向朝外时为正）
+double signedVolume(const UnifiedModel::MeshData& mesh)
+{
+    double volume = 0.0;
+    for (Eigen::Index i = 0; i < mesh.faces.rows(); ++i) {
+        const Eigen::Vector3d a = mesh.vertices.row(mesh.faces(i, 0));
+        const Eigen::Vector3d b = mesh.vertices.row(mesh.faces(i, 1));
+        const Eigen::Vector3d c = mesh.vertices.row(mesh.faces(i, 2));
+        volume += a.dot(b.cross(c));
+    }
+    return volume / 6.0;
+}
+} // namespace
+
+ShapeMesher::ShapeMesher(const Options& options)
+    : myOptions(options)
+{
+}
+
+bool ShapeMesher::mesh(const TopoDS_Shape& shape, Result& result, ImportProgress* progress) const
+{
+    result = Result();
+    if (shape.IsNull()) {
+        getMesherLogger()->warn("Cannot mesh a null shape");
+        return false;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    ImportProgress localProgress;
+    ImportProgress& meshProgress = progress ? *progress : localProgress;
+    const bool hasSolids = TopExp_Explorer(shape, TopAbs_SOLID).More();
+    const bool isVolume = myOptions.volume && hasSolids;
+
+    // 未指定最大尺寸时取包围盒对角线的十分之一
+    double maxSize = myOptions.maxSize;
+    if (maxSize <= 0.0) {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box);
+        maxSize = box.IsVoid() ? 1.0 : std::sqrt(box.SquareExtent()) / 10.0;
+    }
+
+    netgen::MeshingParameters parameters;
+    parameters.maxh = maxSize;
+    parameters.minh = std::clamp(myOptions.minSize, 0.0, maxSize);
+    parameters.grading = std::clamp(myOptions.grading, 0.01, 1.0);
+    parameters.segmentsperedge = std::max(0.0, myOptions.elementsPerEdge);
+    parameters.curvaturesafety = std::max(0.0, myOptions.elementsPerCurvature);
+    parameters.optsteps2d = std::max(0, myOptions.optimizationSteps);
+    parameters.optsteps3d = std::max(0, myOptions.optimizationSteps);
+    parameters.perfstepsstart = netgen::MESHCONST_ANALYSE;
+    parameters.perfstepsend = isVolume ? netgen::MESHCONST_OPTVOLUME : netgen::MESHCONST_OPTSURFACE;
+
+    const unsigned int threadCount =
+        myOptions.threadCount > 0 ? myOptions.threadCount : Utils::getParallelThreadCount();
+#if defined(NETGEN_VERSION_PATCH) && (NETGEN_VERSION_MAJOR > 6 || NETGEN_VERSION_PATCH >= 2204)
+    // 各实体的体网格可以并行剖分
+    parameters.parallel_meshing = threadCount > 1;
+    parameters.nthreads = int(threadCount);
+#endif
+
+    // 分析、边、面及其优化；体网格再增加两个阶段
+    const int nbPhases = isVolume ? 6 : 4;
+
+    std::lock_guard<std::mutex> lock(NETGEN_MUTEX);
+    netgen::multithread.terminate = 0;
+    netgen::multithread.percent = 0.0;
+    meshProgress.setFraction(0.0);
+
+    auto geometry = std::make_shared<netgen::OCCGeometry>(shape);
+    auto ngMesh = std::make_shared<netgen::Mesh>();
+    ngMesh->SetGeometry(geometry);
+
+    std::atomic<bool> isDone{false};
+    std::thread monitor(monitorProgress, std::ref(meshProgress), nbPhases, std::cref(isDone));
+    int status = 0;
+    try {
+        TaskManagerScope taskManager(threadCount);
+        status = geometry->GenerateMesh(ngMesh, parameters);
+    }
+    catch (const std::exception& e) {
+        getMesherLogger()->error("Netgen failed: {}", e.what());
+        status = -1;
+    }
+    catch (...) {
+        getMesherLogger()->error("Netgen failed with an unknown exception");
+        status = -1;
+    }
+    isDone.store(true);
+    monitor.join();
+
+    if (meshProgress.isCancelled() || netgen::multithread.terminate != 0) {
+        netgen::multithread.terminate = 0;
+        getMesherLogger()->info("Meshing cancelled");
+        return false;
+    }
+    if (status != 0) {
+        getMesherLogger()->error("Netgen meshing failed with status {}", status);
+        return false;
+    }
+    meshProgress.setStage("Converting mesh");
+
+    // 表面单元转换为三角形（四边形拆分为两个三角形），只保留用到的节点
+    const auto& points = ngMesh->Points();
+    std::vector<int> surfaceIndex(points.Size(), -1);
+    std::vector<std::array<int, 3>> triangles;
+    triangles.reserve(ngMesh->GetNSE());
+    int nbSurfaceNodes = 0;
+    for (const netgen::Element2d& element : ngMesh->SurfaceElements()) {
+        if (element.IsDeleted() || element.GetNV() < 3) {
+            continue;
+        }
+        std::array<int, 4> corners{};
+        for (int k = 0; k < element.GetNV() && k < 4; ++k) {
+            int& index = surfaceIndex[toIndex(element[k])];
+            if (index < 0) {
+                index = nbSurfaceNodes++;
+            }
+            corners[k] = index;
+        }
+        triangles.push_back({corners[0], corners[1], corners[2]});
+        if (element.GetNV() == 4) {
+            triangles.push_back({corners[0], corners[2], corners[3]});
+        }
+    }
+
+    UnifiedModel::MeshData& surface = result.surface;
+    surface.vertices.resize(nbSurfaceNodes, 3);
+    int pointIndex = 0;
+    for (const netgen::MeshPoint& point : points) {
+        const int index = surfaceIndex[pointIndex++];
+        if (index >= 0) {
+            surface.vertices.row(index) << point(0), point(1), point(2);
+        }
+    }
+    surface.faces.resize(Eigen::Index(triangles.size()), 3);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        surface.faces.row(Eigen::Index(i)) << triangles[i][0], triangles[i][1], triangles[i][2];
+    }
+
+    // 实体的法向统一朝外；平面着色，不计算顶点法向
+    if (hasSolids && signedVolume(surface) < 0.0) {
+        surface.faces.col(1).swap(surface.faces.col(2));
+    }
+    MeshProcessing::computeNormals(surface, false);
+
+    if (isVolume) {
+        result.volumeNodes.resize(Eigen::Index(points.Size()), 3);
+        pointIndex = 0;
+        for (const netgen::MeshPoint& point : points) {
+            result.volumeNodes.row(pointIndex++) << point(0), point(1), point(2);
+        }
+
+        // 只保留线性四面体单元
+        result.tetrahedra.resize(Eigen::Index(ngMesh->GetNE()), 4);
+        Eigen::Index nbTetrahedra = 0;
+        for (const netgen::Element& element : ngMesh->VolumeElements()) {
+            if (element.IsDeleted() || element.GetNV() != 4) {
+                continue;
+            }
+            for (int k = 0; k < 4; ++k) {
+                result.tetrahedra(nbTetrahedra, k) = toIndex(element[k]);
+            }
+            ++nbTetrahedra;
+        }
+        result.tetrahedra.conservativeResize(nbTetrahedra, 4);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    meshProgress.setFraction(1.0);
+    getMesherLogger()->info("Meshed shape into {} triangles and {} tetrahedra in {:.3f} s (max size {:.4g})",
+                            surface.faces.rows(), result.tetrahedra.rows(), result.seconds, maxSize);
+    return true;
+}
+
+UnifiedModel::MeshData ShapeMesher::makeVolumeMesh(const Result& result)
+{
+    UnifiedModel::MeshData mesh;
+    mesh.vertices = result.volumeNodes;
+    mesh.faces.resize(result.tetrahedra.rows() * 4, 3);
+    for (Eigen::Index i = 0; i < result.tetrahedra.rows(); ++i) {
+        // 按正向的顶点顺序输出四个面，面法向朝向四面体外侧
+        int a = result.tetrahedra(i, 0);
+        int b = result.tetrahedra(i, 1);
+        const int c = result.tetrahedra(i, 2);
+        const int d = result.tetrahedra(i, 3);
+        const Eigen::Vector3d ab = mesh.vertices.row(b) - mesh.vertices.row(a);
+        const Eigen::Vector3d ac = mesh.vertices.row(c) - mesh.vertices.row(a);
+        const Eigen::Vector3d ad = mesh.vertices.row(d) - mesh.vertices.row(a);
+        if (ab.cross(ac).dot(ad) < 0.0) {
+            std::swap(a, b);
+        }
+        mesh.faces.row(4 * i) << a, c, b;
+        mesh.faces.row(4 * i + 1) << a, b, d;
+        mesh.faces.row(4 * i + 2) << a, d, c;
+        mesh.faces.row(4 * i + 3) << b, c, d;
+    }
+    MeshProcessing::computeNormals(mesh, false);
+    return mesh;
+}
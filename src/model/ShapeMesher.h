@@ -0,0 +1,118 @@
+/**
+ * @file ShapeMesher.h
+ * @brief Defines the ShapeMesher class which meshes CAD shapes with Netgen.
+ *
+ * Unlike the OCCT tessellation used for display, Netgen produces quality meshes whose
+ * element sizes are controlled explicitly: a surface mesh of the faces and, optionally,
+ * a tetrahedral volume mesh of the solids.
+ */
+#pragma once
+
+#include "ImportProgress.h"
+#include "UnifiedModel.h"
+
+#include <Eigen/Core>
+#include <TopoDS_Shape.hxx>
+
+/**
+ * @class ShapeMesher
+ * @brief Generates surface and volume meshes of shapes with Netgen.
+ *
+ * Netgen keeps its progress state in process-wide globals, so meshing runs are
+ * serialized; within a run, Netgen's task manager uses the requested number of
+ * threads (optimization passes and the volume meshing of separate solids).
+ */
+class ShapeMesher {
+public:
+    /**
+     * @brief Size parameters of the generated mesh
+     */
+    struct Options {
+        /** Maximum element size (0: a tenth of the bounding box diagonal) */
+        double maxSize = 0.0;
+
+        /** Minimum element size */
+        double minSize = 0.0;
+
+        /** Growth rate of the element size away from small features, in (0, 1] */
+        double grading = 0.3;
+
+        /** Minimum number of elements per edge */
+        double elementsPerEdge = 1.0;
+
+        /** Minimum number of elements per radius of curvature */
+        double elementsPerCurvature = 2.0;
+
+        /** Number of smoothing and swapping passes on the surface and volume mesh */
+        int optimizationSteps = 3;
+
+        /** Whether the solids are filled with tetrahedra after the surface meshing */
+        bool volume = false;
+
+        /** Threads used by Netgen (0: one per hardware thread) */
+        unsigned int threadCount = 0;
+    };
+
+    /**
+     * @brief Generated mesh of a shape
+     */
+    struct Result {
+        /** Triangles of the faces (the boundary of the volume mesh), with face normals */
+        UnifiedModel::MeshData surface;
+
+        /** Positions of all nodes of the volume mesh (n x 3, empty for surface meshing) */
+        Eigen::MatrixXd volumeNodes;
+
+        /** Tetrahedra as indices into volumeNodes (m x 4, empty for surface meshing) */
+        Eigen::MatrixXi tetrahedra;
+
+        /** Wall-clock time of the meshing */
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Constructor with the default size parameters
+     */
+    ShapeMesher() = default;
+
+    /**
+     * @brief Constructor
+     * @param options The size parameters
+     */
+    explicit ShapeMesher(const Options& options);
+
+    /**
+     * @brief Gets the size parameters
+     * @return The options
+     */
+    const Options& getOptions() const { return myOptions; }
+
+    /**
+     * @brief Meshes a shape
+     *
+     * The shape is read by Netgen and may receive additional data (e.g. a triangulation
+     * of its faces), so it must not be used by other threads during the call.
+     *
+     * @param shape The shape to mesh
+     * @param result Receives the generated mesh
+     * @param progress Receives the Netgen stage and fraction; cancellation is forwarded to Netgen (optional)
+     * @return bool False if the meshing failed or was cancelled
+     */
+    bool mesh(const TopoDS_Shape& shape, Result& result, ImportProgress* progress = nullptr) const;
+
+    /**
+     * @brief Converts the tetrahedra of a result into a triangle mesh
+     *
+     * The vertices are the volume nodes. Tetrahedron i becomes the faces 4i to 4i+3, oriented
+     * outwards, so the tetrahedra can be recovered from the faces and the inner faces show the
+     * elements when the mesh is drawn with its edges.
+     *
+     * @param result A result of a volume meshing
+     * @return UnifiedModel::MeshData The mesh (empty if the result has no tetrahedra)
+     */
+    static UnifiedModel::MeshData makeVolumeMesh(const Result& result);
+
+private:
+    /** The size parameters */
+    Options myOptions;
+};
@@ -0,0 +1,492 @@
+#include "StlReader.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// 创建STL读取器日志记录器
+static std::shared_ptr<Utils::Logger>& getStlLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.stl");
+    return logger;
+}
+
+namespace
+{
+// 二进制STL文件头的长度（80字节文本 + 32位三角形数）
+constexpr size_t BINARY_HEADER_SIZE = 84;
+
+// 二进制STL一条三角形记录的长度（法向、3个顶点、属性）
+constexpr size_t BINARY_RECORD_SIZE = 50;
+
+// 两次取消检查之间处理的三角形数
+constexpr size_t TRIANGLE_CHUNK_SIZE = 65536;
+
+// 每一波焊接的三角形数，完成的一波可以推送到预览
+constexpr size_t WAVE_TRIANGLES = size_t(1) << 20;
+
+// 角点位置的位模式，用作精确焊接的键
+using CornerKey = std::array<std::uint32_t, 3>;
+
+// 焊接哈希表的空槽标记
+constexpr std::uint32_t EMPTY_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+// 头部以"solid"开头但大小不符的文件，检查数据开头这么多字节判断是否为二进制
+constexpr size_t PAYLOAD_PROBE_SIZE = 4096;
+
+// -0.0与+0.0的位模式不同，统一为+0.0，与MeshProcessing的焊接键一致
+inline CornerKey normalizeZeros(CornerKey key)
+{
+    for (std::uint32_t& bits : key) {
+        if (bits == 0x80000000u) {
+            bits = 0;
+        }
+    }
+    return key;
+}
+
+// 把角点三个坐标的位模式混合为64位哈希
+inline std::uint64_t hashKey(const CornerKey& key)
+{
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (std::uint32_t bits : key) {
+        hash ^= bits;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+// 直接从映射的二进制STL文件的记录中读取角点位置
+// 二进制STL为小端序，与所有支持的平台相同
+struct BinaryCorners
+{
+    const char* records;
+
+    const char* position(size_t corner) const
+    {
+        return records + (corner / 3) * BINARY_RECORD_SIZE + 12 + (corner % 3) * 12;
+    }
+
+    CornerKey key(size_t corner) const
+    {
+        CornerKey result;
+        std::memcpy(result.data(), position(corner), sizeof(result));
+        return normalizeZeros(result);
+    }
+
+    std::array<float, 3> point(size_t corner) const
+    {
+        std::array<float, 3> result;
+        std::memcpy(result.data(), position(corner), sizeof(result));
+        return result;
+    }
+};
+
+// 从ASCII解析器填充的平铺缓冲区读取角点位置
+struct BufferCorners
+{
+    const float* coordinates;
+
+    CornerKey key(size_t corner) const
+    {
+        CornerKey result;
+        std::memcpy(result.data(), coordinates + corner * 3, sizeof(result));
+        return normalizeZeros(result);
+    }
+
+    std::array<float, 3> point(size_t corner) const
+    {
+        return {coordinates[corner * 3], coordinates[corner * 3 + 1], coordinates[corner * 3 + 2]};
+    }
+};
+
+// 把相同的角点焊接为顶点并填充网格缓冲区
+template <typename Corners>
+bool buildMesh(size_t nbTriangles,
+               const Corners& corners,
+               UnifiedModel::MeshData& mesh,
+               ImportProgress& progress,
+               double from,
+               double to)
+{
+    const size_t nbCorners = nbTriangles * 3;
+    if (nbCorners > size_t(std::numeric_limits<int>::max())) {
+        getStlLogger()->error("STL file has too many triangles: {}", nbTriangles);
+        return false;
+    }
+
+    // 用开放寻址哈希表查找位置完全相同的角点；表按哈希值划分给各线程。
+    // 角点按文件顺序分批处理：每批先计算哈希并按分区分桶（桶内保持角点顺序），
+    // 各线程再只处理自己分区的桶，因此每组的代表总是首次出现的角点。
+    // 每批结束后其三角形即为最终结果，可以流式预览
+    progress.setStage("Welding vertices");
+    const size_t nbParts = std::min<size_t>(Utils::getParallelThreadCount(),
+                                             std::max<size_t>(1, nbCorners / TRIANGLE_CHUNK_SIZE));
+    size_t partCapacity = 16;
+    while (partCapacity < 2 * nbCorners / nbParts + 16) {
+        partCapacity *= 2;
+    }
+
+    std::vector<std::vector<std::uint32_t>> tables(nbParts);
+    std::vector<std::uint32_t> representative(nbCorners);
+    std::vector<std::uint32_t> vertexIndex(nbCorners);
+    std::vector<std::uint32_t> vertexCorners;
+    mesh.faces.resize(Eigen::Index(nbTriangles), 3);
+    mesh.normals.resize(Eigen::Index(nbTriangles), 3);
+    std::atomic<bool> isCancelled{false};
+
+    // 每批复用的缓冲区：角点的哈希、按分区排列的角点、每块每分区的计数（随后改为写入位置）和每块的新顶点数
+    const size_t waveCorners = std::min(nbCorners, WAVE_TRIANGLES * 3);
+    const size_t maxWaveChunks = (waveCorners + TRIANGLE_CHUNK_SIZE - 1) / TRIANGLE_CHUNK_SIZE;
+    std::vector<std::uint64_t> hashes(waveCorners);
+    std::vector<std::uint32_t> bucketCorners(waveCorners);
+    std::vector<size_t> chunkOffsets(maxWaveChunks * nbParts);
+    std::vector<size_t> partBegins(nbParts + 1);
+    std::vector<size_t> chunkVertices(maxWaveChunks);
+
+    // 焊接与法向量交替按批进行，分别累计两者的耗时（映射文件的缺页读取计入焊接）
+    ImportStageTiming weldTiming{"weld", 0.0, 0, nbTriangles};
+    ImportStageTiming normalTiming{"normals", 0.0, 0, nbTriangles};
+    auto stageStart = std::chrono::steady_clock::now();
+    auto elapsed = [&stageStart]() {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - stageStart).count();
+        stageStart = now;
+        return seconds;
+    };
+    for (size_t waveBegin = 0; waveBegin < nbTriangles; waveBegin += WAVE_TRIANGLES) {
+        const size_t waveEnd = std::min(nbTriangles, waveBegin + WAVE_TRIANGLES);
+        const size_t cornerBegin = waveBegin * 3;
+        const size_t cornerEnd = waveEnd * 3;
+        const size_t nbChunks = (cornerEnd - cornerBegin + TRIANGLE_CHUNK_SIZE - 1) / TRIANGLE_CHUNK_SIZE;
+        auto chunkRange = [&](size_t chunk) {
+            const size_t begin = cornerBegin + chunk * TRIANGLE_CHUNK_SIZE;
+            return std::make_pair(begin, std::min(cornerEnd, begin + TRIANGLE_CHUNK_SIZE));
+        };
+
+        // 每个角点只计算一次哈希，并统计每块中各分区的角点数
+        Utils::parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                size_t* counts = &chunkOffsets[chunk * nbParts];
+                std::fill(counts, counts + nbParts, size_t(0));
+                const auto range = chunkRange(chunk);
+                for (size_t corner = range.first; corner < range.second; ++corner) {
+                    const std::uint64_t hash = hashKey(corners.key(corner));
+                    hashes[corner - cornerBegin] = hash;
+                    ++counts[(hash >> 32) % nbParts];
+                }
+            }
+        });
+
+        // 分区依次排列，分区内按块的顺序排列
+        size_t offset = 0;
+        for (size_t part = 0; part < nbParts; ++part) {
+            partBegins[part] = offset;
+            for (size_t chunk = 0; chunk < nbChunks; ++chunk) {
+                const size_t count = chunkOffsets[chunk * nbParts + part];
+                chunkOffsets[chunk * nbParts + part] = offset;
+                offset += count;
+            }
+        }
+        partBegins[nbParts] = offset;
+
+        Utils::parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                size_t* offsets = &chunkOffsets[chunk * nbParts];
+                const auto range = chunkRange(chunk);
+                for (size_t corner = range.first; corner < range.second; ++corner) {
+                    const size_t part = (hashes[corner - cornerBegin] >> 32) % nbParts;
+                    bucketCorners[offsets[part]++] = std::uint32_t(corner);
+                }
+            }
+        });
+
+        Utils::parallelFor(0, nbParts, 1, [&](size_t partBegin, size_t partEnd) {
+            for (size_t part = partBegin; part < partEnd; ++part) {
+                std::vector<std::uint32_t>& table = tables[part];
+                if (table.empty()) {
+                    table.assign(partCapacity, EMPTY_SLOT);
+                }
+                for (size_t i = partBegins[part]; i < partBegins[part + 1]; ++i) {
+                    const size_t corner = bucketCorners[i];
+                    const CornerKey key = corners.key(corner);
+                    const std::uint64_t hash = hashes[corner - cornerBegin];
+                    for (size_t slot = hash & (partCapacity - 1);; slot = (slot + 1) & (partCapacity - 1)) {
+                        if (table[slot] == EMPTY_SLOT) {
+                            table[slot] = std::uint32_t(corner);
+                            representative[corner] = std::uint32_t(corner);
+                            break;
+                        }
+                        if (corners.key(table[slot]) == key) {
+                            representative[corner] = table[slot];
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        if (progress.isCancelled()) {
+            return false;
+        }
+
+        // 按首次出现的顺序为顶点编号：先统计每块的新顶点数，再并行编号；顶点坐标在全部焊接完成后再写入
+        Utils::parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                const auto range = chunkRange(chunk);
+                size_t count = 0;
+                for (size_t corner = range.first; corner < range.second; ++corner) {
+                    count += representative[corner] == corner ? 1 : 0;
+                }
+                chunkVertices[chunk] = count;
+            }
+        });
+        size_t nbVertices = vertexCorners.size();
+        for (size_t chunk = 0; chunk < nbChunks; ++chunk) {
+            const size_t count = chunkVertices[chunk];
+            chunkVertices[chunk] = nbVertices;
+            nbVertices += count;
+        }
+        vertexCorners.resize(nbVertices);
+        Utils::parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                const auto range = chunkRange(chunk);
+                size_t vertex = chunkVertices[chunk];
+                for (size_t corner = range.first; corner < range.second; ++corner) {
+                    if (representative[corner] == corner) {
+                        vertexIndex[corner] = std::uint32_t(vertex);
+                        vertexCorners[vertex++] = std::uint32_t(corner);
+                    }
+                }
+            }
+        });
+        Utils::parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                const auto range = chunkRange(chunk);
+                for (size_t corner = range.first; corner < range.second; ++corner) {
+                    mesh.faces(Eigen::Index(corner / 3), Eigen::Index(corner % 3)) =
+                        int(vertexIndex[representative[corner]]);
+                }
+            }
+        });
+        weldTiming.seconds += elapsed();
+
+        // 并行计算面法向量；与igl::per_face_normals一致，退化三角形的法向量为零向量。
+        // 本批三角形已是最终结果，按块发布给预览
+        Utils::parallelFor(waveBegin, waveEnd, TRIANGLE_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; chunk += TRIANGLE_CHUNK_SIZE) {
+                if (progress.isCancelled()) {
+                    isCancelled = true;
+                    return;
+                }
+                const size_t chunkEnd = std::min(end, chunk + TRIANGLE_CHUNK_SIZE);
+                MeshPreviewChunk preview;
+                const bool toPreview = progress.isPreviewEnabled();
+                if (toPreview) {
+                    preview.positions.reserve((chunkEnd - chunk) * 9);
+                    preview.normals.reserve((chunkEnd - chunk) * 3);
+                }
+                for (size_t t = chunk; t < chunkEnd; ++t) {
+                    const std::array<float, 3> points[3] = {
+                        corners.point(t * 3), corners.point(t * 3 + 1), corners.point(t * 3 + 2)};
+                    const Eigen::RowVector3d p0(points[0][0], points[0][1], points[0][2]);
+                    const Eigen::RowVector3d v1 = Eigen::RowVector3d(points[1][0], points[1][1], points[1][2]) - p0;
+                    const Eigen::RowVector3d v2 = Eigen::RowVector3d(points[2][0], points[2][1], points[2][2]) - p0;
+                    const Eigen::RowVector3d n = v1.cross(v2);
+                    const double length = n.norm();
+                    mesh.normals.row(Eigen::Index(t)) =
+                        length > 0.0 ? Eigen::RowVector3d(n / length) : Eigen::RowVector3d::Zero();
+                    if (toPreview) {
+                        for (const std::array<float, 3>& point : points) {
+                            preview.positions.insert(preview.positions.end(), point.begin(), point.end());
+                        }
+                        for (int c = 0; c < 3; ++c) {
+                            preview.normals.push_back(float(mesh.normals(Eigen::Index(t), c)));
+                        }
+                    }
+                }
+                if (toPreview) {
+                    progress.publishPreview(std::move(preview));
+                }
+            }
+        });
+        if (isCancelled) {
+            return false;
+        }
+        normalTiming.seconds += elapsed();
+        progress.setFraction(from + (to - from) * 0.9 * double(waveEnd) / double(nbTriangles));
+    }
+
+    mesh.vertices.resize(Eigen::Index(vertexCorners.size()), 3);
+    Utils::parallelFor(0, vertexCorners.size(), TRIANGLE_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            const std::array<float, 3> point = corners.point(vertexCorners[v]);
+            mesh.vertices(Eigen::Index(v), 0) = point[0];
+            mesh.vertices(Eigen::Index(v), 1) = point[1];
+            mesh.vertices(Eigen::Index(v), 2) = point[2];
+        }
+    });
+    weldTiming.seconds += elapsed();
+    progress.addStageTiming(weldTiming);
+    progress.addStageTiming(normalTiming);
+    return true;
+}
+
+// 跳过空格、制表符和换行
+const char* skipWhitespace(const char* cursor, const char* end)
+{
+    while (cursor < end && std::isspace(static_cast<unsigned char>(*cursor))) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+// ASCII STL只含可打印字符和空白；二进制记录中几乎总有零字节或最高位为1的字节
+bool hasBinaryPayload(const char* data, size_t size)
+{
+    const size_t end = std::min(size, BINARY_HEADER_SIZE + PAYLOAD_PROBE_SIZE);
+    for (size_t i = BINARY_HEADER_SIZE; i < end; ++i) {
+        const unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c >= 0x80 || (c < 0x20 && !std::isspace(c))) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+bool StlReader::read(const std::string& filePath,
+                     UnifiedModel::MeshData& mesh,
+                     ImportProgress& progress,
+                     double fromFraction,
+                     double toFraction)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    progress.setStage("Reading STL file");
+    progress.setFraction(fromFraction);
+
+    ImportStageTimer mapTimer(progress, "map");
+    Utils::MappedFile file;
+    if (!file.open(filePath)) {
+        getStlLogger()->error("Failed to open STL file: {}", filePath);
+        return false;
+    }
+
+    const char* data = file.data();
+    const size_t size = file.size();
+    mapTimer.setBytes(size);
+    mapTimer.stop();
+
+    // 二进制STL：文件大小与三角形数严格对应；文件更大时（末尾有附加数据），头部以"solid"开头的
+    // 只有数据开头含有非文本字节才按二进制读取；其余以"solid"开头的按ASCII解析
+    std::uint32_t nbTriangles = 0;
+    if (size >= BINARY_HEADER_SIZE) {
+        std::memcpy(&nbTriangles, data + 80, sizeof(nbTriangles));
+    }
+    const size_t binarySize = BINARY_HEADER_SIZE + size_t(nbTriangles) * BINARY_RECORD_SIZE;
+    const char* text = skipWhitespace(data, data + size);
+    const bool startsWithSolid =
+        size_t(data + size - text) >= 5 && std::strncmp(text, "solid", 5) == 0;
+    const bool isBinary = size >= BINARY_HEADER_SIZE
+                       && (size == binarySize
+                           || (size > binarySize && (!startsWithSolid || hasBinaryPayload(data, size))));
+
+    bool result = false;
+    if (isBinary) {
+        if (nbTriangles == 0) {
+            getStlLogger()->error("STL file contains no triangles: {}", filePath);
+            return false;
+        }
+        result = buildMesh(nbTriangles,
+                           BinaryCorners{data + BINARY_HEADER_SIZE},
+                           mesh,
+                           progress,
+                           fromFraction,
+                           toFraction);
+    }
+    else if (startsWithSolid) {
+        std::vector<float> coordinates;
+        ImportStageTimer parseTimer(progress, "parse");
+        parseTimer.setBytes(size);
+        if (!parseAscii(data, size, coordinates)) {
+            getStlLogger()->error("Invalid ASCII STL file: {}", filePath);
+            return false;
+        }
+        parseTimer.setElements(coordinates.size() / 9);
+        parseTimer.stop();
+        if (progress.isCancelled()) {
+            return false;
+        }
+        result = buildMesh(coordinates.size() / 9,
+                           BufferCorners{coordinates.data()},
+                           mesh,
+                           progress,
+                           fromFraction,
+                           toFraction);
+    }
+    else {
+        getStlLogger()->error("File is neither binary nor ASCII STL: {}", filePath);
+        return false;
+    }
+
+    if (!result) {
+        return false;
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    getStlLogger()->info("Read {} STL: {} triangles, {} vertices, {:.1f} MB in {:.3f} s ({:.1f} MB/s)",
+                         isBinary ? "binary" : "ASCII",
+                         mesh.faces.rows(),
+                         mesh.vertices.rows(),
+                         double(size) / (1024.0 * 1024.0),
+                         seconds,
+                         seconds > 0.0 ? double(size) / (1024.0 * 1024.0) / seconds : 0.0);
+    return true;
+}
+
+bool StlReader::parseAscii(const char* data, size_t size, std::vector<float>& coordinates) const
+{
+    const char* cursor = data;
+    const char* end = data + size;
+
+    // 只关心"vertex x y z"，其余关键字（facet normal, outer loop, endloop ...）跳过
+    while (cursor < end) {
+        cursor = skipWhitespace(cursor, end);
+        const char* token = cursor;
+        while (cursor < end && !std::isspace(static_cast<unsigned char>(*cursor))) {
+            ++cursor;
+        }
+        if (cursor - token != 6 || std::strncmp(token, "vertex", 6) != 0) {
+            continue;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            cursor = skipWhitespace(cursor, end);
+            if (cursor < end && *cursor == '+') {
+                ++cursor;
+            }
+            float value = 0.0f;
+            const std::from_chars_result parsed = std::from_chars(cursor, end, value);
+            if (parsed.ec != std::errc()) {
+                return false;
+            }
+            coordinates.push_back(value);
+            cursor = parsed.ptr;
+        }
+    }
+
+    return !coordinates.empty() && coordinates.size() % 9 == 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file StlReader.h
+ * @brief Defines the StlReader class, a memory-mapped reader for binary and ASCII STL files.
+ *
+ * Binary STL files are decoded in parallel chunks directly from the mapped file into
+ * the final MeshData buffers. ASCII files are detected and parsed sequentially.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+#include "ImportProgress.h"
+
+#include <string>
+
+/**
+ * @class StlReader
+ * @brief Reads STL files into MeshData.
+ *
+ * Identical corner positions are welded into shared vertices, as igl::read_triangle_mesh
+ * does, and face normals are computed from the vertex positions (the facet normals
+ * stored in STL files are often missing or inconsistent).
+ */
+class StlReader {
+public:
+    /**
+     * @brief Reads an STL file
+     *
+     * @param filePath The path to the STL file
+     * @param mesh Receives the mesh
+     * @param progress Progress and cancellation state
+     * @param fromFraction Progress fraction at the start of the read
+     * @param toFraction Progress fraction at the end of the read
+     * @return bool True if the file was read, false on error or cancellation
+     */
+    bool read(const std::string& filePath,
+              UnifiedModel::MeshData& mesh,
+              ImportProgress& progress,
+              double fromFraction = 0.0,
+              double toFraction = 1.0);
+
+private:
+    /**
+     * @brief Parses the text of an ASCII STL file into a flat corner coordinate buffer
+     *
+     * @param data The file content
+     * @param size The file size in bytes
+     * @param coordinates Receives x, y, z of every triangle corner
+     * @return bool True if the file contains complete triangles
+     */
+    bool parseAscii(const char* data, size_t size, std::vector<float>& coordinates) const;
+};
@@ -1,5 +1,10 @@
 #include "UnifiedModel.h"
+#include <BRepBuilderAPI_Transform.hxx>
+#include <Precision.hxx>
+#include <TopLoc_Location.hxx>
 #include <algorithm>
+#include <functional>
+#include <set>
 #include <stdexcept>
 
 // IModel接口实现
@@ -18,6 +23,97 @@ void UnifiedModel::removeEntity(const std::string& id) {
     removeGeometry(id);
 }
 
+void UnifiedModel::commitChange(const std::string& id, ChangeKind kind, bool isStructural) {
+    ++myGeneration;
+    if (isStructural) {
+        ++myStructureGeneration;
+    }
+    notifyChange(id, kind);
+}
+
+// 合并其他模型（例如后台线程导入的暂存模型）
+std::vector<std::string> UnifiedModel::merge(UnifiedModel&& other) {
+    // 顶层实体（在other中没有父实体）的ID与现有实体冲突时，连同子树一起跳过，例如重复导入同一文件
+    std::map<std::string, bool> skipped;
+    std::function<bool(const std::string&)> isSkipped = [&](const std::string& id) {
+        auto cached = skipped.find(id);
+        if (cached != skipped.end()) {
+            return cached->second;
+        }
+        bool result = false;
+        auto it = other.myGeometries.find(id);
+        if (it != other.myGeometries.end()) {
+            const std::string& parentId = it->second.parentId;
+            if (parentId.empty() || other.myGeometries.count(parentId) == 0) {
+                result = myGeometries.count(id) > 0;
+            }
+            else {
+                result = isSkipped(parentId);
+            }
+        }
+        skipped[id] = result;
+        return result;
+    };
+    
+    // 合并的子实体的ID冲突时改用唯一ID，否则父实体的子列表会指向无关的现有实体
+    std::map<std::string, std::string> renamed;
+    std::set<std::string> newIds;
+    for (const auto& pair : other.myGeometries) {
+        if (myGeometries.count(pair.first) == 0 || isSkipped(pair.first)) {
+            continue;
+        }
+        std::string newId;
+        for (size_t count = 2; newId.empty(); ++count) {
+            std::string candidate = pair.first + "_" + std::to_string(count);
+            if (myGeometries.count(candidate) == 0 && other.myGeometries.count(candidate) == 0
+                && newIds.count(candidate) == 0) {
+                newId = candidate;
+            }
+        }
+        newIds.insert(newId);
+        renamed[pair.first] = newId;
+    }
+    auto mapId = [&renamed](std::string& id) {
+        auto it = renamed.find(id);
+        if (it != renamed.end()) {
+            id = it->second;
+        }
+    };
+    
+    std::vector<std::string> mergedIds;
+    mergedIds.reserve(other.myGeometries.size());
+    for (auto& pair : other.myGeometries) {
+        if (isSkipped(pair.first)) {
+            continue;
+        }
+        std::string id = pair.first;
+        mapId(id);
+        GeometryData& data = pair.second;
+        mapId(data.parentId);
+        for (std::string& childId : data.childIds) {
+            mapId(childId);
+        }
+        myGeometries.emplace(id, std::move(data));
+        mergedIds.push_back(id);
+    }
+    other.myGeometries.clear();
+    ++other.myGeneration;
+    ++other.myStructureGeneration;
+    
+    // 全部插入后再通知，保证监听者看到完整的层次结构
+    for (const std::string& id : mergedIds) {
+        commitChange(id, ChangeKind::GEOMETRY, true);
+    }
+    return mergedIds;
+}
+
+void UnifiedModel::clear() {
+    // 移除根节点时会递归移除其子节点
+    for (const std::string& id : getRootIds()) {
+        removeGeometry(id);
+    }
+}
+
 // 几何数据管理 - CAD形体
 TopoDS_Shape UnifiedModel::getShape(const std::string& id) const {
     auto it = myGeometries.find(id);
@@ -29,32 +125,164 @@ TopoDS_Shape UnifiedModel::getShape(const std::string& id) const {
 
 void UnifiedModel::addShape(const std::string& id, const TopoDS_Shape& shape) {
     myGeometries.emplace(id, GeometryData(shape));
-    notifyChange(id);
+    commitChange(id, ChangeKind::GEOMETRY, true);
+}
+
+// 装配层次结构
+void UnifiedModel::addAssembly(const std::string& id, const std::string& parentId) {
+    GeometryData data;
+    data.type = GeometryType::ASSEMBLY;
+    if (!myGeometries.emplace(id, std::move(data)).second) {
+        return;
+    }
+    if (!parentId.empty()) {
+        attachToParent(id, parentId);
+    }
+    commitChange(id, ChangeKind::GEOMETRY, true);
+}
+
+bool UnifiedModel::setParent(const std::string& id, const std::string& parentId) {
+    if (!attachToParent(id, parentId)) {
+        return false;
+    }
+    // 层次结构不影响显示，按属性变更通知
+    commitChange(id, ChangeKind::ATTRIBUTES, true);
+    return true;
+}
+
+bool UnifiedModel::attachToParent(const std::string& id, const std::string& parentId) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end() || id == parentId) {
+        return false;
+    }
+    
+    auto parentIt = myGeometries.end();
+    if (!parentId.empty()) {
+        parentIt = myGeometries.find(parentId);
+        if (parentIt == myGeometries.end() || parentIt->second.type != GeometryType::ASSEMBLY) {
+            return false;
+        }
+        // 防止形成环：新父节点不能是该实体的后代
+        for (std::string ancestor = parentId; !ancestor.empty(); ancestor = getParentId(ancestor)) {
+            if (ancestor == id) {
+                return false;
+            }
+        }
+    }
+    
+    // 从原父节点中移除
+    if (!it->second.parentId.empty()) {
+        auto oldParentIt = myGeometries.find(it->second.parentId);
+        if (oldParentIt != myGeometries.end()) {
+            auto& siblings = oldParentIt->second.childIds;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), id), siblings.end());
+        }
+    }
+    
+    it->second.parentId = parentId;
+    if (parentIt != myGeometries.end()) {
+        parentIt->second.childIds.push_back(id);
+    }
+    return true;
+}
+
+std::string UnifiedModel::getParentId(const std::string& id) const {
+    auto it = myGeometries.find(id);
+    if (it != myGeometries.end()) {
+        return it->second.parentId;
+    }
+    return std::string();
+}
+
+const std::vector<std::string>& UnifiedModel::getChildIds(const std::string& id) const {
+    static const std::vector<std::string> noChildren;
+    auto it = myGeometries.find(id);
+    if (it != myGeometries.end()) {
+        return it->second.childIds;
+    }
+    return noChildren;
+}
+
+std::vector<std::string> UnifiedModel::getRootIds() const {
+    std::vector<std::string> ids;
+    
+    for (const auto& pair : myGeometries) {
+        if (pair.second.parentId.empty()) {
+            ids.push_back(pair.first);
+        }
+    }
+    
+    return ids;
 }
 
 // 几何数据管理 - 多边形网格
 const UnifiedModel::MeshData* UnifiedModel::getMesh(const std::string& id) const {
     auto it = myGeometries.find(id);
     if (it != myGeometries.end() && it->second.type == GeometryType::MESH) {
-        return &std::get<MeshData>(it->second.geometry);
+        return std::get<MeshDataPtr>(it->second.geometry).get();
+    }
+    return nullptr;
+}
+
+UnifiedModel::MeshDataPtr UnifiedModel::getSharedMesh(const std::string& id) const {
+    auto it = myGeometries.find(id);
+    if (it != myGeometries.end() && it->second.type == GeometryType::MESH) {
+        return std::get<MeshDataPtr>(it->second.geometry);
     }
     return nullptr;
 }
 
 void UnifiedModel::addMesh(const std::string& id, const Eigen::MatrixXd& vertices, const Eigen::MatrixXi& faces) {
     myGeometries.emplace(id, GeometryData(vertices, faces));
-    notifyChange(id);
+    commitChange(id, ChangeKind::GEOMETRY, true);
 }
 
 void UnifiedModel::addMesh(const std::string& id, const Eigen::MatrixXd& vertices, const Eigen::MatrixXi& faces, const Eigen::MatrixXd& normals) {
     myGeometries.emplace(id, GeometryData(vertices, faces, normals));
-    notifyChange(id);
+    commitChange(id, ChangeKind::GEOMETRY, true);
+}
+
+void UnifiedModel::addMesh(const std::string& id, Eigen::MatrixXd&& vertices, Eigen::MatrixXi&& faces) {
+    MeshData mesh;
+    mesh.normals = Eigen::MatrixXd::Zero(faces.rows(), 3);
+    mesh.vertices = std::move(vertices);
+    mesh.faces = std::move(faces);
+    addMesh(id, std::move(mesh));
+}
+
+void UnifiedModel::addMesh(const std::string& id, Eigen::MatrixXd&& vertices, Eigen::MatrixXi&& faces, Eigen::MatrixXd&& normals) {
+    MeshData mesh;
+    mesh.vertices = std::move(vertices);
+    mesh.faces = std::move(faces);
+    mesh.normals = std::move(normals);
+    addMesh(id, std::move(mesh));
+}
+
+void UnifiedModel::addMesh(const std::string& id, MeshData&& mesh) {
+    // 缓冲区只移动不复制，直接在map节点中构造
+    myGeometries.try_emplace(id, std::move(mesh));
+    commitChange(id, ChangeKind::GEOMETRY, true);
 }
 
 // 通用几何数据管理
 void UnifiedModel::removeGeometry(const std::string& id) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end()) {
+        notifyChange(id, ChangeKind::REMOVAL);
+        return;
+    }
+    
+    // 先递归移除子节点（复制一份，因为子节点移除时会修改列表）
+    const std::vector<std::string> children = it->second.childIds;
+    for (const std::string& childId : children) {
+        removeGeometry(childId);
+    }
+    
+    // 从父节点中分离
+    attachToParent(id, "");
+    
     myGeometries.erase(id);
-    notifyChange(id);
+    commitChange(id, ChangeKind::REMOVAL, true);
 }
 
 UnifiedModel::GeometryType UnifiedModel::getGeometryType(const std::string& id) const {
@@ -88,10 +316,21 @@ std::vector<std::string> UnifiedModel::getGeometryIdsByType(GeometryType type) c
 // 颜色属性
 void UnifiedModel::setColor(const std::string& id, const Quantity_Color& color) {
     auto it = myGeometries.find(id);
-    if (it != myGeometries.end()) {
-        it->second.color = color;
-        notifyChange(id);
+    if (it == myGeometries.end()) {
+        return;
     }
+    
+    it->second.color = color;
+    it->second.subShapeColors.clear();
+    if (it->second.type == GeometryType::ASSEMBLY) {
+        // 装配体颜色作用于其下所有零件
+        const std::vector<std::string> children = it->second.childIds;
+        for (const std::string& childId : children) {
+            setColor(childId, color);
+        }
+        return;
+    }
+    commitChange(id, ChangeKind::COLOR, false);
 }
 
 Quantity_Color UnifiedModel::getColor(const std::string& id) const {
@@ -102,6 +341,77 @@ Quantity_Color UnifiedModel::getColor(const std::string& id) const {
     return Quantity_Color(0.8, 0.8, 0.8, Quantity_TOC_RGB); // 默认灰色
 }
 
+void UnifiedModel::setVisible(const std::string& id, bool visible) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end()) {
+        return;
+    }
+    
+    const bool isChanged = it->second.visible != visible;
+    it->second.visible = visible;
+    if (it->second.type == GeometryType::ASSEMBLY) {
+        // 装配体的显示状态作用于其下所有零件
+        const std::vector<std::string> children = it->second.childIds;
+        for (const std::string& childId : children) {
+            setVisible(childId, visible);
+        }
+        return;
+    }
+    if (isChanged) {
+        commitChange(id, ChangeKind::VISIBILITY, false);
+    }
+}
+
+bool UnifiedModel::isVisible(const std::string& id) const {
+    auto it = myGeometries.find(id);
+    return it != myGeometries.end() && it->second.visible;
+}
+
+void UnifiedModel::setName(const std::string& id, const std::string& name) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end() || it->second.name == name) {
+        return;
+    }
+    
+    it->second.name = name;
+    commitChange(id, ChangeKind::ATTRIBUTES, true);
+}
+
+std::string UnifiedModel::getName(const std::string& id) const {
+    auto it = myGeometries.find(id);
+    return it != myGeometries.end() ? it->second.name : std::string();
+}
+
+void UnifiedModel::setLayers(const std::string& id, const std::vector<std::string>& layers) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end()) {
+        return;
+    }
+    
+    it->second.layers = layers;
+    commitChange(id, ChangeKind::ATTRIBUTES, false);
+}
+
+void UnifiedModel::setSubShapeColors(const std::string& id, std::vector<SubShapeColor> colors) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end() || it->second.type != GeometryType::SHAPE) {
+        return;
+    }
+    
+    it->second.subShapeColors = std::move(colors);
+    commitChange(id, ChangeKind::COLOR, false);
+}
+
+void UnifiedModel::setInstanceKey(const std::string& id, const std::string& instanceKey) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end() || it->second.type != GeometryType::SHAPE) {
+        return;
+    }
+    
+    it->second.instanceKey = instanceKey;
+    commitChange(id, ChangeKind::GEOMETRY, false);
+}
+
 // 几何变换 - 通用接口
 void UnifiedModel::transform(const std::string& id, const gp_Trsf& transformation) {
     // 此处需要根据几何类型实现不同的变换逻辑
@@ -111,16 +421,41 @@ void UnifiedModel::transform(const std::string& id, const gp_Trsf& transformatio
     }
     
     // 根据几何类型选择合适的变换方法
-    if (it->second.type == GeometryType::SHAPE) {
-        // 对CAD形体应用变换
-        // 注意：这里需要实际使用OpenCascade的BRepBuilderAPI_Transform等API
-        // 以下代码仅示意，需要根据实际需求实现
-        // TopoDS_Shape& shape = std::get<TopoDS_Shape>(it->second.geometry);
-        // shape = BRepBuilderAPI_Transform(shape, transformation).Shape();
+    if (it->second.type == GeometryType::ASSEMBLY) {
+        // 装配体变换作用于其下所有零件
+        const std::vector<std::string> children = it->second.childIds;
+        for (const std::string& childId : children) {
+            transform(childId, transformation);
+        }
+        return;
+    }
+    else if (it->second.type == GeometryType::SHAPE) {
+        TopoDS_Shape& shape = std::get<TopoDS_Shape>(it->second.geometry);
+        
+        // 刚体变换只改变形体的位置，几何和三角剖分不变，显示只需更新局部变换
+        // （旋转与平移的比例因子恰为1，镜像为-1）
+        // 累积误差使比例因子略偏离1时仍按刚体处理，并把比例因子修正为1
+        if (Abs(transformation.ScaleFactor() - 1.0) <= Precision::Confusion()) {
+            gp_Trsf rigid = transformation;
+            rigid.SetScaleFactor(1.0);
+            shape.Move(TopLoc_Location(rigid));
+            commitChange(id, ChangeKind::TRANSFORM, false);
+            return;
+        }
+        
+        // 位置不能带缩放或镜像，此时复制并变换几何；子形状颜色映射到新的子形状
+        BRepBuilderAPI_Transform shapeTransform(shape, transformation, Standard_True);
+        const TopoDS_Shape& transformed = shapeTransform.Shape();
+        for (SubShapeColor& subShapeColor : it->second.subShapeColors) {
+            const TopoDS_Shape& modified = shapeTransform.ModifiedShape(subShapeColor.subShape.Moved(shape.Location()));
+            subShapeColor.subShape = modified.Moved(transformed.Location().Inverted());
+        }
+        shape = transformed;
+        it->second.instanceKey.clear();
     }
     else if (it->second.type == GeometryType::MESH) {
         // 对网格应用变换
-        MeshData& mesh = std::get<MeshData>(it->second.geometry);
+        MeshData& mesh = detachMesh(it->second);
         
         // 应用变换到顶点
         for (int i = 0; i < mesh.vertices.rows(); ++i) {
@@ -131,13 +466,11 @@ void UnifiedModel::transform(const std::string& id, const gp_Trsf& transformatio
             mesh.vertices(i, 2) = pnt.Z();
         }
 
-        // 对法向量，只应用旋转部分（不包括平移）
-        if (mesh.normals.rows() > 0) {
-            // 提取变换的线性部分（旋转和缩放）
-            gp_Mat rotMat = transformation.VectorialPart();
-            
-            for (int i = 0; i < mesh.normals.rows(); ++i) {
-                gp_XYZ normal(mesh.normals(i, 0), mesh.normals(i, 1), mesh.normals(i, 2));
+        // 对法向量（面法向量和顶点法向量），只应用旋转部分（不包括平移）
+        const gp_Mat rotMat = transformation.VectorialPart();
+        auto transformNormals = [&rotMat](Eigen::MatrixXd& normals) {
+            for (int i = 0; i < normals.rows(); ++i) {
+                gp_XYZ normal(normals(i, 0), normals(i, 1), normals(i, 2));
                 
                 // 只应用旋转部分
                 normal.Multiply(rotMat);
@@ -148,12 +481,34 @@ void UnifiedModel::transform(const std::string& id, const gp_Trsf& transformatio
                     normal.Divide(len);
                 }
                 
-                mesh.normals(i, 0) = normal.X();
-                mesh.normals(i, 1) = normal.Y();
-                mesh.normals(i, 2) = normal.Z();
+                normals(i, 0) = normal.X();
+                normals(i, 1) = normal.Y();
+                normals(i, 2) = normal.Z();
             }
-        }
+        };
+        transformNormals(mesh.normals);
+        transformNormals(mesh.vertexNormals);
     }
     
-    notifyChange(id);
-} 
\ No newline at end of file
+    commitChange(id, ChangeKind::GEOMETRY, false);
+} 
+
+bool UnifiedModel::modifyMesh(const std::string& id, const std::function<void(MeshData&)>& modifier) {
+    auto it = myGeometries.find(id);
+    if (it == myGeometries.end() || it->second.type != GeometryType::MESH) {
+        return false;
+    }
+    
+    modifier(detachMesh(it->second));
+    commitChange(id, ChangeKind::GEOMETRY, false);
+    return true;
+}
+
+UnifiedModel::MeshData& UnifiedModel::detachMesh(GeometryData& data) {
+    // 缓冲区可能与模型副本或显示共享，共享时先复制再修改
+    MeshDataPtr& meshPtr = std::get<MeshDataPtr>(data.geometry);
+    std::shared_ptr<MeshData> meshCopy = meshPtr.use_count() == 1 ? std::const_pointer_cast<MeshData>(meshPtr)
+                                                                   : std::make_shared<MeshData>(*meshPtr);
+    meshPtr = meshCopy;
+    return *meshCopy;
+}
@@ -13,6 +13,8 @@
 #include <vector>
 #include <memory>
 #include <variant>
+#include <cstdint>
+#include <functional>
 
 #include <TopoDS_Shape.hxx>
 #include <Quantity_Color.hxx>
@@ -34,8 +36,9 @@ public:
      * @brief Enumeration of supported geometry types
      */
     enum class GeometryType {
-        SHAPE,  ///< CAD model (TopoDS_Shape)
-        MESH    ///< Polygon mesh (libigl representation)
+        SHAPE,    ///< CAD model (TopoDS_Shape)
+        MESH,     ///< Polygon mesh (libigl representation)
+        ASSEMBLY  ///< Assembly node grouping child entities, carries no geometry itself
     };
     
     /**
@@ -45,31 +48,54 @@ public:
         Eigen::MatrixXd vertices; ///< Vertex positions (n x 3 matrix)
         Eigen::MatrixXi faces;    ///< Face indices (m x 3 matrix for triangular mesh)
         Eigen::MatrixXd normals;  ///< Face normals (m x 3 matrix)
+        Eigen::MatrixXd vertexNormals; ///< Optional vertex normals (n x 3 matrix, or empty)
+        Eigen::MatrixXd vertexColors;  ///< Optional vertex colors (n x 3 RGB in [0, 1], or empty)
         
         /**
          * @brief Default constructor
          */
-        MeshData() : vertices(0, 3), faces(0, 3), normals(0, 3) {}
+        MeshData() : vertices(0, 3), faces(0, 3), normals(0, 3), vertexNormals(0, 3), vertexColors(0, 3) {}
         
         /**
          * @brief Constructor with vertices and faces
          */
         MeshData(const Eigen::MatrixXd& v, const Eigen::MatrixXi& f) 
-            : vertices(v), faces(f), normals(Eigen::MatrixXd::Zero(f.rows(), 3)) {}
+            : vertices(v), faces(f), normals(Eigen::MatrixXd::Zero(f.rows(), 3)),
+              vertexNormals(0, 3), vertexColors(0, 3) {}
             
         /**
          * @brief Constructor with vertices, faces and normals
          */
         MeshData(const Eigen::MatrixXd& v, const Eigen::MatrixXi& f, const Eigen::MatrixXd& n)
-            : vertices(v), faces(f), normals(n) {}
+            : vertices(v), faces(f), normals(n), vertexNormals(0, 3), vertexColors(0, 3) {}
+    };
+    
+    /**
+     * @brief Shared, immutable mesh buffers
+     * 
+     * Like the TopoDS_TShape behind a TopoDS_Shape, mesh buffers are shared rather
+     * than copied: by copies of the model and by the presentations built from it.
+     * The model never modifies buffers that are shared; it copies them first.
+     */
+    using MeshDataPtr = std::shared_ptr<const MeshData>;
+    
+    /**
+     * @brief Color assigned to a sub-shape (face, edge, ...) of a CAD shape
+     * 
+     * The sub-shape is expressed relative to the part's own shape, i.e. as a sub-shape
+     * of `shape.Located(TopLoc_Location())`, so the same colors apply to every instance.
+     */
+    struct SubShapeColor {
+        TopoDS_Shape subShape;  ///< The colored sub-shape
+        Quantity_Color color;   ///< Its color
     };
     
     /**
      * @brief Container for geometry data and associated properties
      */
     struct GeometryData {
-        /** The geometry object, either a TopoDS_Shape or a MeshData */
-        std::variant<TopoDS_Shape, MeshData> geometry;
+        /** The geometry object, either a TopoDS_Shape or shared mesh buffers (never null) */
+        std::variant<TopoDS_Shape, MeshDataPtr> geometry;
         
         /** The color of the geometry */
         Quantity_Color color;
@@ -77,6 +103,31 @@ public:
         /** The type of the geometry */
         GeometryType type;
         
+        /** The ID of the parent assembly node (empty for root entities) */
+        std::string parentId;
+        
+        /** The IDs of the child entities (only used by assembly nodes) */
+        std::vector<std::string> childIds;
+        
+        /** Display name, e.g. the product name read from a STEP file (may be empty) */
+        std::string name;
+        
+        /** Names of the layers the entity belongs to */
+        std::vector<std::string> layers;
+        
+        /** Colors of individual sub-shapes, overriding `color` (CAD shapes only) */
+        std::vector<SubShapeColor> subShapeColors;
+        
+        /**
+         * Key shared by all entities that are placed instances of the same part
+         * (empty if the part is used only once). Instances share the TopoDS_TShape of
+         * their geometry and differ only by location.
+         */
+        std::string instanceKey;
+        
+        /** Whether the entity is displayed */
+        bool visible = true;
+        
         /**
          * @brief Default constructor
          */
@@ -98,7 +149,7 @@ public:
          */
         GeometryData(const Eigen::MatrixXd& vertices, const Eigen::MatrixXi& faces, 
                     const Quantity_Color& color = Quantity_Color(0.8, 0.8, 0.8, Quantity_TOC_RGB))
-            : geometry(MeshData(vertices, faces)), color(color), type(GeometryType::MESH) {}
+            : geometry(std::make_shared<const MeshData>(vertices, faces)), color(color), type(GeometryType::MESH) {}
             
         /**
          * @brief Constructor for polygon meshes with pre-computed normals
@@ -109,7 +160,38 @@ public:
          */
         GeometryData(const Eigen::MatrixXd& vertices, const Eigen::MatrixXi& faces, const Eigen::MatrixXd& normals,
                     const Quantity_Color& color = Quantity_Color(0.8, 0.8, 0.8, Quantity_TOC_RGB))
-            : geometry(MeshData(vertices, faces, normals)), color(color), type(GeometryType::MESH) {}
+            : geometry(std::make_shared<const MeshData>(vertices, faces, normals)), color(color), type(GeometryType::MESH) {}
+        
+        /**
+         * @brief Constructor for polygon meshes taking over the buffers of a mesh
+         * @param mesh The mesh data; it is left empty
+         * @param color The color of the mesh (default: light gray)
+         */
+        explicit GeometryData(MeshData&& mesh, const Quantity_Color& color = Quantity_Color(0.8, 0.8, 0.8, Quantity_TOC_RGB))
+            : geometry(std::make_shared<const MeshData>(std::move(mesh))), color(color), type(GeometryType::MESH) {}
+    };
+    
+    /** Storage type of the geometries, ordered by ID */
+    using GeometryMap = std::map<std::string, GeometryData>;
+    
+    /**
+     * @brief Non-allocating, read-only view over all entities of the model
+     * 
+     * Iterating yields `const std::pair<const std::string, GeometryData>&` in ID order.
+     * The view stays valid for the lifetime of the model; its iterators are invalidated
+     * only for entities that get removed.
+     */
+    class EntityRange {
+    public:
+        explicit EntityRange(const GeometryMap& geometries) : myGeometries(&geometries) {}
+        
+        GeometryMap::const_iterator begin() const { return myGeometries->begin(); }
+        GeometryMap::const_iterator end() const { return myGeometries->end(); }
+        size_t size() const { return myGeometries->size(); }
+        bool empty() const { return myGeometries->empty(); }
+        
+    private:
+        const GeometryMap* myGeometries;
     };
     
     /**
@@ -134,6 +216,59 @@ public:
      */
     void removeEntity(const std::string& id) override;
     
+    /**
+     * @brief Gets a view over all entities without copying their IDs
+     * @return Range of (ID, geometry data) pairs
+     */
+    EntityRange getEntities() const { return EntityRange(myGeometries); }
+    
+    /**
+     * @brief Gets the number of entities in the model
+     * @return The entity count
+     */
+    size_t getEntityCount() const { return myGeometries.size(); }
+    
+    /**
+     * @brief Moves all entities of another model into this one
+     * 
+     * Typically used to hand geometry imported into a staging model on a worker thread
+     * over to the model owned by the UI thread. Top-level entities of the other model whose
+     * ID already exists here are skipped together with their sub-tree. Entities further down
+     * whose ID already exists are merged under a unique ID (with a "_2", "_3"... suffix), and
+     * the links to their parent and children are updated. Listeners are notified once per
+     * merged entity, after all entities have been inserted.
+     * 
+     * @param other The model to take the entities from; it is empty afterwards
+     * @return std::vector<std::string> The IDs of the merged entities, as stored in this model
+     */
+    std::vector<std::string> merge(UnifiedModel&& other);
+    
+    /**
+     * @brief Removes all entities, notifying observers for each of them
+     */
+    void clear();
+    
+    /**
+     * @brief Gets the model generation
+     * 
+     * The generation is incremented on every change to the model (geometry, color,
+     * hierarchy, ...). Consumers can cache derived data and rebuild it only when the
+     * generation differs from the one they cached.
+     * 
+     * @return The current generation
+     */
+    std::uint64_t getGeneration() const { return myGeneration; }
+    
+    /**
+     * @brief Gets the structure generation
+     * 
+     * Like getGeneration(), but only incremented when entities are added, removed or
+     * re-parented. Attribute changes such as colors do not affect it.
+     * 
+     * @return The current structure generation
+     */
+    std::uint64_t getStructureGeneration() const { return myStructureGeneration; }
+    
     /**
      * @brief Gets a CAD shape by its ID
      * @param id The ID of the shape to retrieve
@@ -148,6 +283,89 @@ public:
      */
     void addShape(const std::string& id, const TopoDS_Shape& shape);
     
+    /**
+     * @brief Adds an assembly node to the model
+     * 
+     * Assembly nodes carry no geometry; they group parts and sub-assemblies so that
+     * each part keeps its own entity (and thus its own presentation and selection).
+     * 
+     * @param id The ID to assign to the assembly
+     * @param parentId The ID of the parent assembly (empty for a root node)
+     */
+    void addAssembly(const std::string& id, const std::string& parentId = "");
+    
+    /**
+     * @brief Attaches an entity to a parent assembly node
+     * 
+     * The entity is detached from its previous parent first. Passing an empty parent ID
+     * turns the entity into a root entity. Hierarchy changes do not touch the geometry,
+     * so listeners are notified with ChangeKind::ATTRIBUTES.
+     * 
+     * @param id The ID of the entity to attach
+     * @param parentId The ID of the new parent assembly (empty to detach)
+     * @return True if the entity was attached, false if either ID is unknown or the
+     *         parent is not an assembly
+     */
+    bool setParent(const std::string& id, const std::string& parentId);
+    
+    /**
+     * @brief Gets the parent assembly of an entity
+     * @param id The ID of the entity
+     * @return The ID of the parent assembly, or an empty string for root entities
+     */
+    std::string getParentId(const std::string& id) const;
+    
+    /**
+     * @brief Gets the direct children of an assembly node
+     * @param id The ID of the assembly
+     * @return The IDs of the child entities (empty for parts and unknown IDs)
+     */
+    const std::vector<std::string>& getChildIds(const std::string& id) const;
+    
+    /**
+     * @brief Gets the IDs of all entities without a parent
+     * @return Vector of root entity IDs
+     */
+    std::vector<std::string> getRootIds() const;
+    
+    /**
+     * @brief Sets the display name of an entity
+     * 
+     * Renaming changes the object tree, so it counts as a structural change.
+     * 
+     * @param id The ID of the entity
+     * @param name The new name (empty to fall back to the ID)
+     */
+    void setName(const std::string& id, const std::string& name);
+    
+    /**
+     * @brief Gets the display name of an entity
+     * @param id The ID of the entity
+     * @return The name, or an empty string if none was set
+     */
+    std::string getName(const std::string& id) const;
+    
+    /**
+     * @brief Sets the layers an entity belongs to
+     * @param id The ID of the entity
+     * @param layers The layer names
+     */
+    void setLayers(const std::string& id, const std::vector<std::string>& layers);
+    
+    /**
+     * @brief Sets the sub-shape colors of a CAD shape
+     * @param id The ID of the shape
+     * @param colors The sub-shape colors, relative to the unlocated shape
+     */
+    void setSubShapeColors(const std::string& id, std::vector<SubShapeColor> colors);
+    
+    /**
+     * @brief Marks a CAD shape as an instance of a shared part
+     * @param id The ID of the shape
+     * @param instanceKey Key shared by all instances of the part (empty: not shared)
+     */
+    void setInstanceKey(const std::string& id, const std::string& instanceKey);
+    
     /**
      * @brief Gets a polygon mesh by its ID
      * @param id The ID of the mesh to retrieve
@@ -155,6 +373,17 @@ public:
      */
     const MeshData* getMesh(const std::string& id) const;
     
+    /**
+     * @brief Gets the shared buffers of a polygon mesh
+     * 
+     * Holding the pointer keeps the buffers alive and unchanged: a later transform()
+     * of the mesh works on a copy.
+     * 
+     * @param id The ID of the mesh to retrieve
+     * @return The mesh buffers, or null if the entity is not a mesh
+     */
+    MeshDataPtr getSharedMesh(const std::string& id) const;
+    
     /**
      * @brief Adds a polygon mesh to the model
      * @param id The ID to assign to the mesh
@@ -172,8 +401,35 @@ public:
      */
     void addMesh(const std::string& id, const Eigen::MatrixXd& vertices, const Eigen::MatrixXi& faces, const Eigen::MatrixXd& normals);
     
+    /**
+     * @brief Adds a polygon mesh to the model, taking over the buffers without copying
+     * @param id The ID to assign to the mesh
+     * @param vertices The mesh vertices; left empty
+     * @param faces The mesh faces; left empty
+     */
+    void addMesh(const std::string& id, Eigen::MatrixXd&& vertices, Eigen::MatrixXi&& faces);
+    
+    /**
+     * @brief Adds a polygon mesh with normals, taking over the buffers without copying
+     * @param id The ID to assign to the mesh
+     * @param vertices The mesh vertices; left empty
+     * @param faces The mesh faces; left empty
+     * @param normals The mesh face normals; left empty
+     */
+    void addMesh(const std::string& id, Eigen::MatrixXd&& vertices, Eigen::MatrixXi&& faces, Eigen::MatrixXd&& normals);
+    
+    /**
+     * @brief Adds a polygon mesh to the model, taking over its buffers without copying
+     * @param id The ID to assign to the mesh
+     * @param mesh The mesh data; it is left empty
+     */
+    void addMesh(const std::string& id, MeshData&& mesh);
+    
     /**
      * @brief Removes a geometry from the model
+     * 
+     * Removing an assembly node removes its whole sub-tree.
+     * 
      * @param id The ID of the geometry to remove
      */
     void removeGeometry(const std::string& id);
@@ -201,6 +457,10 @@ public:
     
     /**
      * @brief Sets the color of a geometry
+     * 
+     * Setting the color of an assembly node colors all parts below it. Setting the
+     * color of a part replaces its sub-shape colors.
+     * 
      * @param id The ID of the geometry
      * @param color The color to set
      */
@@ -213,14 +473,81 @@ public:
      */
     Quantity_Color getColor(const std::string& id) const;
     
+    /**
+     * @brief Shows or hides a geometry
+     * 
+     * Hiding an assembly node hides all parts below it.
+     * 
+     * @param id The ID of the geometry
+     * @param visible Whether the geometry is displayed
+     */
+    void setVisible(const std::string& id, bool visible);
+    
+    /**
+     * @brief Checks whether a geometry is displayed
+     * @param id The ID of the geometry
+     * @return False if the geometry is hidden or not found
+     */
+    bool isVisible(const std::string& id) const;
+    
     /**
      * @brief Applies a transformation to a geometry
+     * 
+     * Transforming an assembly node transforms all parts below it. CAD shapes are moved
+     * by changing their location, so listeners are notified with ChangeKind::TRANSFORM;
+     * scaling transformations and meshes change the geometry itself (ChangeKind::GEOMETRY).
+     * 
      * @param id The ID of the geometry to transform
      * @param transformation The transformation to apply
      */
     void transform(const std::string& id, const gp_Trsf& transformation);
     
+    /**
+     * @brief Modifies the buffers of a polygon mesh in place
+     * 
+     * Buffers that are shared (by model copies or presentations) are copied before the
+     * modifier runs, as in transform(). Processing stages such as welding or decimation
+     * use this to replace the mesh without re-adding the entity.
+     * 
+     * @param id The ID of the mesh
+     * @param modifier Function receiving the mutable mesh data
+     * @return True if the entity is a mesh and was modified
+     */
+    bool modifyMesh(const std::string& id, const std::function<void(MeshData&)>& modifier);
+    
 private:
+    /**
+     * @brief Gets the mesh buffers of an entity for writing, copying them if they are shared
+     * @param data The geometry data of a mesh entity
+     * @return The mutable mesh data
+     */
+    static MeshData& detachMesh(GeometryData& data);
+    
+    /**
+     * @brief Moves an entity below a new parent without notifying the listeners
+     * 
+     * Used by setParent() and by mutators that send their own notification.
+     * 
+     * @param id The ID of the entity to attach
+     * @param parentId The ID of the new parent assembly (empty to detach)
+     * @return True if the entity was attached
+     */
+    bool attachToParent(const std::string& id, const std::string& parentId);
+    
+    /**
+     * @brief Bumps the generation counters and notifies the change listeners
+     * @param id The ID of the changed entity
+     * @param kind What changed, so listeners can update only the affected parts
+     * @param isStructural True if entities were added, removed, renamed or re-parented
+     */
+    void commitChange(const std::string& id, ChangeKind kind, bool isStructural);
+    
     /** Map of geometry IDs to geometry data */
-    std::map<std::string, GeometryData> myGeometries;
+    GeometryMap myGeometries;
+    
+    /** Generation incremented on every change */
+    std::uint64_t myGeneration = 0;
+    
+    /** Generation incremented on structural changes only */
+    std::uint64_t myStructureGeneration = 0;
 }; 
\ No newline at end of file
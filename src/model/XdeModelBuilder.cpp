@@ -0,0 +1,371 @@
+#include "XdeModelBuilder.h"
+#include "utils/Logger.h"
+
+#include <BRep_Tool.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TColStd_HSequenceOfExtendedString.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDF_Tool.hxx>
+#include <TDataStd_Name.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+#include <algorithm>
+
+// 创建XDE转换日志记录器
+static std::shared_ptr<Utils::Logger>& getXdeLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("model.xde");
+    return logger;
+}
+
+namespace
+{
+// 返回标签的条目（"0:1:1:3"）
+std::string labelEntry(const TDF_Label& label)
+{
+    TCollection_AsciiString entry;
+    TDF_Tool::Entry(label, entry);
+    return entry.ToCString();
+}
+
+// 返回组件引用的标签，不是组件时返回标签本身
+TDF_Label referredLabel(const TDF_Label& label)
+{
+    TDF_Label referred;
+    if (XCAFDoc_ShapeTool::IsReference(label)
+        && XCAFDoc_ShapeTool::GetReferredShape(label, referred)) {
+        return referred;
+    }
+    return label;
+}
+}  // namespace
+
+XdeModelBuilder::XdeModelBuilder(UnifiedModel& model)
+    : myModel(model)
+{}
+
+int XdeModelBuilder::build(const Handle(TDocStd_Document)& document, const std::string& modelId)
+{
+    myShapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+    myColorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+    myLayerTool = XCAFDoc_DocumentTool::LayerTool(document->Main());
+    myPlacementCounts.clear();
+    myKeyPrefix = modelId + ":";
+    myNbConvertedMeshes = 0;
+
+    TDF_LabelSequence freeLabels;
+    myShapeTool->GetFreeShapes(freeLabels);
+    if (freeLabels.IsEmpty()) {
+        getXdeLogger()->warn("XDE document has no free shapes");
+        return 0;
+    }
+
+    // 先统计每个零件被放置的次数，只有多次放置的零件才作为实例共享
+    for (TDF_LabelSequence::Iterator it(freeLabels); it.More(); it.Next()) {
+        countPlacements(it.Value());
+    }
+
+    int nbParts = 0;
+    if (freeLabels.Length() == 1) {
+        nbParts = addLabel(freeLabels.First(), TopLoc_Location(), modelId, "", "", nullptr);
+    }
+    else {
+        // 多个自由形状时，用一个顶层装配节点把它们组织起来
+        myModel.addAssembly(modelId);
+        for (int i = 1; i <= freeLabels.Length(); ++i) {
+            nbParts += addLabel(freeLabels.Value(i),
+                                TopLoc_Location(),
+                                modelId + "/" + std::to_string(i),
+                                modelId,
+                                "",
+                                nullptr);
+        }
+    }
+
+    getXdeLogger()->debug("Converted XDE document: {} placements of {} unique parts",
+                          nbParts,
+                          myPlacementCounts.size());
+    return nbParts;
+}
+
+void XdeModelBuilder::countPlacements(const TDF_Label& label)
+{
+    const TDF_Label shapeLabel = referredLabel(label);
+    if (XCAFDoc_ShapeTool::IsAssembly(shapeLabel)) {
+        TDF_LabelSequence components;
+        XCAFDoc_ShapeTool::GetComponents(shapeLabel, components);
+        for (TDF_LabelSequence::Iterator it(components); it.More(); it.Next()) {
+            countPlacements(it.Value());
+        }
+        return;
+    }
+    ++myPlacementCounts[labelEntry(shapeLabel)];
+}
+
+int XdeModelBuilder::addLabel(const TDF_Label& label,
+                              const TopLoc_Location& parentLocation,
+                              const std::string& id,
+                              const std::string& parentId,
+                              const std::string& inheritedName,
+                              const Quantity_Color* inheritedColor)
+{
+    // 组件标签引用实际形状，位置沿装配树累积
+    const TDF_Label shapeLabel = referredLabel(label);
+    TopLoc_Location location = parentLocation;
+    if (shapeLabel != label) {
+        location = parentLocation * XCAFDoc_ShapeTool::GetLocation(label);
+    }
+
+    // 组件上的名称和颜色优先于被引用形状上的
+    std::string name = getLabelName(label);
+    if (name.empty()) {
+        name = getLabelName(shapeLabel);
+    }
+    if (name.empty()) {
+        name = inheritedName;
+    }
+
+    Quantity_Color color;
+    const Quantity_Color* effectiveColor = inheritedColor;
+    if (getLabelColor(label, color) || getLabelColor(shapeLabel, color)) {
+        effectiveColor = &color;
+    }
+
+    if (XCAFDoc_ShapeTool::IsAssembly(shapeLabel)) {
+        TDF_LabelSequence components;
+        XCAFDoc_ShapeTool::GetComponents(shapeLabel, components);
+        if (components.Length() == 1) {
+            // 只有一个组件的装配体直接展开为该组件
+            return addLabel(components.First(), location, id, parentId, name, effectiveColor);
+        }
+
+        myModel.addAssembly(id, parentId);
+        myModel.setName(id, name);
+
+        int nbParts = 0;
+        for (int i = 1; i <= components.Length(); ++i) {
+            nbParts += addLabel(components.Value(i),
+                                location,
+                                id + "/" + std::to_string(i),
+                                id,
+                                "",
+                                effectiveColor);
+        }
+        return nbParts;
+    }
+
+    const TopoDS_Shape partShape = XCAFDoc_ShapeTool::GetShape(shapeLabel);
+    if (partShape.IsNull()) {
+        return 0;
+    }
+
+    std::vector<UnifiedModel::SubShapeColor> subShapeColors =
+        getSubShapeColors(shapeLabel, partShape);
+    const std::string entry = labelEntry(shapeLabel);
+    auto countIt = myPlacementCounts.find(entry);
+    const bool isInstanced = countIt != myPlacementCounts.end() && countIt->second > 1;
+    const TopoDS_Shape locatedShape = location.IsIdentity() ? partShape : partShape.Moved(location);
+
+    // 只放置一次的纯三角网格零件直接转换为网格，面颜色转换为顶点颜色
+    UnifiedModel::MeshData mesh;
+    const Quantity_Color baseColor = effectiveColor != nullptr ? *effectiveColor : UnifiedModel::GeometryData().color;
+    if (myToConvertMeshes && !isInstanced && convertToMesh(locatedShape, subShapeColors, baseColor, mesh)) {
+        myModel.addMesh(id, std::move(mesh));
+        ++myNbConvertedMeshes;
+    }
+    else {
+        // 多次放置的零件共享同一个TShape，只有位置不同
+        myModel.addShape(id, locatedShape);
+        if (!subShapeColors.empty()) {
+            myModel.setSubShapeColors(id, std::move(subShapeColors));
+        }
+        if (isInstanced) {
+            myModel.setInstanceKey(id, myKeyPrefix + entry);
+        }
+    }
+    if (!parentId.empty()) {
+        myModel.setParent(id, parentId);
+    }
+    myModel.setName(id, name);
+    if (effectiveColor != nullptr) {
+        myModel.setColor(id, *effectiveColor);
+    }
+
+    std::vector<std::string> layers;
+    appendLabelLayers(label, layers);
+    appendLabelLayers(shapeLabel, layers);
+    if (!layers.empty()) {
+        myModel.setLayers(id, layers);
+    }
+    return 1;
+}
+
+std::string XdeModelBuilder::getLabelName(const TDF_Label& label) const
+{
+    Handle(TDataStd_Name) nameAttribute;
+    if (!label.FindAttribute(TDataStd_Name::GetID(), nameAttribute)) {
+        return std::string();
+    }
+    return TCollection_AsciiString(nameAttribute->Get()).ToCString();
+}
+
+bool XdeModelBuilder::getLabelColor(const TDF_Label& label, Quantity_Color& color) const
+{
+    if (myColorTool.IsNull()) {
+        return false;
+    }
+    return myColorTool->GetColor(label, XCAFDoc_ColorSurf, color)
+        || myColorTool->GetColor(label, XCAFDoc_ColorGen, color);
+}
+
+void XdeModelBuilder::appendLabelLayers(const TDF_Label& label, std::vector<std::string>& layers) const
+{
+    if (myLayerTool.IsNull()) {
+        return;
+    }
+
+    Handle(TColStd_HSequenceOfExtendedString) labelLayers = myLayerTool->GetLayers(label);
+    if (labelLayers.IsNull()) {
+        return;
+    }
+    for (TColStd_SequenceOfExtendedString::Iterator it(*labelLayers); it.More(); it.Next()) {
+        std::string layer = TCollection_AsciiString(it.Value()).ToCString();
+        if (std::find(layers.begin(), layers.end(), layer) == layers.end()) {
+            layers.push_back(std::move(layer));
+        }
+    }
+}
+
+std::vector<UnifiedModel::SubShapeColor> XdeModelBuilder::getSubShapeColors(
+    const TDF_Label& partLabel,
+    const TopoDS_Shape& partShape) const
+{
+    std::vector<UnifiedModel::SubShapeColor> colors;
+
+    TDF_LabelSequence subLabels;
+    if (!XCAFDoc_ShapeTool::GetSubShapes(partLabel, subLabels)) {
+        return colors;
+    }
+
+    // 子形状统一表达为未定位零件形状的子形状，所有实例共用同一组颜色
+    const TopLoc_Location partLocationInverse = partShape.Location().Inverted();
+    for (TDF_LabelSequence::Iterator it(subLabels); it.More(); it.Next()) {
+        Quantity_Color color;
+        if (!getLabelColor(it.Value(), color)) {
+            continue;
+        }
+        TopoDS_Shape subShape = XCAFDoc_ShapeTool::GetShape(it.Value());
+        if (subShape.IsNull()) {
+            continue;
+        }
+        if (!partShape.Location().IsIdentity()) {
+            subShape.Move(partLocationInverse);
+        }
+        colors.push_back({subShape, color});
+    }
+    return colors;
+}
+
+bool XdeModelBuilder::convertToMesh(const TopoDS_Shape& partShape,
+                                    const std::vector<UnifiedModel::SubShapeColor>& subShapeColors,
+                                    const Quantity_Color& baseColor,
+                                    UnifiedModel::MeshData& mesh) const
+{
+    // 所有面都只有三角剖分而没有曲面时才是网格零件
+    std::vector<TopoDS_Face> faces;
+    std::vector<Handle(Poly_Triangulation)> triangulations;
+    std::vector<TopLoc_Location> locations;
+    Standard_Integer nbNodes = 0;
+    Standard_Integer nbTriangles = 0;
+    bool hasNormals = true;
+    for (TopExp_Explorer faceExp(partShape, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(faceExp.Current());
+        TopLoc_Location surfaceLocation;
+        if (!BRep_Tool::Surface(face, surfaceLocation).IsNull()) {
+            return false;
+        }
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) {
+            return false;
+        }
+        faces.push_back(face);
+        triangulations.push_back(triangulation);
+        locations.push_back(location);
+        nbNodes += triangulation->NbNodes();
+        nbTriangles += triangulation->NbTriangles();
+        hasNormals = hasNormals && triangulation->HasNormals();
+    }
+    if (faces.empty() || nbTriangles == 0) {
+        return false;
+    }
+
+    // 面颜色以未定位零件形状的子形状表达，按TShape匹配
+    bool hasFaceColors = false;
+    std::vector<Quantity_Color> faceColors(faces.size(), baseColor);
+    for (const UnifiedModel::SubShapeColor& subShapeColor : subShapeColors) {
+        for (size_t f = 0; f < faces.size(); ++f) {
+            if (faces[f].IsPartner(subShapeColor.subShape)) {
+                faceColors[f] = subShapeColor.color;
+                hasFaceColors = true;
+            }
+        }
+    }
+
+    mesh.vertices.resize(nbNodes, 3);
+    mesh.faces.resize(nbTriangles, 3);
+    mesh.normals.resize(nbTriangles, 3);
+    if (hasNormals) {
+        mesh.vertexNormals.resize(nbNodes, 3);
+    }
+    if (hasFaceColors) {
+        mesh.vertexColors.resize(nbNodes, 3);
+    }
+
+    Eigen::Index nodeOffset = 0;
+    Eigen::Index triangleOffset = 0;
+    for (size_t f = 0; f < faces.size(); ++f) {
+        const Handle(Poly_Triangulation)& triangulation = triangulations[f];
+        const gp_Trsf& transformation = locations[f].Transformation();
+        const bool isReversed = faces[f].Orientation() == TopAbs_REVERSED;
+        for (Standard_Integer n = 1; n <= triangulation->NbNodes(); ++n) {
+            const Eigen::Index row = nodeOffset + n - 1;
+            const gp_Pnt point = triangulation->Node(n).Transformed(transformation);
+            mesh.vertices.row(row) << point.X(), point.Y(), point.Z();
+            if (hasNormals) {
+                gp_Dir normal = triangulation->Normal(n).Transformed(transformation);
+                if (isReversed) {
+                    normal.Reverse();
+                }
+                mesh.vertexNormals.row(row) << normal.X(), normal.Y(), normal.Z();
+            }
+            if (hasFaceColors) {
+                mesh.vertexColors.row(row) << faceColors[f].Red(), faceColors[f].Green(), faceColors[f].Blue();
+            }
+        }
+        for (Standard_Integer t = 1; t <= triangulation->NbTriangles(); ++t) {
+            Standard_Integer n1 = 0, n2 = 0, n3 = 0;
+            triangulation->Triangle(t).Get(n1, n2, n3);
+            if (isReversed) {
+                std::swap(n2, n3);
+            }
+            const Eigen::Index row = triangleOffset + t - 1;
+            mesh.faces.row(row) << int(nodeOffset + n1 - 1), int(nodeOffset + n2 - 1), int(nodeOffset + n3 - 1);
+
+            // 与igl::per_face_normals一致：退化三角形的法向量为零向量
+            const Eigen::RowVector3d p0 = mesh.vertices.row(mesh.faces(row, 0));
+            const Eigen::RowVector3d e1 = mesh.vertices.row(mesh.faces(row, 1)) - p0;
+            const Eigen::RowVector3d e2 = mesh.vertices.row(mesh.faces(row, 2)) - p0;
+            const Eigen::RowVector3d normal = e1.cross(e2);
+            const double length = normal.norm();
+            mesh.normals.row(row) = length > 0.0 ? Eigen::RowVector3d(normal / length) : Eigen::RowVector3d::Zero();
+        }
+        nodeOffset += triangulation->NbNodes();
+        triangleOffset += triangulation->NbTriangles();
+    }
+    return true;
+}
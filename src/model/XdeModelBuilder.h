@@ -0,0 +1,169 @@
+/**
+ * @file XdeModelBuilder.h
+ * @brief Defines the XdeModelBuilder class which converts an XDE document into UnifiedModel entities.
+ *
+ * XDE (eXtended Data Exchange) documents are produced by the CAF-based readers of
+ * OpenCASCADE (STEPCAFControl_Reader, RWGltf_CafReader, ...). They store the assembly
+ * structure together with names, colors and layers, and keep parts that are placed
+ * several times as one shape referenced by several components.
+ */
+#pragma once
+
+#include "UnifiedModel.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <Quantity_Color.hxx>
+#include <TDF_Label.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopLoc_Location.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_LayerTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+/**
+ * @class XdeModelBuilder
+ * @brief Walks the shape tree of an XDE document and adds it to a UnifiedModel.
+ *
+ * Assemblies become ASSEMBLY entities with children "<parent>/<index>", parts become
+ * SHAPE entities carrying the accumulated component location. Assemblies with a single
+ * component are collapsed into that component. Names, colors, face colors and layers
+ * are copied to the entities. Parts placed more than once get a common instance key,
+ * and their shapes share the same TopoDS_TShape.
+ *
+ * Documents read from mesh formats (e.g. by RWGltf_CafReader) hold parts made of faces
+ * that carry only a Poly_Triangulation. With mesh conversion enabled, such parts placed
+ * once become MESH entities; parts placed several times stay shapes so that all
+ * instances keep sharing one triangulation.
+ */
+class XdeModelBuilder {
+public:
+    /**
+     * @brief Constructor
+     * @param model The model to add the entities to
+     */
+    explicit XdeModelBuilder(UnifiedModel& model);
+
+    /**
+     * @brief Adds all free shapes of a document to the model
+     *
+     * A document with several free shapes is grouped under an assembly node.
+     *
+     * @param document The XDE document
+     * @param modelId The ID of the top-level entity
+     * @return int The number of part entities added
+     */
+    int build(const Handle(TDocStd_Document)& document, const std::string& modelId);
+
+    /**
+     * @brief Gets the number of distinct parts found by the last build()
+     * @return The number of unique part shapes
+     */
+    int getUniquePartCount() const { return static_cast<int>(myPlacementCounts.size()); }
+
+    /**
+     * @brief Enables the conversion of triangulation-only parts into MESH entities
+     * @param enabled True to convert parts placed once (disabled by default)
+     */
+    void setMeshConversion(bool enabled) { myToConvertMeshes = enabled; }
+
+    /**
+     * @brief Gets the number of parts converted to meshes by the last build()
+     * @return The number of MESH entities added
+     */
+    int getConvertedMeshCount() const { return myNbConvertedMeshes; }
+
+private:
+    /**
+     * @brief Counts how often each part label is placed in the tree below a label
+     * @param label The label to start from
+     */
+    void countPlacements(const TDF_Label& label);
+
+    /**
+     * @brief Adds a label (part, assembly or component) and its sub-tree to the model
+     * @param label The label to add
+     * @param parentLocation The accumulated location of the parent components
+     * @param id The ID to assign to the entity
+     * @param parentId The ID of the parent assembly (empty for a root node)
+     * @param inheritedName Name to use if neither the label nor the referred shape has one
+     * @param inheritedColor Color inherited from the parent components, if any
+     * @return int The number of part entities added
+     */
+    int addLabel(const TDF_Label& label,
+                 const TopLoc_Location& parentLocation,
+                 const std::string& id,
+                 const std::string& parentId,
+                 const std::string& inheritedName,
+                 const Quantity_Color* inheritedColor);
+
+    /**
+     * @brief Gets the name stored on a label
+     * @param label The label
+     * @return The name, or an empty string if the label has none
+     */
+    std::string getLabelName(const TDF_Label& label) const;
+
+    /**
+     * @brief Gets the surface (or generic) color stored on a label
+     * @param label The label
+     * @param color Receives the color
+     * @return True if the label has a color
+     */
+    bool getLabelColor(const TDF_Label& label, Quantity_Color& color) const;
+
+    /**
+     * @brief Appends the layers of a label to a list, skipping duplicates
+     * @param label The label
+     * @param layers The list to extend
+     */
+    void appendLabelLayers(const TDF_Label& label, std::vector<std::string>& layers) const;
+
+    /**
+     * @brief Collects the colors of the sub-shapes of a part
+     * @param partLabel The label of the part shape
+     * @param partShape The shape of the part
+     * @return The sub-shape colors, expressed relative to the unlocated part shape
+     */
+    std::vector<UnifiedModel::SubShapeColor> getSubShapeColors(const TDF_Label& partLabel,
+                                                               const TopoDS_Shape& partShape) const;
+
+    /**
+     * @brief Converts a part made only of triangulated faces into mesh data
+     * @param partShape The located part shape
+     * @param subShapeColors Face colors relative to the unlocated part shape
+     * @param baseColor Color of the faces without a color of their own
+     * @param mesh Receives the merged triangulations in model coordinates
+     * @return True if every face of the part has a triangulation and no surface
+     */
+    bool convertToMesh(const TopoDS_Shape& partShape,
+                       const std::vector<UnifiedModel::SubShapeColor>& subShapeColors,
+                       const Quantity_Color& baseColor,
+                       UnifiedModel::MeshData& mesh) const;
+
+    /** The model to add the entities to */
+    UnifiedModel& myModel;
+
+    /** Shape tool of the current document */
+    Handle(XCAFDoc_ShapeTool) myShapeTool;
+
+    /** Color tool of the current document */
+    Handle(XCAFDoc_ColorTool) myColorTool;
+
+    /** Layer tool of the current document */
+    Handle(XCAFDoc_LayerTool) myLayerTool;
+
+    /** Number of placements of each part, keyed by label entry */
+    std::map<std::string, int> myPlacementCounts;
+
+    /** Prefix making instance keys unique across documents */
+    std::string myKeyPrefix;
+
+    /** Whether triangulation-only parts placed once become MESH entities */
+    bool myToConvertMeshes = false;
+
+    /** Number of parts converted to meshes by the last build() */
+    int myNbConvertedMeshes = 0;
+};
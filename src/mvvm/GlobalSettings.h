@@ -30,6 +30,7 @@ public:
     
     // Display settings
     Property<int> displayMode{0}; // 0: Shaded, 1: Wireframe, 2: Vertices, etc.
+    Property<bool> backgroundPresentations{true};  // Prepare presentations of meshes and triangulated parts on worker threads
     
     // View settings
     Property<double> cameraDistance{100.0};
@@ -38,6 +39,26 @@ public:
     // Selection settings
     Property<bool> highlightOnHover{true};
     
+    // Import settings
+    Property<int> importWorkerCount{0};        // Files read in parallel, 0: one per hardware thread
+    Property<int> importMemoryBudgetMB{2048};  // Total size of the files read at the same time
+    Property<bool> importCacheEnabled{true};   // Re-open previously imported files from the cache
+    Property<int> importCacheSizeMB{4096};     // Size limit of the import cache directory
+    Property<bool> streamImportPreview{false}; // Show meshes progressively while they are read (costs memory)
+    Property<bool> repairMeshesOnImport{false};  // Remove NaN, degenerate, duplicate and non-manifold faces
+    Property<bool> importLogEnabled{false};      // Append a JSON line with the stage timings of each import
+    Property<std::string> importLogPath{std::string("import_log.jsonl")};
+    
+    // Tessellation settings (applied to CAD shapes at import)
+    Property<bool> tessellateOnImport{true};
+    Property<double> meshDeviationCoefficient{0.001};  // Linear deflection relative to part size
+    Property<double> meshDeviationAngleDeg{20.0};      // Angular deflection in degrees
+    
+    // Netgen meshing settings (Mesh > Generate Mesh)
+    Property<double> netgenMaxSize{0.0};     // Maximum element size, 0: relative to part size
+    Property<double> netgenGrading{0.3};     // Growth rate of the element size
+    Property<bool> netgenVolumeMesh{false};  // Fill solids with tetrahedra as well
+    
     // Connection tracker for property bindings
     ConnectionTracker connections;
 };
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Utils {
+
+/**
+ * @brief 统计64位整数中置位的个数
+ */
+inline unsigned int popCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<unsigned int>(__popcnt64(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<unsigned int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * @brief 获取64位整数最低置位的位置
+ *
+ * @param word 非零的整数
+ */
+inline unsigned int countTrailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned int>(index);
+#else
+    return popCount((word & (~word + 1)) - 1);
+#endif
+}
+
+/**
+ * @brief 长度可变的稠密位集
+ *
+ * 以64位字存储，按字进行并、交、差和取反，适合对大量连续编号的元素做批量集合运算。
+ * 长度之外的位始终为0，因此计数和遍历不需要额外的掩码。
+ */
+class DynamicBitset {
+public:
+    DynamicBitset() = default;
+
+    /**
+     * @brief 构造指定长度、全部为0的位集
+     */
+    explicit DynamicBitset(size_t size) { resize(size); }
+
+    /**
+     * @brief 改变长度，新增的位为0
+     */
+    void resize(size_t size) {
+        mySize = size;
+        myWords.resize((size + 63) / 64, 0);
+        clearTail();
+    }
+
+    /**
+     * @brief 获取长度（位数）
+     */
+    size_t size() const { return mySize; }
+
+    /**
+     * @brief 检查某一位
+     *
+     * @param index 位的序号，超出长度时返回false
+     */
+    bool test(size_t index) const {
+        return index < mySize && ((myWords[index / 64] >> (index % 64)) & 1u) != 0;
+    }
+
+    /**
+     * @brief 设置或清除某一位
+     *
+     * @param index 位的序号，必须小于长度
+     * @param value 新的值
+     * @return 该位是否发生了变化
+     */
+    bool set(size_t index, bool value = true) {
+        std::uint64_t& word = myWords[index / 64];
+        const std::uint64_t mask = std::uint64_t(1) << (index % 64);
+        const bool wasSet = (word & mask) != 0;
+        if (value) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+        return wasSet != value;
+    }
+
+    /**
+     * @brief 清除所有位
+     */
+    void reset() { std::fill(myWords.begin(), myWords.end(), 0); }
+
+    /**
+     * @brief 统计置位的个数
+     */
+    size_t count() const {
+        size_t total = 0;
+        for (std::uint64_t word : myWords) {
+            total += popCount(word);
+        }
+        return total;
+    }
+
+    /**
+     * @brief 检查是否有置位
+     */
+    bool any() const {
+        return std::any_of(myWords.begin(), myWords.end(), [](std::uint64_t word) { return word != 0; });
+    }
+
+    /**
+     * @brief 查找最低的置位
+     *
+     * @return 该位的序号，没有置位时返回size()
+     */
+    size_t findFirst() const {
+        for (size_t i = 0; i < myWords.size(); ++i) {
+            if (myWords[i] != 0) {
+                return i * 64 + countTrailingZeros(myWords[i]);
+            }
+        }
+        return mySize;
+    }
+
+    /**
+     * @brief 并集；other较长的部分被忽略
+     */
+    DynamicBitset& operator|=(const DynamicBitset& other) {
+        const size_t nbWords = std::min(myWords.size(), other.myWords.size());
+        for (size_t i = 0; i < nbWords; ++i) {
+            myWords[i] |= other.myWords[i];
+        }
+        clearTail();
+        return *this;
+    }
+
+    /**
+     * @brief 交集；other较短时超出部分视为0
+     */
+    DynamicBitset& operator&=(const DynamicBitset& other) {
+        const size_t nbWords = std::min(myWords.size(), other.myWords.size());
+        for (size_t i = 0; i < nbWords; ++i) {
+            myWords[i] &= other.myWords[i];
+        }
+        std::fill(myWords.begin() + nbWords, myWords.end(), 0);
+        return *this;
+    }
+
+    /**
+     * @brief 差集：清除other中置位的位
+     */
+    DynamicBitset& subtract(const DynamicBitset& other) {
+        const size_t nbWords = std::min(myWords.size(), other.myWords.size());
+        for (size_t i = 0; i < nbWords; ++i) {
+            myWords[i] &= ~other.myWords[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 对长度内的所有位取反
+     */
+    DynamicBitset& flip() {
+        for (std::uint64_t& word : myWords) {
+            word = ~word;
+        }
+        clearTail();
+        return *this;
+    }
+
+    /**
+     * @brief 按序号升序遍历置位
+     *
+     * @param func 处理函数，签名为 void(size_t index)
+     */
+    template <typename Func>
+    void forEachSet(Func&& func) const {
+        for (size_t i = 0; i < myWords.size(); ++i) {
+            for (std::uint64_t word = myWords[i]; word != 0; word &= word - 1) {
+                func(i * 64 + countTrailingZeros(word));
+            }
+        }
+    }
+
+    bool operator==(const DynamicBitset& other) const {
+        return mySize == other.mySize && myWords == other.myWords;
+    }
+
+    bool operator!=(const DynamicBitset& other) const { return !(*this == other); }
+
+private:
+    /**
+     * @brief 清除最后一个字中超出长度的位
+     */
+    void clearTail() {
+        if (mySize % 64 != 0) {
+            myWords.back() &= (std::uint64_t(1) << (mySize % 64)) - 1;
+        }
+    }
+
+    /** 位的存储，每个字64位 */
+    std::vector<std::uint64_t> myWords;
+
+    /** 长度（位数） */
+    size_t mySize = 0;
+};
+
+} // namespace Utils
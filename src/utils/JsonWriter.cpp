@@ -0,0 +1,155 @@
+#include "JsonWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+namespace Utils {
+
+JsonWriter::JsonWriter(std::ostream& stream, int indent)
+    : myStream(stream), myIndent(indent) {
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    prepareValue();
+    myStream << '{';
+    myHasItems.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    const bool hasItems = !myHasItems.empty() && myHasItems.back();
+    if (!myHasItems.empty()) {
+        myHasItems.pop_back();
+    }
+    if (hasItems) {
+        newLine();
+    }
+    myStream << '}';
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    prepareValue();
+    myStream << '[';
+    myHasItems.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    const bool hasItems = !myHasItems.empty() && myHasItems.back();
+    if (!myHasItems.empty()) {
+        myHasItems.pop_back();
+    }
+    if (hasItems) {
+        newLine();
+    }
+    myStream << ']';
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const std::string& name) {
+    prepareValue();
+    writeString(myStream, name);
+    myStream << (myIndent > 0 ? ": " : ":");
+    myAfterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const std::string& text) {
+    prepareValue();
+    writeString(myStream, text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* text) {
+    return value(std::string(text ? text : ""));
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        return null();
+    }
+    prepareValue();
+    // 使用经典区域设置，15位有效数字可精确表示十进制输入（如0.1）
+    std::ostringstream buffer;
+    buffer.imbue(std::locale::classic());
+    buffer.precision(std::numeric_limits<double>::digits10);
+    buffer << number;
+    myStream << buffer.str();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::int64_t number) {
+    prepareValue();
+    myStream << std::to_string(number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::uint64_t number) {
+    prepareValue();
+    myStream << std::to_string(number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    prepareValue();
+    myStream << (flag ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    prepareValue();
+    myStream << "null";
+    return *this;
+}
+
+void JsonWriter::writeString(std::ostream& stream, const std::string& text) {
+    stream << '"';
+    for (const char ch : text) {
+        switch (ch) {
+            case '"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\r': stream << "\\r"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", int(ch));
+                    stream << escaped;
+                }
+                else {
+                    stream << ch;
+                }
+        }
+    }
+    stream << '"';
+}
+
+void JsonWriter::prepareValue() {
+    // 键之后的值不需要分隔符
+    if (myAfterKey) {
+        myAfterKey = false;
+        return;
+    }
+    if (myHasItems.empty()) {
+        return;
+    }
+    if (myHasItems.back()) {
+        myStream << ',';
+    }
+    myHasItems.back() = true;
+    newLine();
+}
+
+void JsonWriter::newLine() {
+    if (myIndent <= 0) {
+        return;
+    }
+    myStream << '\n' << std::string(myHasItems.size() * size_t(myIndent), ' ');
+}
+
+} // namespace Utils
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @brief 流式JSON写入器
+ *
+ * 直接写入输出流，不构建文档树。逗号与缩进由写入器根据嵌套层级自动处理；
+ * 数字始终使用经典区域设置（小数点为'.'），非有限的浮点数写为null。
+ * 调用者负责保证对象中的键与值成对出现。
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param stream 输出流
+     * @param indent 每层缩进的空格数（0表示紧凑输出，不换行）
+     */
+    explicit JsonWriter(std::ostream& stream, int indent = 2);
+
+    /**
+     * @brief 开始一个对象
+     */
+    JsonWriter& beginObject();
+
+    /**
+     * @brief 结束当前对象
+     */
+    JsonWriter& endObject();
+
+    /**
+     * @brief 开始一个数组
+     */
+    JsonWriter& beginArray();
+
+    /**
+     * @brief 结束当前数组
+     */
+    JsonWriter& endArray();
+
+    /**
+     * @brief 写入对象的键，之后必须写入一个值
+     *
+     * @param name 键名
+     */
+    JsonWriter& key(const std::string& name);
+
+    /**
+     * @brief 写入字符串值
+     */
+    JsonWriter& value(const std::string& text);
+
+    /**
+     * @brief 写入字符串值
+     */
+    JsonWriter& value(const char* text);
+
+    /**
+     * @brief 写入浮点数值（非有限值写为null）
+     */
+    JsonWriter& value(double number);
+
+    /**
+     * @brief 写入整数值
+     */
+    JsonWriter& value(std::int64_t number);
+
+    /**
+     * @brief 写入无符号整数值
+     */
+    JsonWriter& value(std::uint64_t number);
+
+    /**
+     * @brief 写入整数值
+     */
+    JsonWriter& value(int number) { return value(std::int64_t(number)); }
+
+    /**
+     * @brief 写入布尔值
+     */
+    JsonWriter& value(bool flag);
+
+    /**
+     * @brief 写入null
+     */
+    JsonWriter& null();
+
+    /**
+     * @brief 将字符串按JSON转义规则写入流（包括两侧的引号）
+     *
+     * @param stream 输出流
+     * @param text 字符串（按UTF-8原样输出，只转义引号、反斜杠与控制字符）
+     */
+    static void writeString(std::ostream& stream, const std::string& text);
+
+private:
+    /**
+     * @brief 在写入值或开始容器前输出分隔符与缩进
+     */
+    void prepareValue();
+
+    /**
+     * @brief 换行并按当前层级缩进
+     */
+    void newLine();
+
+    std::ostream& myStream;
+    int myIndent;
+
+    /** 每个打开的容器是否已包含元素 */
+    std::vector<bool> myHasItems;
+
+    /** 刚写入键，下一个值紧跟在键之后 */
+    bool myAfterKey = false;
+};
+
+} // namespace Utils
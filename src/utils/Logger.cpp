@@ -1,5 +1,7 @@
 #include "Logger.h"
 
+#include <mutex>
+
 namespace Utils {
 
 // 使用Meyer's Singleton模式确保安全初始化
@@ -8,8 +10,10 @@ std::unordered_map<std::string, std::shared_ptr<Logger>>& getLoggerRegistry() {
     return registry;
 }
 
-// 获取或创建日志记录器
+// 获取或创建日志记录器（导入工作线程也会调用，需要加锁）
 std::shared_ptr<Logger> Logger::getLogger(const std::string& module) {
+    static std::mutex registryMutex;
+    std::lock_guard<std::mutex> lock(registryMutex);
     auto& registry = getLoggerRegistry();
     auto it = registry.find(module);
     if (it != registry.end()) {
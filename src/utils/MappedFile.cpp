@@ -0,0 +1,130 @@
+#include "MappedFile.h"
+
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Utils {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        myData = std::exchange(other.myData, nullptr);
+        mySize = std::exchange(other.mySize, 0);
+        myIsOpen = std::exchange(other.myIsOpen, false);
+#ifdef _WIN32
+        myMappingHandle = std::exchange(other.myMappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filePath) {
+    close();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileW(std::filesystem::path(filePath).wstring().c_str(), GENERIC_READ,
+                              FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    mySize = static_cast<size_t>(fileSize.QuadPart);
+    if (mySize == 0) {
+        // 空文件无法映射
+        CloseHandle(file);
+        myIsOpen = true;
+        return true;
+    }
+    
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        mySize = 0;
+        return false;
+    }
+    
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        mySize = 0;
+        return false;
+    }
+    
+    myMappingHandle = mapping;
+    myData = static_cast<const char*>(view);
+#else
+    const int file = ::open(filePath.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0) {
+        ::close(file);
+        return false;
+    }
+    
+    mySize = static_cast<size_t>(fileStat.st_size);
+    if (mySize == 0) {
+        // 空文件无法映射
+        ::close(file);
+        myIsOpen = true;
+        return true;
+    }
+    
+    void* view = mmap(nullptr, mySize, PROT_READ, MAP_PRIVATE, file, 0);
+    // 映射建立后即可关闭文件描述符
+    ::close(file);
+    if (view == MAP_FAILED) {
+        mySize = 0;
+        return false;
+    }
+    
+    // 提示内核预读整个文件，多个线程按块并行读取时减少缺页等待
+    posix_madvise(view, mySize, POSIX_MADV_WILLNEED);
+    myData = static_cast<const char*>(view);
+#endif
+    
+    myIsOpen = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (myData != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(myData);
+        CloseHandle(static_cast<HANDLE>(myMappingHandle));
+        myMappingHandle = nullptr;
+#else
+        munmap(const_cast<char*>(myData), mySize);
+#endif
+    }
+    myData = nullptr;
+    mySize = 0;
+    myIsOpen = false;
+}
+
+} // namespace Utils
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Utils {
+
+/**
+ * @brief 只读内存映射文件
+ * 
+ * 将整个文件映射到进程地址空间，读取时由操作系统按页加载，不经过额外的缓冲区拷贝。
+ * 映射在对象销毁或调用 close() 时解除。
+ */
+class MappedFile {
+public:
+    /**
+     * @brief 构造一个未打开的映射
+     */
+    MappedFile() = default;
+    
+    /**
+     * @brief 构造并映射文件
+     * 
+     * @param filePath 文件路径
+     */
+    explicit MappedFile(const std::string& filePath) { open(filePath); }
+    
+    /**
+     * @brief 析构函数，解除映射
+     */
+    ~MappedFile() { close(); }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    /**
+     * @brief 映射文件
+     * 
+     * @param filePath 文件路径
+     * @return 成功返回true（空文件也视为成功，此时 data() 为空指针）
+     */
+    bool open(const std::string& filePath);
+    
+    /**
+     * @brief 解除映射
+     */
+    void close();
+    
+    /**
+     * @brief 检查文件是否已映射
+     * 
+     * @return 已映射返回true
+     */
+    bool isOpen() const { return myIsOpen; }
+    
+    /**
+     * @brief 获取映射内存的起始地址
+     * 
+     * @return 文件内容的起始地址
+     */
+    const char* data() const { return myData; }
+    
+    /**
+     * @brief 获取文件大小
+     * 
+     * @return 文件字节数
+     */
+    size_t size() const { return mySize; }
+    
+private:
+    /** 映射内存的起始地址 */
+    const char* myData = nullptr;
+    
+    /** 文件字节数 */
+    size_t mySize = 0;
+    
+    /** 是否已映射 */
+    bool myIsOpen = false;
+    
+#ifdef _WIN32
+    /** Windows 文件映射对象句柄 */
+    void* myMappingHandle = nullptr;
+#endif
+};
+
+} // namespace Utils
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @brief 获取并行任务使用的线程数
+ * 
+ * @return 硬件线程数（至少为1）
+ */
+inline unsigned int getParallelThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief 将区间划分为连续的块并在多个线程上并行处理
+ * 
+ * 调用线程也参与处理。处理函数不应抛出异常。
+ * 
+ * @param begin 起始索引
+ * @param end 结束索引（不含）
+ * @param minChunkSize 每块的最小元素数，避免小任务的线程开销
+ * @param func 处理函数，签名为 void(size_t chunkBegin, size_t chunkEnd)
+ */
+template <typename Func>
+void parallelFor(size_t begin, size_t end, size_t minChunkSize, Func&& func) {
+    if (end <= begin) {
+        return;
+    }
+    
+    const size_t count = end - begin;
+    const size_t nbChunks = std::min<size_t>(getParallelThreadCount(),
+                                             std::max<size_t>(1, count / std::max<size_t>(1, minChunkSize)));
+    if (nbChunks <= 1) {
+        func(begin, end);
+        return;
+    }
+    
+    const size_t chunkSize = (count + nbChunks - 1) / nbChunks;
+    std::vector<std::thread> threads;
+    threads.reserve(nbChunks - 1);
+    for (size_t chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize) {
+        const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+        threads.emplace_back([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); });
+    }
+    func(begin, std::min(end, begin + chunkSize));
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief 并行排序
+ * 
+ * 先将区间分块并行排序，再逐轮两两归并相邻的块（每轮内的归并也并行执行）。
+ * 与 std::sort 一样不是稳定排序，需要确定的顺序时应在比较函数中加入次要键。
+ * 
+ * @param begin 起始迭代器（随机访问）
+ * @param end 结束迭代器
+ * @param comp 比较函数
+ * @param minChunkSize 每块的最小元素数，元素较少时直接调用 std::sort
+ */
+template <typename Iterator, typename Compare>
+void parallelSort(Iterator begin, Iterator end, Compare comp, size_t minChunkSize = size_t(1) << 16) {
+    const size_t count = static_cast<size_t>(end - begin);
+    const size_t nbChunks = std::min<size_t>(getParallelThreadCount(),
+                                             std::max<size_t>(1, count / std::max<size_t>(1, minChunkSize)));
+    if (nbChunks <= 1) {
+        std::sort(begin, end, comp);
+        return;
+    }
+    
+    std::vector<size_t> bounds(nbChunks + 1);
+    for (size_t i = 0; i <= nbChunks; ++i) {
+        bounds[i] = count * i / nbChunks;
+    }
+    parallelFor(0, nbChunks, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            std::sort(begin + bounds[i], begin + bounds[i + 1], comp);
+        }
+    });
+    
+    // 每轮把相邻的两个有序块归并为一个
+    while (bounds.size() > 2) {
+        const size_t nbPairs = (bounds.size() - 1) / 2;
+        parallelFor(0, nbPairs, 1, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                std::inplace_merge(begin + bounds[2 * i], begin + bounds[2 * i + 1], begin + bounds[2 * i + 2], comp);
+            }
+        });
+        std::vector<size_t> merged;
+        merged.reserve(nbPairs + 2);
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != bounds.back()) {
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
+}
+
+} // namespace Utils
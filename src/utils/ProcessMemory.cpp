@@ -0,0 +1,81 @@
+#include "ProcessMemory.h"
+
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace Utils {
+
+#ifdef __linux__
+namespace {
+// 从/proc/self/status读取以kB为单位的字段
+std::uint64_t readStatusKilobytes(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            return std::stoull(line.substr(key.size())) * 1024;
+        }
+    }
+    return 0;
+}
+} // namespace
+#endif
+
+std::uint64_t getResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    return readStatusKilobytes("VmRSS:");
+#else
+    return 0;
+#endif
+}
+
+std::uint64_t getPeakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    return readStatusKilobytes("VmHWM:");
+#else
+    // macOS上ru_maxrss以字节为单位
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return std::uint64_t(usage.ru_maxrss);
+    }
+    return 0;
+#endif
+}
+
+bool resetPeakResidentBytes() {
+#ifdef __linux__
+    // 写入5将VmHWM重置为当前的VmRSS（Linux 4.0起支持）
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.close();
+    return clearRefs.good() && getPeakResidentBytes() <= getResidentBytes() + (std::uint64_t(1) << 20);
+#else
+    return false;
+#endif
+}
+
+} // namespace Utils
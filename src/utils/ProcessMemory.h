@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Utils {
+
+/**
+ * @brief 获取当前进程的常驻内存大小
+ * 
+ * @return 常驻内存字节数（平台不支持时返回0）
+ */
+std::uint64_t getResidentBytes();
+
+/**
+ * @brief 获取当前进程常驻内存的峰值
+ * 
+ * @return 峰值字节数（平台不支持时返回0）
+ */
+std::uint64_t getPeakResidentBytes();
+
+/**
+ * @brief 将常驻内存峰值重置为当前值
+ * 
+ * 用于测量某一段操作的峰值内存，目前仅Linux支持。
+ * 
+ * @return 成功重置返回true
+ */
+bool resetPeakResidentBytes();
+
+} // namespace Utils
@@ -1,5 +1,6 @@
 #include "ImGuiView.h"
 #include "viewmodel/Commands.h"
+#include "model/ModelArchive.h"
 #include "mvvm/MessageBus.h"
 #include "mvvm/GlobalSettings.h"
 #include "utils/Logger.h"
@@ -8,6 +9,8 @@
 #include "imgui_impl_opengl3.h"
 #include <GLFW/glfw3.h>
 #include <nfd.h>
+#include <algorithm>
+#include <filesystem>
 
 // 创建ImGui视图日志记录器 - 使用函数确保安全初始化
 std::shared_ptr<Utils::Logger>& getImGuiLogger() {
@@ -87,6 +90,14 @@ void ImGuiView::newFrame() {
 }
 
 void ImGuiView::render() {
+    // 提交已完成的后台导入、剖分和显示准备（必须在UI线程执行）
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (unifiedViewModel) {
+        unifiedViewModel->pollImport();
+        unifiedViewModel->pollMeshing();
+        unifiedViewModel->pollPresentations();
+    }
+    
     // 渲染菜单栏
     renderMainMenu();
     
@@ -106,6 +117,15 @@ void ImGuiView::render() {
     // 渲染状态栏
     renderStatusBar();
     
+    // 渲染导入和剖分进度
+    renderImportProgress();
+    renderMeshingProgress();
+    
+    // 渲染导入统计面板
+    if (showImportStatistics) {
+        renderImportStatistics();
+    }
+    
     // 渲染ImGui演示窗口（用于开发调试）
     if (showDemoWindow) {
         ImGui::ShowDemoWindow(&showDemoWindow);
@@ -132,16 +152,29 @@ void ImGuiView::renderMainMenu() {
             if (ImGui::MenuItem("New", "Ctrl+N")) {
                 // 处理新建命令
             }
-            if (ImGui::MenuItem("Open", "Ctrl+O")) {
-                // 处理打开命令
+            const bool canImport = getUnifiedViewModel() && !getUnifiedViewModel()->isImporting();
+            if (ImGui::MenuItem("Open", "Ctrl+O", false, canImport)) {
+                executeOpenModel();
             }
-            if (ImGui::MenuItem("Save", "Ctrl+S")) {
-                // 处理保存命令
+            if (ImGui::MenuItem("Save", "Ctrl+S", false, getUnifiedViewModel() != nullptr)) {
+                executeSaveModel();
             }
             ImGui::Separator();
-            if (ImGui::MenuItem("Import Model", "Ctrl+I")) {
+            if (ImGui::MenuItem("Import Model", "Ctrl+I", false, canImport)) {
                 executeImportModel();
             }
+            if (ImGui::MenuItem("Import Folder", nullptr, false, canImport)) {
+                executeImportFolder();
+            }
+            if (ImGui::BeginMenu("Export", getUnifiedViewModel() != nullptr)) {
+                if (ImGui::MenuItem("Export All...")) {
+                    executeExportModel(false);
+                }
+                if (ImGui::MenuItem("Export Selection...", nullptr, false, myViewModel->hasSelection())) {
+                    executeExportModel(true);
+                }
+                ImGui::EndMenu();
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit", "Alt+F4")) {
                 // 处理退出命令
@@ -154,12 +187,44 @@ void ImGuiView::renderMainMenu() {
             if (ImGui::MenuItem("Delete Selected", "Delete", false, myViewModel->hasSelection())) {
                 executeDeleteSelected();
             }
+            ImGui::Separator();
+            
+            // 批量选择
+            auto unifiedViewModel = getUnifiedViewModel();
+            if (ImGui::MenuItem("Select All", "Ctrl+A", false, unifiedViewModel != nullptr)) {
+                unifiedViewModel->selectAll();
+            }
+            if (ImGui::MenuItem("Invert Selection", nullptr, false, unifiedViewModel != nullptr)) {
+                unifiedViewModel->invertSelection();
+            }
+            if (ImGui::MenuItem("Select Shapes", nullptr, false, unifiedViewModel != nullptr)) {
+                unifiedViewModel->selectByType(UnifiedModel::GeometryType::SHAPE);
+            }
+            if (ImGui::MenuItem("Select Meshes", nullptr, false, unifiedViewModel != nullptr)) {
+                unifiedViewModel->selectByType(UnifiedModel::GeometryType::MESH);
+            }
+            if (ImGui::MenuItem("Select Same Color", nullptr, false, myViewModel->hasSelection() && unifiedViewModel)) {
+                unifiedViewModel->selectByColor(unifiedViewModel->getSelectedColor());
+            }
+            if (ImGui::MenuItem("Clear Selection", nullptr, false, myViewModel->hasSelection())) {
+                myViewModel->clearSelection();
+            }
+            ImGui::Separator();
+            
+            // 选择级别：整个对象，或网格的三角形和零件的面
+            bool isElementSelection = unifiedViewModel && unifiedViewModel->elementSelection.get();
+            if (ImGui::MenuItem("Select Elements", nullptr, &isElementSelection, unifiedViewModel != nullptr)) {
+                unifiedViewModel->elementSelection.set(isElementSelection);
+            }
+            ImGui::TextDisabled("Alt+Drag: box, Alt+Right Drag: lasso");
+            ImGui::TextDisabled("Shift: add, Ctrl: toggle");
             ImGui::EndMenu();
         }
         
         if (ImGui::BeginMenu("View")) {
             ImGui::MenuItem("Object Properties", nullptr, &showObjectProperties);
             ImGui::MenuItem("Object Tree", nullptr, &showObjectTree);
+            ImGui::MenuItem("Import Statistics", nullptr, &showImportStatistics);
             ImGui::Separator();
             ImGui::MenuItem("ImGui Demo Window", nullptr, &showDemoWindow);
             ImGui::EndMenu();
@@ -183,6 +248,16 @@ void ImGuiView::renderMainMenu() {
             ImGui::EndMenu();
         }
         
+        if (ImGui::BeginMenu("Mesh")) {
+            auto unifiedViewModel = getUnifiedViewModel();
+            const bool canMesh = unifiedViewModel && !unifiedViewModel->isMeshing()
+                              && myViewModel->hasSelection();
+            if (ImGui::MenuItem("Generate Netgen Mesh", nullptr, false, canMesh)) {
+                unifiedViewModel->startMeshingSelectedAsync();
+            }
+            ImGui::EndMenu();
+        }
+        
         ImGui::EndMainMenuBar();
     }
 }
@@ -193,10 +268,16 @@ void ImGuiView::renderToolbar() {
     auto unifiedViewModel = getUnifiedViewModel();
     
     if (unifiedViewModel) {
+        ImGui::BeginDisabled(unifiedViewModel->isImporting());
         if (ImGui::Button("Import")) {
             executeImportModel();
         }
         ImGui::SameLine();
+        if (ImGui::Button("Import Folder")) {
+            executeImportFolder();
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
         if (ImGui::Button("Box")) {
             executeCreateBox();
         }
@@ -237,7 +318,10 @@ void ImGuiView::renderGeometryProperties() {
     if (!unifiedViewModel) return;
     
     if (unifiedViewModel->hasSelection()) {
-        ImGui::Text("Selected objects: %zu", unifiedViewModel->getSelectedObjects().size());
+        ImGui::Text("Selected objects: %zu", unifiedViewModel->getSelectionCount());
+        if (unifiedViewModel->elementSelection.get()) {
+            ImGui::Text("Selected elements: %d", unifiedViewModel->selectedElementCountProperty.get());
+        }
         
         // 显示颜色选择器
         Quantity_Color currentColor = unifiedViewModel->getSelectedColor();
@@ -276,6 +360,87 @@ void ImGuiView::renderGeometryProperties() {
     if (ImGui::Checkbox("Show View Cube", &isViewCubeVisible)) {
         globalSettings.isViewCubeVisible = isViewCubeVisible;
     }
+    
+    bool backgroundPresentations = globalSettings.backgroundPresentations.get();
+    if (ImGui::Checkbox("Background Presentations", &backgroundPresentations)) {
+        globalSettings.backgroundPresentations = backgroundPresentations;
+    }
+    
+    // 批量导入设置
+    int importWorkerCount = globalSettings.importWorkerCount.get();
+    if (ImGui::SliderInt("Import Workers", &importWorkerCount, 0, 32, importWorkerCount == 0 ? "Auto" : "%d")) {
+        globalSettings.importWorkerCount = importWorkerCount;
+    }
+    
+    int importMemoryBudgetMB = globalSettings.importMemoryBudgetMB.get();
+    if (ImGui::InputInt("Import Budget (MB)", &importMemoryBudgetMB, 256, 1024)) {
+        globalSettings.importMemoryBudgetMB = std::max(64, importMemoryBudgetMB);
+    }
+    
+    bool streamImportPreview = globalSettings.streamImportPreview.get();
+    if (ImGui::Checkbox("Stream Mesh Preview", &streamImportPreview)) {
+        globalSettings.streamImportPreview = streamImportPreview;
+    }
+    
+    bool repairMeshesOnImport = globalSettings.repairMeshesOnImport.get();
+    if (ImGui::Checkbox("Repair Meshes On Import", &repairMeshesOnImport)) {
+        globalSettings.repairMeshesOnImport = repairMeshesOnImport;
+    }
+    
+    // 导入缓存设置
+    bool importCacheEnabled = globalSettings.importCacheEnabled.get();
+    if (ImGui::Checkbox("Import Cache", &importCacheEnabled)) {
+        globalSettings.importCacheEnabled = importCacheEnabled;
+    }
+    
+    int importCacheSizeMB = globalSettings.importCacheSizeMB.get();
+    if (ImGui::InputInt("Cache Size (MB)", &importCacheSizeMB, 256, 1024)) {
+        globalSettings.importCacheSizeMB = std::max(64, importCacheSizeMB);
+    }
+    
+    const ImportCache::Stats cacheStats = unifiedViewModel->getImportCacheStats();
+    ImGui::Text("Cache: %llu hits, %llu misses, %.1f MB",
+                static_cast<unsigned long long>(cacheStats.hits),
+                static_cast<unsigned long long>(cacheStats.misses),
+                double(cacheStats.sizeBytes) / (1024.0 * 1024.0));
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Clear Cache")) {
+        unifiedViewModel->clearImportCache();
+    }
+    
+    // 导入时剖分设置
+    bool tessellateOnImport = globalSettings.tessellateOnImport.get();
+    if (ImGui::Checkbox("Tessellate On Import", &tessellateOnImport)) {
+        globalSettings.tessellateOnImport = tessellateOnImport;
+    }
+    
+    float deviationCoefficient = static_cast<float>(globalSettings.meshDeviationCoefficient.get());
+    if (ImGui::SliderFloat("Linear Deflection", &deviationCoefficient, 0.0001f, 0.01f, "%.4f",
+                           ImGuiSliderFlags_Logarithmic)) {
+        globalSettings.meshDeviationCoefficient = static_cast<double>(deviationCoefficient);
+    }
+    
+    float deviationAngle = static_cast<float>(globalSettings.meshDeviationAngleDeg.get());
+    if (ImGui::SliderFloat("Angular Deflection", &deviationAngle, 1.0f, 45.0f, "%.1f deg")) {
+        globalSettings.meshDeviationAngleDeg = static_cast<double>(deviationAngle);
+    }
+    
+    // Netgen剖分设置
+    float netgenMaxSize = static_cast<float>(globalSettings.netgenMaxSize.get());
+    if (ImGui::InputFloat("Netgen Max Size", &netgenMaxSize, 0.0f, 0.0f,
+                          netgenMaxSize <= 0.0f ? "Auto" : "%.3f")) {
+        globalSettings.netgenMaxSize = std::max(0.0, static_cast<double>(netgenMaxSize));
+    }
+    
+    float netgenGrading = static_cast<float>(globalSettings.netgenGrading.get());
+    if (ImGui::SliderFloat("Netgen Grading", &netgenGrading, 0.1f, 1.0f, "%.2f")) {
+        globalSettings.netgenGrading = static_cast<double>(netgenGrading);
+    }
+    
+    bool netgenVolumeMesh = globalSettings.netgenVolumeMesh.get();
+    if (ImGui::Checkbox("Netgen Volume Mesh", &netgenVolumeMesh)) {
+        globalSettings.netgenVolumeMesh = netgenVolumeMesh;
+    }
 }
 
 void ImGuiView::renderObjectTree() {
@@ -302,37 +467,137 @@ void ImGuiView::renderGeometryTree() {
         return;
     }
     
-    const auto& entityIds = model->getAllEntityIds();
+    // 仅在模型结构或展开状态变化时重建行列表，避免每帧复制全部ID
+    if (myTreeDirty || myTreeGeneration != model->getStructureGeneration()) {
+        rebuildTreeRows(*model);
+    }
     
-    ImGui::Text("Objects: %zu", entityIds.size());
+    ImGui::Text("Objects: %zu", model->getEntityCount());
     ImGui::Separator();
     
-    for (const auto& id : entityIds) {
-        try {
-            UnifiedModel::GeometryType type = model->getGeometryType(id);
-            std::string typeStr;
+    // 只渲染可见的行
+    const float indentSpacing = ImGui::GetStyle().IndentSpacing;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(myTreeRows.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const TreeRow& row = myTreeRows[i];
+            const float indent = row.depth * indentSpacing;
+            if (indent > 0.0f) {
+                ImGui::Indent(indent);
+            }
+            
+            // 隐藏的实体以禁用颜色显示
+            const bool isVisible = model->isVisible(row.id);
+            if (!isVisible) {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+            }
             
-            switch (type) {
-                case UnifiedModel::GeometryType::SHAPE:
-                    typeStr = "CAD";
-                    break;
-                case UnifiedModel::GeometryType::MESH:
-                    typeStr = "Mesh";
-                    break;
-                default:
-                    typeStr = "Unknown";
+            const bool isSelected = unifiedViewModel->isSelected(row.selectionHandle);
+            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen
+                                     | ImGuiTreeNodeFlags_SpanAvailWidth;
+            if (isSelected) {
+                flags |= ImGuiTreeNodeFlags_Selected;
             }
             
-            std::string label = id + " [" + typeStr + "]";
-            bool isSelected = std::find(unifiedViewModel->getSelectedObjects().begin(),
-                                        unifiedViewModel->getSelectedObjects().end(),
-                                        id) != unifiedViewModel->getSelectedObjects().end();
+            if (row.isAssembly) {
+                // 装配节点：展开状态由视图自己维护，变化时下一帧重建行列表
+                const bool isExpanded = myExpandedNodes.count(row.id) > 0;
+                ImGui::SetNextItemOpen(isExpanded);
+                const bool isOpen = ImGui::TreeNodeEx(row.id.c_str(),
+                                                      flags | ImGuiTreeNodeFlags_OpenOnArrow,
+                                                      "%s",
+                                                      row.label.c_str());
+                if (isOpen != isExpanded) {
+                    if (isOpen) {
+                        myExpandedNodes.insert(row.id);
+                    }
+                    else {
+                        myExpandedNodes.erase(row.id);
+                    }
+                    myTreeDirty = true;
+                }
+            }
+            else {
+                ImGui::TreeNodeEx(row.id.c_str(),
+                                  flags | ImGuiTreeNodeFlags_Leaf,
+                                  "%s",
+                                  row.label.c_str());
+                if (ImGui::IsItemClicked()) {
+                    // Ctrl单击切换选中状态，否则只选中该实体
+                    unifiedViewModel->selectEntity(row.id,
+                                                   ImGui::GetIO().KeyCtrl ? SelectionSet::Operation::TOGGLE
+                                                                          : SelectionSet::Operation::REPLACE);
+                }
+            }
             
-            if (ImGui::Selectable(label.c_str(), isSelected)) {
-                // TODO: 处理选择
+            if (!isVisible) {
+                ImGui::PopStyleColor();
             }
-        } catch (const std::exception& e) {
-            ImGui::TextColored(ImVec4(1, 0, 0, 1), "Error: %s", e.what());
+            if (ImGui::BeginPopupContextItem()) {
+                if (ImGui::MenuItem(isVisible ? "Hide" : "Show")) {
+                    unifiedViewModel->setVisible(row.id, !isVisible);
+                }
+                ImGui::EndPopup();
+            }
+            
+            if (indent > 0.0f) {
+                ImGui::Unindent(indent);
+            }
+        }
+    }
+}
+
+void ImGuiView::rebuildTreeRows(const UnifiedModel& model) {
+    myTreeRows.clear();
+    for (const auto& entity : model.getEntities()) {
+        if (entity.second.parentId.empty()) {
+            appendTreeRows(model, entity.first, 0);
+        }
+    }
+    
+    // 句柄只在实体增删时变化，缓存在行中，每帧的选中检查只是位测试
+    if (auto unifiedViewModel = getUnifiedViewModel()) {
+        for (TreeRow& row : myTreeRows) {
+            row.selectionHandle = unifiedViewModel->getSelectionHandle(row.id);
+        }
+    }
+    myTreeGeneration = model.getStructureGeneration();
+    myTreeDirty = false;
+}
+
+void ImGuiView::appendTreeRows(const UnifiedModel& model, const std::string& id, int depth) {
+    const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+    if (!data) {
+        return;
+    }
+    
+    std::string typeStr;
+    switch (data->type) {
+        case UnifiedModel::GeometryType::SHAPE:
+            typeStr = "CAD";
+            break;
+        case UnifiedModel::GeometryType::MESH:
+            typeStr = "Mesh";
+            break;
+        case UnifiedModel::GeometryType::ASSEMBLY:
+            typeStr = "Assembly";
+            break;
+        default:
+            typeStr = "Unknown";
+    }
+    
+    TreeRow row;
+    row.id = id;
+    row.label = (data->name.empty() ? id : data->name) + " [" + typeStr + "]";
+    row.depth = depth;
+    row.isAssembly = data->type == UnifiedModel::GeometryType::ASSEMBLY;
+    myTreeRows.push_back(std::move(row));
+    
+    // 只展开用户打开的装配节点
+    if (data->type == UnifiedModel::GeometryType::ASSEMBLY && myExpandedNodes.count(id) > 0) {
+        for (const auto& childId : data->childIds) {
+            appendTreeRows(model, childId, depth + 1);
         }
     }
 }
@@ -350,10 +615,36 @@ void ImGuiView::renderStatusBar() {
     
     if (ImGui::Begin("StatusBar", nullptr, windowFlags)) {
         ImGui::Text("OpenCascade ImGui Demo");
-        ImGui::SameLine(ImGui::GetWindowWidth() - 120);
         
-        if (myViewModel->hasSelection()) {
-            ImGui::Text("Selected: %zu", myViewModel->getSelectedObjects().size());
+        // 显示最近一次批量导入的吞吐量
+        auto unifiedViewModel = getUnifiedViewModel();
+        if (unifiedViewModel && unifiedViewModel->getLastImportStats().filesImported > 0) {
+            const auto& stats = unifiedViewModel->getLastImportStats();
+            ImGui::SameLine();
+            ImGui::Text("| Last import: %zu files, %zu parts in %.2f s (%.1f MB/s, %.1f parts/s)",
+                        stats.filesImported, stats.partsImported, stats.seconds,
+                        stats.megabytesPerSecond(), stats.partsPerSecond());
+            if (stats.meshesRepaired > 0) {
+                ImGui::SameLine();
+                ImGui::Text("| %zu meshes repaired", stats.meshesRepaired);
+            }
+        }
+
+        // 显示更新队列合并掉的重绘次数
+        if (unifiedViewModel && unifiedViewModel->getViewerUpdates().getCounters().redraws > 0) {
+            const auto& counters = unifiedViewModel->getViewerUpdates().getCounters();
+            ImGui::SameLine();
+            ImGui::Text("| Viewer: %zu redraws for %zu requests (%zu saved)",
+                        counters.redraws, counters.redrawRequests, counters.redrawsSaved());
+        }
+
+        const int elementCount = unifiedViewModel ? unifiedViewModel->selectedElementCountProperty.get() : 0;
+        ImGui::SameLine(ImGui::GetWindowWidth() - (elementCount > 0 ? 240 : 120));
+        
+        if (elementCount > 0) {
+            ImGui::Text("Selected: %zu (%d elements)", myViewModel->getSelectionCount(), elementCount);
+        } else if (myViewModel->hasSelection()) {
+            ImGui::Text("Selected: %zu", myViewModel->getSelectionCount());
         } else {
             ImGui::Text("No selection");
         }
@@ -361,6 +652,173 @@ void ImGuiView::renderStatusBar() {
     ImGui::End();
 }
 
+void ImGuiView::renderImportProgress() {
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel || !unifiedViewModel->isImporting()) {
+        return;
+    }
+    
+    const ImportJob* job = unifiedViewModel->getImportJob();
+    const ImVec2 viewportSize = ImGui::GetMainViewport()->Size;
+    ImGui::SetNextWindowPos(ImVec2(viewportSize.x * 0.5f, viewportSize.y * 0.5f),
+                            ImGuiCond_Always,
+                            ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(400, 0));
+    
+    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | 
+                                   ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings;
+    if (ImGui::Begin("Importing", nullptr, windowFlags)) {
+        ImGui::TextUnformatted(job->getStatusText().c_str());
+        ImGui::ProgressBar(static_cast<float>(job->getFraction()), ImVec2(-1.0f, 0.0f));
+        
+        if (job->isCancelled()) {
+            ImGui::TextDisabled("Cancelling...");
+        } else if (ImGui::Button("Cancel")) {
+            unifiedViewModel->cancelImport();
+        }
+    }
+    ImGui::End();
+}
+
+void ImGuiView::renderMeshingProgress() {
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel || !unifiedViewModel->isMeshing()) {
+        return;
+    }
+    
+    const MeshingJob* job = unifiedViewModel->getMeshingJob();
+    const ImVec2 viewportSize = ImGui::GetMainViewport()->Size;
+    ImGui::SetNextWindowPos(ImVec2(viewportSize.x * 0.5f, viewportSize.y * 0.5f + 80.0f),
+                            ImGuiCond_Always,
+                            ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(400, 0));
+    
+    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | 
+                                   ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings;
+    if (ImGui::Begin("Meshing", nullptr, windowFlags)) {
+        ImGui::TextUnformatted(job->getStatusText().c_str());
+        ImGui::ProgressBar(static_cast<float>(job->getFraction()), ImVec2(-1.0f, 0.0f));
+        
+        if (job->isCancelled()) {
+            ImGui::TextDisabled("Cancelling...");
+        } else if (ImGui::Button("Cancel")) {
+            unifiedViewModel->cancelMeshing();
+        }
+    }
+    ImGui::End();
+}
+
+void ImGuiView::renderImportStatistics() {
+    ImGui::SetNextWindowSize(ImVec2(640, 360), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Import Statistics", &showImportStatistics)) {
+        ImGui::End();
+        return;
+    }
+    
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel) {
+        ImGui::Text("Unknown view model type");
+        ImGui::End();
+        return;
+    }
+    
+    // 导入日志：每次导入追加一行JSON
+    auto& globalSettings = unifiedViewModel->getGlobalSettings();
+    bool importLogEnabled = globalSettings.importLogEnabled.get();
+    if (ImGui::Checkbox("Write Import Log", &importLogEnabled)) {
+        globalSettings.importLogEnabled = importLogEnabled;
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("%s", globalSettings.importLogPath.get().c_str());
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Clear")) {
+        unifiedViewModel->clearImportRecords();
+    }
+    
+    const auto& records = unifiedViewModel->getImportRecords();
+    if (records.empty()) {
+        ImGui::TextDisabled("No import yet");
+        ImGui::End();
+        return;
+    }
+    
+    // 最近的导入在最上面；展开一行显示各阶段耗时及其占比
+    const ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                       ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("ImportRecords", 7, tableFlags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Time (s)");
+        ImGui::TableSetupColumn("Share");
+        ImGui::TableSetupColumn("MB/s");
+        ImGui::TableSetupColumn("Mtri/s");
+        ImGui::TableSetupColumn("Triangles");
+        ImGui::TableSetupColumn("Peak +MB");
+        ImGui::TableHeadersRow();
+        
+        for (auto it = records.rbegin(); it != records.rend(); ++it) {
+            const ImportRecord& record = *it;
+            ImGui::PushID(&record);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            const std::string label = std::filesystem::path(record.filePath).filename().string()
+                + (record.cacheHit ? " (cache)" : "")
+                + (record.cancelled ? " (cancelled)" : (record.succeeded ? "" : " (failed)"));
+            const bool isOpen = ImGui::TreeNodeEx(label.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", record.seconds);
+            // 占比只对展开后的阶段有意义，导入行留空
+            ImGui::TableNextColumn();
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", record.megabytesPerSecond());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", record.trianglesPerSecond() / 1.0e6);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(record.triangles));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", double(record.peakGrowthBytes()) / (1024.0 * 1024.0));
+            
+            if (isOpen) {
+                // 占比相对于全部阶段（含显示）的总耗时
+                double stageSeconds = 0.0;
+                for (const ImportStageTiming& stage : record.stages) {
+                    stageSeconds += stage.seconds;
+                }
+                for (const ImportStageTiming& stage : record.stages) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Indent();
+                    ImGui::TextUnformatted(stage.name.c_str());
+                    ImGui::Unindent();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", stage.seconds);
+                    ImGui::TableNextColumn();
+                    if (stageSeconds > 0.0) {
+                        ImGui::Text("%.0f%%", 100.0 * stage.seconds / stageSeconds);
+                    }
+                    ImGui::TableNextColumn();
+                    if (stage.bytes > 0 && stage.seconds > 0.0) {
+                        ImGui::Text("%.1f", double(stage.bytes) / (1024.0 * 1024.0) / stage.seconds);
+                    }
+                    ImGui::TableNextColumn();
+                    if (stage.elements > 0 && stage.seconds > 0.0) {
+                        ImGui::Text("%.2f", double(stage.elements) / stage.seconds / 1.0e6);
+                    }
+                    ImGui::TableNextColumn();
+                    if (stage.elements > 0) {
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stage.elements));
+                    }
+                    ImGui::TableNextColumn();
+                }
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
 void ImGuiView::executeCreateBox() {
     auto unifiedViewModel = getUnifiedViewModel();
     if (!unifiedViewModel) return;
@@ -402,35 +860,45 @@ void ImGuiView::executeImportModel() {
     // 初始化NFD (Native File Dialog)
     NFD_Init();
     
-    nfdchar_t *outPath = nullptr;
-    nfdfilteritem_t filterItems[4] = {
-        { "All Files", "step,stp,stl,obj" },
+    const nfdpathset_t *outPaths = nullptr;
+    nfdfilteritem_t filterItems[6] = {
+        { "All Files", "step,stp,stl,obj,ply,gltf,glb" },
         { "STEP Files", "step,stp" },
         { "STL Files", "stl" },
-        { "OBJ Files", "obj" }
+        { "OBJ Files", "obj" },
+        { "PLY Files", "ply" },
+        { "glTF Files", "gltf,glb" }
     };
     
-    // 打开文件对话框
-    nfdresult_t result = NFD_OpenDialog(&outPath, filterItems, 4, nullptr);
+    // 打开文件对话框（支持多选）
+    nfdresult_t result = NFD_OpenDialogMultiple(&outPaths, filterItems, 6, nullptr);
     
     if (result == NFD_OKAY) {
-        getImGuiLogger()->info("Selected file: {}", outPath);
+        // 收集选中的文件路径
+        std::vector<std::string> filePaths;
+        nfdpathsetsize_t count = 0;
+        NFD_PathSet_GetCount(outPaths, &count);
+        for (nfdpathsetsize_t i = 0; i < count; ++i) {
+            nfdchar_t *path = nullptr;
+            if (NFD_PathSet_GetPath(outPaths, i, &path) == NFD_OKAY) {
+                filePaths.emplace_back(path);
+                NFD_PathSet_FreePath(path);
+            }
+        }
+        NFD_PathSet_Free(outPaths);
+        getImGuiLogger()->info("Selected {} file(s)", filePaths.size());
         
         // 获取UnifiedViewModel
         auto unifiedViewModel = getUnifiedViewModel();
         if (!unifiedViewModel) {
             getImGuiLogger()->error("Failed to get UnifiedViewModel");
-            NFD_FreePath(outPath);
             NFD_Quit();
             return;
         }
         
-        // 创建并执行导入模型命令
-        Commands::ImportModelCommand importCmd(unifiedViewModel, outPath);
+        // 创建并执行导入模型命令（在后台线程并行导入，不阻塞界面）
+        Commands::ImportModelCommand importCmd(unifiedViewModel, filePaths);
         importCmd.execute();
-        
-        // 释放路径内存
-        NFD_FreePath(outPath);
     } else if (result == NFD_CANCEL) {
         getImGuiLogger()->info("User canceled file dialog");
     } else {
@@ -441,6 +909,151 @@ void ImGuiView::executeImportModel() {
     NFD_Quit();
 }
 
+void ImGuiView::executeImportFolder() {
+    getImGuiLogger()->info("Executing import folder command");
+    
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel) {
+        getImGuiLogger()->error("Failed to get UnifiedViewModel");
+        return;
+    }
+    
+    NFD_Init();
+    
+    // 选择文件夹，导入其中所有支持的文件
+    nfdchar_t *outPath = nullptr;
+    nfdresult_t result = NFD_PickFolder(&outPath, nullptr);
+    
+    if (result == NFD_OKAY) {
+        getImGuiLogger()->info("Selected folder: {}", outPath);
+        if (!unifiedViewModel->startImportDirectoryAsync(outPath)) {
+            getImGuiLogger()->warn("No supported files imported from '{}'", outPath);
+        }
+        NFD_FreePath(outPath);
+    } else if (result == NFD_CANCEL) {
+        getImGuiLogger()->info("User canceled folder dialog");
+    } else {
+        getImGuiLogger()->error("Error opening folder dialog: {}", NFD_GetError());
+    }
+    
+    NFD_Quit();
+}
+
+void ImGuiView::executeOpenModel() {
+    getImGuiLogger()->info("Executing open model command");
+    
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel) {
+        getImGuiLogger()->error("Failed to get UnifiedViewModel");
+        return;
+    }
+    
+    NFD_Init();
+    
+    nfdchar_t *outPath = nullptr;
+    nfdfilteritem_t filterItem[1] = { { "Model Archive", ModelArchive::FILE_EXTENSION + 1 } };
+    nfdresult_t result = NFD_OpenDialog(&outPath, filterItem, 1, nullptr);
+    
+    if (result == NFD_OKAY) {
+        getImGuiLogger()->info("Selected file: {}", outPath);
+        Commands::OpenModelCommand openCmd(unifiedViewModel, outPath);
+        openCmd.execute();
+        myModelFilePath = outPath;
+        NFD_FreePath(outPath);
+    } else if (result == NFD_CANCEL) {
+        getImGuiLogger()->info("User canceled file dialog");
+    } else {
+        getImGuiLogger()->error("Error opening file dialog: {}", NFD_GetError());
+    }
+    
+    NFD_Quit();
+}
+
+void ImGuiView::executeSaveModel() {
+    getImGuiLogger()->info("Executing save model command");
+    
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel) {
+        getImGuiLogger()->error("Failed to get UnifiedViewModel");
+        return;
+    }
+    
+    NFD_Init();
+    
+    // 默认使用上次打开或保存的文件名
+    const std::filesystem::path currentPath(myModelFilePath);
+    const std::string defaultPath = currentPath.has_parent_path() ? currentPath.parent_path().string() : "";
+    const std::string defaultName =
+        currentPath.has_filename() ? currentPath.filename().string() : std::string("model") + ModelArchive::FILE_EXTENSION;
+    
+    nfdchar_t *outPath = nullptr;
+    nfdfilteritem_t filterItem[1] = { { "Model Archive", ModelArchive::FILE_EXTENSION + 1 } };
+    nfdresult_t result = NFD_SaveDialog(&outPath,
+                                        filterItem,
+                                        1,
+                                        defaultPath.empty() ? nullptr : defaultPath.c_str(),
+                                        defaultName.c_str());
+    
+    if (result == NFD_OKAY) {
+        std::filesystem::path filePath(outPath);
+        if (filePath.extension().empty()) {
+            filePath += ModelArchive::FILE_EXTENSION;
+        }
+        Commands::SaveModelCommand saveCmd(unifiedViewModel, filePath.string());
+        saveCmd.execute();
+        myModelFilePath = filePath.string();
+        NFD_FreePath(outPath);
+    } else if (result == NFD_CANCEL) {
+        getImGuiLogger()->info("User canceled file dialog");
+    } else {
+        getImGuiLogger()->error("Error opening file dialog: {}", NFD_GetError());
+    }
+    
+    NFD_Quit();
+}
+
+void ImGuiView::executeExportModel(bool selectionOnly) {
+    getImGuiLogger()->info("Executing export model command");
+    
+    auto unifiedViewModel = getUnifiedViewModel();
+    if (!unifiedViewModel) {
+        getImGuiLogger()->error("Failed to get UnifiedViewModel");
+        return;
+    }
+    
+    NFD_Init();
+    
+    // 默认导出到模型文件所在目录，格式由扩展名决定
+    const std::filesystem::path currentPath(myModelFilePath);
+    const std::string defaultPath = currentPath.has_parent_path() ? currentPath.parent_path().string() : "";
+    const std::string defaultName =
+        (currentPath.has_stem() ? currentPath.stem().string() : std::string("model")) + ".stl";
+    
+    nfdchar_t *outPath = nullptr;
+    nfdfilteritem_t filterItem[2] = { { "Binary STL", "stl" }, { "glTF Binary", "glb" } };
+    nfdresult_t result = NFD_SaveDialog(&outPath,
+                                        filterItem,
+                                        2,
+                                        defaultPath.empty() ? nullptr : defaultPath.c_str(),
+                                        defaultName.c_str());
+    
+    if (result == NFD_OKAY) {
+        std::filesystem::path filePath(outPath);
+        if (filePath.extension().empty()) {
+            filePath += ".stl";
+        }
+        Commands::ExportModelCommand exportCmd(unifiedViewModel, filePath.string(), selectionOnly);
+        exportCmd.execute();
+        NFD_FreePath(outPath);
+    } else if (result == NFD_CANCEL) {
+        getImGuiLogger()->info("User canceled file dialog");
+    } else {
+        getImGuiLogger()->error("Error opening file dialog: {}", NFD_GetError());
+    }
+    
+    NFD_Quit();
+}
+
 void ImGuiView::subscribeToEvents() {
     // 订阅相关事件
     // ...
@@ -7,7 +7,10 @@
 #include <memory>
 #include <map>
 #include <functional>
+#include <set>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 struct GLFWwindow;
 
@@ -33,6 +36,23 @@ private:
     bool showObjectProperties = true;
     bool showObjectTree = true;
     bool showDemoWindow = false;
+    bool showImportStatistics = false;
+    
+    // 对象树缓存：只在模型结构变化或展开状态变化时重建
+    struct TreeRow {
+        std::string id;
+        std::string label;
+        int depth = 0;
+        bool isAssembly = false;
+        SelectionSet::EntityHandle selectionHandle = SelectionSet::INVALID_HANDLE;
+    };
+    std::vector<TreeRow> myTreeRows;
+    std::set<std::string> myExpandedNodes;
+    std::uint64_t myTreeGeneration = UINT64_MAX;
+    bool myTreeDirty = true;
+    
+    // 当前模型存档路径（保存时作为默认文件名）
+    std::string myModelFilePath;
     
     // 获取UnifiedViewModel的辅助方法
     std::shared_ptr<UnifiedViewModel> getUnifiedViewModel() const;
@@ -43,10 +63,15 @@ private:
     void renderObjectProperties();
     void renderObjectTree();
     void renderStatusBar();
+    void renderImportProgress();
+    void renderMeshingProgress();
+    void renderImportStatistics();
     
     // 特定类型视图模型的UI渲染
     void renderGeometryProperties();
     void renderGeometryTree();
+    void rebuildTreeRows(const UnifiedModel& model);
+    void appendTreeRows(const UnifiedModel& model, const std::string& id, int depth);
 
     // 命令执行方法
     void executeCreateBox();
@@ -54,6 +79,10 @@ private:
     void executeCreateMesh();
     void executeDeleteSelected();
     void executeImportModel();
+    void executeImportFolder();
+    void executeOpenModel();
+    void executeSaveModel();
+    void executeExportModel(bool selectionOnly);
 
     // 订阅事件
     void subscribeToEvents();
@@ -3,6 +3,7 @@
 #include "mvvm/GlobalSettings.h"
 #include "utils/Logger.h"
 
+#include <AIS_RubberBand.hxx>
 #include <AIS_Shape.hxx>
 #include <AIS_ViewCube.hxx>
 #include <Aspect_DisplayConnection.hxx>
@@ -11,9 +12,14 @@
 #include <Message.hxx>
 #include <Message_Messenger.hxx>
 #include <OpenGl_GraphicDriver.hxx>
+#include <StdSelect_ViewerSelector3d.hxx>
+#include <TColgp_Array1OfPnt2d.hxx>
 #include <V3d_View.hxx>
 #include <V3d_Viewer.hxx>
 
+#include <algorithm>
+#include <chrono>
+
 // 创建OCCT视图日志记录器 - 使用函数确保安全初始化
 std::shared_ptr<Utils::Logger>& getOcctLogger() {
     static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("view.occt");
@@ -65,6 +71,7 @@ OcctView::OcctView(std::shared_ptr<UnifiedViewModel> viewModel,
     , myMessageBus(messageBus)
 {
     getOcctLogger()->info("Creating view");
+    setupSelectionGestures();
     subscribeToEvents();
 }
 
@@ -169,6 +176,9 @@ void OcctView::render()
     }
     
     try {
+        // 本帧排队的显示变化一次性应用，视图最多重绘一次
+        myViewModel->getViewerUpdates().flush(myView);
+
         // 立即更新视图
         myView->InvalidateImmediate();
         
@@ -199,12 +209,8 @@ void OcctView::onMouseButton(int button, int action, int mods)
 
     const Graphic3d_Vec2i aPos = myWindow->CursorPosition();
     if (action == GLFW_PRESS) {
+        // 单击、框选和套索选择都在松开按键后由控制器处理，按下时不选择，否则每次旋转都会清除选择
         PressMouseButton(aPos, mouseButtonFromGlfw(button), keyFlagsFromGlfw(mods), false);
-
-        // 处理选择
-        if (button == GLFW_MOUSE_BUTTON_LEFT && (mods & GLFW_MOD_CONTROL) == 0) {
-            handleSelection(aPos.x(), aPos.y());
-        }
     }
     else {
         ReleaseMouseButton(aPos, mouseButtonFromGlfw(button), keyFlagsFromGlfw(mods), false);
@@ -225,6 +231,7 @@ void OcctView::onResize(int width, int height)
     if (width != 0 && height != 0 && !myView.IsNull()) {
         myView->Window()->DoResize();
         myView->MustBeResized();
+        myViewModel->getViewerUpdates().flush(myView);
         myView->Invalidate();
         FlushViewEvents(myViewModel->getContext(), myView, true);
     }
@@ -237,6 +244,68 @@ void OcctView::handleViewRedraw(const Handle(AIS_InteractiveContext) & theCtx,
     myToWaitEvents = !myToAskNextFrame;
 }
 
+void OcctView::handleSelectionPoly(const Handle(AIS_InteractiveContext) & theCtx,
+                                   const Handle(V3d_View) & theView)
+{
+    const bool isAreaTool = myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand
+                         || myGL.Selection.Tool == AIS_ViewSelectionTool_Polygon;
+    if (!isAreaTool || !myGL.Selection.ToApplyTool) {
+        // 绘制橡皮筋和窗口缩放仍交给基类
+        AIS_ViewController::handleSelectionPoly(theCtx, theView);
+        return;
+    }
+
+    // 基类选取前会按自己的规则重设重叠检测，所以框选和套索在这里自行选取
+    myGL.Selection.ToApplyTool = false;
+    if (theCtx->IsDisplayed(myRubberBand)) {
+        theCtx->Remove(myRubberBand, false);
+    }
+
+    const NCollection_Sequence<Graphic3d_Vec2i>& aPoints = myGL.Selection.Points;
+    const bool isRubberBand = myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand && aPoints.Size() == 2;
+    const bool isLasso = myGL.Selection.Tool == AIS_ViewSelectionTool_Polygon && aPoints.Size() >= 3;
+    if (isRubberBand || isLasso) {
+        // 元素选择总是选取与框相交的三角形和面；选择实体时从左向右框选只选取完全在框内的实体，
+        // 从右向左框选选取相交的实体，套索只选取完全在内的实体
+        bool isCrossing = myViewModel->elementSelection.get();
+        if (!isCrossing && isRubberBand) {
+            isCrossing = aPoints.Last().x() < aPoints.First().x();
+        }
+
+        const auto aStart = std::chrono::steady_clock::now();
+        theCtx->MainSelector()->AllowOverlapDetection(isCrossing);
+        if (isRubberBand) {
+            const Graphic3d_Vec2i& aPnt1 = aPoints.First();
+            const Graphic3d_Vec2i& aPnt2 = aPoints.Last();
+            theCtx->SelectRectangle(Graphic3d_Vec2i(std::min(aPnt1.x(), aPnt2.x()), std::min(aPnt1.y(), aPnt2.y())),
+                                    Graphic3d_Vec2i(std::max(aPnt1.x(), aPnt2.x()), std::max(aPnt1.y(), aPnt2.y())),
+                                    theView, myGL.Selection.Scheme);
+        } else {
+            TColgp_Array1OfPnt2d aPolyline(1, aPoints.Size());
+            int anIndex = 1;
+            for (NCollection_Sequence<Graphic3d_Vec2i>::Iterator anIter(aPoints); anIter.More(); anIter.Next(), ++anIndex) {
+                aPolyline.SetValue(anIndex, gp_Pnt2d(anIter.Value().x(), anIter.Value().y()));
+            }
+            theCtx->SelectPolygon(aPolyline, theView, myGL.Selection.Scheme);
+        }
+        theCtx->MainSelector()->AllowOverlapDetection(false);
+        getOcctLogger()->debug("Area selection took {:.2f} ms",
+                               std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - aStart).count());
+        OnSelectionChanged(theCtx, theView);
+    }
+
+    myGL.Selection.Points.Clear();
+    theView->Invalidate();
+}
+
+void OcctView::OnSelectionChanged(const Handle(AIS_InteractiveContext) &,
+                                  const Handle(V3d_View) &)
+{
+    // 拾取结果一次性同步到视图模型，元素按拾取时的选择方案合并
+    myViewModel->syncSelectionFromContext(myGL.Selection.Scheme,
+                                          myGL.Selection.Tool != AIS_ViewSelectionTool_Picking);
+}
+
 void OcctView::setupViewCube()
 {
     myViewCube = new AIS_ViewCube();
@@ -260,8 +329,9 @@ void OcctView::setupGrid()
 
 void OcctView::updateVisibility()
 {
-    // 使用ViewModel获取全局设置
+    // 使用ViewModel获取全局设置；显示变化排队，下一帧统一重绘
     auto& globalSettings = myViewModel->getGlobalSettings();
+    ViewerUpdateQueue& updates = myViewModel->getViewerUpdates();
     
     // 更新网格可见性
     bool isGridVisible = globalSettings.isGridVisible.get();
@@ -276,9 +346,9 @@ void OcctView::updateVisibility()
     bool isViewCubeVisible = globalSettings.isViewCubeVisible.get();
     if (!myViewCube.IsNull()) {
         if (isViewCubeVisible) {
-            myViewModel->getContext()->Display(myViewCube, false);
+            updates.display(myViewCube);
         } else {
-            myViewModel->getContext()->Erase(myViewCube, false);
+            updates.erase(myViewCube);
         }
     }
 
@@ -286,35 +356,40 @@ void OcctView::updateVisibility()
     int displayMode = myViewModel->displayMode.get();
     switch (displayMode) {
         case 0:  // Shaded
-            myViewModel->getContext()->SetDisplayMode(AIS_Shaded, Standard_True);
+            myViewModel->getContext()->SetDisplayMode(AIS_Shaded, Standard_False);
             break;
         case 1:  // Wireframe
-            myViewModel->getContext()->SetDisplayMode(AIS_WireFrame, Standard_True);
+            myViewModel->getContext()->SetDisplayMode(AIS_WireFrame, Standard_False);
             break;
         case 2:  // Points
             // 需要其他处理...
             break;
     }
 
-    myViewModel->getContext()->UpdateCurrentViewer();
-    
-    // 强制重绘视图
-    if (!myView.IsNull()) {
-        myView->Invalidate();
-    }
+    updates.invalidate();
 }
 
-void OcctView::handleSelection(int x, int y)
+void OcctView::setupSelectionGestures()
 {
-    myViewModel->getContext()->MoveTo(x, y, myView, Standard_True);
-    myViewModel->getContext()->Select(Standard_True);
-
-    // 更新选中状态
-    AIS_ListOfInteractive selected;
-    // myViewModel->getContext()->Selection(selected);
-
-    for (const Handle(AIS_InteractiveObject) & obj : selected) {
-        myViewModel->processSelection(obj, true);
+    // 左键拖动旋转、Shift+左键平移、Ctrl+左键缩放保持不变；
+    // Alt+左键拖动为框选，Alt+右键拖动为套索选择。
+    // 单击和拖动选择时，Shift加入选择，Ctrl切换选中状态，否则替换选择
+    const unsigned int aLeft = Aspect_VKeyMouse_LeftButton;
+    const unsigned int aRight = Aspect_VKeyMouse_RightButton;
+    const unsigned int anAlt = Aspect_VKeyFlags_ALT;
+    const unsigned int aShift = Aspect_VKeyFlags_SHIFT;
+    const unsigned int aCtrl = Aspect_VKeyFlags_CTRL;
+
+    AIS_MouseGestureMap& aGestures = ChangeMouseGestureMap();
+    AIS_MouseSelectionSchemeMap& aSchemes = ChangeMouseSelectionSchemes();
+    for (unsigned int aModifier : {0u, aShift, aCtrl}) {
+        aGestures.Bind(aLeft | anAlt | aModifier, AIS_MouseGesture_SelectRectangle);
+        aGestures.Bind(aRight | anAlt | aModifier, AIS_MouseGesture_SelectLasso);
+    }
+    for (unsigned int aButton : {aLeft, aLeft | anAlt, aRight | anAlt}) {
+        aSchemes.Bind(aButton, AIS_SelectionScheme_Replace);
+        aSchemes.Bind(aButton | aShift, AIS_SelectionScheme_Add);
+        aSchemes.Bind(aButton | aCtrl, AIS_SelectionScheme_XOR);
     }
 }
 
@@ -325,10 +400,8 @@ void OcctView::subscribeToEvents()
     // Subscribe to model changed events via MessageBus
     myMessageBus.subscribe(MVVM::MessageBus::MessageType::ModelChanged,
         [this](const MVVM::MessageBus::Message& message) {
-            // Force view redraw
-            if (!myView.IsNull()) {
-                myView->Invalidate();
-            }
+            // Request a redraw with the next frame
+            myViewModel->getViewerUpdates().invalidate();
         });
     
     // Get global settings
@@ -338,9 +411,6 @@ void OcctView::subscribeToEvents()
     auto gridConn = globalSettings.isGridVisible.valueChanged.connect(
         [this](const bool&, const bool& isVisible) {
             updateVisibility();
-            if (!myView.IsNull()) {
-                myView->Invalidate();
-            }
         });
     myConnections.track(gridConn);
     
@@ -348,9 +418,6 @@ void OcctView::subscribeToEvents()
     auto cubeConn = globalSettings.isViewCubeVisible.valueChanged.connect(
         [this](const bool&, const bool& isVisible) {
             updateVisibility();
-            if (!myView.IsNull()) {
-                myView->Invalidate();
-            }
         });
     myConnections.track(cubeConn);
 
@@ -358,9 +425,6 @@ void OcctView::subscribeToEvents()
     auto displayConn = myViewModel->displayMode.valueChanged.connect(
         [this](const int&, const int& newMode) {
             updateVisibility();
-            if (!myView.IsNull()) {
-                myView->Invalidate();
-            }
         });
     myConnections.track(displayConn);
     
@@ -368,9 +432,7 @@ void OcctView::subscribeToEvents()
     auto selectionConn = myViewModel->hasSelectionProperty.valueChanged.connect(
         [this](const bool&, const bool& hasSelection) {
             // Update UI or view based on selection state
-            if (!myView.IsNull()) {
-                myView->Invalidate();
-            }
+            myViewModel->getViewerUpdates().invalidate();
         });
     myConnections.track(selectionConn);
     
@@ -143,6 +143,27 @@ protected:
     void handleViewRedraw(const Handle(AIS_InteractiveContext) & theCtx,
                           const Handle(V3d_View) & theView) override;
 
+    /**
+     * @brief Handles the rubber band and lasso tools
+     * 
+     * Chooses between window selection (entities fully inside) and crossing selection
+     * (touched entities) and applies the pick itself, since the base class resets the
+     * overlap detection before selecting. Drawing the rubber band stays with the base class.
+     * 
+     * @param theCtx The interactive context
+     * @param theView The view
+     */
+    void handleSelectionPoly(const Handle(AIS_InteractiveContext) & theCtx,
+                             const Handle(V3d_View) & theView) override;
+
+    /**
+     * @brief Hands the selection of the context over to the view model after a pick
+     * @param theCtx The interactive context
+     * @param theView The view
+     */
+    void OnSelectionChanged(const Handle(AIS_InteractiveContext) & theCtx,
+                            const Handle(V3d_View) & theView) override;
+
 private:
     /** The view model */
     std::shared_ptr<UnifiedViewModel> myViewModel;
@@ -181,11 +202,9 @@ private:
     void updateVisibility();
 
     /**
-     * @brief Handles selection at a specific position
-     * @param x The x-coordinate of the selection position
-     * @param y The y-coordinate of the selection position
+     * @brief Binds the mouse gestures and selection schemes of click, rectangle and lasso selection
      */
-    void handleSelection(int x, int y);
+    void setupSelectionGestures();
 
     /**
      * @brief Subscribes to events from the message bus
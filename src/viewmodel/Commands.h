@@ -5,6 +5,8 @@
 #include <Quantity_Color.hxx>
 #include <gp_Pnt.hxx>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace Commands {
 
@@ -91,21 +93,74 @@ private:
 };
 
 // 导入模型命令 - 支持多种格式（STEP, STL, OBJ等）
+// 导入在后台线程执行（多个文件并行读取），结果由UnifiedViewModel::pollImport在UI线程提交
 class ImportModelCommand : public Command {
 public:
     ImportModelCommand(std::shared_ptr<UnifiedViewModel> viewModel, 
+                      const std::string& filePath)
+        : myViewModel(viewModel), myFilePaths{filePath} {}
+    
+    ImportModelCommand(std::shared_ptr<UnifiedViewModel> viewModel, 
+                      const std::vector<std::string>& filePaths)
+        : myViewModel(viewModel), myFilePaths(filePaths) {}
+    
+    void execute() override {
+        myViewModel->startImportAsync(myFilePaths);
+    }
+    
+private:
+    std::shared_ptr<UnifiedViewModel> myViewModel;
+    std::vector<std::string> myFilePaths;
+};
+
+// 保存模型命令 - 将整个模型写入模型存档
+class SaveModelCommand : public Command {
+public:
+    SaveModelCommand(std::shared_ptr<UnifiedViewModel> viewModel, 
+                    const std::string& filePath)
+        : myViewModel(viewModel), myFilePath(filePath) {}
+    
+    void execute() override {
+        myViewModel->saveModel(myFilePath);
+    }
+    
+private:
+    std::shared_ptr<UnifiedViewModel> myViewModel;
+    std::string myFilePath;
+};
+
+// 打开模型命令 - 用模型存档的内容替换当前模型
+class OpenModelCommand : public Command {
+public:
+    OpenModelCommand(std::shared_ptr<UnifiedViewModel> viewModel, 
+                    const std::string& filePath)
+        : myViewModel(viewModel), myFilePath(filePath) {}
+    
+    void execute() override {
+        myViewModel->openModel(myFilePath);
+    }
+    
+private:
+    std::shared_ptr<UnifiedViewModel> myViewModel;
+    std::string myFilePath;
+};
+
+// 导出模型命令 - 将整个模型或选中的实体写入网格文件
+class ExportModelCommand : public Command {
+public:
+    ExportModelCommand(std::shared_ptr<UnifiedViewModel> viewModel, 
                       const std::string& filePath,
-                      const std::string& modelId = "")
-        : myViewModel(viewModel), myFilePath(filePath), myModelId(modelId) {}
+                      bool selectionOnly)
+        : myViewModel(viewModel), myFilePath(filePath), mySelectionOnly(selectionOnly) {}
     
     void execute() override {
-        myViewModel->importModel(myFilePath, myModelId);
+        myViewModel->exportModel(myFilePath, mySelectionOnly);
     }
     
 private:
     std::shared_ptr<UnifiedViewModel> myViewModel;
     std::string myFilePath;
-    std::string myModelId;
+    bool mySelectionOnly;
 };
 
-} // namespace Commands 
\ No newline at end of file
+} // namespace Commands
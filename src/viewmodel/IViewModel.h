@@ -17,6 +17,7 @@ public:
     // UI状态
     virtual bool hasSelection() const = 0;
     virtual std::vector<std::string> getSelectedObjects() const = 0;
+    virtual size_t getSelectionCount() const = 0;
     
     // 选择处理
     virtual void processSelection(const Handle(AIS_InteractiveObject)& obj, bool isSelected) = 0;
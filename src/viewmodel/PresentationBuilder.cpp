@@ -0,0 +1,113 @@
+#include "PresentationBuilder.h"
+#include "../utils/Logger.h"
+#include "../utils/Parallel.h"
+
+#include <Standard_Failure.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+// 创建显示准备日志记录器
+static std::shared_ptr<Utils::Logger>& getPresentationBuilderLogger()
+{
+    static std::shared_ptr<Utils::Logger> logger = Utils::Logger::getLogger("viewmodel.presentation_builder");
+    return logger;
+}
+
+PresentationBuilder::PresentationBuilder(unsigned int threadCount)
+{
+    // 默认给UI线程留出一个硬件线程
+    if (threadCount == 0) {
+        const unsigned int hardwareThreads = Utils::getParallelThreadCount();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+    myWorkers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        myWorkers.emplace_back(&PresentationBuilder::run, this);
+    }
+}
+
+PresentationBuilder::~PresentationBuilder()
+{
+    {
+        std::lock_guard<std::mutex> lock(myMutex);
+        myIsStopping = true;
+        myRequests.clear();
+    }
+    myCondition.notify_all();
+    for (std::thread& worker : myWorkers) {
+        worker.join();
+    }
+}
+
+void PresentationBuilder::submit(Request request)
+{
+    {
+        std::lock_guard<std::mutex> lock(myMutex);
+        myRequests.push_back(std::move(request));
+    }
+    myCondition.notify_one();
+}
+
+bool PresentationBuilder::takeFinished(Result& result)
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    if (myResults.empty()) {
+        return false;
+    }
+    result = std::move(myResults.front());
+    myResults.pop_front();
+    return true;
+}
+
+size_t PresentationBuilder::getOutstandingCount() const
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myRequests.size() + myActiveCount + myResults.size();
+}
+
+void PresentationBuilder::run()
+{
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(myMutex);
+            myCondition.wait(lock, [this] { return myIsStopping || !myRequests.empty(); });
+            if (myIsStopping) {
+                return;
+            }
+            request = std::move(myRequests.front());
+            myRequests.pop_front();
+            ++myActiveCount;
+        }
+
+        // 只读取请求中的快照：共享的网格缓冲区不会被修改，形状的三角网格在显示期间保持不变
+        Result result;
+        result.id = request.id;
+        result.ticket = request.ticket;
+        const auto startTime = std::chrono::steady_clock::now();
+        try {
+            if (request.mesh) {
+                Mesh_PreparedObject::PrepareMesh(request.mesh, request.withEdges, result.data);
+            }
+            else {
+                Mesh_PreparedObject::PrepareShape(request.shape, request.subShapeColors, request.withEdges, result.data);
+            }
+            result.isPrepared = true;
+        }
+        catch (const Standard_Failure& e) {
+            getPresentationBuilderLogger()->error("Failed to prepare the presentation of '{}': {}",
+                                                  request.id, e.GetMessageString());
+        }
+        catch (const std::exception& e) {
+            getPresentationBuilderLogger()->error("Failed to prepare the presentation of '{}': {}",
+                                                  request.id, e.what());
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        std::lock_guard<std::mutex> lock(myMutex);
+        myResults.push_back(std::move(result));
+        --myActiveCount;
+    }
+}
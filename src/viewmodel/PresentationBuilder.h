@@ -0,0 +1,115 @@
+/**
+ * @file PresentationBuilder.h
+ * @brief Defines the PresentationBuilder class which prepares presentations on worker threads.
+ *
+ * The primitive arrays and the selection BVH of a large part or mesh take much longer
+ * to build than to display. The builder prepares them from immutable snapshots of the
+ * geometry (shared mesh buffers, or a shape with its triangulation) on worker threads;
+ * the UI thread only creates the AIS object from the prepared data and displays it.
+ */
+#pragma once
+
+#include "ais/Mesh_PreparedObject.h"
+#include "../model/UnifiedModel.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class PresentationBuilder
+ * @brief Pool of worker threads preparing Mesh_PreparedObject data.
+ *
+ * Requests are processed in submission order. Results are collected on the UI thread
+ * with takeFinished(); a request is identified by its entity ID and a ticket, so the
+ * caller can discard results that were superseded while they were prepared.
+ */
+class PresentationBuilder {
+public:
+    /**
+     * @brief Snapshot of the geometry of an entity to prepare
+     */
+    struct Request {
+        std::string id;                    ///< The entity
+        std::uint64_t ticket = 0;          ///< Identifies this request among the requests of the entity
+        TopoDS_Shape shape;                ///< Unlocated, triangulated CAD part (null for meshes)
+        UnifiedModel::MeshDataPtr mesh;    ///< Shared mesh buffers (null for CAD parts)
+        std::vector<UnifiedModel::SubShapeColor> subShapeColors;  ///< Colors of the faces of the part
+        bool withEdges = false;            ///< Whether the edges of the wireframe mode are prepared as well
+    };
+
+    /**
+     * @brief Prepared data of a request
+     */
+    struct Result {
+        std::string id;                    ///< The entity
+        std::uint64_t ticket = 0;          ///< Ticket of the request
+        Mesh_PreparedObject::Data data;    ///< The prepared arrays and selection
+        double seconds = 0.0;              ///< Time spent preparing on the worker
+        bool isPrepared = false;           ///< False if the preparation failed
+    };
+
+    /**
+     * @brief Constructor; starts the worker threads
+     * @param threadCount Number of workers (0: one less than the hardware threads, at least one)
+     */
+    explicit PresentationBuilder(unsigned int threadCount = 0);
+
+    /**
+     * @brief Destructor; drops the queued requests and waits for the workers to stop
+     */
+    ~PresentationBuilder();
+
+    PresentationBuilder(const PresentationBuilder&) = delete;
+    PresentationBuilder& operator=(const PresentationBuilder&) = delete;
+
+    /**
+     * @brief Queues a request
+     * @param request The geometry snapshot
+     */
+    void submit(Request request);
+
+    /**
+     * @brief Takes the oldest finished result
+     * @param result Receives the result
+     * @return bool False if no result is available
+     */
+    bool takeFinished(Result& result);
+
+    /**
+     * @brief Gets the number of requests that are queued, being prepared or not taken yet
+     * @return The number of outstanding requests
+     */
+    size_t getOutstandingCount() const;
+
+private:
+    /**
+     * @brief Worker thread entry point
+     */
+    void run();
+
+    /** Protects the queues and the stop flag */
+    mutable std::mutex myMutex;
+
+    /** Signals new requests and the stop request to the workers */
+    std::condition_variable myCondition;
+
+    /** Requests not picked up by a worker yet */
+    std::deque<Request> myRequests;
+
+    /** Results not taken yet */
+    std::deque<Result> myResults;
+
+    /** Number of requests being prepared */
+    size_t myActiveCount = 0;
+
+    /** Set by the destructor */
+    bool myIsStopping = false;
+
+    /** The worker threads */
+    std::vector<std::thread> myWorkers;
+};
@@ -0,0 +1,121 @@
+#include "SelectionSet.h"
+
+SelectionSet::EntityHandle SelectionSet::addEntity(const std::string& id)
+{
+    auto it = myHandles.find(id);
+    if (it != myHandles.end()) {
+        return it->second;
+    }
+
+    // 优先复用已删除实体的句柄，位集不随删除和添加不断增长
+    EntityHandle handle = INVALID_HANDLE;
+    if (!myFreeHandles.empty()) {
+        handle = myFreeHandles.back();
+        myFreeHandles.pop_back();
+        myIds[handle] = id;
+    }
+    else {
+        handle = EntityHandle(myIds.size());
+        myIds.push_back(id);
+        mySelected.resize(myIds.size());
+    }
+    myHandles.emplace(id, handle);
+    return handle;
+}
+
+bool SelectionSet::removeEntity(const std::string& id)
+{
+    auto it = myHandles.find(id);
+    if (it == myHandles.end()) {
+        return false;
+    }
+
+    const EntityHandle handle = it->second;
+    myHandles.erase(it);
+    myIds[handle].clear();
+    myFreeHandles.push_back(handle);
+    return setSelected(handle, false);
+}
+
+void SelectionSet::removeAllEntities()
+{
+    myHandles.clear();
+    myIds.clear();
+    myFreeHandles.clear();
+    mySelected.resize(0);
+    myCount = 0;
+}
+
+SelectionSet::EntityHandle SelectionSet::findHandle(const std::string& id) const
+{
+    auto it = myHandles.find(id);
+    return it != myHandles.end() ? it->second : INVALID_HANDLE;
+}
+
+bool SelectionSet::setSelected(EntityHandle handle, bool isSelected)
+{
+    if (handle >= myIds.size() || !mySelected.set(handle, isSelected)) {
+        return false;
+    }
+    if (isSelected) {
+        ++myCount;
+    }
+    else {
+        --myCount;
+    }
+    return true;
+}
+
+bool SelectionSet::apply(const Utils::DynamicBitset& mask, Operation operation)
+{
+    Utils::DynamicBitset selected = mySelected;
+    switch (operation) {
+        case Operation::REPLACE:
+            selected = mask;
+            selected.resize(myIds.size());
+            break;
+        case Operation::ADD:
+            selected |= mask;
+            break;
+        case Operation::REMOVE:
+            selected.subtract(mask);
+            break;
+        case Operation::TOGGLE: {
+            // 异或：(A | M) - (A & M)
+            Utils::DynamicBitset common = mySelected;
+            common &= mask;
+            selected |= mask;
+            selected.subtract(common);
+            break;
+        }
+    }
+
+    // 掩码可能来自注册了实体之后又释放的句柄，只保留在用的句柄
+    for (EntityHandle handle : myFreeHandles) {
+        selected.set(handle, false);
+    }
+    if (selected == mySelected) {
+        return false;
+    }
+    mySelected = std::move(selected);
+    myCount = mySelected.count();
+    return true;
+}
+
+bool SelectionSet::clear()
+{
+    if (myCount == 0) {
+        return false;
+    }
+    mySelected.reset();
+    myCount = 0;
+    return true;
+}
+
+std::vector<std::string> SelectionSet::getSelectedIds() const
+{
+    std::vector<std::string> ids;
+    ids.reserve(myCount);
+    forEachSelected([&ids](EntityHandle, const std::string& id) { ids.push_back(id); });
+    return ids;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file SelectionSet.h
+ * @brief Defines the SelectionSet class which stores a selection as a dense bitset.
+ *
+ * Every entity gets a small integer handle when it is registered; the selection is a
+ * bitset indexed by handle. Membership tests are a bit test, counting is free, and bulk
+ * operations (select all, invert, select by predicate) are word-wise set operations on
+ * masks, so they scale to hundreds of thousands of entities.
+ */
+#pragma once
+
+#include "../utils/DynamicBitset.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SelectionSet
+ * @brief Selected entities as a bitset over dense entity handles.
+ *
+ * Handles of removed entities are reused, so the bitset stays as large as the highest
+ * number of entities registered at the same time.
+ */
+class SelectionSet {
+public:
+    /** Dense index of an entity */
+    using EntityHandle = std::uint32_t;
+
+    /** Handle returned for unknown entities */
+    static constexpr EntityHandle INVALID_HANDLE = ~EntityHandle(0);
+
+    /**
+     * @brief How a mask is combined with the current selection
+     */
+    enum class Operation {
+        REPLACE,  ///< The selection becomes the mask
+        ADD,      ///< The mask is added to the selection
+        REMOVE,   ///< The mask is removed from the selection
+        TOGGLE    ///< Entities of the mask change their state
+    };
+
+    /**
+     * @brief Registers an entity
+     * @param id The ID of the entity
+     * @return Its handle (the existing one if the entity is already registered)
+     */
+    EntityHandle addEntity(const std::string& id);
+
+    /**
+     * @brief Unregisters an entity; its handle may be reused
+     * @param id The ID of the entity
+     * @return True if the entity was selected
+     */
+    bool removeEntity(const std::string& id);
+
+    /**
+     * @brief Unregisters all entities
+     */
+    void removeAllEntities();
+
+    /**
+     * @brief Gets the handle of an entity
+     * @param id The ID of the entity
+     * @return The handle, or INVALID_HANDLE if the entity is not registered
+     */
+    EntityHandle findHandle(const std::string& id) const;
+
+    /**
+     * @brief Gets the entity of a handle
+     * @param handle A handle below getHandleCount()
+     * @return The ID (empty for a free handle)
+     */
+    const std::string& getId(EntityHandle handle) const { return myIds[handle]; }
+
+    /**
+     * @brief Gets the number of handles, i.e. the size of the masks
+     * @return One more than the highest handle in use
+     */
+    size_t getHandleCount() const { return myIds.size(); }
+
+    /**
+     * @brief Creates an empty mask sized for the current handles
+     * @return The mask
+     */
+    Utils::DynamicBitset makeMask() const { return Utils::DynamicBitset(myIds.size()); }
+
+    /**
+     * @brief Checks whether an entity is selected
+     * @param handle The handle of the entity (INVALID_HANDLE gives false)
+     * @return True if the entity is selected
+     */
+    bool isSelected(EntityHandle handle) const { return mySelected.test(handle); }
+
+    /**
+     * @brief Checks whether an entity is selected
+     * @param id The ID of the entity
+     * @return True if the entity is selected
+     */
+    bool isSelected(const std::string& id) const { return isSelected(findHandle(id)); }
+
+    /**
+     * @brief Selects or deselects an entity
+     * @param handle The handle of the entity
+     * @param isSelected The new state
+     * @return True if the state changed
+     */
+    bool setSelected(EntityHandle handle, bool isSelected);
+
+    /**
+     * @brief Combines a mask with the selection
+     * @param mask Entities to combine, indexed by handle
+     * @param operation How the mask is combined
+     * @return True if the selection changed
+     */
+    bool apply(const Utils::DynamicBitset& mask, Operation operation);
+
+    /**
+     * @brief Deselects all entities
+     * @return True if the selection changed
+     */
+    bool clear();
+
+    /**
+     * @brief Gets the number of selected entities
+     * @return The selection count
+     */
+    size_t getCount() const { return myCount; }
+
+    /**
+     * @brief Checks whether nothing is selected
+     * @return True if the selection is empty
+     */
+    bool isEmpty() const { return myCount == 0; }
+
+    /**
+     * @brief Gets the selection as a mask indexed by handle
+     * @return The bitset
+     */
+    const Utils::DynamicBitset& getBits() const { return mySelected; }
+
+    /**
+     * @brief Calls a function for every selected entity, in handle order
+     * @param func Function with the signature void(EntityHandle handle, const std::string& id)
+     */
+    template <typename Func>
+    void forEachSelected(Func&& func) const {
+        mySelected.forEachSet([this, &func](size_t index) {
+            func(EntityHandle(index), myIds[index]);
+        });
+    }
+
+    /**
+     * @brief Gets the selected entity with the lowest handle
+     * @return Its handle, or INVALID_HANDLE if nothing is selected
+     */
+    EntityHandle getFirstSelected() const {
+        const size_t index = mySelected.findFirst();
+        return index < myIds.size() ? EntityHandle(index) : INVALID_HANDLE;
+    }
+
+    /**
+     * @brief Gets the IDs of the selected entities
+     * @return The IDs, in handle order
+     */
+    std::vector<std::string> getSelectedIds() const;
+
+private:
+    /** Handles of the registered entities */
+    std::unordered_map<std::string, EntityHandle> myHandles;
+
+    /** Entity of each handle (empty for free handles) */
+    std::vector<std::string> myIds;
+
+    /** Handles of removed entities, reused first */
+    std::vector<EntityHandle> myFreeHandles;
+
+    /** The selection, indexed by handle */
+    Utils::DynamicBitset mySelected;
+
+    /** Number of selected entities */
+    size_t myCount = 0;
+};
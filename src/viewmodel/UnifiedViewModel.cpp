@@ -1,19 +1,35 @@
 #include "UnifiedViewModel.h"
 #include "ais/Mesh_DataSource.h"
+#include "ais/Mesh_ElementOwner.h"
+#include "ais/Mesh_PreparedObject.h"
+#include "../model/ModelArchive.h"
+#include "../model/ModelExporter.h"
 #include "../utils/Logger.h"
+#include "../utils/Parallel.h"
+#include <AIS_ConnectedInteractive.hxx>
 #include <AIS_Shape.hxx>
 #include <AIS_Triangulation.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <BRepTools.hxx>
 #include <MeshVS_Drawer.hxx>
 #include <MeshVS_DrawerAttribute.hxx>
 #include <MeshVS_Mesh.hxx>
 #include <MeshVS_MeshPrsBuilder.hxx>
+#include <MeshVS_NodalColorPrsBuilder.hxx>
 #include <MeshVS_DisplayModeFlags.hxx>
+#include <MeshVS_SelectionModeFlags.hxx>
 #include <TColStd_HPackedMapOfInteger.hxx>
 #include <Precision.hxx>
+#include <StdSelect_ViewerSelector3d.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS_Builder.hxx>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <random>
+#include <set>
 #include <iostream>
 
 // 创建ViewModel日志记录器
@@ -22,6 +38,70 @@ static std::shared_ptr<Utils::Logger>& getViewModelLogger() {
     return logger;
 }
 
+namespace
+{
+//! Number of import records kept for the statistics panel.
+constexpr size_t THE_MAX_IMPORT_RECORDS = 100;
+
+//! Time per frame spent displaying presentations prepared on the worker threads, in seconds.
+constexpr double THE_PRESENTATION_FRAME_BUDGET = 0.008;
+
+//! Returns the seconds elapsed since theStart and restarts the measurement.
+double lapSeconds(std::chrono::steady_clock::time_point& theStart)
+{
+    const auto aNow = std::chrono::steady_clock::now();
+    const double aSeconds = std::chrono::duration<double>(aNow - theStart).count();
+    theStart = aNow;
+    return aSeconds;
+}
+
+//! Returns true if an entity takes part in bulk selections.
+bool isSelectable(const UnifiedModel::GeometryData& theData)
+{
+    return theData.visible && theData.type != UnifiedModel::GeometryType::ASSEMBLY;
+}
+
+//! Returns the selection mode picking the elements of a presentation: triangles of
+//! prepared presentations, faces of meshes and of CAD parts.
+Standard_Integer elementSelectionMode(const Handle(AIS_InteractiveObject)& theObject)
+{
+    if (theObject->IsKind(STANDARD_TYPE(Mesh_PreparedObject))) {
+        return Mesh_PreparedObject::SM_Triangles;
+    }
+    if (theObject->IsKind(STANDARD_TYPE(MeshVS_Mesh))) {
+        return MeshVS_SMF_Face;
+    }
+    return AIS_Shape::SelectionMode(TopAbs_FACE);
+}
+
+//! Computes the world bounding box of a shape or mesh.
+Bnd_Box computeEntityBox(const UnifiedModel::GeometryData& theData)
+{
+    Bnd_Box aBox;
+    if (theData.type == UnifiedModel::GeometryType::SHAPE) {
+        // 有三角网格时只遍历网格节点，不计算曲面的精确包围盒
+        const TopoDS_Shape& aShape = std::get<TopoDS_Shape>(theData.geometry);
+        if (!aShape.IsNull()) {
+            BRepBndLib::Add(aShape, aBox, Standard_True);
+        }
+    }
+    else if (theData.type == UnifiedModel::GeometryType::MESH) {
+        const UnifiedModel::MeshDataPtr& aMesh = std::get<UnifiedModel::MeshDataPtr>(theData.geometry);
+        if (aMesh) {
+            for (Eigen::Index i = 0; i < aMesh->vertices.rows(); ++i) {
+                const double aX = aMesh->vertices(i, 0);
+                const double aY = aMesh->vertices(i, 1);
+                const double aZ = aMesh->vertices(i, 2);
+                if (std::isfinite(aX) && std::isfinite(aY) && std::isfinite(aZ)) {
+                    aBox.Update(aX, aY, aZ);
+                }
+            }
+        }
+    }
+    return aBox;
+}
+} // namespace
+
 // Constructor
 UnifiedViewModel::UnifiedViewModel(std::shared_ptr<UnifiedModel> model,
                                    Handle(AIS_InteractiveContext) context,
@@ -29,18 +109,21 @@ UnifiedViewModel::UnifiedViewModel(std::shared_ptr<UnifiedModel> model,
                                    std::shared_ptr<ModelImporter> modelImporter)
     : myModel(model)
     , myContext(context)
+    , myViewerUpdates(context)
     , myGlobalSettings(globalSettings)
     , myModelImporter(modelImporter)
 {
+    myPresentationBuilder = std::make_unique<PresentationBuilder>();
 
     // Register model change listener
-    model->addChangeListener([this](const std::string& id) {
-        this->onModelChanged(id);
+    model->addChangeListener([this](const std::string& id, IModel::ChangeKind kind) {
+        this->onModelChanged(id, kind);
     });
 
     // Initialize display of existing geometries
-    for (const std::string& id : model->getAllEntityIds()) {
-        updatePresentation(id);
+    for (const auto& entity : model->getEntities()) {
+        mySelection.addEntity(entity.first);
+        updatePresentation(entity.first);
     }
 
     // Bind display mode property to global settings
@@ -48,6 +131,22 @@ UnifiedViewModel::UnifiedViewModel(std::shared_ptr<UnifiedModel> model,
     auto connection = displayMode.bindTo(globalSettings.displayMode);
     connections.track(connection);
 
+    // 切换选择级别时重新激活所有显示对象的选择模式
+    auto elementConnection = elementSelection.valueChanged.connect([this](const bool&, const bool&) {
+        updateSelectionModes();
+    });
+    connections.track(elementConnection);
+
+    // 延迟显示的对象在刷新时按当前级别激活选择模式；视图立方体等不属于模型的对象除外
+    myViewerUpdates.setDisplayCallback([this](const Handle(AIS_InteractiveObject)& object) {
+        if (elementSelection.get() && myObjectToIdMap.count(object) > 0) {
+            activateSelectionMode(object);
+        }
+    });
+
+    // 选择模式激活后由选择器在后台线程构建敏感实体的BVH，首次框选不必等待
+    myContext->MainSelector()->SetToPrebuildBVH(Standard_True);
+
     // Initialize selection properties
     updateSelectionProperties();
 }
@@ -113,8 +212,18 @@ bool UnifiedViewModel::importModel(const std::string& filePath, const std::strin
         return false;
     }
     
+    // 后台导入在工作线程上使用导入器，不能同时修改其设置
+    if (myImportJob) {
+        getViewModelLogger()->warn("Cannot import a model while a background import is running");
+        return false;
+    }
+    
     // 使用注入的 ModelImporter 导入模型
+    applyImportSettings();
+    myIsTimingPresentation = true;
     bool result = myModelImporter->importModel(filePath, *myModel, modelId);
+    myIsTimingPresentation = false;
+    collectImportRecords();
     
     if (result) {
         getViewModelLogger()->info("Model imported successfully");
@@ -125,107 +234,946 @@ bool UnifiedViewModel::importModel(const std::string& filePath, const std::strin
     return result;
 }
 
+bool UnifiedViewModel::saveModel(const std::string& filePath)
+{
+    LOG_FUNCTION_SCOPE(getViewModelLogger(), "saveModel");
+    getViewModelLogger()->info("Saving model to '{}'", filePath);
+    
+    ModelArchive archive;
+    return archive.save(*myModel, filePath);
+}
+
+bool UnifiedViewModel::exportModel(const std::string& filePath, bool selectionOnly)
+{
+    LOG_FUNCTION_SCOPE(getViewModelLogger(), "exportModel");
+    getViewModelLogger()->info("Exporting {} to '{}'", selectionOnly ? "selection" : "model", filePath);
+    
+    // 导出会把三角剖分写入共享的形状，后台表示构建期间不能同时进行
+    if (isBuildingPresentations()) {
+        getViewModelLogger()->warn("Cannot export while presentations are being built");
+        return false;
+    }
+    
+    // 导出使用与导入相同的剖分参数
+    ModelExporter exporter;
+    ModelExporter::Options options;
+    if (myModelImporter) {
+        options.tessellation = myModelImporter->getTessellationOptions();
+    }
+    exporter.setOptions(options);
+    
+    if (!selectionOnly) {
+        return exporter.exportModel(*myModel, filePath);
+    }
+    const std::vector<std::string> selected = getSelectedObjects();
+    if (selected.empty()) {
+        getViewModelLogger()->warn("Nothing selected to export");
+        return false;
+    }
+    return exporter.exportEntities(*myModel, selected, filePath);
+}
+
+bool UnifiedViewModel::openModel(const std::string& filePath)
+{
+    LOG_FUNCTION_SCOPE(getViewModelLogger(), "openModel");
+    getViewModelLogger()->info("Opening model from '{}'", filePath);
+    
+    if (myImportJob) {
+        getViewModelLogger()->warn("Cannot open a model while an import is running");
+        return false;
+    }
+    // 网格划分完成后按形状ID提交结果，模型内容不能在此期间被替换
+    if (myMeshingJob) {
+        getViewModelLogger()->warn("Cannot open a model while a meshing is running");
+        return false;
+    }
+    
+    // 先读入暂存模型，成功后才替换当前内容
+    UnifiedModel staging;
+    ModelArchive archive;
+    if (!archive.load(filePath, staging)) {
+        return false;
+    }
+    
+    clearSelection();
+    myModel->clear();
+    myModel->merge(std::move(staging));
+    return true;
+}
+
+bool UnifiedViewModel::startImportAsync(const std::vector<std::string>& filePaths)
+{
+    if (myImportJob) {
+        getViewModelLogger()->warn("An import is already running");
+        return false;
+    }
+    if (!myModelImporter || filePaths.empty()) {
+        return false;
+    }
+
+    // 并行读取的线程数和内存预算来自全局设置
+    ModelImporter::BatchOptions options;
+    options.workerCount =
+        static_cast<unsigned int>(std::max(0, myGlobalSettings.importWorkerCount.get()));
+    options.memoryBudgetBytes =
+        std::uint64_t(std::max(1, myGlobalSettings.importMemoryBudgetMB.get())) * 1024 * 1024;
+    options.streamPreview = myGlobalSettings.streamImportPreview.get();
+
+    applyImportSettings();
+    myImportJob = std::make_unique<ImportJob>(myModelImporter, filePaths, options);
+    myImportJob->start();
+    return true;
+}
+
+bool UnifiedViewModel::startImportDirectoryAsync(const std::string& directory)
+{
+    if (!myModelImporter) {
+        return false;
+    }
+
+    std::vector<std::string> filePaths = myModelImporter->collectSupportedFiles(directory);
+    getViewModelLogger()->info("Found {} supported file(s) in '{}'", filePaths.size(), directory);
+    return startImportAsync(filePaths);
+}
+
+void UnifiedViewModel::applyImportSettings()
+{
+    // 导入器在后台线程中只读使用，因此只在没有导入任务运行时更新设置
+    ModelImporter::TessellationOptions tessellation;
+    tessellation.enabled = myGlobalSettings.tessellateOnImport.get();
+    tessellation.deviationCoefficient = myGlobalSettings.meshDeviationCoefficient.get();
+    tessellation.deviationAngleDeg = myGlobalSettings.meshDeviationAngleDeg.get();
+    myModelImporter->setTessellationOptions(tessellation);
+    myModelImporter->setMeshRepairEnabled(myGlobalSettings.repairMeshesOnImport.get());
+
+    // 导入缓存：首次启用时在临时目录中创建，之后只更新大小上限
+    if (!myGlobalSettings.importCacheEnabled.get()) {
+        myModelImporter->setImportCache(nullptr);
+        return;
+    }
+    const std::uint64_t cacheBytes =
+        std::uint64_t(std::max(1, myGlobalSettings.importCacheSizeMB.get())) * 1024 * 1024;
+    if (const auto& cache = myModelImporter->getImportCache()) {
+        cache->setMaxBytes(cacheBytes);
+        return;
+    }
+    std::error_code error;
+    const std::filesystem::path cacheDirectory =
+        std::filesystem::temp_directory_path(error) / "occt-imgui-cache";
+    if (error) {
+        getViewModelLogger()->warn("No temporary directory for the import cache: {}", error.message());
+        return;
+    }
+    myModelImporter->setImportCache(std::make_shared<ImportCache>(cacheDirectory.string(), cacheBytes));
+}
+
+ImportCache::Stats UnifiedViewModel::getImportCacheStats() const
+{
+    const auto& cache = myModelImporter ? myModelImporter->getImportCache() : nullptr;
+    return cache ? cache->getStats() : ImportCache::Stats();
+}
+
+void UnifiedViewModel::clearImportCache()
+{
+    if (myModelImporter && myModelImporter->getImportCache() && !myImportJob) {
+        myModelImporter->getImportCache()->clear();
+    }
+}
+
+void UnifiedViewModel::cancelImport()
+{
+    if (myImportJob) {
+        getViewModelLogger()->info("Cancelling background import");
+        myImportJob->cancel();
+    }
+}
+
+void UnifiedViewModel::pollImport()
+{
+    if (!myImportJob) {
+        return;
+    }
+    updateImportPreview();
+    if (!myImportJob->isFinished()) {
+        return;
+    }
+
+    // 在UI线程上把导入结果交给模型，模型变更通知会创建对应的显示对象；
+    // 完整网格替换流式预览，最终状态与一次性导入相同。显示在工作线程上准备时，
+    // 预览保留到全部交付为止
+    myIsTimingPresentation = true;
+    const size_t nbImported = myImportJob->commit(*myModel);
+    myIsTimingPresentation = false;
+    if (myTimedPresentationCount == 0) {
+        removeImportPreview();
+    }
+    collectImportRecords();
+    myLastImportStats = myImportJob->getStats();
+    if (myImportJob->isCancelled()) {
+        getViewModelLogger()->info("Background import cancelled");
+    }
+    else {
+        getViewModelLogger()->info("Background import finished, {} file(s) imported", nbImported);
+    }
+    myImportJob.reset();
+}
+
+void UnifiedViewModel::collectImportRecords()
+{
+    if (!myModelImporter) {
+        return;
+    }
+
+    // 显示仍在工作线程上准备时推迟到全部交付，使记录包含显示耗时
+    if (myTimedPresentationCount > 0) {
+        myHasUncollectedImportRecords = true;
+        return;
+    }
+    myHasUncollectedImportRecords = false;
+
+    // 单个文件的导入在添加实体时即逐个显示（父子关系可能尚未建立），全部耗时都属于该文件；
+    // 批量导入一次性合并，按根实体分配
+    std::vector<ImportRecord> records = myModelImporter->takeImportRecords();
+    if (records.size() == 1 && myPresentationTimings.size() > 1) {
+        PresentationTiming total;
+        for (const auto& entry : myPresentationTimings) {
+            total.buildSeconds += entry.second.buildSeconds;
+            total.displaySeconds += entry.second.displaySeconds;
+            total.objects += entry.second.objects;
+        }
+        myPresentationTimings = {{records.front().modelId, total}};
+    }
+
+    for (ImportRecord& record : records) {
+        auto timing = myPresentationTimings.find(record.modelId);
+        if (timing != myPresentationTimings.end()) {
+            record.stages.push_back({"presentation", timing->second.buildSeconds, 0, timing->second.objects});
+            record.stages.push_back({"display", timing->second.displaySeconds, 0, timing->second.objects});
+        }
+        if (myGlobalSettings.importLogEnabled.get()) {
+            record.appendToLog(myGlobalSettings.importLogPath.get());
+        }
+        myImportRecords.push_back(std::move(record));
+        if (myImportRecords.size() > THE_MAX_IMPORT_RECORDS) {
+            myImportRecords.pop_front();
+        }
+    }
+    myPresentationTimings.clear();
+}
+
+bool UnifiedViewModel::startMeshingSelectedAsync()
+{
+    if (myMeshingJob) {
+        getViewModelLogger()->warn("A meshing is already running");
+        return false;
+    }
+
+    std::vector<std::string> shapeIds;
+    mySelection.forEachSelected([this, &shapeIds](SelectionSet::EntityHandle, const std::string& id) {
+        const UnifiedModel::GeometryData* data = myModel->getGeometryData(id);
+        if (data && data->type == UnifiedModel::GeometryType::SHAPE) {
+            shapeIds.push_back(id);
+        }
+    });
+    if (shapeIds.empty()) {
+        getViewModelLogger()->warn("No shape selected for meshing");
+        return false;
+    }
+
+    ShapeMesher::Options options;
+    options.maxSize = std::max(0.0, myGlobalSettings.netgenMaxSize.get());
+    options.grading = myGlobalSettings.netgenGrading.get();
+    options.volume = myGlobalSettings.netgenVolumeMesh.get();
+    myMeshingJob = std::make_unique<MeshingJob>(*myModel, shapeIds, options);
+    myMeshingJob->start();
+    return true;
+}
+
+void UnifiedViewModel::cancelMeshing()
+{
+    if (myMeshingJob) {
+        getViewModelLogger()->info("Cancelling background meshing");
+        myMeshingJob->cancel();
+    }
+}
+
+void UnifiedViewModel::pollMeshing()
+{
+    if (!myMeshingJob || !myMeshingJob->isFinished()) {
+        return;
+    }
+
+    // 在UI线程上把网格加入模型，模型变更通知会创建对应的显示对象
+    const std::vector<std::string> meshIds = myMeshingJob->commit(*myModel);
+    if (myMeshingJob->isCancelled()) {
+        getViewModelLogger()->info("Background meshing cancelled");
+    }
+    else {
+        getViewModelLogger()->info("Background meshing finished, {} mesh(es) added", meshIds.size());
+    }
+    myMeshingJob.reset();
+}
+
+void UnifiedViewModel::pollPresentations()
+{
+    // 每帧只在预算内交付，其余留到下一帧，大量零件同时完成时不会卡住界面
+    const auto startTime = std::chrono::steady_clock::now();
+    PresentationBuilder::Result result;
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()
+               < THE_PRESENTATION_FRAME_BUDGET
+           && myPresentationBuilder->takeFinished(result)) {
+        // 准备期间被取消或被更新的请求已过时
+        auto pending = myPendingPresentations.find(result.id);
+        if (pending == myPendingPresentations.end() || pending->second.ticket != result.ticket) {
+            continue;
+        }
+        const bool isTimed = pending->second.isTimed;
+        myPendingPresentations.erase(pending);
+        if (isTimed) {
+            --myTimedPresentationCount;
+        }
+
+        const UnifiedModel::GeometryData* data = myModel->getGeometryData(result.id);
+        if (!data) {
+            continue;
+        }
+
+        auto handOffTime = std::chrono::steady_clock::now();
+        Handle(AIS_InteractiveObject) aisObj;
+        double buildSeconds = 0.0;
+        if (result.isPrepared) {
+            // 颜色、位置和显示模式在交付时读取，准备期间的修改不需要重新准备
+            Handle(Mesh_PreparedObject) preparedObj = new Mesh_PreparedObject(std::move(result.data));
+            preparedObj->SetColor(data->color);
+            if (data->type == UnifiedModel::GeometryType::SHAPE) {
+                preparedObj->SetLocalTransformation(
+                    std::get<TopoDS_Shape>(data->geometry).Location().Transformation());
+            }
+            preparedObj->SetDisplayMode(displayMode.get() == 1 ? AIS_WireFrame : AIS_Shaded);
+            aisObj = preparedObj;
+            buildSeconds = result.seconds + lapSeconds(handOffTime);
+        }
+        else {
+            // 准备失败时退回到在UI线程上创建
+            aisObj = createPresentationForGeometry(result.id, data);
+            buildSeconds = lapSeconds(handOffTime);
+        }
+        removePresentation(result.id);
+        if (!aisObj.IsNull()) {
+            displayPresentation(result.id, aisObj, buildSeconds, isTimed);
+        }
+    }
+
+    // 导入的显示全部交付后再记录耗时并移除流式预览
+    if (myTimedPresentationCount == 0) {
+        if (myHasUncollectedImportRecords) {
+            collectImportRecords();
+        }
+        if (!myImportJob && !myImportPreview.IsNull()) {
+            removeImportPreview();
+        }
+    }
+}
+
+void UnifiedViewModel::updateImportPreview()
+{
+    // 各文件新解码的三角形追加到同一个预览对象，首批三角形到达时请求显示
+    for (MeshPreviewChunk& chunk : myImportJob->takePreviews()) {
+        if (chunk.normals.empty()) {
+            continue;
+        }
+        if (myImportPreview.IsNull()) {
+            myImportPreview = new Mesh_ImportPreview();
+            myViewerUpdates.display(myImportPreview);
+        }
+        myImportPreview->AddTriangles(chunk.positions, chunk.normals);
+        myViewerUpdates.invalidate();
+    }
+}
+
+void UnifiedViewModel::removeImportPreview()
+{
+    if (myImportPreview.IsNull()) {
+        return;
+    }
+    // 尚未刷新的显示请求随预览一起丢弃
+    myViewerUpdates.forget(myImportPreview);
+    myContext->Remove(myImportPreview, false);
+    myImportPreview.Nullify();
+    myViewerUpdates.invalidate();
+}
+
 // IViewModel interface implementation
 void UnifiedViewModel::deleteSelectedObjects()
 {
-    std::vector<std::string> objectsToDelete(mySelectedObjects.begin(), mySelectedObjects.end());
+    // 先清空选择，删除时不再逐个更新选择属性
+    const std::vector<std::string> objectsToDelete = mySelection.getSelectedIds();
+    mySelection.clear();
 
     for (const std::string& id : objectsToDelete) {
         myModel->removeEntity(id);
     }
 
-    mySelectedObjects.clear();
+    updateSelectionProperties();
 }
 
 bool UnifiedViewModel::hasSelection() const
 {
-    return !mySelectedObjects.empty();
+    return !mySelection.isEmpty();
 }
 
 std::vector<std::string> UnifiedViewModel::getSelectedObjects() const
 {
-    return std::vector<std::string>(mySelectedObjects.begin(), mySelectedObjects.end());
+    return mySelection.getSelectedIds();
 }
 
 void UnifiedViewModel::processSelection(const Handle(AIS_InteractiveObject) & obj, bool isSelected)
 {
     auto it = myObjectToIdMap.find(obj);
     if (it != myObjectToIdMap.end()) {
-        if (isSelected) {
-            mySelectedObjects.insert(it->second);
+        if (mySelection.setSelected(mySelection.findHandle(it->second), isSelected)) {
+            // Update selection properties
+            updateSelectionProperties();
         }
-        else {
-            mySelectedObjects.erase(it->second);
-        }
-
-        // Update selection properties
-        updateSelectionProperties();
     }
 }
 
 void UnifiedViewModel::clearSelection()
 {
-    mySelectedObjects.clear();
-    myContext->ClearSelected(Standard_True);
+    mySelection.clear();
+    myContext->ClearSelected(Standard_False);
+    clearSelectedElements();
+    myViewerUpdates.invalidate();
 
     // Update selection properties
     updateSelectionProperties();
 }
 
+void UnifiedViewModel::selectEntity(const std::string& id, SelectionSet::Operation operation)
+{
+    Utils::DynamicBitset mask = mySelection.makeMask();
+    const SelectionSet::EntityHandle handle = mySelection.findHandle(id);
+    if (handle != SelectionSet::INVALID_HANDLE) {
+        mask.set(handle);
+    }
+    applySelection(mask, operation);
+}
+
+void UnifiedViewModel::selectAll()
+{
+    applySelection(makeSelectionMask(nullptr), SelectionSet::Operation::REPLACE);
+}
+
+void UnifiedViewModel::invertSelection()
+{
+    applySelection(makeSelectionMask(nullptr), SelectionSet::Operation::TOGGLE);
+}
+
+void UnifiedViewModel::selectByType(UnifiedModel::GeometryType type, SelectionSet::Operation operation)
+{
+    applySelection(makeSelectionMask([type](const UnifiedModel::GeometryData& data) { return data.type == type; }),
+                   operation);
+}
+
+void UnifiedViewModel::selectByColor(const Quantity_Color& color, double tolerance, SelectionSet::Operation operation)
+{
+    applySelection(makeSelectionMask([&color, tolerance](const UnifiedModel::GeometryData& data) {
+                       return data.color.Distance(color) <= tolerance;
+                   }),
+                   operation);
+}
+
+void UnifiedViewModel::selectInBox(const Bnd_Box& box, bool isFullyInside, SelectionSet::Operation operation)
+{
+    if (box.IsVoid()) {
+        applySelection(mySelection.makeMask(), operation);
+        return;
+    }
+
+    // 包围盒按句柄缓存，只计算新增和修改过的实体
+    updateEntityBoxes();
+    Utils::DynamicBitset mask = makeSelectionMask(nullptr);
+    for (size_t handle = 0; handle < mask.size(); ++handle) {
+        if (!mask.test(handle)) {
+            continue;
+        }
+        const Bnd_Box& entityBox = myEntityBoxes[handle];
+        bool isInBox = !entityBox.IsVoid() && !box.IsOut(entityBox);
+        if (isInBox && isFullyInside) {
+            // 轴对齐的盒子包含两个角点即包含整个盒子
+            isInBox = !box.IsOut(entityBox.CornerMin()) && !box.IsOut(entityBox.CornerMax());
+        }
+        if (!isInBox) {
+            mask.set(handle, false);
+        }
+    }
+    applySelection(mask, operation);
+}
+
+void UnifiedViewModel::applySelection(const Utils::DynamicBitset& mask, SelectionSet::Operation operation)
+{
+    if (!mySelection.apply(mask, operation)) {
+        return;
+    }
+    syncContextSelection();
+    updateSelectionProperties();
+}
+
+void UnifiedViewModel::syncSelectionFromContext(AIS_SelectionScheme scheme, bool isAreaPick)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 敏感实体只保留最近一次拾取命中的三角形，在下一次拾取之前合并到元素所有者；
+    // 单击只选择检测到的所有者，其后的拾取结果不参与
+    const Handle(StdSelect_ViewerSelector3d)& selector = myContext->MainSelector();
+    std::set<Handle(Mesh_PreparedObject)> elementObjects;
+    for (Standard_Integer rank = 1; rank <= selector->NbPicked(); ++rank) {
+        Handle(Mesh_ElementOwner) owner = Handle(Mesh_ElementOwner)::DownCast(selector->Picked(rank));
+        if (owner.IsNull() || (!isAreaPick && owner != myContext->DetectedOwner())) {
+            continue;
+        }
+
+        // 上下文按整个所有者加入、切换或移除；拾取前已选中的所有者按方案合并三角形，其余替换
+        const bool wasSelected = mySelectedElementOwners.count(owner) > 0;
+        const AIS_SelectionScheme ownerScheme = wasSelected ? scheme : AIS_SelectionScheme_Replace;
+        if (!owner->IsSelected() && !wasSelected) {
+            continue;
+        }
+        if (!owner->UpdateSelectedElements(selector->PickedEntity(rank), ownerScheme)) {
+            continue;
+        }
+        if (!owner->IsSelected() && !owner->SelectedElements().IsEmpty()) {
+            myContext->AddOrRemoveSelected(owner, Standard_False);
+        }
+        elementObjects.insert(Handle(Mesh_PreparedObject)::DownCast(owner->Selectable()));
+    }
+    for (const Handle(Mesh_PreparedObject)& object : elementObjects) {
+        if (!object.IsNull()) {
+            object->RedrawSelectedElements(myContext->MainPrsMgr());
+        }
+    }
+
+    // 上下文中的选择已按单击或框选的方式合并过，汇总为掩码后整体替换选择集
+    Utils::DynamicBitset mask = mySelection.makeMask();
+    std::set<Handle(Mesh_ElementOwner)> selectedElementOwners;
+    for (myContext->InitSelected(); myContext->MoreSelected(); myContext->NextSelected()) {
+        Handle(Mesh_ElementOwner) owner = Handle(Mesh_ElementOwner)::DownCast(myContext->SelectedOwner());
+        if (!owner.IsNull()) {
+            selectedElementOwners.insert(owner);
+        }
+        auto it = myObjectToIdMap.find(myContext->SelectedInteractive());
+        if (it == myObjectToIdMap.end()) {
+            continue;
+        }
+        const SelectionSet::EntityHandle handle = mySelection.findHandle(it->second);
+        if (handle != SelectionSet::INVALID_HANDLE) {
+            mask.set(handle);
+        }
+    }
+    mySelection.apply(mask, SelectionSet::Operation::REPLACE);
+
+    // 取消选中的所有者不再保留三角形，再次选中时从新拾取的三角形开始
+    for (const Handle(Mesh_ElementOwner)& owner : mySelectedElementOwners) {
+        if (selectedElementOwners.count(owner) == 0) {
+            owner->ClearSelectedElements();
+        }
+    }
+    mySelectedElementOwners.swap(selectedElementOwners);
+
+    // 元素数量在实体不变时也可能变化，总是更新
+    updateSelectionProperties();
+    getViewModelLogger()->debug("Selection synchronized from the viewer: {} objects, {} elements in {:.2f} ms",
+                                mySelection.getCount(),
+                                selectedElementCountProperty.get(),
+                                lapSeconds(startTime) * 1000.0);
+}
+
+Utils::DynamicBitset UnifiedViewModel::makeSelectionMask(
+    const std::function<bool(const UnifiedModel::GeometryData&)>& predicate) const
+{
+    Utils::DynamicBitset mask = mySelection.makeMask();
+    for (const auto& entity : myModel->getEntities()) {
+        if (!isSelectable(entity.second) || (predicate && !predicate(entity.second))) {
+            continue;
+        }
+        const SelectionSet::EntityHandle handle = mySelection.findHandle(entity.first);
+        if (handle != SelectionSet::INVALID_HANDLE) {
+            mask.set(handle);
+        }
+    }
+    return mask;
+}
+
+void UnifiedViewModel::updateEntityBoxes()
+{
+    myEntityBoxes.resize(mySelection.getHandleCount());
+    myValidEntityBoxes.resize(mySelection.getHandleCount());
+
+    std::vector<std::pair<SelectionSet::EntityHandle, const UnifiedModel::GeometryData*>> outdated;
+    for (const auto& entity : myModel->getEntities()) {
+        if (!isSelectable(entity.second)) {
+            continue;
+        }
+        const SelectionSet::EntityHandle handle = mySelection.findHandle(entity.first);
+        if (handle != SelectionSet::INVALID_HANDLE && !myValidEntityBoxes.test(handle)) {
+            outdated.emplace_back(handle, &entity.second);
+        }
+    }
+
+    // 各实体的包围盒互不相关，并行计算；模型在此期间不会被修改
+    Utils::parallelFor(0, outdated.size(), 64, [this, &outdated](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            myEntityBoxes[outdated[i].first] = computeEntityBox(*outdated[i].second);
+        }
+    });
+    for (const auto& entry : outdated) {
+        myValidEntityBoxes.set(entry.first);
+    }
+}
+
+void UnifiedViewModel::invalidateEntityBox(SelectionSet::EntityHandle handle)
+{
+    if (handle < myValidEntityBoxes.size()) {
+        myValidEntityBoxes.set(handle, false);
+    }
+}
+
+void UnifiedViewModel::syncContextSelection()
+{
+    // 逐个加入选中对象，最后统一刷新高亮
+    myContext->ClearSelected(Standard_False);
+    clearSelectedElements();
+    mySelection.forEachSelected([this](SelectionSet::EntityHandle, const std::string& id) {
+        auto it = myIdToObjectMap.find(id);
+        if (it != myIdToObjectMap.end() && myContext->IsDisplayed(it->second)) {
+            myContext->AddOrRemoveSelected(it->second, Standard_False);
+        }
+    });
+    myViewerUpdates.invalidate();
+}
+
+void UnifiedViewModel::clearSelectedElements()
+{
+    for (const Handle(Mesh_ElementOwner)& owner : mySelectedElementOwners) {
+        owner->ClearSelectedElements();
+    }
+    mySelectedElementOwners.clear();
+}
+
+void UnifiedViewModel::updateSelectionModes()
+{
+    // 原有级别的所有者不再有效，先清空选择
+    clearSelection();
+    for (const auto& entry : myIdToObjectMap) {
+        if (myContext->IsDisplayed(entry.second)) {
+            activateSelectionMode(entry.second);
+        }
+    }
+    getViewModelLogger()->info("Selection level: {}", elementSelection.get() ? "elements" : "objects");
+}
+
+void UnifiedViewModel::activateSelectionMode(const Handle(AIS_InteractiveObject)& object)
+{
+    // 只激活一种模式，框选时不会同时选中整个对象和它的元素
+    const Standard_Integer mode = elementSelection.get() ? elementSelectionMode(object) : 0;
+    myContext->SetSelectionModeActive(object, mode, Standard_True, AIS_SelectionModesConcurrency_Single);
+}
+
+size_t UnifiedViewModel::countSelectedElements()
+{
+    if (!elementSelection.get()) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (myContext->InitSelected(); myContext->MoreSelected(); myContext->NextSelected()) {
+        Handle(Mesh_ElementOwner) owner = Handle(Mesh_ElementOwner)::DownCast(myContext->SelectedOwner());
+        count += owner.IsNull() ? 1 : size_t(owner->SelectedElements().Extent());
+    }
+    return count;
+}
+
 // New method to update selection properties
 void UnifiedViewModel::updateSelectionProperties()
 {
-    hasSelectionProperty.set(!mySelectedObjects.empty());
-    selectionCountProperty.set(static_cast<int>(mySelectedObjects.size()));
+    hasSelectionProperty.set(!mySelection.isEmpty());
+    selectionCountProperty.set(static_cast<int>(mySelection.getCount()));
+    selectedElementCountProperty.set(static_cast<int>(countSelectedElements()));
 }
 
 // Attribute access and modification
 void UnifiedViewModel::setSelectedColor(const Quantity_Color& color)
 {
-    for (const std::string& id : mySelectedObjects) {
+    for (const std::string& id : mySelection.getSelectedIds()) {
         myModel->setColor(id, color);
     }
 }
 
 Quantity_Color UnifiedViewModel::getSelectedColor() const
 {
-    if (mySelectedObjects.empty()) {
+    const SelectionSet::EntityHandle first = mySelection.getFirstSelected();
+    if (first == SelectionSet::INVALID_HANDLE) {
         return Quantity_Color(0.8, 0.8, 0.8, Quantity_TOC_RGB);  // Default gray
     }
 
     // Return color of the first selected object
-    return myModel->getColor(*mySelectedObjects.begin());
+    return myModel->getColor(mySelection.getId(first));
+}
+
+void UnifiedViewModel::setVisible(const std::string& id, bool visible)
+{
+    myModel->setVisible(id, visible);
 }
 
 // Private methods
 void UnifiedViewModel::updatePresentation(const std::string& id)
 {
-    // Delete existing representation
-    auto it = myIdToObjectMap.find(id);
-    if (it != myIdToObjectMap.end()) {
-        myContext->Remove(it->second, false);
-        myObjectToIdMap.erase(it->second);
-        myIdToObjectMap.erase(it);
-    }
+    // 尚未交付的准备结果已过时
+    cancelPendingPresentation(id);
 
     // Get geometry data
     const UnifiedModel::GeometryData* data = myModel->getGeometryData(id);
-    if (!data) {
+
+    // 隐藏的实体在重新显示时才创建显示对象
+    if (!data || !data->visible) {
+        removePresentation(id);
+        return;
+    }
+
+    // 网格和已剖分的零件在工作线程上准备，现有显示对象保留到交付为止
+    if (submitPresentation(id, *data)) {
         return;
     }
 
+    // Delete existing representation
+    removePresentation(id);
+
     // Create new representation
+    auto startTime = std::chrono::steady_clock::now();
     Handle(AIS_InteractiveObject) aisObj = createPresentationForGeometry(id, data);
     if (aisObj.IsNull()) {
         return;
     }
+    displayPresentation(id, aisObj, lapSeconds(startTime), myIsTimingPresentation);
+}
+
+bool UnifiedViewModel::submitPresentation(const std::string& id, const UnifiedModel::GeometryData& data)
+{
+    if (!myGlobalSettings.backgroundPresentations.get()) {
+        return false;
+    }
+
+    PresentationBuilder::Request request;
+    if (data.type == UnifiedModel::GeometryType::MESH) {
+        request.mesh = std::get<UnifiedModel::MeshDataPtr>(data.geometry);
+        if (!request.mesh) {
+            return false;
+        }
+    }
+    else {
+        // 实例共享原型的显示；没有三角网格的形状由AIS_Shape在显示时剖分；
+        // 面以外的子形状颜色只有AIS_ColoredShape能显示
+        const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data.geometry);
+        if (!data.instanceKey.empty() || shape.IsNull() || !TopExp_Explorer(shape, TopAbs_FACE).More()
+            || !BRepTools::Triangulation(shape, Precision::Infinite())) {
+            return false;
+        }
+        for (const UnifiedModel::SubShapeColor& subShapeColor : data.subShapeColors) {
+            if (subShapeColor.subShape.ShapeType() != TopAbs_FACE) {
+                return false;
+            }
+        }
+        request.shape = shape.Located(TopLoc_Location());
+        request.subShapeColors = data.subShapeColors;
+    }
+
+    request.id = id;
+    request.ticket = ++myNextPresentationTicket;
+    request.withEdges = displayMode.get() == 1;
+    myPendingPresentations[id] = {request.ticket, myIsTimingPresentation, !request.subShapeColors.empty()};
+    if (myIsTimingPresentation) {
+        ++myTimedPresentationCount;
+    }
+    myPresentationBuilder->submit(std::move(request));
+    return true;
+}
+
+void UnifiedViewModel::cancelPendingPresentation(const std::string& id)
+{
+    auto it = myPendingPresentations.find(id);
+    if (it == myPendingPresentations.end()) {
+        return;
+    }
+    if (it->second.isTimed) {
+        --myTimedPresentationCount;
+    }
+    myPendingPresentations.erase(it);
+}
 
+void UnifiedViewModel::displayPresentation(const std::string& id,
+                                           const Handle(AIS_InteractiveObject)& object,
+                                           double buildSeconds,
+                                           bool isTimed)
+{
     // Display object
-    myContext->Display(aisObj, false);
+    // 显示本身计入每帧的显示预算，立即执行；重绘合并到本帧的刷新
+    auto startTime = std::chrono::steady_clock::now();
+    myContext->Display(object, false);
+    if (elementSelection.get()) {
+        activateSelectionMode(object);
+    }
+    myViewerUpdates.invalidate();
+
+    // 提交导入时按导入的根实体累计显示耗时
+    if (isTimed) {
+        std::string rootId = id;
+        for (std::string parentId = myModel->getParentId(rootId); !parentId.empty();
+             parentId = myModel->getParentId(rootId)) {
+            rootId = parentId;
+        }
+        PresentationTiming& timing = myPresentationTimings[rootId];
+        timing.buildSeconds += buildSeconds;
+        timing.displaySeconds += lapSeconds(startTime);
+        ++timing.objects;
+    }
 
     // Update mapping
-    myIdToObjectMap[id] = aisObj;
-    myObjectToIdMap[aisObj] = id;
+    myIdToObjectMap[id] = object;
+    myObjectToIdMap[object] = id;
+}
+
+void UnifiedViewModel::removePresentation(const std::string& id)
+{
+    auto it = myIdToObjectMap.find(id);
+    if (it == myIdToObjectMap.end()) {
+        return;
+    }
+
+    const bool isInstance = it->second->IsKind(STANDARD_TYPE(AIS_ConnectedInteractive));
+    // 删除的对象不能再被本帧排队的显示请求重新加回
+    myViewerUpdates.forget(it->second);
+    myContext->Remove(it->second, false);
+    myViewerUpdates.invalidate();
+    myObjectToIdMap.erase(it->second);
+    myIdToObjectMap.erase(it);
+    if (isInstance) {
+        pruneInstancePrototypes();
+    }
+}
+
+bool UnifiedViewModel::updatePresentationColor(const std::string& id)
+{
+    const UnifiedModel::GeometryData* data = myModel->getGeometryData(id);
+    if (!data) {
+        return false;
+    }
+
+    // 准备中的显示在交付时读取颜色；子形状颜色编入了准备的分组，改变时重新准备
+    auto pending = myPendingPresentations.find(id);
+    if (pending != myPendingPresentations.end()) {
+        return !pending->second.hasSubShapeColors && data->subShapeColors.empty();
+    }
+
+    auto it = myIdToObjectMap.find(id);
+    if (it == myIdToObjectMap.end()) {
+        return false;
+    }
+
+    // 预先准备的对象直接修改共享的着色属性；子形状颜色编入了准备的分组，改变时重新准备
+    Handle(Mesh_PreparedObject) preparedObj = Handle(Mesh_PreparedObject)::DownCast(it->second);
+    if (!preparedObj.IsNull()) {
+        if (preparedObj->HasCustomColors() || !data->subShapeColors.empty()) {
+            return false;
+        }
+        myContext->SetColor(preparedObj, data->color, false);
+        myViewerUpdates.invalidate();
+        return true;
+    }
+
+    // 带子形状颜色的零件：重设自定义颜色后重新计算显示，沿用已有的三角网格和选择数据
+    Handle(AIS_ColoredShape) coloredShape = Handle(AIS_ColoredShape)::DownCast(it->second);
+    if (!coloredShape.IsNull()) {
+        coloredShape->ClearCustomAspects();
+        coloredShape->SetColor(data->color);
+        for (const UnifiedModel::SubShapeColor& subShapeColor : data->subShapeColors) {
+            coloredShape->SetCustomColor(subShapeColor.subShape, subShapeColor.color);
+        }
+        myViewerUpdates.redisplay(coloredShape);
+        return true;
+    }
+
+    // 普通形状只更新着色属性；新增子形状颜色时需改用AIS_ColoredShape重建
+    Handle(AIS_Shape) aisShape = Handle(AIS_Shape)::DownCast(it->second);
+    if (!aisShape.IsNull()) {
+        if (!data->subShapeColors.empty()) {
+            return false;
+        }
+        myContext->SetColor(aisShape, data->color, false);
+        myViewerUpdates.invalidate();
+        return true;
+    }
+
+    // 网格的颜色用于边线，数据源和选择保持不变
+    Handle(MeshVS_Mesh) meshObj = Handle(MeshVS_Mesh)::DownCast(it->second);
+    if (!meshObj.IsNull()) {
+        meshObj->GetDrawer()->SetColor(MeshVS_DA_EdgeColor, data->color);
+        myViewerUpdates.redisplay(meshObj);
+        return true;
+    }
+
+    // 实例按颜色连接到不同的原型，重建只是重新连接
+    return false;
+}
+
+bool UnifiedViewModel::updatePresentationTransform(const std::string& id)
+{
+    // 准备中的显示在交付时读取位置
+    if (myPendingPresentations.count(id) > 0) {
+        return true;
+    }
+
+    auto it = myIdToObjectMap.find(id);
+    const UnifiedModel::GeometryData* data = myModel->getGeometryData(id);
+    if (it == myIdToObjectMap.end() || !data || data->type != UnifiedModel::GeometryType::SHAPE) {
+        return false;
+    }
+
+    // 形状的显示对象由未定位的形状构建，位置是局部变换，移动时无需重新计算显示和选择
+    myContext->SetLocation(it->second, std::get<TopoDS_Shape>(data->geometry).Location());
+    myViewerUpdates.invalidate();
+    return true;
+}
+
+void UnifiedViewModel::updatePresentationVisibility(const std::string& id)
+{
+    const UnifiedModel::GeometryData* data = myModel->getGeometryData(id);
+    if (!data) {
+        return;
+    }
+
+    auto it = myIdToObjectMap.find(id);
+    if (data->visible) {
+        // 隐藏期间保留的显示对象直接重新显示
+        if (it == myIdToObjectMap.end()) {
+            updatePresentation(id);
+        }
+        else {
+            myViewerUpdates.display(it->second);
+        }
+        return;
+    }
+
+    if (myPendingPresentations.count(id) > 0) {
+        // 准备中的显示重新显示时已过时，连同旧的显示对象一起丢弃
+        cancelPendingPresentation(id);
+        removePresentation(id);
+    }
+    else if (it != myIdToObjectMap.end()) {
+        myViewerUpdates.erase(it->second);
+    }
+    if (mySelection.setSelected(mySelection.findHandle(id), false)) {
+        updateSelectionProperties();
+    }
 }
 
 Handle(AIS_InteractiveObject)
@@ -241,39 +1189,86 @@ Handle(AIS_InteractiveObject)
 
     // Create appropriate AIS object based on geometry type
     if (data->type == UnifiedModel::GeometryType::SHAPE) {
-        // Create AIS_Shape for CAD shape
         const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data->geometry);
-        Handle(AIS_Shape) aisShape = new AIS_Shape(shape);
-        aisShape->SetColor(data->color);
+
+        if (!data->instanceKey.empty()) {
+            // 多次放置的零件连接到共享原型，三角化和显示数据只生成一次
+            Handle(AIS_ConnectedInteractive) instance = new AIS_ConnectedInteractive();
+            instance->Connect(getInstancePrototype(*data), shape.Location().Transformation());
+            aisObj = instance;
+        }
+        else if (!data->subShapeColors.empty()) {
+            // 子形状颜色以未定位的零件形状为参照，位置作为局部变换
+            Handle(AIS_ColoredShape) coloredShape =
+                createColoredShape(shape.Located(TopLoc_Location()), *data);
+            coloredShape->SetLocalTransformation(shape.Location().Transformation());
+            aisObj = coloredShape;
+        }
+        else {
+            // Create AIS_Shape for CAD shape
+            // 位置作为局部变换，移动时不必重建显示
+            Handle(AIS_Shape) aisShape = new AIS_Shape(shape.Located(TopLoc_Location()));
+            aisShape->SetColor(data->color);
+            aisShape->SetLocalTransformation(shape.Location().Transformation());
+            aisObj = aisShape;
+        }
+
+        // 导入时已剖分的形状直接使用现有三角网格，不在UI线程上重新剖分
+        if (BRepTools::Triangulation(shape, Precision::Infinite())) {
+            disableAutoTriangulation(aisObj);
+        }
 
         // Set display mode based on displayMode
         switch (displayMode.get()) {
             case 0:  // Shaded
-                aisShape->SetDisplayMode(AIS_Shaded);
+                aisObj->SetDisplayMode(AIS_Shaded);
                 break;
             case 1:  // Wireframe
-                aisShape->SetDisplayMode(AIS_WireFrame);
+                aisObj->SetDisplayMode(AIS_WireFrame);
                 break;
                 // Can add more display modes
         }
-
-        aisObj = aisShape;
     }
     else if (data->type == UnifiedModel::GeometryType::MESH) {
-        // Get the mesh data from the geometry
-        const UnifiedModel::MeshData& meshData = std::get<UnifiedModel::MeshData>(data->geometry);
-        Handle(Mesh_DataSource) meshDataSource = new Mesh_DataSource(meshData.vertices,
+        // 显示与模型共享网格缓冲区，不复制顶点、面和法向量
+        const UnifiedModel::MeshDataPtr& meshPtr = std::get<UnifiedModel::MeshDataPtr>(data->geometry);
+        const UnifiedModel::MeshData& meshData = *meshPtr;
+        Handle(Mesh_DataSource) meshDataSource = new Mesh_DataSource(meshPtr,
+                                                                     meshData.vertices,
                                                                      meshData.faces,
-                                                                     meshData.normals);
+                                                                     meshData.normals,
+                                                                     meshData.vertexNormals);
 
         Handle(MeshVS_Mesh) meshObj = new MeshVS_Mesh;
         meshObj->SetDataSource(meshDataSource);
 
-        Handle(MeshVS_MeshPrsBuilder) mainBuilder =
-            new MeshVS_MeshPrsBuilder(meshObj, MeshVS_DMF_WireFrame | MeshVS_DMF_Shading);
+        // 文件中带有顶点法向量时使用平滑着色
+        if (meshDataSource->HasNodeNormals()) {
+            meshObj->GetDrawer()->SetBoolean(MeshVS_DA_SmoothShading, true);
+        }
+
+        const bool hasVertexColors = meshData.vertexColors.rows() == meshData.vertices.rows()
+                                     && meshData.vertexColors.cols() == 3;
+        Handle(MeshVS_MeshPrsBuilder) mainBuilder = new MeshVS_MeshPrsBuilder(
+            meshObj, hasVertexColors ? MeshVS_DMF_WireFrame : MeshVS_DMF_WireFrame | MeshVS_DMF_Shading);
         meshObj->AddBuilder(mainBuilder, true);
         meshObj->GetDrawer()->SetColor(MeshVS_DA_EdgeColor, data->color);
 
+        if (hasVertexColors) {
+            // 顶点颜色由节点颜色构建器负责着色显示
+            Handle(MeshVS_NodalColorPrsBuilder) colorBuilder =
+                new MeshVS_NodalColorPrsBuilder(meshObj, MeshVS_DMF_NodalColorDataPrs | MeshVS_DMF_OCCMask);
+            for (Eigen::Index i = 0; i < meshData.vertexColors.rows(); ++i) {
+                colorBuilder->SetColor(Standard_Integer(i + 1),
+                                       Quantity_Color(meshData.vertexColors(i, 0),
+                                                      meshData.vertexColors(i, 1),
+                                                      meshData.vertexColors(i, 2),
+                                                      Quantity_TOC_sRGB));
+            }
+            meshObj->AddBuilder(colorBuilder, false);
+            meshObj->GetDrawer()->SetBoolean(MeshVS_DA_ColorReflection, true);
+        }
+
         // Hide all nodes by default
         Handle(TColStd_HPackedMapOfInteger) aNodes = new TColStd_HPackedMapOfInteger(meshDataSource->GetAllNodes());
         meshObj->SetHiddenNodes(aNodes);
@@ -286,7 +1281,95 @@ Handle(AIS_InteractiveObject)
     return aisObj;
 }
 
-void UnifiedViewModel::onModelChanged(const std::string& id)
+Handle(AIS_ColoredShape) UnifiedViewModel::createColoredShape(const TopoDS_Shape& shape,
+                                                              const UnifiedModel::GeometryData& data)
 {
-    updatePresentation(id);
+    Handle(AIS_ColoredShape) coloredShape = new AIS_ColoredShape(shape);
+    coloredShape->SetColor(data.color);
+    for (const UnifiedModel::SubShapeColor& subShapeColor : data.subShapeColors) {
+        coloredShape->SetCustomColor(subShapeColor.subShape, subShapeColor.color);
+    }
+    return coloredShape;
+}
+
+Handle(AIS_InteractiveObject)
+    UnifiedViewModel::getInstancePrototype(const UnifiedModel::GeometryData& data)
+{
+    // 颜色不同的实例使用不同的原型
+    const std::string key =
+        data.instanceKey + "#" + Quantity_Color::ColorToHex(data.color).ToCString();
+    auto it = myInstancePrototypes.find(key);
+    if (it != myInstancePrototypes.end()) {
+        return it->second;
+    }
+
+    const TopoDS_Shape& shape = std::get<TopoDS_Shape>(data.geometry);
+    Handle(AIS_ColoredShape) prototype = createColoredShape(shape.Located(TopLoc_Location()), data);
+    myInstancePrototypes.emplace(key, prototype);
+    return prototype;
+}
+
+void UnifiedViewModel::disableAutoTriangulation(const Handle(AIS_InteractiveObject)& object)
+{
+    Handle(AIS_ConnectedInteractive) instance = Handle(AIS_ConnectedInteractive)::DownCast(object);
+    if (!instance.IsNull()) {
+        instance->ConnectedTo()->Attributes()->SetAutoTriangulation(false);
+        return;
+    }
+    object->Attributes()->SetAutoTriangulation(false);
+}
+
+void UnifiedViewModel::pruneInstancePrototypes()
+{
+    // 只剩缓存自身持有引用的原型已无实例使用
+    for (auto it = myInstancePrototypes.begin(); it != myInstancePrototypes.end();) {
+        if (it->second->GetRefCount() == 1) {
+            it = myInstancePrototypes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void UnifiedViewModel::onModelChanged(const std::string& id, IModel::ChangeKind kind)
+{
+    // 新实体取得选择句柄；几何和位置变化使缓存的包围盒失效
+    if (kind != IModel::ChangeKind::REMOVAL) {
+        const SelectionSet::EntityHandle handle = mySelection.addEntity(id);
+        if (kind == IModel::ChangeKind::GEOMETRY || kind == IModel::ChangeKind::TRANSFORM) {
+            invalidateEntityBox(handle);
+        }
+    }
+
+    switch (kind) {
+        case IModel::ChangeKind::ATTRIBUTES:
+            // 名称和图层不影响显示
+            break;
+        case IModel::ChangeKind::REMOVAL:
+            cancelPendingPresentation(id);
+            removePresentation(id);
+            invalidateEntityBox(mySelection.findHandle(id));
+            if (mySelection.removeEntity(id)) {
+                updateSelectionProperties();
+            }
+            break;
+        case IModel::ChangeKind::COLOR:
+            if (!updatePresentationColor(id)) {
+                updatePresentation(id);
+            }
+            break;
+        case IModel::ChangeKind::TRANSFORM:
+            if (!updatePresentationTransform(id)) {
+                updatePresentation(id);
+            }
+            break;
+        case IModel::ChangeKind::VISIBILITY:
+            updatePresentationVisibility(id);
+            break;
+        case IModel::ChangeKind::GEOMETRY:
+        default:
+            updatePresentation(id);
+            break;
+    }
 }
\ No newline at end of file
@@ -8,20 +8,31 @@
 #pragma once
 
 #include "IViewModel.h"
+#include "ais/Mesh_ElementOwner.h"
+#include "ais/Mesh_ImportPreview.h"
 #include "../model/UnifiedModel.h"
 #include "../model/ModelImporter.h"
+#include "../model/ImportJob.h"
+#include "../model/MeshingJob.h"
+#include "PresentationBuilder.h"
+#include "SelectionSet.h"
+#include "ViewerUpdateQueue.h"
 #include "../mvvm/Property.h"
 #include "../mvvm/GlobalSettings.h"
 
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_InteractiveObject.hxx>
+#include <AIS_ColoredShape.hxx>
 #include <AIS_Shape.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <BRepPrimAPI_MakeCone.hxx>
+#include <Bnd_Box.hxx>
+#include <deque>
 #include <memory>
-#include <set>
+#include <functional>
 #include <string>
 #include <map>
+#include <set>
 
 /**
  * @class UnifiedViewModel
@@ -76,10 +87,161 @@ public:
      * @brief Imports a model from a file
      * @param filePath The path to the model file
      * @param modelId The ID to assign to the imported model (if empty, the filename will be used)
-     * @return True if import was successful, false otherwise
+     * @return True if import was successful, false otherwise (also while a background import is running)
      */
     bool importModel(const std::string& filePath, const std::string& modelId = "");
     
+    /**
+     * @brief Saves the whole model to a model archive
+     * @param filePath The path of the archive file
+     * @return True if the archive was written, false otherwise
+     */
+    bool saveModel(const std::string& filePath);
+    
+    /**
+     * @brief Replaces the model content with the content of a model archive
+     * @param filePath The path of the archive file
+     * @return True if the archive was loaded, false otherwise (the model is left unchanged);
+     *         also false while a background import or meshing is running
+     */
+    bool openModel(const std::string& filePath);
+    
+    /**
+     * @brief Exports the model, or only the selected entities, to a mesh file
+     * @param filePath The output file; its extension (.stl or .glb) selects the format
+     * @param selectionOnly Whether only the selected entities are exported
+     * @return True if the file was written, false otherwise; also false while presentations are
+     *         being built, since the export tessellates the shapes the workers read
+     */
+    bool exportModel(const std::string& filePath, bool selectionOnly);
+    
+    /**
+     * @brief Starts importing files on a background worker
+     * 
+     * The imported geometry is handed over to the model by pollImport(), on the thread
+     * that calls it (the UI thread).
+     * 
+     * @param filePaths The files to import
+     * @return True if the import was started, false if another import is still running
+     */
+    bool startImportAsync(const std::vector<std::string>& filePaths);
+    
+    /**
+     * @brief Starts importing all supported files of a directory on a background worker
+     * @param directory The directory to scan recursively
+     * @return True if the import was started, false if there is nothing to import or
+     *         another import is still running
+     */
+    bool startImportDirectoryAsync(const std::string& directory);
+    
+    /**
+     * @brief Gets the statistics of the last committed background import
+     * @return Throughput statistics (all zero before the first import)
+     */
+    const ModelImporter::BatchStats& getLastImportStats() const { return myLastImportStats; }
+    
+    /**
+     * @brief Gets the records of the recent imports, oldest first
+     * 
+     * Each record holds the stage timings of the importer, followed by the time spent
+     * creating ("presentation") and displaying ("display") the objects of the import.
+     * 
+     * @return The records of the last imports
+     */
+    const std::deque<ImportRecord>& getImportRecords() const { return myImportRecords; }
+    
+    /**
+     * @brief Removes all import records
+     */
+    void clearImportRecords() { myImportRecords.clear(); }
+    
+    /**
+     * @brief Gets the statistics of the on-disk import cache
+     * @return Hit/miss statistics (all zero while the cache is disabled)
+     */
+    ImportCache::Stats getImportCacheStats() const;
+    
+    /**
+     * @brief Removes all entries of the on-disk import cache
+     */
+    void clearImportCache();
+    
+    /**
+     * @brief Checks whether a background import is in progress
+     * @return True while an import job exists that has not been committed yet
+     */
+    bool isImporting() const { return myImportJob != nullptr; }
+    
+    /**
+     * @brief Gets the running background import
+     * @return Pointer to the import job, or nullptr if none is running
+     */
+    const ImportJob* getImportJob() const { return myImportJob.get(); }
+    
+    /**
+     * @brief Requests cancellation of the running background import
+     */
+    void cancelImport();
+    
+    /**
+     * @brief Commits a finished background import into the model
+     * 
+     * Must be called regularly (once per frame) on the UI thread. While the import runs,
+     * the triangles streamed by the mesh readers are displayed as a preview, which is
+     * replaced by the imported meshes on commit.
+     */
+    void pollImport();
+    
+    /**
+     * @brief Starts meshing the selected shapes with Netgen on a background worker
+     * 
+     * The size parameters come from the global settings. The meshes are added to the
+     * model by pollMeshing(), next to their shapes.
+     * 
+     * @return True if the meshing was started, false if no shape is selected or
+     *         another meshing is still running
+     */
+    bool startMeshingSelectedAsync();
+    
+    /**
+     * @brief Checks whether a background meshing is in progress
+     * @return True while a meshing job exists that has not been committed yet
+     */
+    bool isMeshing() const { return myMeshingJob != nullptr; }
+    
+    /**
+     * @brief Gets the running background meshing
+     * @return Pointer to the meshing job, or nullptr if none is running
+     */
+    const MeshingJob* getMeshingJob() const { return myMeshingJob.get(); }
+    
+    /**
+     * @brief Requests cancellation of the running background meshing
+     */
+    void cancelMeshing();
+    
+    /**
+     * @brief Commits a finished background meshing into the model
+     * 
+     * Must be called regularly (once per frame) on the UI thread.
+     */
+    void pollMeshing();
+    
+    /**
+     * @brief Displays the presentations prepared on the worker threads
+     * 
+     * Must be called regularly (once per frame) on the UI thread. Results are handed
+     * over within a small time budget per call, so many parts finishing together do
+     * not stall a frame; prepared results that were superseded are discarded.
+     */
+    void pollPresentations();
+    
+    /**
+     * @brief Checks whether presentations are being prepared on the worker threads
+     * @return True while a prepared presentation has not been displayed yet
+     */
+    bool isBuildingPresentations() const { return !myPendingPresentations.empty(); }
+    
     /**
      * @brief Deletes the currently selected objects
      */
@@ -97,6 +259,107 @@ public:
      */
     std::vector<std::string> getSelectedObjects() const override;
     
+    /**
+     * @brief Gets the number of selected objects without copying the selection
+     * @return The selection count
+     */
+    size_t getSelectionCount() const override { return mySelection.getCount(); }
+    
+    /**
+     * @brief Checks whether an object is selected without copying the selection
+     * @param id The ID of the object
+     * @return True if the object is selected, false otherwise
+     */
+    bool isSelected(const std::string& id) const { return mySelection.isSelected(id); }
+    
+    /**
+     * @brief Checks whether an object is selected with a single bit test
+     * @param handle The selection handle of the object (see getSelectionHandle())
+     * @return True if the object is selected, false otherwise
+     */
+    bool isSelected(SelectionSet::EntityHandle handle) const { return mySelection.isSelected(handle); }
+    
+    /**
+     * @brief Gets the selection handle of an entity
+     * 
+     * Handles stay valid until the entity is removed, i.e. until the structure of the
+     * model changes.
+     * 
+     * @param id The ID of the entity
+     * @return The handle, or SelectionSet::INVALID_HANDLE for unknown entities
+     */
+    SelectionSet::EntityHandle getSelectionHandle(const std::string& id) const { return mySelection.findHandle(id); }
+    
+    /**
+     * @brief Selects a single entity
+     * @param id The ID of the entity
+     * @param operation How the entity is combined with the selection
+     */
+    void selectEntity(const std::string& id,
+                      SelectionSet::Operation operation = SelectionSet::Operation::REPLACE);
+    
+    /**
+     * @brief Selects all visible shapes and meshes
+     */
+    void selectAll();
+    
+    /**
+     * @brief Inverts the selection of the visible shapes and meshes
+     */
+    void invertSelection();
+    
+    /**
+     * @brief Selects the visible entities of a geometry type
+     * @param type The geometry type (SHAPE or MESH)
+     * @param operation How the matching entities are combined with the selection
+     */
+    void selectByType(UnifiedModel::GeometryType type,
+                      SelectionSet::Operation operation = SelectionSet::Operation::REPLACE);
+    
+    /**
+     * @brief Selects the visible entities of a color
+     * @param color The color to match
+     * @param tolerance Maximum distance between the colors in RGB space
+     * @param operation How the matching entities are combined with the selection
+     */
+    void selectByColor(const Quantity_Color& color,
+                       double tolerance = 1.0e-3,
+                       SelectionSet::Operation operation = SelectionSet::Operation::REPLACE);
+    
+    /**
+     * @brief Selects the visible entities whose bounding box lies in a box
+     * @param box The box, in world coordinates
+     * @param isFullyInside True to require the whole entity in the box, false to accept touching entities
+     * @param operation How the matching entities are combined with the selection
+     */
+    void selectInBox(const Bnd_Box& box,
+                     bool isFullyInside = false,
+                     SelectionSet::Operation operation = SelectionSet::Operation::REPLACE);
+    
+    /**
+     * @brief Combines a mask of entities with the selection
+     * 
+     * The AIS selection and the selection properties are updated once.
+     * 
+     * @param mask Entities indexed by selection handle
+     * @param operation How the mask is combined with the selection
+     */
+    void applySelection(const Utils::DynamicBitset& mask, SelectionSet::Operation operation);
+    
+    /**
+     * @brief Takes over the selection of the interactive context after a pick
+     * 
+     * Called once per click, rectangle or polygon pick. The triangles detected by the pick
+     * are combined with the triangles of the picked element owners according to the scheme:
+     * added with AIS_SelectionScheme_Add, toggled with AIS_SelectionScheme_XOR, replaced
+     * otherwise. An owner the context deselected keeps its selection while triangles remain.
+     * The selected objects are then combined into a mask that replaces the selection in one step.
+     * 
+     * @param scheme The selection scheme the pick was applied with
+     * @param isAreaPick True for rectangle and polygon picks, false for a click
+     */
+    void syncSelectionFromContext(AIS_SelectionScheme scheme = AIS_SelectionScheme_Replace, bool isAreaPick = false);
+    
     /**
      * @brief Processes selection/deselection of an interactive object
      * @param obj The interactive object that was selected or deselected
@@ -142,6 +405,19 @@ public:
      */
     MVVM::Property<int> selectionCountProperty{0};
     
+    /**
+     * @brief Property for the selection level
+     * 
+     * False selects whole objects; true selects triangles of meshes and prepared
+     * presentations, and faces of CAD parts. Changing the level clears the selection.
+     */
+    MVVM::Property<bool> elementSelection{false};
+    
+    /**
+     * @brief Property for the number of selected triangles and faces (element level only)
+     */
+    MVVM::Property<int> selectedElementCountProperty{0};
+    
     /**
      * @brief Sets the color of the selected objects
      * @param color The color to set
@@ -154,6 +430,13 @@ public:
      */
     Quantity_Color getSelectedColor() const;
     
+    /**
+     * @brief Shows or hides an entity (hiding an assembly hides its parts)
+     * @param id The ID of the entity
+     * @param visible Whether the entity is displayed
+     */
+    void setVisible(const std::string& id, bool visible);
+    
     /**
      * @brief Gets the UnifiedModel with type information preserved
      * @return Shared pointer to the UnifiedModel
@@ -166,6 +449,12 @@ public:
      */
     Handle(V3d_Viewer) getViewer() const { return myContext->CurrentViewer(); }
     
+    /**
+     * @brief Gets the queue of viewer updates, flushed by the view once per frame
+     * @return Reference to the update queue
+     */
+    ViewerUpdateQueue& getViewerUpdates() { return myViewerUpdates; }
+    
     /**
      * @brief Gets the global settings
      * @return Reference to the global settings
@@ -184,8 +473,17 @@ private:
     /** The OCCT interactive context */
     Handle(AIS_InteractiveContext) myContext;
     
-    /** Set of selected object IDs */
-    std::set<std::string> mySelectedObjects;
+    /** Display changes and redraws collected during the frame */
+    ViewerUpdateQueue myViewerUpdates;
+    
+    /** Selected objects, as a bitset over the entity handles */
+    SelectionSet mySelection;
+    
+    /** World bounding boxes of the entities, indexed by selection handle */
+    std::vector<Bnd_Box> myEntityBoxes;
+    
+    /** Entities whose box in myEntityBoxes is up to date */
+    Utils::DynamicBitset myValidEntityBoxes;
     
     /** Reference to the global settings */
     MVVM::GlobalSettings& myGlobalSettings;
@@ -193,18 +491,145 @@ private:
     /** The model importer */
     std::shared_ptr<ModelImporter> myModelImporter;
     
+    /** The running background import, if any */
+    std::unique_ptr<ImportJob> myImportJob;
+    
+    /** The running background meshing, if any */
+    std::unique_ptr<MeshingJob> myMeshingJob;
+    
+    /** Preview of the meshes streamed by the running import (null while nothing was streamed) */
+    Handle(Mesh_ImportPreview) myImportPreview;
+    
+    // Statistics of the last committed background import
+    ModelImporter::BatchStats myLastImportStats;
+    
     /**
-     * @brief Updates the visual presentation of a geometry
+     * @brief Time spent on the presentation of the entities of an import
+     */
+    struct PresentationTiming {
+        double buildSeconds = 0.0;    ///< Creation of the AIS objects
+        double displaySeconds = 0.0;  ///< Display of the AIS objects (computes their presentation)
+        std::uint64_t objects = 0;    ///< Number of objects displayed
+    };
+    
+    /** Presentation time per root entity, measured while an import is committed */
+    std::map<std::string, PresentationTiming> myPresentationTimings;
+    
+    /** Whether updatePresentation() is currently measured */
+    bool myIsTimingPresentation = false;
+    
+    /** Prepares presentations of meshes and triangulated parts on worker threads */
+    std::unique_ptr<PresentationBuilder> myPresentationBuilder;
+    
+    /**
+     * @brief Presentation submitted to the builder and not displayed yet
+     */
+    struct PendingPresentation {
+        std::uint64_t ticket = 0;  ///< Ticket of the latest request of the entity
+        bool isTimed = false;      ///< Whether the time is added to the import records
+        bool hasSubShapeColors = false;  ///< Whether sub-shape colors are baked into the request
+    };
+    
+    /** Pending presentations per entity ID */
+    std::map<std::string, PendingPresentation> myPendingPresentations;
+    
+    /** Ticket of the last submitted request */
+    std::uint64_t myNextPresentationTicket = 0;
+    
+    /** Number of pending presentations measured for the import records */
+    size_t myTimedPresentationCount = 0;
+    
+    /** Whether the import records wait for pending presentations */
+    bool myHasUncollectedImportRecords = false;
+    
+    /** Records of the recent imports, oldest first */
+    std::deque<ImportRecord> myImportRecords;
+    
+    /**
+     * @brief Takes the new import records from the importer, completes them with the
+     *        measured presentation time and appends them to the import log
+     */
+    void collectImportRecords();
+    
+    /**
+     * @brief Rebuilds the visual presentation of a geometry
      * @param id The ID of the geometry to update
      */
     void updatePresentation(const std::string& id);
     
+    /**
+     * @brief Removes the visual presentation of a geometry
+     * @param id The ID of the geometry
+     */
+    void removePresentation(const std::string& id);
+    
+    /**
+     * @brief Submits the presentation of a mesh or triangulated part to the worker threads
+     * 
+     * The current presentation stays displayed until the prepared one is handed over.
+     * 
+     * @param id The ID of the geometry
+     * @param data The geometry data
+     * @return False if the presentation has to be created on the UI thread instead
+     */
+    bool submitPresentation(const std::string& id, const UnifiedModel::GeometryData& data);
+    
+    /**
+     * @brief Forgets the pending presentation of a geometry; its result will be discarded
+     * @param id The ID of the geometry
+     */
+    void cancelPendingPresentation(const std::string& id);
+    
+    /**
+     * @brief Displays a new presentation of a geometry and records its time
+     * @param id The ID of the geometry
+     * @param object The presentation, replacing the current one
+     * @param buildSeconds Time spent creating the presentation
+     * @param isTimed Whether the time is added to the import records
+     */
+    void displayPresentation(const std::string& id,
+                             const Handle(AIS_InteractiveObject)& object,
+                             double buildSeconds,
+                             bool isTimed);
+    
+    /**
+     * @brief Applies the color of a geometry to its existing presentation
+     * 
+     * Presentations still being prepared read the color when they are handed off, so
+     * they are accepted unless sub-shape colors are involved.
+     * 
+     * @param id The ID of the geometry
+     * @return False if the presentation has to be rebuilt instead
+     */
+    bool updatePresentationColor(const std::string& id);
+    
+    /**
+     * @brief Applies the location of a CAD shape to its existing presentation
+     * @param id The ID of the geometry
+     * @return False if the presentation has to be rebuilt instead
+     */
+    bool updatePresentationTransform(const std::string& id);
+    
+    /**
+     * @brief Displays or erases the presentation of a geometry
+     * @param id The ID of the geometry
+     */
+    void updatePresentationVisibility(const std::string& id);
+    
     /** Map from OCCT objects to model IDs */
     std::map<Handle(AIS_InteractiveObject), std::string> myObjectToIdMap;
     
     /** Map from model IDs to OCCT objects */
     std::map<std::string, Handle(AIS_InteractiveObject)> myIdToObjectMap;
     
+    /** Element owners selected after the last pick, whose triangles later picks combine with */
+    std::set<Handle(Mesh_ElementOwner)> mySelectedElementOwners;
+    
+    /**
+     * @brief Clears the triangles of all element owners, e.g. after the context selection was cleared
+     */
+    void clearSelectedElements();
+    
     /**
      * @brief Creates an appropriate AIS object for a geometry
      * @param id The ID of the geometry
@@ -214,14 +639,105 @@ private:
     Handle(AIS_InteractiveObject) createPresentationForGeometry(
         const std::string& id, const UnifiedModel::GeometryData* data);
     
+    /**
+     * @brief Creates a shape presentation carrying the sub-shape colors of a part
+     * @param shape The unlocated part shape
+     * @param data The geometry data providing the colors
+     * @return The created AIS object
+     */
+    Handle(AIS_ColoredShape) createColoredShape(const TopoDS_Shape& shape,
+                                                const UnifiedModel::GeometryData& data);
+    
+    /**
+     * @brief Gets (or creates) the shared presentation of an instanced part
+     * @param data The geometry data of one of the instances
+     * @return The prototype object the instances are connected to
+     */
+    Handle(AIS_InteractiveObject) getInstancePrototype(const UnifiedModel::GeometryData& data);
+    
+    /**
+     * @brief Makes a shape presentation use the triangulation computed at import
+     * @param object The shape presentation (or instance, whose prototype is updated)
+     */
+    void disableAutoTriangulation(const Handle(AIS_InteractiveObject)& object);
+    
+    /**
+     * @brief Adds the triangles streamed by the running import since the last frame to the preview
+     */
+    void updateImportPreview();
+    
+    /**
+     * @brief Removes the preview of the running import
+     */
+    void removeImportPreview();
+    
+    /**
+     * @brief Pushes the import-related global settings to the model importer
+     */
+    void applyImportSettings();
+    
+    /**
+     * @brief Drops prototypes that are no longer referenced by any instance
+     */
+    void pruneInstancePrototypes();
+    
+    /** Shared presentations of instanced parts, keyed by instance key and color */
+    std::map<std::string, Handle(AIS_ColoredShape)> myInstancePrototypes;
+    
     /**
      * @brief Callback for model changes
+     * 
+     * Only geometry changes rebuild the presentation; color, location and visibility
+     * changes are applied to the existing AIS object.
+     * 
      * @param id The ID of the changed geometry
+     * @param kind What changed
      */
-    void onModelChanged(const std::string& id);
+    void onModelChanged(const std::string& id, IModel::ChangeKind kind);
     
     /**
      * @brief Updates selection properties
      */
     void updateSelectionProperties();
+    
+    /**
+     * @brief Builds a mask of the visible shapes and meshes matching a predicate
+     * @param predicate Test of the geometry data (null accepts all)
+     * @return The mask, indexed by selection handle
+     */
+    Utils::DynamicBitset makeSelectionMask(
+        const std::function<bool(const UnifiedModel::GeometryData&)>& predicate) const;
+    
+    /**
+     * @brief Computes the missing bounding boxes of the visible shapes and meshes
+     */
+    void updateEntityBoxes();
+    
+    /**
+     * @brief Marks the bounding box of an entity as outdated
+     * @param handle The selection handle of the entity
+     */
+    void invalidateEntityBox(SelectionSet::EntityHandle handle);
+    
+    /**
+     * @brief Highlights the selected objects in the interactive context
+     */
+    void syncContextSelection();
+    
+    /**
+     * @brief Activates the selection mode of the current level on all displayed objects
+     */
+    void updateSelectionModes();
+    
+    /**
+     * @brief Activates the selection mode of the current level on a displayed object
+     * @param object The AIS object
+     */
+    void activateSelectionMode(const Handle(AIS_InteractiveObject)& object);
+    
+    /**
+     * @brief Counts the selected triangles and faces of the interactive context
+     * @return The count, 0 at object level
+     */
+    size_t countSelectedElements();
 }; 
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "ViewerUpdateQueue.h"
+
+#include <algorithm>
+
+ViewerUpdateQueue::ViewerUpdateQueue(const Handle(AIS_InteractiveContext)& context)
+    : myContext(context)
+{
+}
+
+void ViewerUpdateQueue::display(const Handle(AIS_InteractiveObject)& object)
+{
+    Request& request = findRequest(object);
+    request.visibility = Visibility::SHOWN;
+}
+
+void ViewerUpdateQueue::erase(const Handle(AIS_InteractiveObject)& object)
+{
+    Request& request = findRequest(object);
+    request.visibility = Visibility::HIDDEN;
+}
+
+void ViewerUpdateQueue::redisplay(const Handle(AIS_InteractiveObject)& object)
+{
+    Request& request = findRequest(object);
+    request.toRecompute = true;
+}
+
+void ViewerUpdateQueue::invalidate()
+{
+    ++myCounters.redrawRequests;
+    myIsRedrawRequested = true;
+}
+
+void ViewerUpdateQueue::forget(const Handle(AIS_InteractiveObject)& object)
+{
+    if (myRequests.erase(object) == 0) {
+        return;
+    }
+    // 同时移出顺序表，再次请求时重新排在末尾
+    myOrder.erase(std::remove(myOrder.begin(), myOrder.end(), object), myOrder.end());
+}
+
+void ViewerUpdateQueue::setDisplayCallback(std::function<void(const Handle(AIS_InteractiveObject)&)> callback)
+{
+    myDisplayCallback = std::move(callback);
+}
+
+bool ViewerUpdateQueue::flush(const Handle(V3d_View)& view)
+{
+    if (!hasPending()) {
+        return false;
+    }
+
+    // 先取出请求，回调中产生的新请求留到下一帧
+    std::map<Handle(AIS_InteractiveObject), Request> requests;
+    std::vector<Handle(AIS_InteractiveObject)> order;
+    requests.swap(myRequests);
+    order.swap(myOrder);
+    myIsRedrawRequested = false;
+
+    for (const Handle(AIS_InteractiveObject)& object : order) {
+        auto it = requests.find(object);
+        if (it == requests.end() || myContext.IsNull()) {
+            continue;
+        }
+
+        // 显示在重新计算之前，隐藏在之后，对象只计算一次且不会在隐藏后重新出现
+        const Request& request = it->second;
+        if (request.visibility == Visibility::SHOWN) {
+            myContext->Display(object, Standard_False);
+            ++myCounters.displays;
+            if (myDisplayCallback) {
+                myDisplayCallback(object);
+            }
+        }
+        if (request.toRecompute) {
+            myContext->Redisplay(object, Standard_False);
+            ++myCounters.redisplays;
+        }
+        if (request.visibility == Visibility::HIDDEN) {
+            myContext->Erase(object, Standard_False);
+            ++myCounters.erases;
+        }
+    }
+
+    // 整帧只使视图失效一次，由随后的FlushViewEvents重绘
+    if (!view.IsNull()) {
+        view->Invalidate();
+    }
+    ++myCounters.redraws;
+    return true;
+}
+
+ViewerUpdateQueue::Request& ViewerUpdateQueue::findRequest(const Handle(AIS_InteractiveObject)& object)
+{
+    ++myCounters.redrawRequests;
+
+    auto it = myRequests.find(object);
+    if (it != myRequests.end()) {
+        ++myCounters.coalesced;
+        return it->second;
+    }
+    myOrder.push_back(object);
+    return myRequests[object];
+}
@@ -0,0 +1,156 @@
+/**
+ * @file ViewerUpdateQueue.h
+ * @brief Defines the ViewerUpdateQueue class which applies viewer updates once per frame.
+ *
+ * Model change handlers, property listeners and message bus subscribers record what has to
+ * change in the viewer instead of updating it directly. The view flushes the queue once per
+ * frame, just before it processes its events, so an action that touches the viewer several
+ * times costs a single redraw.
+ */
+#pragma once
+
+#include <AIS_InteractiveContext.hxx>
+#include <V3d_View.hxx>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * @class ViewerUpdateQueue
+ * @brief Per-frame queue of display, erase, redisplay and redraw requests.
+ *
+ * Requests for the same object are merged: the last display or erase wins and an object is
+ * recomputed at most once per frame. Objects are processed in the order of their first request.
+ */
+class ViewerUpdateQueue {
+public:
+    /**
+     * @brief Statistics of the queue since its creation or the last resetCounters()
+     */
+    struct Counters {
+        size_t redrawRequests = 0;  ///< Requests that would have redrawn the viewer on their own
+        size_t redraws = 0;         ///< Redraws performed by flush()
+        size_t coalesced = 0;       ///< Requests merged into an earlier request for the same object
+        size_t displays = 0;        ///< Objects displayed by flush()
+        size_t erases = 0;          ///< Objects erased by flush()
+        size_t redisplays = 0;      ///< Objects recomputed by flush()
+
+        /**
+         * @brief Gets the number of redraws saved by merging the requests of a frame
+         * @return Redraw requests minus performed redraws
+         */
+        size_t redrawsSaved() const { return redrawRequests > redraws ? redrawRequests - redraws : 0; }
+    };
+
+    /**
+     * @brief Constructor
+     * @param context The interactive context the requests are applied to
+     */
+    explicit ViewerUpdateQueue(const Handle(AIS_InteractiveContext)& context);
+
+    /**
+     * @brief Requests an object to be displayed
+     * @param object The AIS object
+     */
+    void display(const Handle(AIS_InteractiveObject)& object);
+
+    /**
+     * @brief Requests an object to be erased (it stays loaded in the context)
+     * @param object The AIS object
+     */
+    void erase(const Handle(AIS_InteractiveObject)& object);
+
+    /**
+     * @brief Requests the presentations of an object to be recomputed
+     * @param object The AIS object
+     */
+    void redisplay(const Handle(AIS_InteractiveObject)& object);
+
+    /**
+     * @brief Requests a redraw of the viewer
+     */
+    void invalidate();
+
+    /**
+     * @brief Drops the pending requests of an object, e.g. before it is removed from the context
+     * @param object The AIS object
+     */
+    void forget(const Handle(AIS_InteractiveObject)& object);
+
+    /**
+     * @brief Sets a function called for every object displayed by flush()
+     * @param callback Function with the signature void(const Handle(AIS_InteractiveObject)&)
+     */
+    void setDisplayCallback(std::function<void(const Handle(AIS_InteractiveObject)&)> callback);
+
+    /**
+     * @brief Checks whether the next flush() has work to do
+     * @return True if requests are pending
+     */
+    bool hasPending() const { return myIsRedrawRequested || !myRequests.empty(); }
+
+    /**
+     * @brief Gets the number of objects with pending requests
+     * @return The object count
+     */
+    size_t getPendingCount() const { return myRequests.size(); }
+
+    /**
+     * @brief Applies the pending requests and invalidates the view once
+     * @param view The view to redraw (may be null)
+     * @return True if something was applied
+     */
+    bool flush(const Handle(V3d_View)& view);
+
+    /**
+     * @brief Gets the statistics
+     * @return The counters
+     */
+    const Counters& getCounters() const { return myCounters; }
+
+    /**
+     * @brief Resets the statistics
+     */
+    void resetCounters() { myCounters = Counters(); }
+
+private:
+    /** Display state requested for an object */
+    enum class Visibility {
+        UNCHANGED,
+        SHOWN,
+        HIDDEN
+    };
+
+    /** Merged requests of an object */
+    struct Request {
+        Visibility visibility = Visibility::UNCHANGED;
+        bool toRecompute = false;
+    };
+
+    /**
+     * @brief Gets the merged request of an object, creating it on the first request
+     * @param object The AIS object
+     * @return The request
+     */
+    Request& findRequest(const Handle(AIS_InteractiveObject)& object);
+
+    /** The interactive context */
+    Handle(AIS_InteractiveContext) myContext;
+
+    /** Merged requests per object */
+    std::map<Handle(AIS_InteractiveObject), Request> myRequests;
+
+    /** Objects in the order of their first request */
+    std::vector<Handle(AIS_InteractiveObject)> myOrder;
+
+    /** Whether invalidate() was called (object requests redraw the viewer on their own) */
+    bool myIsRedrawRequested = false;
+
+    /** Called for every displayed object */
+    std::function<void(const Handle(AIS_InteractiveObject)&)> myDisplayCallback;
+
+    /** Statistics */
+    Counters myCounters;
+};
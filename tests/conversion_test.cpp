@@ -0,0 +1,216 @@
+#define BOOST_TEST_MODULE Conversion Tests
+#include <boost/test/unit_test.hpp>
+
+#include "model/ConversionPipeline.h"
+#include "model/ImportCache.h"
+#include "model/MeshProcessing.h"
+#include "model/UnifiedModel.h"
+#include "utils/JsonWriter.h"
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+//! Builds an N x N grid of unit squares as a triangle soup (three vertices per triangle).
+UnifiedModel::MeshData makeGridSoup(int theSize)
+{
+    UnifiedModel::MeshData aMesh;
+    aMesh.vertices.resize(6 * theSize * theSize, 3);
+    aMesh.faces.resize(2 * theSize * theSize, 3);
+    int aVertex = 0;
+    int aFace = 0;
+    for (int i = 0; i < theSize; ++i) {
+        for (int j = 0; j < theSize; ++j) {
+            const double aCorners[4][3] = {{double(i), double(j), 0.0},
+                                           {i + 1.0, double(j), 0.0},
+                                           {i + 1.0, j + 1.0, 0.0},
+                                           {double(i), j + 1.0, 0.0}};
+            const int aTriangles[2][3] = {{0, 1, 2}, {0, 2, 3}};
+            for (const auto& aTriangle : aTriangles) {
+                for (int c = 0; c < 3; ++c) {
+                    const double* aCorner = aCorners[aTriangle[c]];
+                    aMesh.vertices.row(aVertex) << aCorner[0], aCorner[1], aCorner[2];
+                    aMesh.faces(aFace, c) = aVertex++;
+                }
+                ++aFace;
+            }
+        }
+    }
+    aMesh.normals = Eigen::MatrixXd::Zero(aMesh.faces.rows(), 3);
+    return aMesh;
+}
+}
+
+BOOST_AUTO_TEST_CASE(weld_vertices_test)
+{
+    // 4x4的三角形汤：96个顶点焊接为25个，面数不变
+    UnifiedModel::MeshData mesh = makeGridSoup(4);
+    mesh.vertexColors = Eigen::MatrixXd::Constant(mesh.vertices.rows(), 3, 0.5);
+    const MeshProcessing::Result result = MeshProcessing::weldVertices(mesh);
+    BOOST_CHECK_EQUAL(result.verticesBefore, 96);
+    BOOST_CHECK_EQUAL(result.verticesAfter, 25);
+    BOOST_CHECK_EQUAL(mesh.vertices.rows(), 25);
+    BOOST_CHECK_EQUAL(mesh.faces.rows(), 32);
+    BOOST_CHECK_EQUAL(mesh.vertexColors.rows(), 25);
+    BOOST_CHECK_CLOSE(mesh.vertexColors(24, 1), 0.5, 1e-9);
+    BOOST_CHECK(mesh.faces.maxCoeff() < 25);
+
+    // 容差内的顶点合并，退化面被移除；非有限坐标的顶点保持独立
+    UnifiedModel::MeshData noisy = makeGridSoup(2);
+    noisy.vertices(0, 0) += 1e-5;
+    noisy.vertices(1, 0) = std::nan("");
+    MeshProcessing::weldVertices(noisy, 1e-3);
+    BOOST_CHECK_EQUAL(noisy.vertices.rows(), 9 + 1);
+    BOOST_CHECK_EQUAL(noisy.faces.rows(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(repair_mesh_test)
+{
+    // 三角形汤中的重复面（含反向）、退化面、NaN顶点和非流形边
+    UnifiedModel::MeshData mesh = makeGridSoup(2);
+    const int nbFaces = static_cast<int>(mesh.faces.rows());
+    mesh.vertices.conservativeResize(mesh.vertices.rows() + 9, 3);
+    const int base = nbFaces * 3;
+    mesh.vertices.row(base + 0) << 0.0, 0.0, 0.0;   // 第一个面的反向副本
+    mesh.vertices.row(base + 1) << 1.0, 1.0, 0.0;
+    mesh.vertices.row(base + 2) << 1.0, 0.0, 0.0;
+    mesh.vertices.row(base + 3) << 0.0, 0.0, 0.0;   // 共线的退化面
+    mesh.vertices.row(base + 4) << 1.0, 0.0, 0.0;
+    mesh.vertices.row(base + 5) << 2.0, 0.0, 0.0;
+    mesh.vertices.row(base + 6) << 1.0, 0.0, 0.0;   // 边(1,0)-(1,1)上的第三个面，面积最小
+    mesh.vertices.row(base + 7) << 1.0, 1.0, 0.0;
+    mesh.vertices.row(base + 8) << 1.0, 0.5, 0.1;
+    mesh.faces.conservativeResize(nbFaces + 4, 3);
+    for (int i = 0; i < 3; ++i) {
+        mesh.faces.row(nbFaces + i) << base + 3 * i, base + 3 * i + 1, base + 3 * i + 2;
+    }
+    mesh.faces.row(nbFaces + 3) << 0, 1, base + 9;  // 越界索引
+    mesh.vertices(5, 2) = std::nan("");            // 第二个面的顶点
+    mesh.normals = Eigen::MatrixXd::Zero(mesh.faces.rows(), 3);
+
+    const MeshProcessing::RepairReport report = MeshProcessing::repair(mesh);
+    BOOST_CHECK_EQUAL(report.nonFiniteVertices, 1);
+    BOOST_CHECK_EQUAL(report.invalidFaces, 2);
+    BOOST_CHECK_EQUAL(report.degenerateFaces, 1);
+    BOOST_CHECK_EQUAL(report.duplicateFaces, 1);
+    BOOST_CHECK_EQUAL(report.nonManifoldEdges, 1);
+    BOOST_CHECK_EQUAL(report.nonManifoldFaces, 1);
+    BOOST_CHECK_EQUAL(report.removedFaces(), 5);
+    BOOST_CHECK_EQUAL(report.counts.facesAfter, size_t(nbFaces - 1));
+    BOOST_CHECK_EQUAL(mesh.faces.rows(), nbFaces - 1);
+    BOOST_CHECK_EQUAL(mesh.normals.rows(), mesh.faces.rows());
+    BOOST_CHECK_EQUAL(mesh.vertices.rows(), 3 * (nbFaces - 1));
+    BOOST_CHECK(mesh.vertices.allFinite());
+    BOOST_CHECK(mesh.faces.maxCoeff() < mesh.vertices.rows());
+
+    // 修复后的网格没有缺陷，不再改变
+    const MeshProcessing::RepairReport clean = MeshProcessing::repair(mesh);
+    BOOST_CHECK(!clean.hasChanges());
+    BOOST_CHECK_EQUAL(clean.removedFaces(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(decimate_test)
+{
+    UnifiedModel::MeshData mesh = makeGridSoup(100);
+    MeshProcessing::weldVertices(mesh);
+    const MeshProcessing::Result result = MeshProcessing::decimate(mesh, 0.1);
+    BOOST_CHECK_EQUAL(result.facesBefore, 20000);
+    BOOST_CHECK_EQUAL(result.facesAfter, size_t(mesh.faces.rows()));
+    BOOST_CHECK(result.facesAfter > 1000);
+    BOOST_CHECK(result.facesAfter < 3000);
+    BOOST_CHECK_EQUAL(mesh.normals.rows(), mesh.faces.rows());
+    BOOST_CHECK(mesh.faces.maxCoeff() < mesh.vertices.rows());
+
+    // 比例不在(0, 1)内时不修改网格
+    const MeshProcessing::Result unchanged = MeshProcessing::decimate(mesh, 1.0);
+    BOOST_CHECK_EQUAL(unchanged.facesAfter, unchanged.facesBefore);
+}
+
+BOOST_AUTO_TEST_CASE(compute_normals_test)
+{
+    UnifiedModel::MeshData mesh = makeGridSoup(3);
+    MeshProcessing::weldVertices(mesh);
+    mesh.faces.conservativeResize(mesh.faces.rows() + 1, 3);
+    mesh.faces.row(mesh.faces.rows() - 1) << 0, 0, 1;  // 退化面
+
+    MeshProcessing::computeNormals(mesh);
+    BOOST_CHECK_EQUAL(mesh.normals.rows(), mesh.faces.rows());
+    BOOST_CHECK_CLOSE(mesh.normals(0, 2), 1.0, 1e-9);
+    BOOST_CHECK_EQUAL(mesh.normals.row(mesh.faces.rows() - 1).norm(), 0.0);
+    BOOST_CHECK_EQUAL(mesh.vertexNormals.rows(), mesh.vertices.rows());
+    for (Eigen::Index i = 0; i < mesh.vertexNormals.rows(); ++i) {
+        BOOST_CHECK_CLOSE(mesh.vertexNormals(i, 2), 1.0, 1e-9);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_test)
+{
+    std::ostringstream stream;
+    Utils::JsonWriter json(stream, 0);
+    json.beginObject();
+    json.key("name").value("a\"b\\c\n");
+    json.key("values").beginArray().value(1).value(0.5).value(std::nan("")).value(true).endArray();
+    json.key("empty").beginObject().endObject();
+    json.endObject();
+    BOOST_CHECK_EQUAL(stream.str(), "{\"name\":\"a\\\"b\\\\c\\n\",\"values\":[1,0.5,null,true],\"empty\":{}}");
+}
+
+BOOST_AUTO_TEST_CASE(conversion_pipeline_test)
+{
+    const std::filesystem::path outputDir = std::filesystem::temp_directory_path() / "occt_imgui_conversion";
+    const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() / "occt_imgui_conversion_cache";
+    std::filesystem::remove_all(outputDir);
+    std::filesystem::remove_all(cacheDir);
+
+    ConversionPipeline::Options options;
+    BOOST_REQUIRE(ConversionPipeline::parseFormat("stl", options.format));
+    for (const std::string name : {"weld", "normals"}) {
+        ConversionPipeline::Stage stage;
+        BOOST_REQUIRE(ConversionPipeline::parseStage(name, stage));
+        options.stages.push_back(stage);
+    }
+    ConversionPipeline::Stage stage;
+    BOOST_CHECK(!ConversionPipeline::parseStage("smooth", stage));
+    options.outputDirectory = outputDir.string();
+    options.cache = std::make_shared<ImportCache>(cacheDir.string(), std::uint64_t(64) << 20);
+
+    ConversionPipeline pipeline(options);
+    const std::vector<ConversionPipeline::FileReport> reports =
+        pipeline.convertFiles({MESH_TEST_DATA_DIR "/cube.stl", MESH_TEST_DATA_DIR "/missing.stl"});
+    BOOST_REQUIRE_EQUAL(reports.size(), 2);
+
+    // 立方体：导入、两个处理阶段、写入缓存和导出依次计时
+    const ConversionPipeline::FileReport& report = reports[0];
+    BOOST_CHECK(report.succeeded);
+    BOOST_CHECK(!report.cacheHit);
+    BOOST_CHECK_EQUAL(report.triangles, 12);
+    BOOST_CHECK_EQUAL(report.outputBytes, 84 + 50 * 12);
+    BOOST_CHECK(std::filesystem::exists(report.outputPath));
+    std::vector<std::string> stageNames;
+    for (const auto& timing : report.stages) {
+        stageNames.push_back(timing.name);
+        BOOST_CHECK(timing.seconds >= 0.0);
+    }
+    const std::vector<std::string> expectedStages = {"cache-load", "import", "weld", "normals", "cache-store", "export"};
+    BOOST_CHECK_EQUAL_COLLECTIONS(stageNames.begin(), stageNames.end(), expectedStages.begin(), expectedStages.end());
+    BOOST_CHECK(!reports[1].succeeded);
+
+    // 第二次转换命中缓存，跳过导入与处理阶段
+    const ConversionPipeline::FileReport cached = pipeline.convertFile(MESH_TEST_DATA_DIR "/cube.stl");
+    BOOST_CHECK(cached.succeeded);
+    BOOST_CHECK(cached.cacheHit);
+    BOOST_CHECK_EQUAL(cached.triangles, 12);
+    BOOST_CHECK_EQUAL(cached.stages.size(), 2);
+
+    std::ostringstream json;
+    pipeline.writeJson(json, reports);
+    BOOST_CHECK(json.str().find("\"stageSeconds\"") != std::string::npos);
+    BOOST_CHECK(json.str().find("\"error\": \"Cannot read file\"") != std::string::npos);
+
+    std::filesystem::remove_all(outputDir);
+    std::filesystem::remove_all(cacheDir);
+}
@@ -10,6 +10,10 @@
 #include <TColStd_Array1OfReal.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 
+#include <cmath>
+#include <memory>
+#include <tuple>
+
 // Test fixture for Mesh_DataSource tests
 struct MeshDataSourceFixture {
     MeshDataSourceFixture() {
@@ -224,4 +228,35 @@ BOOST_FIXTURE_TEST_CASE(invalid_inputs_test, MeshDataSourceFixture)
     Standard_Real nx, ny, nz;
     result = dataSource1->GetNormal(F.rows() + 1, 3, nx, ny, nz);
     BOOST_CHECK(!result);
-} 
\ No newline at end of file
+}
+
+// Test construction without copying the buffers
+BOOST_FIXTURE_TEST_CASE(buffer_ownership_test, MeshDataSourceFixture)
+{
+    // 右值构造接管缓冲区
+    Eigen::MatrixXd movedV = V;
+    Eigen::MatrixXi movedF = F;
+    Handle(Mesh_DataSource) moved = new Mesh_DataSource(std::move(movedV), std::move(movedF));
+    BOOST_CHECK_EQUAL(movedV.size(), 0);
+    BOOST_CHECK_EQUAL(moved->GetAllElements().Extent(), F.rows());
+    
+    // 共享构造只持有所有者的引用，数据在原始引用释放后仍然有效
+    auto owner = std::make_shared<std::tuple<Eigen::MatrixXd, Eigen::MatrixXi, Eigen::MatrixXd>>(V, F, N);
+    Handle(Mesh_DataSource) shared =
+        new Mesh_DataSource(owner, std::get<0>(*owner), std::get<1>(*owner), std::get<2>(*owner));
+    BOOST_CHECK_EQUAL(owner.use_count(), 2);
+    owner.reset();
+    
+    TColStd_Array1OfReal coords(1, 9);
+    Standard_Integer nbNodes;
+    MeshVS_EntityType type;
+    BOOST_REQUIRE(shared->GetGeom(1, true, coords, nbNodes, type));
+    BOOST_CHECK_CLOSE(coords(1), V(F(0, 0), 0), 1e-6);
+    BOOST_CHECK_CLOSE(coords(9), V(F(0, 2), 2), 1e-6);
+    
+    Standard_Real nx, ny, nz;
+    BOOST_REQUIRE(shared->GetNormal(1, 3, nx, ny, nz));
+    BOOST_CHECK_CLOSE(std::sqrt(nx * nx + ny * ny + nz * nz), 1.0, 1e-6);
+    BOOST_CHECK(!shared->HasNodeNormals());
+}
+
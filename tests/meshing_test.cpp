@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE Meshing Tests
+#include <boost/test/unit_test.hpp>
+
+#include "model/MeshingJob.h"
+#include "model/ShapeMesher.h"
+#include "model/UnifiedModel.h"
+
+#include <BRepPrimAPI_MakeBox.hxx>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//! Returns the signed volume enclosed by the triangles of a mesh.
+double surfaceVolume(const UnifiedModel::MeshData& theMesh)
+{
+    double aVolume = 0.0;
+    for (Eigen::Index i = 0; i < theMesh.faces.rows(); ++i) {
+        const Eigen::Vector3d a = theMesh.vertices.row(theMesh.faces(i, 0));
+        const Eigen::Vector3d b = theMesh.vertices.row(theMesh.faces(i, 1));
+        const Eigen::Vector3d c = theMesh.vertices.row(theMesh.faces(i, 2));
+        aVolume += a.dot(b.cross(c));
+    }
+    return aVolume / 6.0;
+}
+
+//! Returns the total volume of the tetrahedra of a mesh.
+double tetrahedraVolume(const ShapeMesher::Result& theResult)
+{
+    double aVolume = 0.0;
+    for (Eigen::Index i = 0; i < theResult.tetrahedra.rows(); ++i) {
+        const Eigen::Vector3d a = theResult.volumeNodes.row(theResult.tetrahedra(i, 0));
+        const Eigen::Vector3d b = theResult.volumeNodes.row(theResult.tetrahedra(i, 1));
+        const Eigen::Vector3d c = theResult.volumeNodes.row(theResult.tetrahedra(i, 2));
+        const Eigen::Vector3d d = theResult.volumeNodes.row(theResult.tetrahedra(i, 3));
+        aVolume += std::abs((b - a).dot((c - a).cross(d - a))) / 6.0;
+    }
+    return aVolume;
+}
+}
+
+BOOST_AUTO_TEST_CASE(surface_meshing_test)
+{
+    ShapeMesher::Options options;
+    options.maxSize = 2.0;
+    ShapeMesher mesher(options);
+
+    ImportProgress progress;
+    ShapeMesher::Result result;
+    BOOST_REQUIRE(mesher.mesh(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(), result, &progress));
+    BOOST_CHECK_CLOSE(progress.getFraction(), 1.0, 1e-9);
+
+    // 每个面至少剖分为 5x5 个单元，表面封闭且法向朝外
+    const UnifiedModel::MeshData& surface = result.surface;
+    BOOST_CHECK(surface.faces.rows() >= 6 * 2 * 25);
+    BOOST_CHECK_EQUAL(surface.normals.rows(), surface.faces.rows());
+    BOOST_CHECK(surface.faces.maxCoeff() < surface.vertices.rows());
+    BOOST_CHECK_CLOSE(surfaceVolume(surface), 1000.0, 1e-6);
+    BOOST_CHECK_EQUAL(result.tetrahedra.rows(), 0);
+
+    // 空形状无法剖分
+    BOOST_CHECK(!mesher.mesh(TopoDS_Shape(), result));
+}
+
+BOOST_AUTO_TEST_CASE(volume_meshing_test)
+{
+    ShapeMesher::Options options;
+    options.maxSize = 2.5;
+    options.volume = true;
+    ShapeMesher::Result result;
+    BOOST_REQUIRE(ShapeMesher(options).mesh(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(), result));
+
+    BOOST_CHECK(result.tetrahedra.rows() > 0);
+    BOOST_CHECK(result.tetrahedra.maxCoeff() < result.volumeNodes.rows());
+    BOOST_CHECK_CLOSE(tetrahedraVolume(result), 1000.0, 1e-6);
+    BOOST_CHECK_CLOSE(surfaceVolume(result.surface), 1000.0, 1e-6);
+
+    // 每个四面体成为四个朝外的三角形，各自围成的体积之和即为实体体积
+    const UnifiedModel::MeshData volumeMesh = ShapeMesher::makeVolumeMesh(result);
+    BOOST_CHECK_EQUAL(volumeMesh.faces.rows(), 4 * result.tetrahedra.rows());
+    BOOST_CHECK_EQUAL(volumeMesh.normals.rows(), volumeMesh.faces.rows());
+    BOOST_CHECK_CLOSE(surfaceVolume(volumeMesh), 1000.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(meshing_job_test)
+{
+    UnifiedModel model;
+    model.addAssembly("asm");
+    model.addShape("box", BRepPrimAPI_MakeBox(10.0, 20.0, 30.0).Shape());
+    model.setParent("box", "asm");
+    model.setName("box", "Box");
+    model.addMesh("tri", Eigen::MatrixXd::Identity(3, 3), (Eigen::MatrixXi(1, 3) << 0, 1, 2).finished());
+
+    // 非形状实体被忽略
+    MeshingJob job(model, {"box", "tri", "missing"});
+    BOOST_CHECK_EQUAL(job.getShapeCount(), 1);
+    job.start();
+    while (!job.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_CLOSE(job.getFraction(), 1.0, 1e-9);
+
+    const std::vector<std::string> meshIds = job.commit(model);
+    BOOST_REQUIRE_EQUAL(meshIds.size(), 1);
+    BOOST_CHECK_EQUAL(meshIds[0], "box_mesh");
+    BOOST_CHECK(model.getGeometryType("box_mesh") == UnifiedModel::GeometryType::MESH);
+    BOOST_CHECK_EQUAL(model.getName("box_mesh"), "Box (mesh)");
+    BOOST_CHECK_EQUAL(model.getParentId("box_mesh"), "asm");
+    BOOST_CHECK(model.getMesh("box_mesh")->faces.rows() > 0);
+
+    // 体网格作为第二个实体加在形状旁边
+    ShapeMesher::Options volumeOptions;
+    volumeOptions.volume = true;
+    MeshingJob volumeJob(model, {"box"}, volumeOptions);
+    volumeJob.start();
+    while (!volumeJob.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const std::vector<std::string> volumeIds = volumeJob.commit(model);
+    BOOST_REQUIRE_EQUAL(volumeIds.size(), 2);
+    BOOST_CHECK_EQUAL(volumeIds[0], "box_mesh2");
+    BOOST_CHECK_EQUAL(volumeIds[1], "box_volume");
+    BOOST_CHECK_EQUAL(model.getName("box_volume"), "Box (volume mesh)");
+    BOOST_CHECK_EQUAL(model.getParentId("box_volume"), "asm");
+    BOOST_CHECK_CLOSE(surfaceVolume(*model.getMesh("box_volume")), 6000.0, 1e-6);
+
+    // 取消的任务不向模型添加网格
+    MeshingJob cancelled(model, {"box"});
+    cancelled.cancel();
+    cancelled.start();
+    BOOST_CHECK(cancelled.commit(model).empty());
+    BOOST_CHECK(model.getGeometryData("box_mesh3") == nullptr);
+}
@@ -0,0 +1,220 @@
+#define BOOST_TEST_MODULE ModelArchive Tests
+#include <boost/test/unit_test.hpp>
+
+#include "model/ImportCache.h"
+#include "model/ModelArchive.h"
+#include "model/ModelImporter.h"
+#include "model/UnifiedModel.h"
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepTools.hxx>
+#include <Precision.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <gp_Trsf.hxx>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace
+{
+std::string tempArchivePath(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / (name + ModelArchive::FILE_EXTENSION)).string();
+}
+}
+
+BOOST_AUTO_TEST_CASE(archive_round_trip_test)
+{
+    // 装配体：两个共享同一TShape的实例（带子形状颜色、图层和三角剖分）以及一个带顶点颜色的网格
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 20.0, 30.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.5);
+    gp_Trsf offset;
+    offset.SetTranslation(gp_Vec(50.0, 0.0, 0.0));
+
+    UnifiedModel model;
+    model.addAssembly("asm");
+    model.setName("asm", "Assembly");
+    model.addShape("asm/1", box);
+    model.addShape("asm/2", box.Moved(TopLoc_Location(offset)));
+    for (const std::string id : {"asm/1", "asm/2"}) {
+        model.setParent(id, "asm");
+        model.setName(id, "Box");
+        model.setColor(id, Quantity_Color(Quantity_NOC_RED));
+        model.setInstanceKey(id, "part:box");
+        model.setLayers(id, {"Layer A", "Layer B"});
+    }
+    TopExp_Explorer faceExp(box, TopAbs_FACE);
+    model.setSubShapeColors("asm/2", {{faceExp.Current(), Quantity_Color(Quantity_NOC_BLUE1)}});
+
+    UnifiedModel::MeshData mesh;
+    mesh.vertices.resize(3, 3);
+    mesh.vertices << 0, 0, 0, 1, 0, 0, 0, 1, 0;
+    mesh.faces.resize(1, 3);
+    mesh.faces << 0, 1, 2;
+    mesh.normals.resize(1, 3);
+    mesh.normals << 0, 0, 1;
+    mesh.vertexColors = Eigen::MatrixXd::Constant(3, 3, 0.5);
+    model.addMesh("scan", std::move(mesh));
+
+    const std::string archivePath = tempArchivePath("occt_imgui_round_trip");
+    ModelArchive archive;
+    BOOST_REQUIRE(archive.save(model, archivePath));
+
+    UnifiedModel loaded;
+    BOOST_REQUIRE(archive.load(archivePath, loaded));
+    std::filesystem::remove(archivePath);
+
+    // 层次结构与属性
+    BOOST_CHECK_EQUAL(loaded.getEntityCount(), 4);
+    BOOST_REQUIRE_EQUAL(loaded.getChildIds("asm").size(), 2);
+    BOOST_CHECK_EQUAL(loaded.getChildIds("asm")[0], "asm/1");
+    BOOST_CHECK_EQUAL(loaded.getName("asm"), "Assembly");
+    BOOST_CHECK_EQUAL(loaded.getName("asm/2"), "Box");
+    BOOST_CHECK(loaded.getColor("asm/1").IsEqual(Quantity_Color(Quantity_NOC_RED)));
+    const UnifiedModel::GeometryData* instance = loaded.getGeometryData("asm/2");
+    BOOST_REQUIRE(instance != nullptr);
+    BOOST_CHECK_EQUAL(instance->instanceKey, "part:box");
+    BOOST_CHECK_EQUAL(instance->layers.size(), 2);
+    BOOST_REQUIRE_EQUAL(instance->subShapeColors.size(), 1);
+    BOOST_CHECK_EQUAL(instance->subShapeColors[0].subShape.ShapeType(), TopAbs_FACE);
+    BOOST_CHECK(instance->subShapeColors[0].color.IsEqual(Quantity_Color(Quantity_NOC_BLUE1)));
+
+    // 实例共享TShape、保留位置和三角剖分
+    const TopoDS_Shape first = loaded.getShape("asm/1");
+    const TopoDS_Shape second = loaded.getShape("asm/2");
+    BOOST_CHECK(first.TShape() == second.TShape());
+    BOOST_CHECK(second.Location().Transformation().TranslationPart().IsEqual(gp_XYZ(50.0, 0.0, 0.0), 1e-9));
+    BOOST_CHECK(BRepTools::Triangulation(first, Precision::Infinite()));
+
+    // 网格缓冲区逐字节一致
+    const UnifiedModel::MeshData* loadedMesh = loaded.getMesh("scan");
+    BOOST_REQUIRE(loadedMesh != nullptr);
+    BOOST_CHECK(loadedMesh->vertices == model.getMesh("scan")->vertices);
+    BOOST_CHECK(loadedMesh->faces == model.getMesh("scan")->faces);
+    BOOST_CHECK(loadedMesh->normals == model.getMesh("scan")->normals);
+    BOOST_CHECK_EQUAL(loadedMesh->vertexNormals.rows(), 0);
+    BOOST_CHECK(loadedMesh->vertexColors == model.getMesh("scan")->vertexColors);
+}
+
+BOOST_AUTO_TEST_CASE(archive_reopen_time_test)
+{
+    // 导入STEP（含三角剖分）与重新打开存档的耗时对比
+    UnifiedModel imported;
+    ModelImporter importer;
+    const auto importStart = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", imported));
+    const double importSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - importStart).count();
+
+    const std::string archivePath = tempArchivePath("occt_imgui_reopen");
+    ModelArchive archive;
+    BOOST_REQUIRE(archive.save(imported, archivePath));
+
+    UnifiedModel reopened;
+    const auto loadStart = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(archive.load(archivePath, reopened));
+    const double loadSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+    std::filesystem::remove(archivePath);
+
+    BOOST_TEST_MESSAGE("STEP import: " << importSeconds << " s, archive load: " << loadSeconds << " s");
+    BOOST_CHECK_EQUAL(reopened.getEntityCount(), imported.getEntityCount());
+    BOOST_CHECK_EQUAL(reopened.getName("ANC101"), imported.getName("ANC101"));
+    BOOST_CHECK(BRepTools::Triangulation(reopened.getShape("ANC101"), Precision::Infinite()));
+    BOOST_CHECK_LT(loadSeconds, importSeconds);
+}
+
+BOOST_AUTO_TEST_CASE(archive_invalid_file_test)
+{
+    // 非存档文件读取失败，且不修改模型
+    UnifiedModel model;
+    model.addAssembly("existing");
+    ModelArchive archive;
+    BOOST_CHECK(!archive.load(MESH_TEST_DATA_DIR "/unsupported.xyz", model));
+    BOOST_CHECK(!archive.load(MESH_TEST_DATA_DIR "/missing.oimodel", model));
+    BOOST_CHECK_EQUAL(model.getEntityCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(import_cache_hit_test)
+{
+    const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() / "occt_imgui_cache_hit";
+    std::filesystem::remove_all(cacheDir);
+    auto cache = std::make_shared<ImportCache>(cacheDir.string(), std::uint64_t(1) << 30);
+
+    ModelImporter importer;
+    importer.setImportCache(cache);
+
+    // 第一次导入未命中并写入缓存，第二次以新ID命中
+    UnifiedModel first;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", first, "first"));
+    BOOST_CHECK_EQUAL(cache->getStats().misses, 1);
+    BOOST_CHECK_EQUAL(cache->getStats().stores, 1);
+
+    UnifiedModel second;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", second, "second"));
+    BOOST_CHECK_EQUAL(cache->getStats().hits, 1);
+    BOOST_CHECK_EQUAL(second.getEntityCount(), first.getEntityCount());
+    BOOST_CHECK(!second.getShape("second").IsNull());
+    BOOST_CHECK(BRepTools::Triangulation(second.getShape("second"), Precision::Infinite()));
+
+    // 剖分设置改变时键也随之改变
+    const std::string key = cache->makeKey(MESH_TEST_DATA_DIR "/ANC101.stp", "a");
+    BOOST_CHECK_EQUAL(key.size(), 32);
+    BOOST_CHECK_EQUAL(key, cache->makeKey(MESH_TEST_DATA_DIR "/ANC101.stp", "a"));
+    BOOST_CHECK_NE(key, cache->makeKey(MESH_TEST_DATA_DIR "/ANC101.stp", "b"));
+    BOOST_CHECK(cache->makeKey(MESH_TEST_DATA_DIR "/missing.stp", "a").empty());
+
+    ModelImporter::TessellationOptions options;
+    options.deviationCoefficient = 0.01;
+    importer.setTessellationOptions(options);
+    UnifiedModel third;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", third, "third"));
+    BOOST_CHECK_EQUAL(cache->getStats().misses, 2);
+
+    std::filesystem::remove_all(cacheDir);
+}
+
+BOOST_AUTO_TEST_CASE(import_cache_eviction_test)
+{
+    const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() / "occt_imgui_cache_lru";
+    std::filesystem::remove_all(cacheDir);
+    ImportCache cache(cacheDir.string(), std::uint64_t(1) << 30);
+
+    UnifiedModel model;
+    UnifiedModel::MeshData mesh;
+    mesh.vertices = Eigen::MatrixXd::Random(10000, 3);
+    mesh.faces = Eigen::MatrixXi::Zero(1, 3);
+    model.addMesh("mesh", std::move(mesh));
+
+    // 写入三个条目，并在"a"被访问后把上限缩小到两个条目
+    BOOST_REQUIRE(cache.store("a", model));
+    BOOST_REQUIRE(cache.store("b", model));
+    BOOST_REQUIRE(cache.store("c", model));
+    const std::uint64_t entryBytes = cache.getStats().sizeBytes / 3;
+    const auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    std::filesystem::last_write_time(cacheDir / (std::string("a") + ModelArchive::FILE_EXTENSION), past);
+    std::filesystem::last_write_time(cacheDir / (std::string("b") + ModelArchive::FILE_EXTENSION), past);
+    std::filesystem::last_write_time(cacheDir / (std::string("c") + ModelArchive::FILE_EXTENSION), past);
+
+    UnifiedModel hit;
+    BOOST_REQUIRE(cache.load("a", hit, "renamed"));
+    BOOST_CHECK(hit.getMesh("renamed") != nullptr);
+    cache.setMaxBytes(entryBytes * 2 + entryBytes / 2);
+
+    const ImportCache::Stats stats = cache.getStats();
+    BOOST_CHECK_EQUAL(stats.evictions, 1);
+    BOOST_CHECK_LE(stats.sizeBytes, cache.getMaxBytes());
+    UnifiedModel probe;
+    BOOST_CHECK(cache.load("a", probe, "a"));
+    BOOST_CHECK_EQUAL(cache.getStats().misses, 0);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.getStats().sizeBytes, 0);
+    BOOST_CHECK(!cache.load("b", probe, "b"));
+    std::filesystem::remove_all(cacheDir);
+}
@@ -2,11 +2,48 @@
 #include <boost/test/unit_test.hpp>
 
 #include "model/ModelImporter.h"
+#include "model/ModelExporter.h"
+#include "model/ImportJob.h"
+#include "model/ImportRecord.h"
+#include "model/ObjReader.h"
+#include "model/PlyReader.h"
+#include "model/StlReader.h"
 #include "model/UnifiedModel.h"
+#include "ais/Mesh_DataSource.h"
+#include "utils/Parallel.h"
+#include "utils/ProcessMemory.h"
 
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <Bnd_Box.hxx>
+#include <Message_ProgressRange.hxx>
+#include <RWGltf_CafWriter.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <BRepTools.hxx>
+#include <Precision.hxx>
+#include <STEPCAFControl_Writer.hxx>
+#include <STEPControl_Writer.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDocStd_Document.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <igl/readOBJ.h>
+#include <igl/read_triangle_mesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <chrono>
+#include <thread>
+#include <set>
 
 BOOST_AUTO_TEST_CASE(supported_extensions_test)
 {
@@ -18,9 +55,12 @@ BOOST_AUTO_TEST_CASE(supported_extensions_test)
     BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".stp") != extensions.end());
     BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".stl") != extensions.end());
     BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".obj") != extensions.end());
+    BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".ply") != extensions.end());
+    BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".gltf") != extensions.end());
+    BOOST_CHECK(std::find(extensions.begin(), extensions.end(), ".glb") != extensions.end());
     
     // 验证扩展名数量
-    BOOST_CHECK_EQUAL(extensions.size(), 4);
+    BOOST_CHECK_EQUAL(extensions.size(), 7);
 }
 
 BOOST_AUTO_TEST_CASE(import_step_file_test)
@@ -172,4 +212,1064 @@ BOOST_AUTO_TEST_CASE(import_unsupported_format_test)
     // 验证导入失败
     BOOST_CHECK(!result);
     BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 0);
-} 
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(import_step_multiple_roots_test)
+{
+    // 写出一个包含两个独立根实体的STEP文件
+    std::filesystem::path step_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_two_roots.step";
+    
+    STEPControl_Writer writer;
+    writer.Transfer(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(), STEPControl_AsIs);
+    writer.Transfer(BRepPrimAPI_MakeBox(gp_Pnt(20.0, 0.0, 0.0), 5.0, 5.0, 5.0).Shape(),
+                    STEPControl_AsIs);
+    BOOST_REQUIRE(writer.Write(step_file_path.string().c_str()) == IFSelect_RetDone);
+    
+    auto model = std::make_shared<UnifiedModel>();
+    ModelImporter importer;
+    BOOST_CHECK(importer.importModel(step_file_path.string(), *model, "two_roots"));
+    
+    // 每个根实体成为装配节点下的独立零件
+    BOOST_CHECK(model->getGeometryType("two_roots") == UnifiedModel::GeometryType::ASSEMBLY);
+    const auto& children = model->getChildIds("two_roots");
+    BOOST_REQUIRE_EQUAL(children.size(), 2);
+    for (const auto& childId : children) {
+        BOOST_CHECK(model->getGeometryType(childId) == UnifiedModel::GeometryType::SHAPE);
+        BOOST_CHECK_EQUAL(model->getParentId(childId), "two_roots");
+    }
+    BOOST_CHECK_EQUAL(model->getRootIds().size(), 1);
+    
+    std::filesystem::remove(step_file_path);
+}
+
+namespace
+{
+// 用XDE写出多个根实体：若干独立零件，以及若干各使用两次一个零件的顶层装配体。
+// isShared为真时所有装配体使用同一个零件，否则每个装配体有自己的零件
+std::filesystem::path writeStepRoots(const std::string& fileName, int nbParts, int nbAssemblies, bool isShared)
+{
+    Handle(TDocStd_Document) document = new TDocStd_Document("MDTV-XCAF");
+    XCAFDoc_DocumentTool::Set(document->Main(), Standard_False);
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+    
+    for (int i = 0; i < nbParts; ++i) {
+        const gp_Pnt center(30.0 * (i % 8), 30.0 * (i / 8), 0.0);
+        const TopoDS_Shape shape = (i % 2 == 0) ? BRepPrimAPI_MakeSphere(center, 5.0 + i % 5).Shape()
+                                                : BRepPrimAPI_MakeBox(center, 10.0, 5.0 + i % 7, 8.0).Shape();
+        shapeTool->AddShape(shape, false);
+    }
+    TDF_Label partLabel;
+    for (int i = 0; i < nbAssemblies; ++i) {
+        if (partLabel.IsNull() || !isShared) {
+            partLabel = shapeTool->AddShape(BRepPrimAPI_MakeBox(10.0, 10.0, 5.0 + i).Shape(), false);
+        }
+        const TDF_Label assemblyLabel = shapeTool->NewShape();
+        for (int j = 0; j < 2; ++j) {
+            gp_Trsf placement;
+            placement.SetTranslation(gp_Vec(20.0 * j, 100.0 + 20.0 * i, 0.0));
+            shapeTool->AddComponent(assemblyLabel, partLabel, TopLoc_Location(placement));
+        }
+    }
+    shapeTool->UpdateAssemblies();
+    
+    const std::filesystem::path step_file_path = std::filesystem::temp_directory_path() / fileName;
+    STEPCAFControl_Writer writer;
+    BOOST_REQUIRE(writer.Transfer(document, STEPControl_AsIs));
+    BOOST_REQUIRE(writer.Write(step_file_path.string().c_str()) == IFSelect_RetDone);
+    return step_file_path;
+}
+
+// 用基本读取器导入，不剖分；返回并行转换的文件数
+size_t importStepRoots(const std::filesystem::path& step_file_path,
+                       ModelImporter::StepTransferMode mode,
+                       UnifiedModel& model)
+{
+    ModelImporter::TessellationOptions noTessellation;
+    noTessellation.enabled = false;
+    ModelImporter importer;
+    importer.setStepReaderMode(ModelImporter::StepReaderMode::BASIC);
+    importer.setStepTransferMode(mode);
+    importer.setTessellationOptions(noTessellation);
+    const auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK(importer.importModel(step_file_path.string(), model, "roots"));
+    BOOST_TEST_MESSAGE("STEP import of " << step_file_path.filename().string() << " ("
+                       << (mode == ModelImporter::StepTransferMode::PARALLEL ? "parallel" : "serial") << "): "
+                       << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                       << " s on " << std::thread::hardware_concurrency() << " threads");
+    return importer.getParallelStepTransferCount();
+}
+
+// 统计模型中的形状数，并收集它们引用的TShape
+size_t collectShapes(const UnifiedModel& model, std::set<const TopoDS_TShape*>& tshapes)
+{
+    size_t nbShapes = 0;
+    for (const auto& entity : model.getEntities()) {
+        if (entity.second.type == UnifiedModel::GeometryType::SHAPE) {
+            tshapes.insert(std::get<TopoDS_Shape>(entity.second.geometry).TShape().get());
+            ++nbShapes;
+        }
+    }
+    return nbShapes;
+}
+
+// 两次导入得到相同的根实体（顺序、类型、包围盒），形状数量和TShape共享相同
+void checkSameRoots(const UnifiedModel& serialModel,
+                    const UnifiedModel& parallelModel,
+                    size_t nbRoots,
+                    size_t nbShapes,
+                    size_t nbTShapes)
+{
+    const auto& serialChildren = serialModel.getChildIds("roots");
+    const auto& parallelChildren = parallelModel.getChildIds("roots");
+    BOOST_REQUIRE_EQUAL(serialChildren.size(), nbRoots);
+    BOOST_REQUIRE_EQUAL(parallelChildren.size(), serialChildren.size());
+    for (size_t i = 0; i < serialChildren.size(); ++i) {
+        BOOST_CHECK_EQUAL(parallelChildren[i], serialChildren[i]);
+        BOOST_REQUIRE(parallelModel.getGeometryType(parallelChildren[i])
+                      == serialModel.getGeometryType(serialChildren[i]));
+        if (serialModel.getGeometryType(serialChildren[i]) != UnifiedModel::GeometryType::SHAPE) {
+            BOOST_CHECK_EQUAL(parallelModel.getChildIds(parallelChildren[i]).size(),
+                              serialModel.getChildIds(serialChildren[i]).size());
+            continue;
+        }
+        Bnd_Box serialBox;
+        Bnd_Box parallelBox;
+        BRepBndLib::Add(serialModel.getShape(serialChildren[i]), serialBox);
+        BRepBndLib::Add(parallelModel.getShape(parallelChildren[i]), parallelBox);
+        BOOST_CHECK_SMALL(serialBox.CornerMin().Distance(parallelBox.CornerMin()), 1e-6);
+        BOOST_CHECK_SMALL(serialBox.CornerMax().Distance(parallelBox.CornerMax()), 1e-6);
+    }
+    
+    std::set<const TopoDS_TShape*> serialShapes;
+    std::set<const TopoDS_TShape*> parallelShapes;
+    BOOST_CHECK_EQUAL(collectShapes(serialModel, serialShapes), nbShapes);
+    BOOST_CHECK_EQUAL(serialShapes.size(), nbTShapes);
+    BOOST_CHECK_EQUAL(collectShapes(parallelModel, parallelShapes), nbShapes);
+    BOOST_CHECK_EQUAL(parallelShapes.size(), nbTShapes);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(import_step_parallel_transfer_test)
+{
+    // 根实体互不共享零件：每个装配体内部的两个实例仍共享同一个TShape
+    const int nbParts = 16;
+    const int nbAssemblies = 8;
+    const std::filesystem::path step_file_path =
+        writeStepRoots("occt_imgui_independent_roots.step", nbParts, nbAssemblies, false);
+    
+    UnifiedModel serialModel;
+    UnifiedModel parallelModel;
+    BOOST_CHECK_EQUAL(importStepRoots(step_file_path, ModelImporter::StepTransferMode::SERIAL, serialModel), 0u);
+    const size_t nbParallel =
+        importStepRoots(step_file_path, ModelImporter::StepTransferMode::PARALLEL, parallelModel);
+    std::filesystem::remove(step_file_path);
+    
+    // 只有一个硬件线程时不会并行转换
+    if (Utils::getParallelThreadCount() > 1) {
+        BOOST_CHECK_EQUAL(nbParallel, 1u);
+    }
+    else {
+        BOOST_TEST_MESSAGE("Single hardware thread, the parallel transfer was not exercised");
+        BOOST_CHECK_EQUAL(nbParallel, 0u);
+    }
+    checkSameRoots(serialModel, parallelModel, size_t(nbParts + nbAssemblies),
+                   size_t(nbParts + 2 * nbAssemblies), size_t(nbParts + nbAssemblies));
+}
+
+BOOST_AUTO_TEST_CASE(import_step_shared_roots_fallback_test)
+{
+    // 所有装配体使用同一个零件：改为串行转换，零件的所有实例只对应一个TShape
+    const int nbParts = 16;
+    const int nbAssemblies = 8;
+    const std::filesystem::path step_file_path =
+        writeStepRoots("occt_imgui_shared_roots.step", nbParts, nbAssemblies, true);
+    
+    UnifiedModel serialModel;
+    UnifiedModel parallelModel;
+    importStepRoots(step_file_path, ModelImporter::StepTransferMode::SERIAL, serialModel);
+    BOOST_CHECK_EQUAL(importStepRoots(step_file_path, ModelImporter::StepTransferMode::PARALLEL, parallelModel), 0u);
+    std::filesystem::remove(step_file_path);
+    
+    checkSameRoots(serialModel, parallelModel, size_t(nbParts + nbAssemblies),
+                   size_t(nbParts + 2 * nbAssemblies), size_t(nbParts + 1));
+}
+
+BOOST_AUTO_TEST_CASE(import_progress_test)
+{
+    auto model = std::make_shared<UnifiedModel>();
+    ModelImporter importer;
+    
+    // 正常导入后进度为1
+    ImportProgress progress;
+    BOOST_CHECK(importer.importModel(MESH_TEST_DATA_DIR "/bunny.obj", *model, "", progress));
+    BOOST_CHECK_CLOSE(progress.getFraction(), 1.0, 1e-9);
+    
+    // 已取消的导入不会向模型添加任何内容
+    ImportProgress cancelled;
+    cancelled.cancel();
+    BOOST_CHECK(!importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", *model, "", cancelled));
+    BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(import_job_test)
+{
+    auto model = std::make_shared<UnifiedModel>();
+    auto importer = std::make_shared<ModelImporter>();
+    
+    std::vector<std::string> notified;
+    model->addChangeListener([&notified](const std::string& id) { notified.push_back(id); });
+    
+    ImportJob job(importer, {MESH_TEST_DATA_DIR "/cube.stl", MESH_TEST_DATA_DIR "/ANC101.stp"});
+    job.start();
+    while (!job.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    
+    // 工作线程只写暂存模型，提交前目标模型保持不变
+    BOOST_CHECK(notified.empty());
+    BOOST_CHECK_CLOSE(job.getFraction(), 1.0, 1e-9);
+    
+    BOOST_CHECK_EQUAL(job.commit(*model), 2);
+    BOOST_CHECK(model->getGeometryType("cube") == UnifiedModel::GeometryType::MESH);
+    BOOST_CHECK(model->getGeometryType("ANC101") == UnifiedModel::GeometryType::SHAPE);
+    BOOST_CHECK_EQUAL(notified.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(import_job_cancel_test)
+{
+    auto model = std::make_shared<UnifiedModel>();
+    auto importer = std::make_shared<ModelImporter>();
+    
+    ImportJob job(importer, {MESH_TEST_DATA_DIR "/ANC101.stp", MESH_TEST_DATA_DIR "/bunny.obj"});
+    job.start();
+    job.cancel();
+    
+    // 取消后不提交任何几何
+    BOOST_CHECK_EQUAL(job.commit(*model), 0);
+    BOOST_CHECK(job.isCancelled());
+    BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(import_preview_stream_test)
+{
+    // 流式预览覆盖全部三角形，且不改变读取结果
+    for (const std::string path : {MESH_TEST_DATA_DIR "/cube.stl", MESH_TEST_DATA_DIR "/bunny.obj"}) {
+        ModelImporter importer;
+        UnifiedModel plain;
+        ImportProgress plainProgress;
+        BOOST_REQUIRE(importer.importModel(path, plain, "mesh", plainProgress));
+        BOOST_CHECK_EQUAL(plainProgress.takePreview().getTriangleCount(), 0);
+        
+        UnifiedModel streamed;
+        ImportProgress streamedProgress;
+        streamedProgress.setPreviewEnabled(true);
+        BOOST_REQUIRE(importer.importModel(path, streamed, "mesh", streamedProgress));
+        const MeshPreviewChunk preview = streamedProgress.takePreview();
+        BOOST_CHECK_EQUAL(preview.getTriangleCount(), size_t(plain.getMesh("mesh")->faces.rows()));
+        BOOST_CHECK_EQUAL(preview.positions.size(), preview.getTriangleCount() * 9);
+        BOOST_CHECK(streamed.getMesh("mesh")->vertices == plain.getMesh("mesh")->vertices);
+        BOOST_CHECK(streamed.getMesh("mesh")->faces == plain.getMesh("mesh")->faces);
+        BOOST_CHECK(streamed.getMesh("mesh")->normals == plain.getMesh("mesh")->normals);
+        BOOST_CHECK_EQUAL(streamedProgress.takePreview().getTriangleCount(), 0);
+        
+        // 预览三角形不超过上限，读取结果不受影响
+        UnifiedModel limited;
+        ImportProgress limitedProgress;
+        limitedProgress.setPreviewEnabled(true);
+        limitedProgress.setPreviewTriangleLimit(5);
+        BOOST_REQUIRE(importer.importModel(path, limited, "mesh", limitedProgress));
+        const MeshPreviewChunk limitedPreview = limitedProgress.takePreview();
+        BOOST_CHECK_EQUAL(limitedPreview.getTriangleCount(), 5);
+        BOOST_CHECK_EQUAL(limitedPreview.positions.size(), 45);
+        BOOST_CHECK(!limitedProgress.isPreviewEnabled());
+        BOOST_CHECK(limited.getMesh("mesh")->faces == plain.getMesh("mesh")->faces);
+    }
+    
+    // 导入任务按文件收集预览
+    auto importer = std::make_shared<ModelImporter>();
+    ModelImporter::BatchOptions options;
+    options.streamPreview = true;
+    ImportJob job(importer, {MESH_TEST_DATA_DIR "/cube.stl"}, options);
+    job.start();
+    while (!job.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const std::vector<MeshPreviewChunk> previews = job.takePreviews();
+    BOOST_REQUIRE_EQUAL(previews.size(), 1);
+    BOOST_CHECK_EQUAL(previews[0].getTriangleCount(), 12);
+    
+    // 任务的预览上限由各文件平分
+    options.previewTriangleLimit = 10;
+    ImportJob limitedJob(importer, {MESH_TEST_DATA_DIR "/cube.stl", MESH_TEST_DATA_DIR "/cube.stl"}, options);
+    limitedJob.start();
+    while (!limitedJob.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (const MeshPreviewChunk& preview : limitedJob.takePreviews()) {
+        BOOST_CHECK_EQUAL(preview.getTriangleCount(), 5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(import_batch_test)
+{
+    UnifiedModel model;
+    ModelImporter importer;
+    
+    std::vector<std::string> notified;
+    model.addChangeListener([&notified](const std::string& id) { notified.push_back(id); });
+    
+    // 1字节预算：每次只允许一个文件在读取，验证预算不会导致死锁
+    ModelImporter::BatchOptions options;
+    options.workerCount = 4;
+    options.memoryBudgetBytes = 1;
+    
+    ModelImporter::BatchStats stats = importer.importBatch({MESH_TEST_DATA_DIR "/cube.stl",
+                                                            MESH_TEST_DATA_DIR "/cube.obj",
+                                                            MESH_TEST_DATA_DIR "/ANC101.stp",
+                                                            MESH_TEST_DATA_DIR "/unsupported.xyz"},
+                                                           model,
+                                                           options);
+    
+    BOOST_CHECK_EQUAL(stats.filesRequested, 4);
+    BOOST_CHECK_EQUAL(stats.filesImported, 3);
+    BOOST_CHECK_EQUAL(stats.partsImported, 3);
+    BOOST_CHECK(stats.bytesRead > 0);
+    BOOST_CHECK(stats.seconds > 0.0);
+    
+    // 同名文件在批次内获得唯一ID
+    BOOST_CHECK(model.getGeometryType("cube") == UnifiedModel::GeometryType::MESH);
+    BOOST_CHECK(model.getGeometryType("cube_2") == UnifiedModel::GeometryType::MESH);
+    BOOST_CHECK(model.getGeometryType("ANC101") == UnifiedModel::GeometryType::SHAPE);
+    BOOST_CHECK_EQUAL(notified.size(), 3);
+    
+    // 目录扫描只返回支持的格式
+    std::vector<std::string> files = importer.collectSupportedFiles(MESH_TEST_DATA_DIR, false);
+    BOOST_CHECK(!files.empty());
+    for (const auto& file : files) {
+        BOOST_CHECK(std::filesystem::path(file).extension() != ".xyz");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(import_step_xde_colors_test)
+{
+    UnifiedModel model;
+    ModelImporter importer;
+    BOOST_CHECK(importer.getStepReaderMode() == ModelImporter::StepReaderMode::XDE);
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101_colored.stp", model));
+    
+    // XDE读取器保留面颜色
+    size_t nbColoredFaces = 0;
+    for (const auto& entity : model.getEntities()) {
+        nbColoredFaces += entity.second.subShapeColors.size();
+    }
+    BOOST_CHECK(nbColoredFaces > 0);
+    
+    // 基本读取器只有几何
+    UnifiedModel basicModel;
+    importer.setStepReaderMode(ModelImporter::StepReaderMode::BASIC);
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101_colored.stp", basicModel));
+    for (const auto& entity : basicModel.getEntities()) {
+        BOOST_CHECK(entity.second.subShapeColors.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(import_step_xde_instancing_test)
+{
+    // 用XDE写出一个装配体：同一个零件放置三次
+    Handle(TDocStd_Document) document = new TDocStd_Document("MDTV-XCAF");
+    XCAFDoc_DocumentTool::Set(document->Main(), Standard_False);
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+    Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+    
+    const TDF_Label partLabel = shapeTool->AddShape(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(), false);
+    TDataStd_Name::Set(partLabel, "Block");
+    colorTool->SetColor(partLabel, Quantity_Color(Quantity_NOC_RED), XCAFDoc_ColorSurf);
+    
+    const TDF_Label assemblyLabel = shapeTool->NewShape();
+    TDataStd_Name::Set(assemblyLabel, "Row");
+    for (int i = 0; i < 3; ++i) {
+        gp_Trsf placement;
+        placement.SetTranslation(gp_Vec(20.0 * i, 0.0, 0.0));
+        shapeTool->AddComponent(assemblyLabel, partLabel, TopLoc_Location(placement));
+    }
+    shapeTool->UpdateAssemblies();
+    
+    std::filesystem::path step_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_instances.step";
+    STEPCAFControl_Writer writer;
+    BOOST_REQUIRE(writer.Transfer(document, STEPControl_AsIs));
+    BOOST_REQUIRE(writer.Write(step_file_path.string().c_str()) == IFSelect_RetDone);
+    
+    UnifiedModel model;
+    ModelImporter importer;
+    auto startTime = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(importer.importModel(step_file_path.string(), model, "row"));
+    const double xdeSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    BOOST_CHECK(model.getGeometryType("row") == UnifiedModel::GeometryType::ASSEMBLY);
+    BOOST_CHECK_EQUAL(model.getName("row"), "Row");
+    const auto& children = model.getChildIds("row");
+    BOOST_REQUIRE_EQUAL(children.size(), 3);
+    
+    // 三个实例共享同一个TShape和实例键，只有位置不同
+    std::set<const TopoDS_TShape*> xdeShapes;
+    const std::string instanceKey = model.getGeometryData(children[0])->instanceKey;
+    BOOST_CHECK(!instanceKey.empty());
+    for (const auto& childId : children) {
+        const UnifiedModel::GeometryData* data = model.getGeometryData(childId);
+        BOOST_CHECK_EQUAL(data->name, "Block");
+        BOOST_CHECK_EQUAL(data->instanceKey, instanceKey);
+        BOOST_CHECK(data->color.IsEqual(Quantity_Color(Quantity_NOC_RED)));
+        xdeShapes.insert(std::get<TopoDS_Shape>(data->geometry).TShape().get());
+    }
+    BOOST_CHECK_EQUAL(xdeShapes.size(), 1);
+    
+    // 与基本读取器比较转换时间和唯一形状数量
+    UnifiedModel basicModel;
+    importer.setStepReaderMode(ModelImporter::StepReaderMode::BASIC);
+    startTime = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(importer.importModel(step_file_path.string(), basicModel, "row"));
+    const double basicSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    std::set<const TopoDS_TShape*> basicShapes;
+    for (const auto& entity : basicModel.getEntities()) {
+        if (entity.second.type == UnifiedModel::GeometryType::SHAPE) {
+            basicShapes.insert(std::get<TopoDS_Shape>(entity.second.geometry).TShape().get());
+        }
+    }
+    BOOST_TEST_MESSAGE("STEP transfer: XDE " << xdeSeconds << " s, " << xdeShapes.size()
+                       << " unique shapes; basic " << basicSeconds << " s, "
+                       << basicShapes.size() << " unique shapes");
+    
+    std::filesystem::remove(step_file_path);
+}
+
+BOOST_AUTO_TEST_CASE(import_gltf_file_test)
+{
+    // 用XDE写出GLB：一个网格放置两次，另一个网格放置一次
+    Handle(TDocStd_Document) document = new TDocStd_Document("MDTV-XCAF");
+    XCAFDoc_DocumentTool::Set(document->Main(), Standard_False);
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+    Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+    
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(5.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.1);
+    BRepMesh_IncrementalMesh(sphere, 0.1);
+    const TDF_Label boxLabel = shapeTool->AddShape(box, false);
+    const TDF_Label sphereLabel = shapeTool->AddShape(sphere, false);
+    TDataStd_Name::Set(boxLabel, "Box");
+    TDataStd_Name::Set(sphereLabel, "Ball");
+    colorTool->SetColor(sphereLabel, Quantity_Color(Quantity_NOC_RED), XCAFDoc_ColorSurf);
+    
+    const TDF_Label sceneLabel = shapeTool->NewShape();
+    TDataStd_Name::Set(sceneLabel, "Scene");
+    for (int i = 0; i < 2; ++i) {
+        gp_Trsf placement;
+        placement.SetTranslation(gp_Vec(20.0 * i, 0.0, 0.0));
+        shapeTool->AddComponent(sceneLabel, boxLabel, TopLoc_Location(placement));
+    }
+    gp_Trsf spherePlacement;
+    spherePlacement.SetTranslation(gp_Vec(0.0, 30.0, 0.0));
+    shapeTool->AddComponent(sceneLabel, sphereLabel, TopLoc_Location(spherePlacement));
+    shapeTool->UpdateAssemblies();
+    
+    std::filesystem::path glb_file_path = std::filesystem::temp_directory_path() / "occt_imgui_scene.glb";
+    RWGltf_CafWriter writer(glb_file_path.string().c_str(), true);
+    writer.ChangeCoordinateSystemConverter().SetInputLengthUnit(0.001);
+    writer.ChangeCoordinateSystemConverter().SetInputCoordinateSystem(RWMesh_CoordinateSystem_Zup);
+    BOOST_REQUIRE(writer.Perform(document, TColStd_IndexedDataMapOfStringString(), Message_ProgressRange()));
+    
+    UnifiedModel model;
+    ModelImporter importer;
+    BOOST_REQUIRE(importer.importModel(glb_file_path.string(), model, "scene"));
+    std::filesystem::remove(glb_file_path);
+    
+    // 节点层次保留；重复的网格作为共享三角剖分的实例，单次放置的网格直接转换为MeshData
+    BOOST_CHECK(model.getGeometryType("scene") == UnifiedModel::GeometryType::ASSEMBLY);
+    const auto& children = model.getChildIds("scene");
+    BOOST_REQUIRE_EQUAL(children.size(), 3);
+    
+    std::vector<std::string> instanceIds;
+    std::string meshId;
+    for (const std::string& id : children) {
+        const UnifiedModel::GeometryData* data = model.getGeometryData(id);
+        BOOST_REQUIRE(data != nullptr);
+        if (data->type == UnifiedModel::GeometryType::SHAPE) {
+            BOOST_CHECK(!data->instanceKey.empty());
+            BOOST_CHECK(BRepTools::Triangulation(model.getShape(id), Precision::Infinite()));
+            instanceIds.push_back(id);
+        }
+        else if (data->type == UnifiedModel::GeometryType::MESH) {
+            meshId = id;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(instanceIds.size(), 2);
+    BOOST_CHECK(model.getShape(instanceIds[0]).TShape() == model.getShape(instanceIds[1]).TShape());
+    BOOST_CHECK_EQUAL(model.getGeometryData(instanceIds[0])->instanceKey,
+                      model.getGeometryData(instanceIds[1])->instanceKey);
+    
+    // 网格坐标换算回毫米且包含放置位置
+    BOOST_REQUIRE(!meshId.empty());
+    BOOST_CHECK_EQUAL(model.getName(meshId), "Ball");
+    BOOST_CHECK(model.getColor(meshId).IsEqual(Quantity_Color(Quantity_NOC_RED)));
+    const UnifiedModel::MeshData* mesh = model.getMesh(meshId);
+    BOOST_REQUIRE(mesh != nullptr);
+    BOOST_CHECK(mesh->faces.rows() > 0);
+    BOOST_CHECK_EQUAL(mesh->normals.rows(), mesh->faces.rows());
+    BOOST_CHECK(mesh->faces.maxCoeff() < mesh->vertices.rows());
+    BOOST_CHECK_CLOSE(mesh->vertices.col(1).maxCoeff() - mesh->vertices.col(1).minCoeff(), 10.0, 1.0);
+    BOOST_CHECK_CLOSE((mesh->vertices.col(1).maxCoeff() + mesh->vertices.col(1).minCoeff()) / 2.0, 30.0, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(export_stl_test)
+{
+    // 两个共享TShape的未剖分长方体实例和一个三角形网格
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    gp_Trsf offset;
+    offset.SetTranslation(gp_Vec(50.0, 0.0, 0.0));
+    
+    UnifiedModel model;
+    model.addAssembly("asm");
+    model.addShape("asm/1", box);
+    model.addShape("asm/2", box.Moved(TopLoc_Location(offset)));
+    for (const std::string id : {"asm/1", "asm/2"}) {
+        model.setParent(id, "asm");
+        model.setInstanceKey(id, "part:box");
+    }
+    Eigen::MatrixXd vertices(3, 3);
+    vertices << 0, 0, 0, 1, 0, 0, 0, 1, 0;
+    Eigen::MatrixXi faces(1, 3);
+    faces << 0, 1, 2;
+    model.addMesh("tri", vertices, faces);
+    
+    // 形状在导出前剖分：每个长方体12个三角形，每个三角形记录50字节
+    const std::filesystem::path stl_file_path = std::filesystem::temp_directory_path() / "occt_imgui_export.stl";
+    ModelExporter exporter;
+    BOOST_REQUIRE(exporter.exportModel(model, stl_file_path.string()));
+    BOOST_CHECK(BRepTools::Triangulation(model.getShape("asm/1"), Precision::Infinite()));
+    BOOST_CHECK_EQUAL(exporter.getLastStats().parts, 3);
+    BOOST_CHECK_EQUAL(exporter.getLastStats().triangles, 25);
+    BOOST_CHECK_EQUAL(std::filesystem::file_size(stl_file_path), 84 + 50 * 25);
+    
+    // 三角形位于放置后的位置
+    UnifiedModel imported;
+    ModelImporter importer;
+    BOOST_REQUIRE(importer.importModel(stl_file_path.string(), imported, "exported"));
+    const UnifiedModel::MeshData* mesh = imported.getMesh("exported");
+    BOOST_REQUIRE(mesh != nullptr);
+    BOOST_CHECK_EQUAL(mesh->faces.rows(), 25);
+    BOOST_CHECK_CLOSE(mesh->vertices.col(0).maxCoeff(), 60.0, 1e-4);
+    
+    // 只导出选中的实例
+    BOOST_REQUIRE(exporter.exportEntities(model, {"asm/2"}, stl_file_path.string()));
+    BOOST_CHECK_EQUAL(std::filesystem::file_size(stl_file_path), 84 + 50 * 12);
+    std::filesystem::remove(stl_file_path);
+    
+    BOOST_CHECK(!exporter.exportModel(model, (std::filesystem::temp_directory_path() / "model.xyz").string()));
+}
+
+BOOST_AUTO_TEST_CASE(export_glb_round_trip_test)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.1);
+    gp_Trsf offset;
+    offset.SetTranslation(gp_Vec(50.0, 0.0, 0.0));
+    
+    UnifiedModel model;
+    model.addAssembly("asm");
+    model.addShape("asm/1", box);
+    model.addShape("asm/2", box.Moved(TopLoc_Location(offset)));
+    for (const std::string id : {"asm/1", "asm/2"}) {
+        model.setParent(id, "asm");
+        model.setName(id, "Box");
+        model.setInstanceKey(id, "part:box");
+    }
+    Eigen::MatrixXd vertices(3, 3);
+    vertices << 0, 0, 0, 1, 0, 0, 0, 1, 0;
+    Eigen::MatrixXi faces(1, 3);
+    faces << 0, 1, 2;
+    model.addMesh("tri", vertices, faces);
+    model.setColor("tri", Quantity_Color(Quantity_NOC_RED));
+    
+    // 实例共用一个glTF网格，二进制块中长方体只写一次
+    const std::filesystem::path glb_file_path = std::filesystem::temp_directory_path() / "occt_imgui_export.glb";
+    ModelExporter exporter;
+    BOOST_REQUIRE(exporter.exportModel(model, glb_file_path.string()));
+    BOOST_CHECK_EQUAL(exporter.getLastStats().parts, 3);
+    BOOST_CHECK_EQUAL(exporter.getLastStats().triangles, 13);
+    
+    UnifiedModel imported;
+    ModelImporter importer;
+    BOOST_REQUIRE(importer.importModel(glb_file_path.string(), imported, "exported"));
+    std::filesystem::remove(glb_file_path);
+    
+    // 重新导入后单位、朝向和实例都与原模型一致
+    std::vector<std::string> instanceIds;
+    std::string meshId;
+    for (const auto& entry : imported.getEntities()) {
+        if (entry.second.type == UnifiedModel::GeometryType::SHAPE) {
+            instanceIds.push_back(entry.first);
+        }
+        else if (entry.second.type == UnifiedModel::GeometryType::MESH) {
+            meshId = entry.first;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(instanceIds.size(), 2);
+    BOOST_CHECK(imported.getShape(instanceIds[0]).TShape() == imported.getShape(instanceIds[1]).TShape());
+    std::set<long> minX;
+    for (const std::string& id : instanceIds) {
+        BOOST_CHECK_EQUAL(imported.getName(id), "Box");
+        Bnd_Box bounds;
+        BRepBndLib::Add(imported.getShape(id), bounds);
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        BOOST_CHECK_CLOSE(zMax - zMin, 10.0, 1.0);
+        minX.insert(std::lround(xMin));
+    }
+    BOOST_CHECK(minX == std::set<long>({0, 50}));
+    
+    BOOST_REQUIRE(!meshId.empty());
+    BOOST_CHECK(imported.getColor(meshId).IsEqual(Quantity_Color(Quantity_NOC_RED)));
+    const UnifiedModel::MeshData* mesh = imported.getMesh(meshId);
+    BOOST_REQUIRE(mesh != nullptr);
+    BOOST_CHECK_EQUAL(mesh->faces.rows(), 1);
+    BOOST_CHECK_CLOSE(mesh->vertices.col(0).maxCoeff(), 1.0, 1e-3);
+    BOOST_CHECK_CLOSE(mesh->vertices.col(1).maxCoeff(), 1.0, 1e-3);
+    BOOST_CHECK_SMALL(mesh->vertices.col(2).cwiseAbs().maxCoeff(), 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(export_empty_scene_test)
+{
+    // 只有装配体和空网格的场景没有可写出的三角形
+    UnifiedModel model;
+    model.addAssembly("asm");
+    model.addMesh("asm/empty", Eigen::MatrixXd(0, 3), Eigen::MatrixXi(0, 3));
+    model.setParent("asm/empty", "asm");
+    
+    ModelExporter exporter;
+    for (const std::string extension : {".glb", ".stl"}) {
+        const std::filesystem::path file_path =
+            std::filesystem::temp_directory_path() / ("occt_imgui_empty_export" + extension);
+        std::filesystem::remove(file_path);
+        BOOST_CHECK(!exporter.exportModel(model, file_path.string()));
+        BOOST_CHECK(!exporter.exportEntities(model, {"asm/empty"}, file_path.string()));
+        BOOST_CHECK(!std::filesystem::exists(file_path));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(import_step_tessellation_test)
+{
+    ModelImporter importer;
+    
+    // 默认在导入时完成剖分，显示时无需再计算三角网格
+    UnifiedModel model;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", model));
+    BOOST_CHECK(BRepTools::Triangulation(model.getShape("ANC101"), Precision::Infinite()));
+    
+    // 关闭剖分阶段时形状保持未剖分
+    ModelImporter::TessellationOptions options;
+    options.enabled = false;
+    importer.setTessellationOptions(options);
+    UnifiedModel untessellated;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/ANC101.stp", untessellated));
+    BOOST_CHECK(!BRepTools::Triangulation(untessellated.getShape("ANC101"), Precision::Infinite()));
+}
+
+BOOST_AUTO_TEST_CASE(stl_reader_test)
+{
+    // 二进制STL：与igl::read_triangle_mesh一样合并重复顶点
+    UnifiedModel::MeshData mesh;
+    ImportProgress progress;
+    StlReader reader;
+    BOOST_REQUIRE(reader.read(MESH_TEST_DATA_DIR "/cube.stl", mesh, progress));
+    
+    Eigen::MatrixXd iglVertices;
+    Eigen::MatrixXi iglFaces;
+    BOOST_REQUIRE(igl::read_triangle_mesh(MESH_TEST_DATA_DIR "/cube.stl", iglVertices, iglFaces));
+    BOOST_CHECK_EQUAL(mesh.vertices.rows(), iglVertices.rows());
+    BOOST_CHECK_EQUAL(mesh.faces.rows(), iglFaces.rows());
+    BOOST_CHECK_EQUAL(mesh.normals.rows(), mesh.faces.rows());
+    BOOST_CHECK(mesh.faces.minCoeff() >= 0);
+    BOOST_CHECK(mesh.faces.maxCoeff() < mesh.vertices.rows());
+    
+    // ASCII STL（以"solid"开头）自动识别
+    std::filesystem::path ascii_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_ascii.stl";
+    {
+        std::ofstream file(ascii_file_path);
+        file << "solid quad\n"
+             << " facet normal 0 0 1\n  outer loop\n"
+             << "   vertex 0 0 0\n   vertex 1 0 0\n   vertex 1 1 0\n"
+             << "  endloop\n endfacet\n"
+             << " facet normal 0 0 1\n  outer loop\n"
+             << "   vertex 0 0 0\n   vertex 1 1 0\n   vertex 0 1 0\n"
+             << "  endloop\n endfacet\n"
+             << "endsolid quad\n";
+    }
+    UnifiedModel::MeshData asciiMesh;
+    BOOST_REQUIRE(reader.read(ascii_file_path.string(), asciiMesh, progress));
+    BOOST_CHECK_EQUAL(asciiMesh.faces.rows(), 2);
+    BOOST_CHECK_EQUAL(asciiMesh.vertices.rows(), 4);
+    BOOST_CHECK_CLOSE(asciiMesh.normals(0, 2), 1.0, 1e-9);
+    std::filesystem::remove(ascii_file_path);
+    
+    // 头部以"solid"开头、末尾有附加数据的二进制STL仍按二进制读取；-0.0与+0.0焊接为同一个顶点
+    std::filesystem::path binary_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_solid_header.stl";
+    {
+        const float triangles[2][12] = {{0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f},
+                                        {0.0f, 0.0f, 1.0f, -0.0f, 0.0f, -0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f}};
+        std::string header = "solid exported as binary";
+        header.resize(80, ' ');
+        const std::uint32_t nbTriangles = 2;
+        const std::uint16_t attributes = 0;
+        std::ofstream file(binary_file_path, std::ios::binary);
+        file.write(header.data(), 80);
+        file.write(reinterpret_cast<const char*>(&nbTriangles), sizeof(nbTriangles));
+        for (const auto& triangle : triangles) {
+            file.write(reinterpret_cast<const char*>(triangle), sizeof(triangle));
+            file.write(reinterpret_cast<const char*>(&attributes), sizeof(attributes));
+        }
+        file.write(std::string(16, '\0').data(), 16);
+    }
+    UnifiedModel::MeshData binaryMesh;
+    BOOST_REQUIRE(reader.read(binary_file_path.string(), binaryMesh, progress));
+    BOOST_CHECK_EQUAL(binaryMesh.faces.rows(), 2);
+    BOOST_CHECK_EQUAL(binaryMesh.vertices.rows(), 4);
+    std::filesystem::remove(binary_file_path);
+    
+    // 非STL内容读取失败
+    UnifiedModel::MeshData invalidMesh;
+    BOOST_CHECK(!reader.read(MESH_TEST_DATA_DIR "/unsupported.xyz", invalidMesh, progress));
+}
+
+BOOST_AUTO_TEST_CASE(obj_reader_test)
+{
+    // 与igl::readOBJ的结果一致
+    UnifiedModel::MeshData mesh;
+    ImportProgress progress;
+    ObjReader reader;
+    BOOST_REQUIRE(reader.read(MESH_TEST_DATA_DIR "/bunny.obj", mesh, progress));
+    
+    Eigen::MatrixXd iglVertices;
+    Eigen::MatrixXi iglFaces;
+    BOOST_REQUIRE(igl::readOBJ(MESH_TEST_DATA_DIR "/bunny.obj", iglVertices, iglFaces));
+    BOOST_REQUIRE_EQUAL(mesh.vertices.rows(), iglVertices.rows());
+    BOOST_REQUIRE_EQUAL(mesh.faces.rows(), iglFaces.rows());
+    BOOST_CHECK(mesh.faces == iglFaces);
+    BOOST_CHECK(mesh.vertices.isApprox(iglVertices));
+    BOOST_CHECK_EQUAL(mesh.normals.rows(), mesh.faces.rows());
+    BOOST_CHECK_CLOSE(progress.getFraction(), 1.0, 1e-9);
+    
+    // 负索引、四边形扇形三角化和顶点法向量
+    std::filesystem::path obj_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_relative.obj";
+    {
+        std::ofstream file(obj_file_path);
+        file << "# quad with vertex normals\r\n"
+             << "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\n"
+             << "vt 0 0\r\nvn 0 0 -1\r\n"
+             << "f -4/1/-1 -3/1/-1 -2/1/-1 -1/1/-1\r\n"
+             << "v +2 0 0\r\n"
+             << "f 2 5 3\r\n";
+    }
+    UnifiedModel::MeshData quadMesh;
+    BOOST_REQUIRE(reader.read(obj_file_path.string(), quadMesh, progress));
+    BOOST_REQUIRE_EQUAL(quadMesh.faces.rows(), 3);
+    BOOST_CHECK_EQUAL(quadMesh.vertices.rows(), 5);
+    BOOST_CHECK_EQUAL(quadMesh.faces(1, 0), 0);
+    BOOST_CHECK_EQUAL(quadMesh.faces(1, 1), 2);
+    BOOST_CHECK_EQUAL(quadMesh.faces(1, 2), 3);
+    BOOST_CHECK_EQUAL(quadMesh.faces(2, 1), 4);
+    BOOST_CHECK_CLOSE(quadMesh.vertices(4, 0), 2.0, 1e-9);
+    // 带vn的面使用文件中的法向量，其余面使用几何法向量
+    BOOST_CHECK_CLOSE(quadMesh.normals(0, 2), -1.0, 1e-9);
+    BOOST_CHECK_CLOSE(quadMesh.normals(2, 2), 1.0, 1e-9);
+    
+    // 越界索引读取失败
+    {
+        std::ofstream file(obj_file_path);
+        file << "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n";
+    }
+    UnifiedModel::MeshData invalidMesh;
+    BOOST_CHECK(!reader.read(obj_file_path.string(), invalidMesh, progress));
+    std::filesystem::remove(obj_file_path);
+}
+
+BOOST_AUTO_TEST_CASE(import_obj_peak_memory_test)
+{
+    // 1000 x 1000网格：一百万顶点、约两百万三角形
+    const int gridSize = 1000;
+    const std::filesystem::path obj_file_path = std::filesystem::temp_directory_path() / "occt_imgui_grid.obj";
+    {
+        std::ofstream file(obj_file_path);
+        for (int i = 0; i < gridSize; ++i) {
+            for (int j = 0; j < gridSize; ++j) {
+                file << "v " << i * 0.1 << ' ' << j * 0.1 << ' ' << (i * j % 7) * 0.01 << '\n';
+            }
+        }
+        for (int i = 0; i + 1 < gridSize; ++i) {
+            for (int j = 0; j + 1 < gridSize; ++j) {
+                const int a = i * gridSize + j + 1;
+                file << "f " << a << ' ' << a + 1 << ' ' << a + gridSize + 1 << '\n'
+                     << "f " << a << ' ' << a + gridSize + 1 << ' ' << a + gridSize << '\n';
+            }
+        }
+    }
+    
+    if (!Utils::resetPeakResidentBytes()) {
+        BOOST_TEST_MESSAGE("Peak resident memory cannot be measured on this platform");
+    }
+    const std::uint64_t baseline = Utils::getResidentBytes();
+    
+    // 导入并按视图模型的方式为网格创建显示数据源
+    UnifiedModel model;
+    ModelImporter importer;
+    BOOST_REQUIRE(importer.importModel(obj_file_path.string(), model, "grid"));
+    const double fileBytes = double(std::filesystem::file_size(obj_file_path));
+    std::filesystem::remove(obj_file_path);
+    UnifiedModel::MeshDataPtr mesh = model.getSharedMesh("grid");
+    BOOST_REQUIRE(mesh);
+    const long useCount = mesh.use_count();
+    Handle(Mesh_DataSource) dataSource =
+        new Mesh_DataSource(mesh, mesh->vertices, mesh->faces, mesh->normals, mesh->vertexNormals);
+    BOOST_CHECK_EQUAL(dataSource->GetAllElements().Extent(), mesh->faces.rows());
+    // 显示数据源持有模型网格而不是复制缓冲区
+    BOOST_CHECK_EQUAL(mesh.use_count(), useCount + 1);
+    
+    if (baseline == 0 || Utils::getPeakResidentBytes() < baseline) {
+        return;
+    }
+    
+    // 缓冲区从读取器一路移动到模型并由显示共享：峰值只包含最终网格（约为文件的两倍）、
+    // 读取时的文件映射和临时数据。常驻内存受分配器和系统影响，所以只检查一个宽松的上限，
+    // 多出几份网格副本时会超过
+    const double meshBytes = double(mesh->vertices.size()) * sizeof(double)
+                           + double(mesh->faces.size()) * sizeof(int)
+                           + double(mesh->normals.size()) * sizeof(double)
+                           + double(mesh->vertexNormals.size()) * sizeof(double);
+    const double peakBytes = double(Utils::getPeakResidentBytes() - baseline);
+    BOOST_TEST_MESSAGE("Peak memory during import: " << peakBytes / meshBytes << " x mesh size, "
+                       << peakBytes / fileBytes << " x file size");
+    BOOST_CHECK_LT(peakBytes, 6.0 * fileBytes);
+}
+
+BOOST_AUTO_TEST_CASE(import_ply_file_test)
+{
+    const float positions[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+    
+    // 二进制小端PLY：三角形面、顶点法向量和颜色，面之后还有一个需要跳过的元素
+    std::filesystem::path binary_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_binary.ply";
+    {
+        std::ofstream file(binary_file_path, std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\ncomment scanner export\n"
+             << "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+             << "property float nx\nproperty float ny\nproperty float nz\n"
+             << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+             << "element face 2\nproperty list uchar int vertex_indices\n"
+             << "element edge 1\nproperty int vertex1\nproperty int vertex2\n"
+             << "end_header\n";
+        for (int i = 0; i < 4; ++i) {
+            const float normal[3] = {0.0f, 0.0f, 2.0f};
+            const unsigned char color[3] = {255, static_cast<unsigned char>(i * 85), 0};
+            file.write(reinterpret_cast<const char*>(positions[i]), sizeof(positions[i]));
+            file.write(reinterpret_cast<const char*>(normal), sizeof(normal));
+            file.write(reinterpret_cast<const char*>(color), sizeof(color));
+        }
+        const int triangles[2][3] = {{0, 1, 2}, {0, 2, 3}};
+        for (const auto& triangle : triangles) {
+            const unsigned char count = 3;
+            file.write(reinterpret_cast<const char*>(&count), 1);
+            file.write(reinterpret_cast<const char*>(triangle), sizeof(triangle));
+        }
+        const int edge[2] = {0, 1};
+        file.write(reinterpret_cast<const char*>(edge), sizeof(edge));
+    }
+    
+    auto model = std::make_shared<UnifiedModel>();
+    ModelImporter importer;
+    BOOST_REQUIRE(importer.importModel(binary_file_path.string(), *model, "scan"));
+    const UnifiedModel::MeshData* mesh = model->getMesh("scan");
+    BOOST_REQUIRE(mesh != nullptr);
+    BOOST_CHECK_EQUAL(mesh->vertices.rows(), 4);
+    BOOST_REQUIRE_EQUAL(mesh->faces.rows(), 2);
+    BOOST_CHECK_EQUAL(mesh->faces(1, 2), 3);
+    BOOST_CHECK_CLOSE(mesh->vertices(2, 1), 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(mesh->normals(0, 2), 1.0, 1e-9);
+    BOOST_REQUIRE_EQUAL(mesh->vertexNormals.rows(), 4);
+    BOOST_CHECK_CLOSE(mesh->vertexNormals(3, 2), 2.0, 1e-9);
+    BOOST_REQUIRE_EQUAL(mesh->vertexColors.rows(), 4);
+    BOOST_CHECK_CLOSE(mesh->vertexColors(0, 0), 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(mesh->vertexColors(2, 1), 170.0 / 255.0, 1e-9);
+    std::filesystem::remove(binary_file_path);
+    
+    // ASCII PLY：四边形按扇形三角化，无法向量和颜色
+    std::filesystem::path ascii_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_ascii.ply";
+    {
+        std::ofstream file(ascii_file_path);
+        file << "ply\nformat ascii 1.0\n"
+             << "element vertex 4\nproperty double x\nproperty double y\nproperty double z\n"
+             << "element face 1\nproperty list uchar uint vertex_index\n"
+             << "end_header\n"
+             << "0 0 0\n1 0 0\n1 1 0\n0 1 0\n"
+             << "4 0 1 2 3\n";
+    }
+    UnifiedModel::MeshData asciiMesh;
+    ImportProgress progress;
+    PlyReader reader;
+    BOOST_REQUIRE(reader.read(ascii_file_path.string(), asciiMesh, progress));
+    BOOST_CHECK_EQUAL(asciiMesh.faces.rows(), 2);
+    BOOST_CHECK_EQUAL(asciiMesh.faces(1, 1), 2);
+    BOOST_CHECK_EQUAL(asciiMesh.vertexNormals.rows(), 0);
+    BOOST_CHECK_EQUAL(asciiMesh.vertexColors.rows(), 0);
+    
+    // 越界索引读取失败
+    {
+        std::ofstream file(ascii_file_path);
+        file << "ply\nformat ascii 1.0\n"
+             << "element vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+             << "element face 1\nproperty list uchar int vertex_indices\n"
+             << "end_header\n"
+             << "0 0 0\n1 0 0\n1 1 0\n"
+             << "3 0 1 3\n";
+    }
+    UnifiedModel::MeshData invalidMesh;
+    BOOST_CHECK(!reader.read(ascii_file_path.string(), invalidMesh, progress));
+    
+    // 声明的面数超出文件内容或32位索引范围时直接失败，不按声明的数量预留内存
+    for (const char* faceCount : {"200000000", "5000000000"}) {
+        for (const char* format : {"ascii", "binary_little_endian"}) {
+            {
+                std::ofstream file(ascii_file_path, std::ios::binary);
+                file << "ply\nformat " << format << " 1.0\n"
+                     << "element vertex 3\nproperty uchar x\nproperty uchar y\nproperty uchar z\n"
+                     << "element face " << faceCount << "\nproperty list uchar int vertex_indices\n"
+                     << "end_header\n"
+                     << "0 0 0\n1 0 0\n1 1 0\n"
+                     << "3 0 1 2\n";
+            }
+            UnifiedModel::MeshData truncatedMesh;
+            BOOST_CHECK(!reader.read(ascii_file_path.string(), truncatedMesh, progress));
+            BOOST_CHECK_EQUAL(truncatedMesh.faces.rows(), 0);
+        }
+    }
+    std::filesystem::remove(ascii_file_path);
+}
+
+BOOST_AUTO_TEST_CASE(import_mesh_repair_test)
+{
+    // 重复面、退化面，以及一条被四个面共用的边
+    const std::filesystem::path obj_file_path =
+        std::filesystem::temp_directory_path() / "occt_imgui_defects.obj";
+    {
+        std::ofstream file(obj_file_path);
+        file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 2\nv 0 -3 0\nv 0 0 -1\n"
+             << "f 1 2 3\nf 3 2 1\nf 1 1 2\nf 1 2 4\nf 1 2 5\nf 1 2 6\n";
+    }
+    
+    // 默认不修复
+    ModelImporter importer;
+    UnifiedModel model;
+    BOOST_REQUIRE(importer.importModel(obj_file_path.string(), model, "raw"));
+    BOOST_CHECK_EQUAL(model.getMesh("raw")->faces.rows(), 6);
+    BOOST_CHECK(importer.getRepairReports().empty());
+    
+    // 共用边上保留面积最大的两个面
+    importer.setMeshRepairEnabled(true);
+    BOOST_REQUIRE(importer.importModel(obj_file_path.string(), model, "repaired"));
+    std::filesystem::remove(obj_file_path);
+    const UnifiedModel::MeshData* mesh = model.getMesh("repaired");
+    BOOST_REQUIRE_EQUAL(mesh->faces.rows(), 2);
+    BOOST_CHECK_EQUAL(mesh->vertices.rows(), 4);
+    BOOST_CHECK_EQUAL(mesh->normals.rows(), 2);
+    
+    const auto reports = importer.getRepairReports();
+    BOOST_REQUIRE_EQUAL(reports.count("repaired"), 1);
+    const MeshProcessing::RepairReport& report = reports.at("repaired");
+    BOOST_CHECK_EQUAL(report.degenerateFaces, 1);
+    BOOST_CHECK_EQUAL(report.duplicateFaces, 1);
+    BOOST_CHECK_EQUAL(report.nonManifoldEdges, 1);
+    BOOST_CHECK_EQUAL(report.nonManifoldFaces, 2);
+    BOOST_CHECK_EQUAL(report.unusedVertices, 2);
+    
+    importer.clearRepairReports();
+    BOOST_CHECK(importer.getRepairReports().empty());
+}
+
+BOOST_AUTO_TEST_CASE(import_record_test)
+{
+    // 计时器在作用域结束或stop()时记录一次
+    ImportProgress progress;
+    {
+        ImportStageTimer timer(progress, "stage");
+        timer.setBytes(10);
+        timer.setElements(2);
+        timer.stop();
+    }
+    std::vector<ImportStageTiming> timings = progress.takeStageTimings();
+    BOOST_REQUIRE_EQUAL(timings.size(), 1);
+    BOOST_CHECK_EQUAL(timings[0].name, "stage");
+    BOOST_CHECK_EQUAL(timings[0].bytes, 10);
+    BOOST_CHECK_EQUAL(timings[0].elements, 2);
+    BOOST_CHECK(timings[0].seconds >= 0.0);
+    BOOST_CHECK(progress.takeStageTimings().empty());
+    
+    // 每次导入生成一条记录，包含读取器和导入器的各阶段
+    ModelImporter importer;
+    UnifiedModel model;
+    BOOST_REQUIRE(importer.importModel(MESH_TEST_DATA_DIR "/bunny.obj", model, "bunny"));
+    BOOST_CHECK(!importer.importModel(MESH_TEST_DATA_DIR "/missing.obj", model, "missing"));
+    const std::vector<ImportRecord> records = importer.takeImportRecords();
+    BOOST_REQUIRE_EQUAL(records.size(), 2);
+    BOOST_CHECK(importer.takeImportRecords().empty());
+    
+    const ImportRecord& record = records[0];
+    BOOST_CHECK(record.succeeded);
+    BOOST_CHECK_EQUAL(record.modelId, "bunny");
+    BOOST_CHECK_EQUAL(record.format, ".obj");
+    BOOST_CHECK_EQUAL(record.fileBytes, std::filesystem::file_size(MESH_TEST_DATA_DIR "/bunny.obj"));
+    BOOST_CHECK_EQUAL(record.triangles, std::uint64_t(model.getMesh("bunny")->faces.rows()));
+    BOOST_CHECK_EQUAL(record.vertices, std::uint64_t(model.getMesh("bunny")->vertices.rows()));
+    BOOST_CHECK_EQUAL(record.parts, 1);
+    BOOST_CHECK(record.seconds > 0.0);
+    std::set<std::string> stageNames;
+    double stageSeconds = 0.0;
+    for (const ImportStageTiming& stage : record.stages) {
+        stageNames.insert(stage.name);
+        stageSeconds += stage.seconds;
+    }
+    for (const char* name : {"map", "count", "parse vertices", "parse faces", "add mesh"}) {
+        BOOST_CHECK_MESSAGE(stageNames.count(name) == 1, "missing stage " << name);
+    }
+    BOOST_CHECK(stageSeconds <= record.seconds);
+    BOOST_CHECK_EQUAL(record.getStageSeconds("add mesh"),
+                      std::find_if(record.stages.begin(), record.stages.end(), [](const ImportStageTiming& stage) {
+                          return stage.name == "add mesh";
+                      })->seconds);
+    BOOST_CHECK(!records[1].succeeded);
+    
+    // 日志每条记录一行
+    const std::filesystem::path log_file_path = std::filesystem::temp_directory_path() / "occt_imgui_imports.jsonl";
+    std::filesystem::remove(log_file_path);
+    BOOST_REQUIRE(records[0].appendToLog(log_file_path.string()));
+    BOOST_REQUIRE(records[1].appendToLog(log_file_path.string()));
+    std::ifstream log(log_file_path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(log, line);) {
+        lines.push_back(line);
+    }
+    log.close();
+    std::filesystem::remove(log_file_path);
+    BOOST_REQUIRE_EQUAL(lines.size(), 2);
+    BOOST_CHECK_EQUAL(lines[0].front(), '{');
+    BOOST_CHECK_EQUAL(lines[0].back(), '}');
+    BOOST_CHECK(lines[0].find("\"id\":\"bunny\"") != std::string::npos);
+    BOOST_CHECK(lines[0].find("\"name\":\"parse faces\"") != std::string::npos);
+    BOOST_CHECK(lines[1].find("\"succeeded\":false") != std::string::npos);
+}
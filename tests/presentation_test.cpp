@@ -0,0 +1,327 @@
+#define BOOST_TEST_MODULE Presentation Tests
+#include <boost/test/unit_test.hpp>
+
+#include "ais/Mesh_ElementOwner.h"
+#include "ais/Mesh_PreparedObject.h"
+#include "viewmodel/PresentationBuilder.h"
+#include "viewmodel/ViewerUpdateQueue.h"
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <SelectBasics_PickResult.hxx>
+#include <SelectMgr_SelectingVolumeManager.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace
+{
+//! Returns a unit cube mesh with 8 vertices and 12 outward-facing triangles.
+UnifiedModel::MeshDataPtr makeCubeMesh(bool theWithNodeNormals)
+{
+    auto aMesh = std::make_shared<UnifiedModel::MeshData>();
+    aMesh->vertices.resize(8, 3);
+    aMesh->vertices << 0, 0, 0,
+                       1, 0, 0,
+                       1, 1, 0,
+                       0, 1, 0,
+                       0, 0, 1,
+                       1, 0, 1,
+                       1, 1, 1,
+                       0, 1, 1;
+    aMesh->faces.resize(12, 3);
+    aMesh->faces << 0, 2, 1,  0, 3, 2,
+                    4, 5, 6,  4, 6, 7,
+                    0, 1, 5,  0, 5, 4,
+                    1, 2, 6,  1, 6, 5,
+                    2, 3, 7,  2, 7, 6,
+                    3, 0, 4,  3, 4, 7;
+    if (theWithNodeNormals) {
+        aMesh->vertexNormals = (aMesh->vertices.array() - 0.5).matrix().rowwise().normalized();
+    }
+    return aMesh;
+}
+
+//! Returns a flat grid over the unit square in the XY plane with 2 triangles per cell.
+UnifiedModel::MeshDataPtr makeGridMesh(int theNbCells)
+{
+    auto aMesh = std::make_shared<UnifiedModel::MeshData>();
+    const int aNbNodes = theNbCells + 1;
+    aMesh->vertices.resize(aNbNodes * aNbNodes, 3);
+    for (int aRow = 0; aRow < aNbNodes; ++aRow) {
+        for (int aCol = 0; aCol < aNbNodes; ++aCol) {
+            aMesh->vertices.row(aRow * aNbNodes + aCol) << double(aCol) / theNbCells, double(aRow) / theNbCells, 0.0;
+        }
+    }
+    aMesh->faces.resize(2 * theNbCells * theNbCells, 3);
+    for (int aRow = 0; aRow < theNbCells; ++aRow) {
+        for (int aCol = 0; aCol < theNbCells; ++aCol) {
+            const int aNode = aRow * aNbNodes + aCol;
+            const int aCell = aRow * theNbCells + aCol;
+            aMesh->faces.row(2 * aCell) << aNode, aNode + 1, aNode + aNbNodes + 1;
+            aMesh->faces.row(2 * aCell + 1) << aNode, aNode + aNbNodes + 1, aNode + aNbNodes;
+        }
+    }
+    return aMesh;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(prepare_mesh_test)
+{
+    // 没有顶点法向量时每个三角形使用独立顶点
+    Mesh_PreparedObject::Data aFlat;
+    Mesh_PreparedObject::PrepareMesh(makeCubeMesh(false), Standard_True, aFlat);
+    BOOST_REQUIRE_EQUAL(aFlat.Patches.size(), 1u);
+    BOOST_CHECK_EQUAL(aFlat.NbTriangles, 12);
+    BOOST_CHECK_EQUAL(aFlat.Patches[0].Triangles->VertexNumber(), 36);
+    BOOST_CHECK(!aFlat.Patches[0].Sensitive.IsNull());
+    BOOST_CHECK_CLOSE(aFlat.Patches[0].Min.x(), 0.0f, 1e-4);
+    BOOST_CHECK_CLOSE(aFlat.Patches[0].Max.z(), 1.0f, 1e-4);
+
+    // 立方体的每条边只出现一次：12条棱加6条对角线
+    BOOST_REQUIRE(!aFlat.Edges.IsNull());
+    BOOST_CHECK_EQUAL(aFlat.Edges->EdgeNumber(), 36);
+
+    // 有顶点法向量时共享顶点，边线在需要时才准备
+    Mesh_PreparedObject::Data aSmooth;
+    Mesh_PreparedObject::PrepareMesh(makeCubeMesh(true), Standard_False, aSmooth);
+    BOOST_REQUIRE_EQUAL(aSmooth.Patches.size(), 1u);
+    BOOST_CHECK_EQUAL(aSmooth.Patches[0].Triangles->VertexNumber(), 8);
+    BOOST_CHECK_EQUAL(aSmooth.Patches[0].Triangles->EdgeNumber(), 36);
+    BOOST_CHECK(aSmooth.Edges.IsNull());
+}
+
+BOOST_AUTO_TEST_CASE(prepare_shape_test)
+{
+    TopoDS_Shape aBox = BRepPrimAPI_MakeBox(10.0, 20.0, 30.0).Shape();
+
+    // 没有三角网格的面被跳过
+    Mesh_PreparedObject::Data anEmpty;
+    Mesh_PreparedObject::PrepareShape(aBox, {}, Standard_False, anEmpty);
+    BOOST_CHECK(anEmpty.Patches.empty());
+    BOOST_CHECK_EQUAL(anEmpty.NbTriangles, 0);
+
+    BRepMesh_IncrementalMesh(aBox, 0.1);
+    TopExp_Explorer aFaceExp(aBox, TopAbs_FACE);
+    const TopoDS_Shape aColoredFace = aFaceExp.Current();
+    std::vector<UnifiedModel::SubShapeColor> aColors = {{aColoredFace, Quantity_Color(Quantity_NOC_RED)}};
+
+    Mesh_PreparedObject::Data aData;
+    Mesh_PreparedObject::PrepareShape(aBox, aColors, Standard_True, aData);
+    BOOST_CHECK_EQUAL(aData.NbTriangles, 12);
+    BOOST_REQUIRE_EQUAL(aData.Patches.size(), 2u);
+    BOOST_CHECK(!aData.Patches[0].HasCustomColor);
+    BOOST_CHECK_EQUAL(aData.Patches[0].Triangles->EdgeNumber(), 30);
+    BOOST_CHECK(aData.Patches[1].HasCustomColor);
+    BOOST_CHECK(aData.Patches[1].Color == Quantity_Color(Quantity_NOC_RED));
+    BOOST_CHECK_EQUAL(aData.Patches[1].Triangles->EdgeNumber(), 6);
+    BOOST_CHECK_CLOSE(aData.Patches[0].Max.y() + aData.Patches[1].Max.y(), 40.0f, 1e-4);
+
+    // 12条棱，每条一段
+    BOOST_REQUIRE(!aData.Edges.IsNull());
+    BOOST_CHECK_EQUAL(aData.Edges->VertexNumber(), 24);
+}
+
+BOOST_AUTO_TEST_CASE(presentation_builder_test)
+{
+    PresentationBuilder aBuilder(2);
+    for (std::uint64_t aTicket = 1; aTicket <= 3; ++aTicket) {
+        PresentationBuilder::Request aRequest;
+        aRequest.id = "mesh";
+        aRequest.ticket = aTicket;
+        aRequest.mesh = makeCubeMesh(false);
+        aBuilder.submit(std::move(aRequest));
+    }
+
+    std::vector<PresentationBuilder::Result> aResults;
+    const auto aDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (aResults.size() < 3 && std::chrono::steady_clock::now() < aDeadline) {
+        PresentationBuilder::Result aResult;
+        if (aBuilder.takeFinished(aResult)) {
+            aResults.push_back(std::move(aResult));
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(aResults.size(), 3u);
+    BOOST_CHECK_EQUAL(aBuilder.getOutstandingCount(), 0u);
+    for (const PresentationBuilder::Result& aResult : aResults) {
+        BOOST_CHECK_EQUAL(aResult.id, "mesh");
+        BOOST_CHECK(aResult.isPrepared);
+        BOOST_CHECK_EQUAL(aResult.data.NbTriangles, 12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(element_pick_test)
+{
+    // 约一百万个三角形，框选左半部分
+    const int aNbCells = 708;
+    Mesh_PreparedObject::Data aData;
+    Mesh_PreparedObject::PrepareMesh(makeGridMesh(aNbCells), Standard_False, aData);
+    BOOST_REQUIRE_EQUAL(aData.Patches.size(), 1u);
+    const Handle(Graphic3d_ArrayOfTriangles)& aTriangles = aData.Patches[0].Triangles;
+
+    // 与三角形选择模式相同的敏感实体
+    Handle(Mesh_ElementOwner) anOwner = new Mesh_ElementOwner(Handle(SelectMgr_SelectableObject)(), 0);
+    Handle(Select3D_SensitivePrimitiveArray) aSensitive = new Select3D_SensitivePrimitiveArray(anOwner);
+    aSensitive->SetDetectElements(Standard_True);
+    aSensitive->SetDetectElementMap(Standard_True);
+    BOOST_REQUIRE(aSensitive->InitTriangulation(aTriangles->Attributes(), aTriangles->Indices(), TopLoc_Location()));
+    aSensitive->BVH();
+
+    // 正交相机正对网格，1000x1000像素的窗口恰好显示单位正方形
+    Handle(Graphic3d_Camera) aCamera = new Graphic3d_Camera();
+    aCamera->SetProjectionType(Graphic3d_Camera::Projection_Orthographic);
+    aCamera->SetCenter(gp_Pnt(0.5, 0.5, 0.0));
+    aCamera->SetEye(gp_Pnt(0.5, 0.5, 10.0));
+    aCamera->SetUp(gp_Dir(0.0, 1.0, 0.0));
+    aCamera->SetScale(1.0);
+    aCamera->SetAspect(1.0);
+    aCamera->SetZRange(1.0, 20.0);
+
+    SelectMgr_SelectingVolumeManager aMgr;
+    aMgr.InitBoxSelectingVolume(gp_Pnt2d(0.0, 0.0), gp_Pnt2d(500.0, 1000.0));
+    aMgr.SetCamera(aCamera);
+    aMgr.SetWindowSize(1000, 1000);
+    aMgr.AllowOverlapDetection(Standard_True);
+    aMgr.BuildSelectingVolume();
+
+    const auto aStart = std::chrono::steady_clock::now();
+    SelectBasics_PickResult aPickResult;
+    BOOST_REQUIRE(aSensitive->Matches(aMgr, aPickResult));
+    BOOST_REQUIRE(anOwner->UpdateSelectedElements(aSensitive));
+    const double aMilliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - aStart).count();
+    BOOST_TEST_MESSAGE("Box pick of " << aData.NbTriangles << " triangles: " << aMilliseconds << " ms");
+
+    // 左半部分的三角形，加上与分界线相接的一列
+    const Standard_Integer aNbSelected = anOwner->SelectedElements().Extent();
+    BOOST_CHECK_GE(aNbSelected, aData.NbTriangles / 2);
+    BOOST_CHECK_LE(aNbSelected, aData.NbTriangles / 2 + 4 * aNbCells);
+    BOOST_CHECK(anOwner->SelectedElements().Contains(0));
+    BOOST_CHECK(!anOwner->SelectedElements().Contains(aData.NbTriangles - 1));
+}
+
+BOOST_AUTO_TEST_CASE(element_selection_scheme_test)
+{
+    const int aNbCells = 20;
+    Mesh_PreparedObject::Data aData;
+    Mesh_PreparedObject::PrepareMesh(makeGridMesh(aNbCells), Standard_False, aData);
+    BOOST_REQUIRE_EQUAL(aData.Patches.size(), 1u);
+    const Handle(Graphic3d_ArrayOfTriangles)& aTriangles = aData.Patches[0].Triangles;
+
+    Handle(Mesh_ElementOwner) anOwner = new Mesh_ElementOwner(Handle(SelectMgr_SelectableObject)(), 0);
+    Handle(Select3D_SensitivePrimitiveArray) aSensitive = new Select3D_SensitivePrimitiveArray(anOwner);
+    aSensitive->SetDetectElements(Standard_True);
+    aSensitive->SetDetectElementMap(Standard_True);
+    BOOST_REQUIRE(aSensitive->InitTriangulation(aTriangles->Attributes(), aTriangles->Indices(), TopLoc_Location()));
+    aSensitive->BVH();
+
+    Handle(Graphic3d_Camera) aCamera = new Graphic3d_Camera();
+    aCamera->SetProjectionType(Graphic3d_Camera::Projection_Orthographic);
+    aCamera->SetCenter(gp_Pnt(0.5, 0.5, 0.0));
+    aCamera->SetEye(gp_Pnt(0.5, 0.5, 10.0));
+    aCamera->SetUp(gp_Dir(0.0, 1.0, 0.0));
+    aCamera->SetScale(1.0);
+    aCamera->SetAspect(1.0);
+    aCamera->SetZRange(1.0, 20.0);
+
+    // 框选一个窗口区域，返回命中的三角形
+    auto pickBox = [&](const gp_Pnt2d& theMin, const gp_Pnt2d& theMax, TColStd_PackedMapOfInteger& theDetected) {
+        SelectMgr_SelectingVolumeManager aMgr;
+        aMgr.InitBoxSelectingVolume(theMin, theMax);
+        aMgr.SetCamera(aCamera);
+        aMgr.SetWindowSize(1000, 1000);
+        aMgr.AllowOverlapDetection(Standard_True);
+        aMgr.BuildSelectingVolume();
+        SelectBasics_PickResult aPickResult;
+        BOOST_REQUIRE(aSensitive->Matches(aMgr, aPickResult));
+        Mesh_ElementOwner::DetectedElements(aSensitive, theDetected);
+    };
+
+    // 左半部分替换选择
+    TColStd_PackedMapOfInteger aLeft;
+    pickBox(gp_Pnt2d(0.0, 0.0), gp_Pnt2d(500.0, 1000.0), aLeft);
+    BOOST_REQUIRE(anOwner->UpdateSelectedElements(aSensitive, AIS_SelectionScheme_Replace));
+    BOOST_CHECK(anOwner->SelectedElements().IsEqual(aLeft));
+
+    // 第二个框加入选择：两个框的三角形合在一起
+    TColStd_PackedMapOfInteger aBottom;
+    pickBox(gp_Pnt2d(0.0, 500.0), gp_Pnt2d(1000.0, 1000.0), aBottom);
+    BOOST_REQUIRE(anOwner->UpdateSelectedElements(aSensitive, AIS_SelectionScheme_Add));
+    TColStd_PackedMapOfInteger aCombined;
+    aCombined.Union(aLeft, aBottom);
+    BOOST_CHECK_EQUAL(anOwner->SelectedElements().Extent(), aCombined.Extent());
+    BOOST_CHECK_GT(aCombined.Extent(), aLeft.Extent());
+    BOOST_CHECK_GT(aCombined.Extent(), aBottom.Extent());
+    BOOST_CHECK_LT(aCombined.Extent(), aData.NbTriangles);
+
+    // 再次切换左半部分，只剩第二个框中不属于左半部分的三角形
+    TColStd_PackedMapOfInteger aToggled;
+    pickBox(gp_Pnt2d(0.0, 0.0), gp_Pnt2d(500.0, 1000.0), aToggled);
+    BOOST_REQUIRE(anOwner->UpdateSelectedElements(aSensitive, AIS_SelectionScheme_XOR));
+    TColStd_PackedMapOfInteger aRest;
+    aRest.Subtraction(aBottom, aLeft);
+    BOOST_CHECK(anOwner->SelectedElements().IsEqual(aRest));
+
+    // 清空后只有新拾取的三角形
+    anOwner->ClearSelectedElements();
+    pickBox(gp_Pnt2d(0.0, 0.0), gp_Pnt2d(500.0, 1000.0), aToggled);
+    BOOST_REQUIRE(anOwner->UpdateSelectedElements(aSensitive, AIS_SelectionScheme_Add));
+    BOOST_CHECK(anOwner->SelectedElements().IsEqual(aLeft));
+}
+
+BOOST_AUTO_TEST_CASE(viewer_update_queue_test)
+{
+    // 没有上下文时只合并请求，刷新不访问查看器
+    ViewerUpdateQueue queue{Handle(AIS_InteractiveContext)()};
+    Handle(AIS_InteractiveObject) box = new AIS_Shape(BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape());
+    Handle(AIS_InteractiveObject) other = new AIS_Shape(BRepPrimAPI_MakeBox(2.0, 2.0, 2.0).Shape());
+    BOOST_CHECK(!queue.hasPending());
+    BOOST_CHECK(!queue.flush(Handle(V3d_View)()));
+
+    // 同一对象的请求合并为一项，被删除对象的请求丢弃
+    queue.erase(box);
+    queue.display(box);
+    queue.redisplay(box);
+    queue.redisplay(box);
+    queue.display(other);
+    queue.invalidate();
+    queue.invalidate();
+    BOOST_CHECK(queue.hasPending());
+    BOOST_CHECK_EQUAL(queue.getPendingCount(), 2u);
+    queue.forget(other);
+    BOOST_CHECK_EQUAL(queue.getPendingCount(), 1u);
+
+    // 一帧的所有请求只重绘一次
+    BOOST_CHECK(queue.flush(Handle(V3d_View)()));
+    BOOST_CHECK(!queue.hasPending());
+    const ViewerUpdateQueue::Counters& counters = queue.getCounters();
+    BOOST_CHECK_EQUAL(counters.redrawRequests, 7u);
+    BOOST_CHECK_EQUAL(counters.coalesced, 3u);
+    BOOST_CHECK_EQUAL(counters.redraws, 1u);
+    BOOST_CHECK_EQUAL(counters.redrawsSaved(), 6u);
+
+    queue.resetCounters();
+    BOOST_CHECK_EQUAL(queue.getCounters().redrawRequests, 0u);
+
+    // 丢弃唯一的请求后没有剩余工作，再次请求的对象重新计入
+    queue.display(other);
+    queue.forget(other);
+    BOOST_CHECK(!queue.hasPending());
+    BOOST_CHECK(!queue.flush(Handle(V3d_View)()));
+    queue.display(box);
+    queue.display(other);
+    queue.forget(box);
+    queue.display(box);
+    BOOST_CHECK_EQUAL(queue.getPendingCount(), 2u);
+    BOOST_CHECK(queue.flush(Handle(V3d_View)()));
+    BOOST_CHECK(!queue.hasPending());
+}
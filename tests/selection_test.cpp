@@ -0,0 +1,122 @@
+#define BOOST_TEST_MODULE Selection Tests
+#include <boost/test/unit_test.hpp>
+
+#include "utils/DynamicBitset.h"
+#include "viewmodel/SelectionSet.h"
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(dynamic_bitset_test)
+{
+    Utils::DynamicBitset bits(130);
+    BOOST_CHECK_EQUAL(bits.size(), 130u);
+    BOOST_CHECK(!bits.any());
+    BOOST_CHECK_EQUAL(bits.findFirst(), 130u);
+
+    BOOST_CHECK(bits.set(0));
+    BOOST_CHECK(bits.set(64));
+    BOOST_CHECK(bits.set(129));
+    BOOST_CHECK(!bits.set(129));
+    BOOST_CHECK_EQUAL(bits.count(), 3u);
+    BOOST_CHECK(bits.test(64));
+    BOOST_CHECK(!bits.test(65));
+    BOOST_CHECK(!bits.test(1000));
+    BOOST_CHECK_EQUAL(bits.findFirst(), 0u);
+
+    std::vector<size_t> indices;
+    bits.forEachSet([&indices](size_t index) { indices.push_back(index); });
+    BOOST_CHECK((indices == std::vector<size_t>{0, 64, 129}));
+
+    // 取反不会置位长度之外的位
+    Utils::DynamicBitset inverted = bits;
+    inverted.flip();
+    BOOST_CHECK_EQUAL(inverted.count(), 127u);
+    inverted |= bits;
+    BOOST_CHECK_EQUAL(inverted.count(), 130u);
+    inverted.subtract(bits);
+    BOOST_CHECK_EQUAL(inverted.count(), 127u);
+    inverted &= bits;
+    BOOST_CHECK(!inverted.any());
+
+    // 缩短后超出的位被清除，再加长时为0
+    bits.resize(64);
+    BOOST_CHECK_EQUAL(bits.count(), 1u);
+    bits.resize(130);
+    BOOST_CHECK(!bits.test(64));
+}
+
+BOOST_AUTO_TEST_CASE(selection_set_test)
+{
+    SelectionSet selection;
+    const SelectionSet::EntityHandle a = selection.addEntity("a");
+    const SelectionSet::EntityHandle b = selection.addEntity("b");
+    const SelectionSet::EntityHandle c = selection.addEntity("c");
+    BOOST_CHECK_EQUAL(selection.addEntity("b"), b);
+    BOOST_CHECK_EQUAL(selection.findHandle("c"), c);
+    BOOST_CHECK_EQUAL(selection.findHandle("missing"), SelectionSet::INVALID_HANDLE);
+    BOOST_CHECK(!selection.isSelected("missing"));
+
+    BOOST_CHECK(selection.setSelected(a, true));
+    BOOST_CHECK(!selection.setSelected(a, true));
+    BOOST_CHECK(selection.isSelected("a"));
+    BOOST_CHECK_EQUAL(selection.getCount(), 1u);
+
+    // 批量操作
+    Utils::DynamicBitset mask = selection.makeMask();
+    mask.set(b);
+    mask.set(c);
+    BOOST_CHECK(selection.apply(mask, SelectionSet::Operation::ADD));
+    BOOST_CHECK_EQUAL(selection.getCount(), 3u);
+    BOOST_CHECK(selection.apply(mask, SelectionSet::Operation::REMOVE));
+    BOOST_CHECK((selection.getSelectedIds() == std::vector<std::string>{"a"}));
+    BOOST_CHECK(selection.apply(mask, SelectionSet::Operation::TOGGLE));
+    BOOST_CHECK_EQUAL(selection.getCount(), 3u);
+    BOOST_CHECK(selection.apply(mask, SelectionSet::Operation::REPLACE));
+    BOOST_CHECK_EQUAL(selection.getCount(), 2u);
+    BOOST_CHECK(!selection.apply(mask, SelectionSet::Operation::REPLACE));
+    BOOST_CHECK_EQUAL(selection.getId(selection.getFirstSelected()), "b");
+
+    // 删除选中的实体时返回true，句柄被复用且不带选中状态
+    BOOST_CHECK(selection.removeEntity("b"));
+    BOOST_CHECK_EQUAL(selection.getCount(), 1u);
+    BOOST_CHECK(!selection.removeEntity("a"));
+    const SelectionSet::EntityHandle d = selection.addEntity("d");
+    BOOST_CHECK(d == a || d == b);
+    BOOST_CHECK(!selection.isSelected(d));
+    BOOST_CHECK_EQUAL(selection.getHandleCount(), 3u);
+
+    // 掩码中已释放的句柄被忽略
+    Utils::DynamicBitset all = selection.makeMask();
+    all.flip();
+    BOOST_CHECK(selection.apply(all, SelectionSet::Operation::REPLACE));
+    BOOST_CHECK_EQUAL(selection.getCount(), 2u);
+
+    BOOST_CHECK(selection.clear());
+    BOOST_CHECK(!selection.clear());
+    BOOST_CHECK(selection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(selection_set_bulk_test)
+{
+    // 大量实体的全选和反选只是按字运算
+    const size_t count = 500000;
+    SelectionSet selection;
+    for (size_t i = 0; i < count; ++i) {
+        selection.addEntity("entity_" + std::to_string(i));
+    }
+
+    Utils::DynamicBitset all = selection.makeMask();
+    all.flip();
+    BOOST_CHECK(selection.apply(all, SelectionSet::Operation::REPLACE));
+    BOOST_CHECK_EQUAL(selection.getCount(), count);
+
+    Utils::DynamicBitset even = selection.makeMask();
+    for (size_t i = 0; i < count; i += 2) {
+        even.set(i);
+    }
+    BOOST_CHECK(selection.apply(even, SelectionSet::Operation::TOGGLE));
+    BOOST_CHECK_EQUAL(selection.getCount(), count / 2);
+    BOOST_CHECK(!selection.isSelected("entity_0"));
+    BOOST_CHECK(selection.isSelected("entity_1"));
+}
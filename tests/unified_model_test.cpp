@@ -15,9 +15,12 @@
 #include <Quantity_Color.hxx>
 #include <gp_Trsf.hxx>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 // 辅助函数 - 从OCCT形体提取三角网格并转换为libigl格式
 std::tuple<Eigen::MatrixXd, Eigen::MatrixXi, Eigen::MatrixXd> extractMeshFromShape(const TopoDS_Shape& shape) {
@@ -263,4 +266,278 @@ BOOST_FIXTURE_TEST_CASE(get_geometry_ids_by_type_test, UnifiedModelFixture)
     BOOST_CHECK_EQUAL(meshIds.size(), 2);
     BOOST_CHECK(std::find(meshIds.begin(), meshIds.end(), "mesh1") != meshIds.end());
     BOOST_CHECK(std::find(meshIds.begin(), meshIds.end(), "mesh2") != meshIds.end());
-} 
\ No newline at end of file
+}
+
+// 测试装配层次结构
+BOOST_FIXTURE_TEST_CASE(assembly_hierarchy_test, UnifiedModelFixture)
+{
+    // 构建 asm -> (part1, sub -> (part2))
+    model->addAssembly("asm");
+    model->addShape("asm/part1", shape);
+    BOOST_CHECK(model->setParent("asm/part1", "asm"));
+    model->addAssembly("asm/sub", "asm");
+    model->addMesh("asm/sub/part2", vertices, faces, normals);
+    BOOST_CHECK(model->setParent("asm/sub/part2", "asm/sub"));
+    
+    BOOST_CHECK(model->getGeometryType("asm") == UnifiedModel::GeometryType::ASSEMBLY);
+    BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 4);
+    BOOST_CHECK_EQUAL(model->getRootIds().size(), 1);
+    BOOST_CHECK_EQUAL(model->getRootIds()[0], "asm");
+    BOOST_CHECK_EQUAL(model->getChildIds("asm").size(), 2);
+    BOOST_CHECK_EQUAL(model->getParentId("asm/sub/part2"), "asm/sub");
+    
+    // 父节点必须是装配体，且不能形成环
+    BOOST_CHECK(!model->setParent("asm", "asm/part1"));
+    BOOST_CHECK(!model->setParent("asm", "asm/sub"));
+    
+    // 装配体颜色作用于所有零件
+    std::vector<std::string> changed;
+    model->addChangeListener([&changed](const std::string& id) { changed.push_back(id); });
+    Quantity_Color red(1.0, 0.0, 0.0, Quantity_TOC_RGB);
+    model->setColor("asm", red);
+    BOOST_CHECK_CLOSE(model->getColor("asm/sub/part2").Red(), 1.0, 1e-6);
+    BOOST_CHECK(std::find(changed.begin(), changed.end(), "asm/part1") != changed.end());
+    BOOST_CHECK(std::find(changed.begin(), changed.end(), "asm/sub/part2") != changed.end());
+    
+    // 移除子装配体会移除其整个子树并从父节点分离
+    model->removeGeometry("asm/sub");
+    BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 2);
+    BOOST_CHECK(model->getGeometryData("asm/sub/part2") == nullptr);
+    BOOST_CHECK_EQUAL(model->getChildIds("asm").size(), 1);
+    
+    // 移除根装配体会清空模型
+    model->removeGeometry("asm");
+    BOOST_CHECK_EQUAL(model->getAllEntityIds().size(), 0);
+}
+
+// 测试模型版本号与实体视图
+BOOST_FIXTURE_TEST_CASE(generation_and_entity_range_test, UnifiedModelFixture)
+{
+    const std::uint64_t initialGeneration = model->getGeneration();
+    const std::uint64_t initialStructure = model->getStructureGeneration();
+    BOOST_CHECK(model->getEntities().empty());
+    
+    model->addShape("shape1", shape);
+    model->addMesh("mesh1", vertices, faces, normals);
+    BOOST_CHECK(model->getGeneration() > initialGeneration);
+    BOOST_CHECK(model->getStructureGeneration() > initialStructure);
+    
+    // 实体视图按ID顺序遍历，不复制ID
+    std::vector<std::string> ids;
+    for (const auto& entity : model->getEntities()) {
+        ids.push_back(entity.first);
+    }
+    BOOST_CHECK_EQUAL(model->getEntities().size(), 2);
+    BOOST_CHECK_EQUAL(model->getEntityCount(), 2);
+    BOOST_CHECK(ids == model->getAllEntityIds());
+    
+    // 属性修改只改变总版本号，不改变结构版本号
+    const std::uint64_t structure = model->getStructureGeneration();
+    const std::uint64_t generation = model->getGeneration();
+    model->setColor("shape1", Quantity_Color(0.0, 1.0, 0.0, Quantity_TOC_RGB));
+    BOOST_CHECK(model->getGeneration() > generation);
+    BOOST_CHECK_EQUAL(model->getStructureGeneration(), structure);
+    
+    // 结构修改同时改变两个版本号
+    model->removeGeometry("mesh1");
+    BOOST_CHECK(model->getStructureGeneration() > structure);
+    BOOST_CHECK_EQUAL(model->getEntities().size(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(part_attributes_test, UnifiedModelFixture)
+{
+    model->addShape("shape1", shape);
+    
+    // 名称和图层
+    model->setName("shape1", "Bracket");
+    model->setLayers("shape1", {"Layer1", "Layer2"});
+    BOOST_CHECK_EQUAL(model->getName("shape1"), "Bracket");
+    BOOST_CHECK_EQUAL(model->getName("unknown"), "");
+    BOOST_CHECK_EQUAL(model->getGeometryData("shape1")->layers.size(), 2);
+    
+    // 子形状颜色和实例键
+    TopExp_Explorer faceExplorer(shape, TopAbs_FACE);
+    BOOST_REQUIRE(faceExplorer.More());
+    model->setSubShapeColors("shape1", {{faceExplorer.Current(), Quantity_Color(Quantity_NOC_RED)}});
+    model->setInstanceKey("shape1", "part:0:1:1:1");
+    BOOST_CHECK_EQUAL(model->getGeometryData("shape1")->subShapeColors.size(), 1);
+    BOOST_CHECK_EQUAL(model->getGeometryData("shape1")->instanceKey, "part:0:1:1:1");
+    
+    // 设置零件整体颜色会覆盖子形状颜色
+    model->setColor("shape1", Quantity_Color(Quantity_NOC_BLUE1));
+    BOOST_CHECK(model->getGeometryData("shape1")->subShapeColors.empty());
+    
+    // 属性在合并时一起转移
+    UnifiedModel target;
+    target.merge(std::move(*model));
+    BOOST_CHECK_EQUAL(target.getName("shape1"), "Bracket");
+    BOOST_CHECK_EQUAL(target.getGeometryData("shape1")->instanceKey, "part:0:1:1:1");
+}
+
+// 测试网格缓冲区的移动与共享
+BOOST_FIXTURE_TEST_CASE(mesh_buffer_sharing_test, UnifiedModelFixture)
+{
+    // 右值重载接管缓冲区，不复制
+    Eigen::MatrixXd movedVertices = vertices;
+    Eigen::MatrixXi movedFaces = faces;
+    Eigen::MatrixXd movedNormals = normals;
+    const double* vertexBuffer = movedVertices.data();
+    model->addMesh("mesh1", std::move(movedVertices), std::move(movedFaces), std::move(movedNormals));
+    BOOST_CHECK_EQUAL(movedVertices.size(), 0);
+    BOOST_CHECK_EQUAL(movedFaces.size(), 0);
+    BOOST_REQUIRE(model->getMesh("mesh1") != nullptr);
+    BOOST_CHECK(model->getMesh("mesh1")->vertices.data() == vertexBuffer);
+    
+    // 共享中的缓冲区在变换时先复制，持有者看到的数据保持不变
+    UnifiedModel::MeshDataPtr shared = model->getSharedMesh("mesh1");
+    BOOST_REQUIRE(shared);
+    BOOST_CHECK(shared.get() == model->getMesh("mesh1"));
+    const double originalX = shared->vertices(0, 0);
+    gp_Trsf translation;
+    translation.SetTranslation(gp_Vec(10.0, 0.0, 0.0));
+    model->transform("mesh1", translation);
+    BOOST_CHECK_CLOSE(shared->vertices(0, 0), originalX, 1e-9);
+    BOOST_CHECK_CLOSE(model->getMesh("mesh1")->vertices(0, 0), originalX + 10.0, 1e-9);
+    
+    // 不再共享时原地修改
+    shared.reset();
+    const UnifiedModel::MeshData* current = model->getMesh("mesh1");
+    model->transform("mesh1", translation);
+    BOOST_CHECK(model->getMesh("mesh1") == current);
+    BOOST_CHECK(!model->getSharedMesh("missing"));
+}
+
+// 测试变更通知携带的变更类型
+BOOST_FIXTURE_TEST_CASE(change_kind_test, UnifiedModelFixture)
+{
+    std::vector<std::pair<std::string, IModel::ChangeKind>> changes;
+    model->addChangeListener([&changes](const std::string& id, IModel::ChangeKind kind) {
+        changes.emplace_back(id, kind);
+    });
+    size_t idOnlyCount = 0;
+    model->addChangeListener([&idOnlyCount](const std::string&) { ++idOnlyCount; });
+    
+    // 新增实体属于几何变更，改变父节点属于属性变更
+    model->addAssembly("asm");
+    model->addShape("part", shape);
+    const std::uint64_t generation = model->getGeneration();
+    BOOST_REQUIRE(model->setParent("part", "asm"));
+    BOOST_CHECK_GT(model->getGeneration(), generation);
+    model->addMesh("mesh1", vertices, faces, normals);
+    BOOST_REQUIRE_EQUAL(changes.size(), 4);
+    BOOST_CHECK_EQUAL(changes[2].first, "part");
+    BOOST_CHECK(changes[2].second == IModel::ChangeKind::ATTRIBUTES);
+    BOOST_CHECK(changes.back().second == IModel::ChangeKind::GEOMETRY);
+    BOOST_CHECK_EQUAL(idOnlyCount, 4);
+    
+    // 无效的父节点不通知
+    changes.clear();
+    BOOST_CHECK(!model->setParent("asm", "part"));
+    BOOST_CHECK(changes.empty());
+    
+    // 装配体颜色只通知零件的颜色变更
+    changes.clear();
+    model->setColor("asm", Quantity_Color(1.0, 0.0, 0.0, Quantity_TOC_RGB));
+    BOOST_REQUIRE_EQUAL(changes.size(), 1);
+    BOOST_CHECK_EQUAL(changes[0].first, "part");
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::COLOR);
+    
+    // 名称和图层不影响显示
+    changes.clear();
+    model->setName("part", "Part");
+    model->setLayers("part", {"layer"});
+    BOOST_REQUIRE_EQUAL(changes.size(), 2);
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::ATTRIBUTES);
+    BOOST_CHECK(changes[1].second == IModel::ChangeKind::ATTRIBUTES);
+    
+    // 刚体变换只移动形状，几何保持共享
+    const TopoDS_Shape original = model->getShape("part");
+    gp_Trsf translation;
+    translation.SetTranslation(gp_Vec(10.0, 0.0, 0.0));
+    changes.clear();
+    model->transform("part", translation);
+    BOOST_REQUIRE_EQUAL(changes.size(), 1);
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::TRANSFORM);
+    BOOST_CHECK(model->getShape("part").IsPartner(original));
+    BOOST_CHECK_CLOSE(model->getShape("part").Location().Transformation().TranslationPart().X(), 10.0, 1e-9);
+    
+    // 比例因子只因舍入误差偏离1时仍是刚体变换
+    gp_Trsf nearlyRigid = translation;
+    nearlyRigid.SetScaleFactor(1.0 + 1e-10);
+    changes.clear();
+    model->transform("part", nearlyRigid);
+    BOOST_REQUIRE_EQUAL(changes.size(), 1);
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::TRANSFORM);
+    BOOST_CHECK(model->getShape("part").IsPartner(original));
+    BOOST_CHECK_EQUAL(model->getShape("part").Location().Transformation().ScaleFactor(), 1.0);
+    
+    // 缩放改变几何本身，网格变换同样改变顶点
+    gp_Trsf scaling;
+    scaling.SetScale(gp_Pnt(0.0, 0.0, 0.0), 2.0);
+    changes.clear();
+    model->transform("part", scaling);
+    model->transform("mesh1", translation);
+    BOOST_REQUIRE_EQUAL(changes.size(), 2);
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::GEOMETRY);
+    BOOST_CHECK(changes[1].second == IModel::ChangeKind::GEOMETRY);
+    BOOST_CHECK(!model->getShape("part").IsPartner(original));
+    
+    // 隐藏装配体会隐藏其零件，状态不变时不通知
+    changes.clear();
+    model->setVisible("asm", false);
+    model->setVisible("asm", false);
+    BOOST_REQUIRE_EQUAL(changes.size(), 1);
+    BOOST_CHECK_EQUAL(changes[0].first, "part");
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::VISIBILITY);
+    BOOST_CHECK(!model->isVisible("asm"));
+    BOOST_CHECK(!model->isVisible("part"));
+    BOOST_CHECK(model->isVisible("mesh1"));
+    BOOST_CHECK(!model->isVisible("missing"));
+    
+    // 移除实体
+    changes.clear();
+    model->removeGeometry("mesh1");
+    BOOST_REQUIRE_EQUAL(changes.size(), 1);
+    BOOST_CHECK(changes[0].second == IModel::ChangeKind::REMOVAL);
+}
+
+// 测试合并时的ID冲突
+BOOST_FIXTURE_TEST_CASE(merge_id_collision_test, UnifiedModelFixture)
+{
+    model->addShape("part", shape);
+    model->addAssembly("asm");
+    model->addAssembly("asm/sub", "asm");
+    
+    // 暂存模型中新装配体下的子装配体与现有零件同名；同名的顶层装配体连同子树跳过
+    UnifiedModel staging;
+    staging.addAssembly("top");
+    staging.addAssembly("part", "top");
+    staging.addMesh("part/mesh", vertices, faces, normals);
+    BOOST_CHECK(staging.setParent("part/mesh", "part"));
+    staging.addShape("top/other", shape);
+    BOOST_CHECK(staging.setParent("top/other", "top"));
+    staging.addAssembly("asm");
+    staging.addShape("asm/extra", shape);
+    BOOST_CHECK(staging.setParent("asm/extra", "asm"));
+    
+    std::vector<std::string> mergedIds = model->merge(std::move(staging));
+    std::sort(mergedIds.begin(), mergedIds.end());
+    BOOST_CHECK((mergedIds == std::vector<std::string>{"part/mesh", "part_2", "top", "top/other"}));
+    BOOST_CHECK_EQUAL(staging.getEntityCount(), 0);
+    
+    // 冲突的子实体以新ID挂在原父实体下，其子实体随之改挂
+    std::vector<std::string> topChildren = model->getChildIds("top");
+    std::sort(topChildren.begin(), topChildren.end());
+    BOOST_CHECK((topChildren == std::vector<std::string>{"part_2", "top/other"}));
+    BOOST_CHECK_EQUAL(model->getParentId("part_2"), "top");
+    BOOST_CHECK(model->getGeometryType("part_2") == UnifiedModel::GeometryType::ASSEMBLY);
+    BOOST_CHECK((model->getChildIds("part_2") == std::vector<std::string>{"part/mesh"}));
+    BOOST_CHECK_EQUAL(model->getParentId("part/mesh"), "part_2");
+    
+    // 现有实体不受影响
+    BOOST_CHECK(model->getGeometryType("part") == UnifiedModel::GeometryType::SHAPE);
+    BOOST_CHECK_EQUAL(model->getParentId("part"), "");
+    BOOST_CHECK((model->getChildIds("asm") == std::vector<std::string>{"asm/sub"}));
+    BOOST_CHECK(model->getGeometryData("asm/extra") == nullptr);
+    BOOST_CHECK_EQUAL(model->getRootIds().size(), 3);
+}